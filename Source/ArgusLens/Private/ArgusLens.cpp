@@ -10,6 +10,7 @@
 #include "Misc/Paths.h"
 #include "TimerManager.h"
 #include "Nexus/Palantir/Public/PalantirTrace.h"
+#include "Nexus/Palantir/Public/PalantirTimeline.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogArgusLens, Display, All);
 
@@ -43,7 +44,7 @@ void UArgusLens::StartPerformanceMonitoring(float DurationSeconds, bool bTrackNe
     }
 
     // Sample every 100ms
-    World->GetTimerManager().SetTimer(GPerformanceMonitorHandle, FTimerDelegate::CreateLambda([]()
+    World->GetTimerManager().SetTimer(GPerformanceMonitorHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("PerformanceSample"), []()
     {
         FPerformanceSample Sample;
         Sample.Timestamp = FDateTime::Now().ToString(TEXT("%Y-%m-%d %H:%M:%S"));
@@ -70,6 +71,10 @@ void UArgusLens::StartPerformanceMonitoring(float DurationSeconds, bool bTrackNe
             {
                 GTotalHitches++;
                 UE_LOG(LogArgusLens, Warning, TEXT("ArgusLens: Hitch detected - Frame time: %.1fms"), Sample.FrameTimeMs);
+                if (FPalantirTimeline::IsRecording())
+                {
+                    FPalantirTimeline::AddInstant(TEXT("Hitch"), TEXT("hitch"), FString::Printf(TEXT("%.1fms"), Sample.FrameTimeMs), true);
+                }
             }
 
             // Track peak memory
@@ -80,18 +85,18 @@ void UArgusLens::StartPerformanceMonitoring(float DurationSeconds, bool bTrackNe
 
             GPerformanceSamples.Add(Sample);
         }
-    }), 0.1f, true);
+    })), 0.1f, true);
 
     // Stop monitoring after duration
     FTimerHandle StopHandle;
-    World->GetTimerManager().SetTimer(StopHandle, FTimerDelegate::CreateLambda([World]()
+    World->GetTimerManager().SetTimer(StopHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("PerformanceMonitorEnd"), [World]()
     {
         if (World)
         {
             World->GetTimerManager().ClearTimer(GPerformanceMonitorHandle);
         }
         UE_LOG(LogArgusLens, Display, TEXT("PERFORMANCE MONITORING STOPPED"));
-    }), DurationSeconds, false);
+    })), DurationSeconds, false);
 }
 
 void UArgusLens::StopPerformanceMonitoring()
@@ -10,6 +10,7 @@
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
 #include "Engine/Engine.h"
+#include "Nexus/Palantir/Public/PalantirTrace.h"
 
 // Global state for simulated clients and replication events
 static TArray<FSimulatedClient> GSimulatedClients;
@@ -69,7 +70,7 @@ void UBishopBridge::SpawnSimulatedClients(int32 ClientCount, float DurationMinut
     TSharedRef<int32, ESPMode::ThreadSafe> ReplicationTicks = MakeShared<int32, ESPMode::ThreadSafe>(0);
     TSharedRef<FTimerHandle> ReplicationHandle = MakeShared<FTimerHandle>();
 
-    World->GetTimerManager().SetTimer(*ReplicationHandle, FTimerDelegate::CreateLambda([ReplicationTicks, ClientCount]()
+    World->GetTimerManager().SetTimer(*ReplicationHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("ReplicationTick"), [ReplicationTicks, ClientCount]()
     {
         if (*ReplicationTicks > 1000) return; // Limit ticks to avoid infinite log
 
@@ -100,11 +101,11 @@ void UBishopBridge::SpawnSimulatedClients(int32 ClientCount, float DurationMinut
         }
 
         (*ReplicationTicks)++;
-    }), 0.5f, true);
+    })), 0.5f, true);
 
     // End simulation after duration
     FTimerHandle EndHandle;
-    World->GetTimerManager().SetTimer(EndHandle, FTimerDelegate::CreateLambda([World, ReplicationHandle]()
+    World->GetTimerManager().SetTimer(EndHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("ReplicationEnd"), [World, ReplicationHandle]()
     {
         if (World)
         {
@@ -113,7 +114,7 @@ void UBishopBridge::SpawnSimulatedClients(int32 ClientCount, float DurationMinut
         float SyncRate = (GTotalReplicationAttempts > 0) ? (float)GSuccessfulReplications / GTotalReplicationAttempts : 1.0f;
         BishopBridgeLog(FString::Printf(TEXT("SIMULATION COMPLETE: %d clients, sync rate %.1f%%"),
             GSimulatedClients.Num(), SyncRate * 100.0f));
-    }), DurationMinutes * 60.0f, false);
+    })), DurationMinutes * 60.0f, false);
 }
 
 float UBishopBridge::GetAverageReplicationLagMs()
@@ -57,8 +57,9 @@ void UCortexiphanInjector::InjectChaos(float DurationSeconds, float Intensity)
     TSharedRef<FTimerHandle, ESPMode::ThreadSafe> ChaosTimerHandle = MakeShared<FTimerHandle, ESPMode::ThreadSafe>();
     TSharedRef<FTimerHandle, ESPMode::ThreadSafe> EndTimerHandle = MakeShared<FTimerHandle, ESPMode::ThreadSafe>();
 
-    // Periodic chaos tick — safe lambda captures (no references to stack locals or this)
-    World->GetTimerManager().SetTimer(*ChaosTimerHandle, FTimerDelegate::CreateLambda([TimeLeft, Intensity]()
+    // Periodic chaos tick — safe lambda captures (no references to stack locals or this).
+    // Wrapped so chaos events still land in the breadcrumbs of the test that injected them.
+    World->GetTimerManager().SetTimer(*ChaosTimerHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("ChaosTick"), [TimeLeft, Intensity]()
     {
         if (*TimeLeft <= 0.0f) return;
 
@@ -87,17 +88,17 @@ void UCortexiphanInjector::InjectChaos(float DurationSeconds, float Intensity)
         }
 
         *TimeLeft -= 3.0f;
-    }), 3.0f, true);
+    })), 3.0f, true);
 
     // End chaos after the requested duration — clear the periodic timer safely.
-    World->GetTimerManager().SetTimer(*EndTimerHandle, FTimerDelegate::CreateLambda([ChaosTimerHandle, World]()
+    World->GetTimerManager().SetTimer(*EndTimerHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("ChaosEnd"), [ChaosTimerHandle, World]()
     {
         if (World && World->GetTimerManager().IsTimerActive(*ChaosTimerHandle))
         {
             World->GetTimerManager().ClearTimer(*ChaosTimerHandle);
             ChaosLog(TEXT("CORTEXIPHAN EFFECT SUBSIDING — RETURNING TO BASELINE"));
         }
-    }), DurationSeconds, false);
+    })), DurationSeconds, false);
 }
 
 void UCortexiphanInjector::TriggerLagSpike(float AddedLatencyMs)
@@ -140,7 +141,7 @@ void UCortexiphanInjector::SimulateJitterAndReordering(float JitterMs, float Reo
     FTimerHandle JitterHandle;
 
     // Periodic jitter injection
-    World->GetTimerManager().SetTimer(JitterHandle, FTimerDelegate::CreateLambda([TimeLeft, JitterMs, ReorderPercent]()
+    World->GetTimerManager().SetTimer(JitterHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("JitterTick"), [TimeLeft, JitterMs, ReorderPercent]()
     {
         if (*TimeLeft <= 0.0f) return;
 
@@ -152,20 +153,20 @@ void UCortexiphanInjector::SimulateJitterAndReordering(float JitterMs, float Reo
         }
 
         *TimeLeft -= 1.0f;
-    }), 1.0f, true);
+    })), 1.0f, true);
 
     // Stop jitter injection after duration
     // Use a shared ref to keep the handle alive across lambda lifetime
     TSharedRef<FTimerHandle, ESPMode::ThreadSafe> JitterHandlePtr = MakeShared<FTimerHandle, ESPMode::ThreadSafe>(JitterHandle);
     FTimerHandle StopHandle;
-    World->GetTimerManager().SetTimer(StopHandle, FTimerDelegate::CreateLambda([World, JitterHandlePtr]()
+    World->GetTimerManager().SetTimer(StopHandle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("JitterEnd"), [World, JitterHandlePtr]()
     {
         if (World)
         {
             World->GetTimerManager().ClearTimer(*JitterHandlePtr);
             ChaosLog(TEXT("JITTER/REORDER SUBSIDING"));
         }
-    }), Duration, false);
+    })), Duration, false);
 }
 
 void UCortexiphanInjector::ExportChaosArtifact(const FString& OutputPath)
@@ -243,6 +243,7 @@ static void RenderSlateDashboard(const TMap<FString, int32>& Counters, const TAr
 		int32 SkippedCount = 0;
 		
 		// Count test results from AllResults
+		FNexusResultCollector::Flush();
 		for (const FNexusTestResult& Result : FNexusTest::AllResults)
 		{
 			if (Result.bSkipped)
@@ -260,6 +261,7 @@ static void RenderSlateDashboard(const TMap<FString, int32>& Counters, const TAr
 		}
 		
 		int32 TotalExecuted = PassedCount + FailedCount + SkippedCount;
+		FNexusTestDescriptor::MaterializeAll();
 		int32 TotalDiscovered = FNexusTest::AllTests.Num();
 		
 		FString PassedText = FString::Printf(TEXT("  ✓ Passed: %d"), PassedCount);
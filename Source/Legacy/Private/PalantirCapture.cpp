@@ -2,6 +2,7 @@
 #include "Engine/Engine.h"
 #include "HighResScreenshot.h"
 #include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "Nexus/Palantir/Public/PalantirTrace.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFilemanager.h"
 #include "HAL/PlatformProcess.h"
@@ -26,7 +27,7 @@ void FPalantirCapture::TakeScreenshotOnFailure(const FString& TestName)
         FString CapturedTestName = TestName;
 
         // Launch a background task to poll for the asynchronous screenshot and register artifacts.
-        Async(EAsyncExecution::ThreadPool, [CapturedBaseName, CapturedTestName, ScreenshotsDir, SavedDir, TimeoutSeconds, PollInterval]() {
+        PalantirAsync(EAsyncExecution::ThreadPool, TEXT("ScreenshotPoll"), [CapturedBaseName, CapturedTestName, ScreenshotsDir, SavedDir, TimeoutSeconds, PollInterval]() {
             double Elapsed = 0.0;
             FString FoundPath;
             IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -0,0 +1,213 @@
+#include "NexusActorPool.h"
+#include "NexusModule.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+
+static constexpr int32 GNexusActorPoolDefaultPrewarm = 8;
+
+// Idle actors wait here, hidden and without collision; well above the default KillZ
+static const FVector GNexusActorPoolParkLocation(0.0, 0.0, -100000.0);
+
+FNexusActorPool& FNexusActorPool::Get()
+{
+    static FNexusActorPool Instance;
+    return Instance;
+}
+
+bool FNexusActorPool::IsEnabled()
+{
+    if (FParse::Param(FCommandLine::Get(), TEXT("NexusActorPool")))
+    {
+        return true;
+    }
+
+    bool bEnabled = false;
+    if (GConfig)
+    {
+        GConfig->GetBool(TEXT("/Script/Nexus.NexusSettings"), TEXT("bActorPoolEnabled"), bEnabled, GGameIni);
+    }
+    return bEnabled;
+}
+
+int32 FNexusActorPool::GetPrewarmCount()
+{
+    int32 Count = GNexusActorPoolDefaultPrewarm;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusActorPoolPrewarm="), Count) && GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("ActorPoolPrewarm"), Count, GGameIni);
+    }
+    return FMath::Max(0, Count);
+}
+
+AActor* FNexusActorPool::Acquire(UWorld* World, UClass* Class, const FVector& Location, const FRotator& Rotation)
+{
+    check(IsInGameThread());
+
+    if (!World || !Class)
+    {
+        return nullptr;
+    }
+
+    const FPoolKey Key(World, Class);
+    if (!IdleActors.Contains(Key))
+    {
+        Prewarm(World, Class, GetPrewarmCount());
+    }
+
+    TArray<TWeakObjectPtr<AActor>>& Idle = IdleActors.FindOrAdd(Key);
+    while (Idle.Num() > 0)
+    {
+        AActor* Actor = Idle.Pop(EAllowShrinking::No).Get();
+        if (!Actor || Actor->IsActorBeingDestroyed())
+        {
+            continue;  // Destroyed behind the pool's back (world teardown, rollback)
+        }
+        if (Activate(Actor, Location, Rotation))
+        {
+            ++Stats.Hits;
+            return Actor;
+        }
+
+        // The spot is taken for this shape; keep the actor for the next request
+        Deactivate(Actor);
+        Idle.Add(Actor);
+        break;
+    }
+
+    ++Stats.Misses;
+    return SpawnPooled(World, Class, Location, Rotation);
+}
+
+bool FNexusActorPool::Release(AActor* Actor)
+{
+    check(IsInGameThread());
+
+    if (!Actor || Actor->IsActorBeingDestroyed() || !PooledActors.Contains(Actor))
+    {
+        return false;
+    }
+
+    Deactivate(Actor);
+    IdleActors.FindOrAdd(FPoolKey(Actor->GetWorld(), Actor->GetClass())).Add(Actor);
+    ++Stats.Released;
+    return true;
+}
+
+void FNexusActorPool::Prewarm(UWorld* World, UClass* Class, int32 Count)
+{
+    check(IsInGameThread());
+
+    TArray<TWeakObjectPtr<AActor>>& Idle = IdleActors.FindOrAdd(FPoolKey(World, Class));
+    Idle.RemoveAll([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid(); });
+
+    while (Idle.Num() < Count)
+    {
+        AActor* Actor = SpawnPooled(World, Class, GNexusActorPoolParkLocation, FRotator::ZeroRotator);
+        if (!Actor)
+        {
+            break;
+        }
+        Deactivate(Actor);
+        Idle.Add(Actor);
+        ++Stats.Prewarmed;
+    }
+}
+
+bool FNexusActorPool::IsPooledActor(const AActor* Actor) const
+{
+    return Actor && PooledActors.Contains(Actor);
+}
+
+void FNexusActorPool::Empty()
+{
+    for (TPair<FPoolKey, TArray<TWeakObjectPtr<AActor>>>& Pair : IdleActors)
+    {
+        for (const TWeakObjectPtr<AActor>& Actor : Pair.Value)
+        {
+            if (Actor.IsValid() && !Actor->IsActorBeingDestroyed())
+            {
+                Actor->Destroy();
+            }
+        }
+    }
+    IdleActors.Empty();
+    PooledActors.Empty();
+}
+
+AActor* FNexusActorPool::SpawnPooled(UWorld* World, UClass* Class, const FVector& Location, const FRotator& Rotation)
+{
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+
+    AActor* Actor = World->SpawnActor<AActor>(Class, Location, Rotation, SpawnParams);
+    if (Actor)
+    {
+        PooledActors.Add(Actor);
+    }
+    return Actor;
+}
+
+void FNexusActorPool::Deactivate(AActor* Actor)
+{
+    if (APawn* Pawn = Cast<APawn>(Actor))
+    {
+        // AI controllers spawned for the pawn go away; a new one is spawned on reactivation
+        Pawn->DetachFromControllerPendingDestroy();
+    }
+    if (ACharacter* Character = Cast<ACharacter>(Actor))
+    {
+        if (UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+        {
+            Movement->StopMovementImmediately();
+            Movement->DisableMovement();
+        }
+    }
+
+    Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+    TArray<AActor*> Attached;
+    Actor->GetAttachedActors(Attached);
+    for (AActor* Child : Attached)
+    {
+        Child->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+    }
+
+    Actor->SetActorHiddenInGame(true);
+    Actor->SetActorEnableCollision(false);
+    Actor->SetActorTickEnabled(false);
+    Actor->SetActorLocationAndRotation(GNexusActorPoolParkLocation, FRotator::ZeroRotator, false, nullptr, ETeleportType::ResetPhysics);
+}
+
+bool FNexusActorPool::Activate(AActor* Actor, const FVector& Location, const FRotator& Rotation)
+{
+    // TeleportTo adjusts the spot like AdjustIfPossibleButDontSpawnIfColliding does for spawns
+    Actor->SetActorEnableCollision(true);
+    if (!Actor->TeleportTo(Location, Rotation))
+    {
+        return false;
+    }
+
+    Actor->SetActorHiddenInGame(false);
+    Actor->SetActorTickEnabled(true);
+
+    if (ACharacter* Character = Cast<ACharacter>(Actor))
+    {
+        if (UCharacterMovementComponent* Movement = Character->GetCharacterMovement())
+        {
+            Movement->SetDefaultMovementMode();
+        }
+    }
+    if (APawn* Pawn = Cast<APawn>(Actor))
+    {
+        if (!Pawn->GetController() && Pawn->AutoPossessAI != EAutoPossessAI::Disabled)
+        {
+            Pawn->SpawnDefaultController();
+        }
+    }
+    return true;
+}
@@ -0,0 +1,210 @@
+#include "NexusCancellation.h"
+#include "NexusCore.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+// Sentinel poll interval - bounds how long another process's abort takes to reach in-flight tests here
+static constexpr uint32 GNexusAbortPollMs = 20;
+
+// A sentinel written this long before the run started still counts (a shard that aborted while we booted)
+static constexpr double GNexusAbortSentinelSlackSeconds = 10.0;
+
+void FNexusCancellationToken::Cancel(const FString& InReason)
+{
+    {
+        FScopeLock Lock(&ReasonLock);
+        if (bCancelled.load(std::memory_order_relaxed))
+        {
+            return;
+        }
+        Reason = InReason;
+    }
+    bCancelled.store(true, std::memory_order_release);
+}
+
+FString FNexusCancellationToken::GetReason() const
+{
+    {
+        FScopeLock Lock(&ReasonLock);
+        if (!Reason.IsEmpty() || !Parent.IsValid())
+        {
+            return Reason;
+        }
+    }
+    return Parent->GetReason();
+}
+
+TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& FNexusCancellationToken::GetCurrentRef()
+{
+    // Function-local thread_local (avoids C2492 with thread_local static members on exported classes)
+    thread_local TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Current;
+    return Current;
+}
+
+TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> FNexusCancellationToken::GetCurrent()
+{
+    return GetCurrentRef();
+}
+
+bool FNexusCancellationToken::IsCurrentCancelled()
+{
+    const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& Current = GetCurrentRef();
+    return Current.IsValid() && Current->IsCancellationRequested();
+}
+
+FNexusCancellationScope::FNexusCancellationScope(const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& Token)
+    : Previous(FNexusCancellationToken::GetCurrentRef())
+{
+    FNexusCancellationToken::GetCurrentRef() = Token;
+}
+
+FNexusCancellationScope::~FNexusCancellationScope()
+{
+    FNexusCancellationToken::GetCurrentRef() = Previous;
+}
+
+// ============================================================================
+// FNexusRunCancellation
+// ============================================================================
+
+/**
+ * Polls the abort sentinel and cancels the run token when another process writes it
+ */
+class FNexusAbortSentinelWatcher : public FRunnable
+{
+public:
+    explicit FNexusAbortSentinelWatcher(const TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe>& InToken)
+        : Token(InToken)
+        , SentinelPath(UNexusCore::GetAbortFilePath())
+        , NotBefore(FDateTime::UtcNow() - FTimespan::FromSeconds(GNexusAbortSentinelSlackSeconds))
+        , OwnPidLine(FString::Printf(TEXT("PID=%d"), FPlatformProcess::GetCurrentProcessId()))
+    {
+        StopEvent = FPlatformProcess::GetSynchEventFromPool(true);
+    }
+
+    virtual ~FNexusAbortSentinelWatcher() override
+    {
+        FPlatformProcess::ReturnSynchEventToPool(StopEvent);
+    }
+
+    virtual uint32 Run() override
+    {
+        FDateTime LastSeen = FDateTime::MinValue();
+        while (!StopEvent->Wait(GNexusAbortPollMs))
+        {
+            const FDateTime Stamp = IFileManager::Get().GetTimeStamp(*SentinelPath);
+            if (Stamp < NotBefore || Stamp == LastSeen)
+            {
+                continue;
+            }
+            LastSeen = Stamp;
+
+            // Our own aborts cancel the token directly; a sentinel we wrote is either that or left over from an earlier run
+            FString Contents;
+            FFileHelper::LoadFileToString(Contents, *SentinelPath);
+            TArray<FString> Lines;
+            Contents.ParseIntoArrayLines(Lines);
+            if (Lines.Contains(OwnPidLine))
+            {
+                continue;
+            }
+
+            FString Reason;
+            for (const FString& Line : Lines)
+            {
+                if (Line.StartsWith(TEXT("Reason=")))
+                {
+                    Reason = Line.RightChop(7);
+                }
+            }
+            UE_LOG(LogNexus, Warning, TEXT("NEXUS: Abort sentinel written by another process — cancelling in-flight tests (Reason: %s)"), *Reason);
+            Token->Cancel(FString::Printf(TEXT("Aborted by another process: %s"), *Reason));
+            break;
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        StopEvent->Trigger();
+    }
+
+private:
+    TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe> Token;
+    const FString SentinelPath;
+    const FDateTime NotBefore;
+    const FString OwnPidLine;
+    FEvent* StopEvent = nullptr;
+};
+
+// The lock only guards replacing the token and the watcher; readers go through GNexusRunTokenPtr
+static FCriticalSection GNexusRunCancellationLock;
+static std::atomic<FNexusCancellationToken*> GNexusRunTokenPtr{nullptr};
+static TUniquePtr<FNexusAbortSentinelWatcher> GNexusAbortWatcher;
+static FRunnableThread* GNexusAbortWatcherThread = nullptr;
+
+// Every run token stays alive for the process (one per run), so a lock-free reader never sees a freed one
+static TArray<TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe>> GNexusRunTokens;
+
+static FNexusCancellationToken* ReplaceRunTokenLocked()
+{
+    FNexusCancellationToken* Token = &GNexusRunTokens.Add_GetRef(MakeShared<FNexusCancellationToken, ESPMode::ThreadSafe>()).Get();
+    GNexusRunTokenPtr.store(Token, std::memory_order_release);
+    return Token;
+}
+
+void FNexusRunCancellation::BeginRun()
+{
+    EndRun();
+
+    FScopeLock Lock(&GNexusRunCancellationLock);
+    GNexusAbortWatcher = MakeUnique<FNexusAbortSentinelWatcher>(ReplaceRunTokenLocked()->AsShared());
+    GNexusAbortWatcherThread = FRunnableThread::Create(GNexusAbortWatcher.Get(), TEXT("NexusAbortWatcher"), 0, TPri_BelowNormal);
+}
+
+void FNexusRunCancellation::EndRun()
+{
+    FScopeLock Lock(&GNexusRunCancellationLock);
+    if (GNexusAbortWatcherThread)
+    {
+        GNexusAbortWatcherThread->Kill(true);  // Stop() + join
+        delete GNexusAbortWatcherThread;
+        GNexusAbortWatcherThread = nullptr;
+    }
+    GNexusAbortWatcher.Reset();
+}
+
+void FNexusRunCancellation::Cancel(const FString& Reason)
+{
+    GetToken()->Cancel(Reason);
+}
+
+bool FNexusRunCancellation::IsCancelled()
+{
+    const FNexusCancellationToken* Token = GNexusRunTokenPtr.load(std::memory_order_acquire);
+    return Token && Token->IsCancellationRequested();
+}
+
+TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe> FNexusRunCancellation::GetToken()
+{
+    FNexusCancellationToken* Token = GNexusRunTokenPtr.load(std::memory_order_acquire);
+    if (!Token)
+    {
+        FScopeLock Lock(&GNexusRunCancellationLock);
+        Token = GNexusRunTokenPtr.load(std::memory_order_relaxed);
+        if (!Token)
+        {
+            Token = ReplaceRunTokenLocked();
+        }
+    }
+    return Token->AsShared();
+}
+
+TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe> FNexusRunCancellation::MakeAttemptToken()
+{
+    return MakeShared<FNexusCancellationToken, ESPMode::ThreadSafe>(TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>(GetToken()));
+}
@@ -0,0 +1,236 @@
+#include "NexusConcurrency.h"
+#include "NexusModule.h"
+#include "Nexus/Palantir/Public/PalantirTimeline.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ConfigCacheIni.h"
+
+const TCHAR* LexToString(ENexusResourceClass ResourceClass)
+{
+    switch (ResourceClass)
+    {
+    case ENexusResourceClass::CpuBound:    return TEXT("CpuBound");
+    case ENexusResourceClass::IoBound:     return TEXT("IoBound");
+    case ENexusResourceClass::MemoryHeavy: return TEXT("MemoryHeavy");
+    default:                               return TEXT("Default");
+    }
+}
+
+static double GetGovernorSetting(const TCHAR* Key, double DefaultValue)
+{
+    double Value = DefaultValue;
+    if (GConfig)
+    {
+        GConfig->GetDouble(TEXT("/Script/Nexus.NexusSettings"), Key, Value, GGameIni);
+    }
+    return Value;
+}
+
+FNexusConcurrencyGovernor::FNexusConcurrencyGovernor(int32 InInitialTarget, int32 InMaxTarget)
+{
+    MaxTarget = FMath::Max(1, InMaxTarget);
+    Target = FMath::Clamp(InInitialTarget, 1, MaxTarget);
+    CpuCores = FMath::Max(1, FPlatformMisc::NumberOfCores());
+
+    SampleIntervalSeconds = FMath::Max(0.05, GetGovernorSetting(TEXT("ConcurrencySampleInterval"), 0.25));
+    CpuHigh = GetGovernorSetting(TEXT("ConcurrencyCpuHigh"), 90.0);
+    CpuLow = FMath::Min(CpuHigh, GetGovernorSetting(TEXT("ConcurrencyCpuLow"), 75.0));
+    MinFreeMemoryMb = GetGovernorSetting(TEXT("MinFreeMemoryMb"), 1024.0);
+    MaxResidentMemoryMb = GetGovernorSetting(TEXT("MaxResidentMemoryMb"), 0.0);
+
+    Stats.InitialTarget = Target;
+    Stats.MinTarget = Target;
+    Stats.MaxTarget = Target;
+    FPalantirTimeline::AddCounter(TEXT("ConcurrencyTarget"), Target);
+
+    // Prime the CPU counter so the first sample covers the first interval of the run
+    LastSampleSeconds = FPlatformTime::Seconds();
+    NextSampleSeconds = LastSampleSeconds + SampleIntervalSeconds;
+    FPlatformTime::UpdateCPUTime(0.0f);
+}
+
+bool FNexusConcurrencyGovernor::IsEnabled()
+{
+    int32 PinnedWorkers = 0;
+    if (FParse::Param(FCommandLine::Get(), TEXT("NexusNoAdaptiveConcurrency")) ||
+        (FParse::Value(FCommandLine::Get(), TEXT("NexusWorkers="), PinnedWorkers) && PinnedWorkers > 0))
+    {
+        return false;
+    }
+
+    bool bEnabled = true;
+    if (GConfig)
+    {
+        GConfig->GetBool(TEXT("/Script/Nexus.NexusSettings"), TEXT("bAdaptiveConcurrency"), bEnabled, GGameIni);
+    }
+    return bEnabled;
+}
+
+int32 FNexusConcurrencyGovernor::GetMaxWorkerCount(int32 DefaultWorkers)
+{
+    int32 Workers = 0;
+    if (GConfig && GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("MaxAdaptiveWorkers"), Workers, GGameIni) && Workers > 0)
+    {
+        return FMath::Max(Workers, DefaultWorkers);
+    }
+    return FMath::Max(1, DefaultWorkers * 2);
+}
+
+bool FNexusConcurrencyGovernor::CanAdmitLocked(ENexusResourceClass ResourceClass) const
+{
+    // Something must always be able to run, or a refusal could stall the schedule
+    if (ActiveSlots + ActiveIoBound == 0)
+    {
+        return true;
+    }
+
+    switch (ResourceClass)
+    {
+    case ENexusResourceClass::IoBound:
+        return true;  // Bounded by the worker threads only
+    case ENexusResourceClass::CpuBound:
+        return ActiveSlots < Target && ActiveCpuBound < CpuCores;
+    case ENexusResourceClass::MemoryHeavy:
+        return ActiveSlots < Target && ActiveMemoryHeavy < (bMemoryPressure ? 1 : FMath::Max(1, Target / 2));
+    default:
+        return ActiveSlots < Target;
+    }
+}
+
+bool FNexusConcurrencyGovernor::TryAdmit(ENexusResourceClass ResourceClass, bool bForce)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!bForce && !CanAdmitLocked(ResourceClass))
+    {
+        return false;
+    }
+
+    switch (ResourceClass)
+    {
+    case ENexusResourceClass::IoBound:
+        ++ActiveIoBound;
+        break;
+    case ENexusResourceClass::CpuBound:
+        ++ActiveCpuBound;
+        ++ActiveSlots;
+        break;
+    case ENexusResourceClass::MemoryHeavy:
+        ++ActiveMemoryHeavy;
+        ++ActiveSlots;
+        break;
+    default:
+        ++ActiveSlots;
+        break;
+    }
+    Stats.PeakActive = FMath::Max(Stats.PeakActive, ActiveSlots + ActiveIoBound);
+    FPalantirTimeline::AddCounter(TEXT("ActiveTests"), ActiveSlots + ActiveIoBound);
+    return true;
+}
+
+void FNexusConcurrencyGovernor::Release(ENexusResourceClass ResourceClass)
+{
+    FScopeLock ScopeLock(&Lock);
+    switch (ResourceClass)
+    {
+    case ENexusResourceClass::IoBound:
+        ActiveIoBound = FMath::Max(0, ActiveIoBound - 1);
+        break;
+    case ENexusResourceClass::CpuBound:
+        ActiveCpuBound = FMath::Max(0, ActiveCpuBound - 1);
+        ActiveSlots = FMath::Max(0, ActiveSlots - 1);
+        break;
+    case ENexusResourceClass::MemoryHeavy:
+        ActiveMemoryHeavy = FMath::Max(0, ActiveMemoryHeavy - 1);
+        ActiveSlots = FMath::Max(0, ActiveSlots - 1);
+        break;
+    default:
+        ActiveSlots = FMath::Max(0, ActiveSlots - 1);
+        break;
+    }
+    FPalantirTimeline::AddCounter(TEXT("ActiveTests"), ActiveSlots + ActiveIoBound);
+}
+
+void FNexusConcurrencyGovernor::Tick(TFunctionRef<int32()> GetRunQueueLength)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (Now < NextSampleSeconds || !SampleLock.TryLock())
+    {
+        return;
+    }
+
+    if (Now >= NextSampleSeconds)
+    {
+        // The game thread is blocked in RunTests while the scheduler runs, so the core ticker that normally
+        // feeds FPlatformTime's CPU counter is idle; the governor drives it instead
+        FPlatformTime::UpdateCPUTime(static_cast<float>(Now - LastSampleSeconds));
+        LastSampleSeconds = Now;
+        NextSampleSeconds = Now + SampleIntervalSeconds;
+
+        const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+        FNexusConcurrencySample Sample;
+        Sample.CpuUtilization = FPlatformTime::GetCPUTime().CPUTimePctRelative;
+        Sample.RunQueueLength = GetRunQueueLength();
+        Sample.ResidentMemoryMb = static_cast<double>(MemoryStats.UsedPhysical) / (1024.0 * 1024.0);
+        Sample.AvailableMemoryMb = static_cast<double>(MemoryStats.AvailablePhysical) / (1024.0 * 1024.0);
+        Update(Sample);
+    }
+
+    SampleLock.Unlock();
+}
+
+void FNexusConcurrencyGovernor::Update(const FNexusConcurrencySample& Sample)
+{
+    FScopeLock ScopeLock(&Lock);
+    Stats.PeakCpuUtilization = FMath::Max(Stats.PeakCpuUtilization, Sample.CpuUtilization);
+
+    bMemoryPressure = Sample.AvailableMemoryMb < MinFreeMemoryMb ||
+        (MaxResidentMemoryMb > 0.0 && Sample.ResidentMemoryMb > MaxResidentMemoryMb);
+    if (bMemoryPressure)
+    {
+        // Back off hard - an OOM kill loses the whole run, an idle core only loses time
+        ++Stats.MemoryPressureSamples;
+        SetTargetLocked(Target - FMath::Max(1, Target / 4), TEXT("memory pressure"), Sample);
+    }
+    else if (Sample.CpuUtilization > CpuHigh)
+    {
+        SetTargetLocked(Target - 1, TEXT("CPU saturated"), Sample);
+    }
+    else if (Sample.CpuUtilization < CpuLow && Sample.RunQueueLength > 0 && ActiveSlots >= Target)
+    {
+        SetTargetLocked(Target + 1, TEXT("CPU idle with work queued"), Sample);
+    }
+}
+
+void FNexusConcurrencyGovernor::SetTargetLocked(int32 NewTarget, const TCHAR* Reason, const FNexusConcurrencySample& Sample)
+{
+    NewTarget = FMath::Clamp(NewTarget, 1, MaxTarget);
+    if (NewTarget == Target)
+    {
+        return;
+    }
+
+    (NewTarget > Target ? Stats.Raises : Stats.Lowers)++;
+    UE_LOG(LogNexus, Verbose, TEXT("NEXUS: Concurrency %d -> %d (%s: CPU %.0f%%, %d queued, %.0f MB resident, %.0f MB free)"),
+        Target, NewTarget, Reason, Sample.CpuUtilization, Sample.RunQueueLength, Sample.ResidentMemoryMb, Sample.AvailableMemoryMb);
+
+    Target = NewTarget;
+    Stats.MinTarget = FMath::Min(Stats.MinTarget, Target);
+    Stats.MaxTarget = FMath::Max(Stats.MaxTarget, Target);
+    FPalantirTimeline::AddCounter(TEXT("ConcurrencyTarget"), Target);
+}
+
+int32 FNexusConcurrencyGovernor::GetTarget() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Target;
+}
+
+FNexusConcurrencyStats FNexusConcurrencyGovernor::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Stats;
+}
@@ -1,6 +1,11 @@
 #include "NexusConsoleCommands.h"
 #include "NexusCore.h"
 #include "Nexus/Core/Public/NexusTest.h"
+#include "Nexus/Core/Public/NexusSharding.h"
+#include "Nexus/Core/Public/NexusResultCache.h"
+#include "Nexus/Core/Public/NexusFlakiness.h"
+#include "Nexus/Core/Public/NexusRunHistory.h"
+#include "Nexus/Core/Public/NexusTestFilter.h"
 #include "Nexus/LCARSBridge/Public/LCARSReporter.h"
 #include "Nexus/Palantir/Public/PalantirOracle.h"
 #include "HAL/IConsoleManager.h"
@@ -9,9 +14,15 @@ void FNexusConsoleCommands::Register()
 {
 	IConsoleManager::Get().RegisterConsoleCommand(
 		TEXT("Nexus.RunTests"),
-		TEXT("Execute all discovered NEXUS_TEST macros and generate LCARS report"),
+		TEXT("Execute all discovered NEXUS_TEST macros and generate LCARS report. Usage: Nexus.RunTests [Shard=K/N] [Incremental] [NexusFilter=expr (last)]"),
 		FConsoleCommandWithArgsDelegate::CreateStatic(&FNexusConsoleCommands::OnRunTests)
 	);
+
+	IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("Nexus.MergeShards"),
+		TEXT("Merge shard result files (default Saved/NexusReports/shards) into a single LCARS report. Usage: Nexus.MergeShards [Directory]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&FNexusConsoleCommands::OnMergeShards)
+	);
 }
 
 void FNexusConsoleCommands::OnRunTests(const TArray<FString>& Args)
@@ -26,14 +37,67 @@ void FNexusConsoleCommands::OnRunTests(const TArray<FString>& Args)
 		UE_LOG(LogTemp, Display, TEXT("💡 To run game-thread tests with full world context, click 'Play' in the editor first"));
 	}
 
-	int32 TotalTests = FNexusTest::AllTests.Num();
-	UE_LOG(LogTemp, Warning, TEXT("🧪 NEXUS: Running %d test(s)..."), TotalTests);
-	UNexusCore::RunAllTests(true);  // true = parallel execution
+	// Nexus.RunTests NexusFilter=tag:Networking && !tag:Stress selects a subset of the suite
+	// (benchmarks only run when the filter names tag:Benchmark)
+	FNexusTestFilter Filter;
+	FString FilterExpression;
+	if (FNexusTestFilter::ParseFromArgs(Args, FilterExpression))
+	{
+		FString FilterError;
+		if (!FNexusTestFilter::Compile(FilterExpression, Filter, FilterError))
+		{
+			UE_LOG(LogTemp, Error, TEXT("❌ NEXUS: Invalid filter \"%s\": %s"), *FilterExpression, *FilterError);
+			return;
+		}
+	}
+	TArray<FNexusTest*> SelectedTests = Filter.SelectForRun(UNexusCore::DiscoveredTests);
+
+	// Nexus.RunTests Shard=K/N runs only this process's slice of the suite
+	FNexusShardSpec Shard;
+	const bool bSharded = FNexusSharding::ParseFromArgs(Args, Shard) && Shard.IsSharded();
+	if (bSharded)
+	{
+		SelectedTests = FNexusSharding::Partition(SelectedTests, Shard);
+	}
+
+	// Nexus.RunTests Incremental skips tests whose module binaries and data are unchanged since they passed
+	FNexusResultCache ResultCache(Shard);
+	ResultCache.Load();
+	TArray<FNexusTest*> TestsToRun = SelectedTests;
+	int32 CachedCount = 0;
+	if (FNexusResultCache::IsIncremental(Args))
+	{
+		TestsToRun = ResultCache.FilterUnchanged(SelectedTests, CachedCount);
+	}
+
+	// Flaky tests (per the persisted pass/fail history) run last, once, and can't fail the run
+	FNexusFlakiness& Flakiness = FNexusFlakiness::Get();
+	Flakiness.Load();
+	Flakiness.ApplyQuarantine(TestsToRun);
+
+	int32 TotalTests = SelectedTests.Num();
+	UE_LOG(LogTemp, Warning, TEXT("🧪 NEXUS: Running %d test(s)..."), TestsToRun.Num());
+	const FDateTime RunStart = FDateTime::Now();
+	UNexusCore::RunTests(TestsToRun, true);  // true = parallel execution
+	UNexusCore::TotalTests += CachedCount;
+	UNexusCore::PassedTests += CachedCount;
+
+	ResultCache.RecordResults(SelectedTests, RunStart);
+	ResultCache.Save();
+	Flakiness.RecordResults(SelectedTests, RunStart);
+	FNexusRunHistory::Get().RecordResults(SelectedTests, RunStart, Shard);
+
+	if (bSharded)
+	{
+		FNexusSharding::WriteShardResults(Shard);
+	}
 
 	// Calculate pass/fail/skip counts from results
-	int32 PassedCount = 0;
+	FNexusResultCollector::Flush();
+	int32 PassedCount = CachedCount;  // Cached results are passes that weren't re-executed
 	int32 FailedCount = 0;
 	int32 SkippedCount = 0;
+	int32 QuarantinedCount = 0;
 	
 	for (const FNexusTestResult& Result : FNexusTest::AllResults)
 	{
@@ -41,6 +105,10 @@ void FNexusConsoleCommands::OnRunTests(const TArray<FString>& Args)
 		{
 			SkippedCount++;
 		}
+		else if (Result.bQuarantined)
+		{
+			QuarantinedCount++;
+		}
 		else if (Result.bPassed)
 		{
 			PassedCount++;
@@ -52,6 +120,10 @@ void FNexusConsoleCommands::OnRunTests(const TArray<FString>& Args)
 	}
 
 	UE_LOG(LogTemp, Display, TEXT("✅ NEXUS: Complete — %d/%d passed"), PassedCount, TotalTests);
+	if (QuarantinedCount > 0)
+	{
+		UE_LOG(LogTemp, Display, TEXT("🧪 NEXUS: %d quarantined (flaky) test(s) ran apart — see the LCARS Quarantine card"), QuarantinedCount);
+	}
 
 	// Populate maps with actual test results from AllResults
 	TMap<FString, bool> Results;
@@ -71,3 +143,17 @@ void FNexusConsoleCommands::OnRunTests(const TArray<FString>& Args)
 	LCARSReporter::ExportResultsToLCARSFromPalantir(Results, Durations, Artifacts, LcarsPath);
 	UE_LOG(LogTemp, Display, TEXT("📊 NEXUS: Report exported to %s"), *LcarsPath);
 }
+
+void FNexusConsoleCommands::OnMergeShards(const TArray<FString>& Args)
+{
+	const FString Directory = Args.Num() > 0 ? Args[0] : FString();
+	if (FNexusSharding::MergeShardResults(Directory) == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("❌ NEXUS: No shard result files found in %s"), Directory.IsEmpty() ? *FNexusSharding::GetShardResultsDir() : *Directory);
+		return;
+	}
+
+	FPalantirObserver::GenerateFinalReport();
+	UE_LOG(LogTemp, Display, TEXT("✅ NEXUS: Merged shards — %d/%d passed, %d failed, %d skipped"),
+		UNexusCore::PassedTests.load(), UNexusCore::TotalTests.load(), UNexusCore::FailedTests.load(), UNexusCore::SkippedTests.load());
+}
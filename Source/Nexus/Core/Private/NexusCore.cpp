@@ -1,12 +1,28 @@
 #include "NexusCore.h"
 #include "NexusModule.h"
 #include "NexusTest.h"
+#include "NexusScheduler.h"
+#include "NexusSharding.h"
+#include "NexusResultCache.h"
+#include "NexusFlakiness.h"
+#include "NexusRunHistory.h"
+#include "NexusWorkerFarm.h"
+#include "NexusTestGraph.h"
+#include "NexusTestRegistry.h"
+#include "NexusTestFilter.h"
+#include "NexusFixture.h"
+#include "NexusLatent.h"
+#include "NexusWatchdog.h"
+#include "NexusWorldPool.h"
+#include "NexusActorPool.h"
 #include "Nexus/Palantir/Public/PalantirOracle.h"
 #include "Misc/CommandLine.h"
 #include "HAL/PlatformProcess.h"
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
 #include "HAL/PlatformFilemanager.h"
+#include "HAL/FileManager.h"
+#include "Json.h"
 #include "Misc/DateTime.h"
 #include "Engine/World.h"
 #include "GameFramework/GameStateBase.h"
@@ -20,10 +36,10 @@
 TArray<FNexusTestResult> FNexusTest::AllResults;
 
 /**
- * Helper function to create a test context with world access when available
+ * Create a test context with world access when available
  * Returns an empty context if no world is available (e.g., in dedicated test sessions)
  */
-static FNexusTestContext CreateTestContext()
+FNexusTestContext UNexusCore::CreateTestContext()
 {
     FNexusTestContext Context;
     
@@ -31,30 +47,14 @@ static FNexusTestContext CreateTestContext()
     for (TObjectIterator<UWorld> It; It; ++It)
     {
         UWorld* World = *It;
-        // Skip editor worlds using WorldType (bIsEditorWorld removed in UE 5.7)
-        if (World && World->WorldType != EWorldType::Editor && !World->bIsTearingDown)
+        // Skip editor worlds using WorldType (bIsEditorWorld removed in UE 5.7), and worlds leased out by the world pool
+        if (World && World->WorldType != EWorldType::Editor && !World->bIsTearingDown && !FNexusWorldPool::IsPooledWorld(World))
         {
             Context.World = World;
             Context.GameState = World->GetGameState();
-
-            // Wait for PlayerController possession (up to 5 seconds)
-            const double WaitStart = FPlatformTime::Seconds();
-            const double Timeout = 5.0;
-            while (FPlatformTime::Seconds() - WaitStart < Timeout)
-            {
-                APlayerController* PC = World->GetFirstPlayerController();
-                if (PC && PC->GetPawn())
-                {
-                    Context.PlayerController = PC;
-                    break;
-                }
-                FPlatformProcess::Sleep(0.05f);
-            }
-            // If not possessed, still assign PC if available
-            if (!Context.PlayerController && World->GetFirstPlayerController())
-            {
-                Context.PlayerController = World->GetFirstPlayerController();
-            }
+            // Never waits for possession: sleeping here blocks the game thread the pawn is spawned on.
+            // Tests that need the pawn wait for it latently (co_await Nexus::Until).
+            Context.PlayerController = World->GetFirstPlayerController();
             break;
         }
     }
@@ -93,15 +93,95 @@ static void PopulatePerformanceMetrics(FTestPerformanceMetrics& OutMetrics)
     OutMetrics.bPassedPerformanceGates = true;
 }
 
+/**
+ * True if a non-editor game world (PIE or standalone) is available for game-thread tests
+ */
+static bool HasActiveGameWorld()
+{
+    for (TObjectIterator<UWorld> It; It; ++It)
+    {
+        UWorld* World = *It;
+        if (World && World->WorldType != EWorldType::Editor && !World->bIsTearingDown)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Dependency graph of the run in progress (RunAllTests), consulted by RunSequentialWithFailFast
+static FNexusTestGraph* GActiveTestGraph = nullptr;
+
+/**
+ * Report a finished parallel test, release or skip its dependents, and trigger fail-fast if it was a critical failure
+ */
+static void ReportParallelResult(FNexusScheduler& Scheduler, FNexusTestGraph& Graph, const TSet<const FNexusTest*>& SchedulerLane,
+    FNexusTest* Test, bool bPassed, int32 WorkerIndex)
+{
+    const bool bSkipped = Test->LastResult.bSkipped;
+
+    // Handle skipped tests separately
+    if (bSkipped)
+    {
+        UNexusCore::NotifyTestSkipped(Test->TestName);
+        FPalantirObserver::OnTestSkipped(Test->GetId());
+    }
+    else
+    {
+        UNexusCore::NotifyTestFinished(Test->TestName, bPassed);
+        FPalantirObserver::OnTestFinished(Test->GetId(), bPassed);
+    }
+
+    if (bPassed && !bSkipped)
+    {
+        // Dependents start the moment their last prerequisite passes
+        for (FNexusTest* Released : Graph.MarkPassed(Test))
+        {
+            if (SchedulerLane.Contains(Released))
+            {
+                Scheduler.ReleasePending(Released, WorkerIndex);
+            }
+        }
+    }
+    else
+    {
+        for (FNexusTest* Skipped : Graph.SkipDependentsOf(Test))
+        {
+            if (SchedulerLane.Contains(Skipped))
+            {
+                Scheduler.DropPending(Skipped);
+            }
+        }
+    }
+
+    // Signal critical failure for fail-fast behavior; a critical test with dependents only takes its subtree down.
+    // Quarantined tests are known to be flaky and never abort.
+    if (!bPassed && !bSkipped && !Test->bQuarantined && NexusHasFlag(Test->Priority, ETestPriority::Critical))
+    {
+        if (!FNexusTestGraph::ShouldAbortRun(Test, &Graph))
+        {
+            UE_LOG(LogNexus, Error, TEXT("CRITICAL TEST FAILED: %s — Skipped its dependents, continuing with independent tests"), *Test->TestName);
+        }
+        else
+        {
+            Scheduler.Cancel();
+            UE_LOG(LogNexus, Error, TEXT("CRITICAL TEST FAILED: %s — Aborting remaining tests"), *Test->TestName);
+            UNexusCore::SignalAbort(FString::Printf(TEXT("Critical test failed: %s"), *Test->TestName));
+        }
+    }
+}
+
 // Define the static test array from FNexusTest
 // NEXUS_API on static member ensures proper DLL export for dependent modules
 TArray<FNexusTest*> FNexusTest::AllTests;
 
-int32 UNexusCore::TotalTests = 0;
-int32 UNexusCore::PassedTests = 0;
-int32 UNexusCore::FailedTests = 0;
-int32 UNexusCore::SkippedTests = 0;
-int32 UNexusCore::CriticalTests = 0;
+std::atomic<int32> UNexusCore::TotalTests{0};
+std::atomic<int32> UNexusCore::PassedTests{0};
+std::atomic<int32> UNexusCore::FailedTests{0};
+std::atomic<int32> UNexusCore::SkippedTests{0};
+std::atomic<int32> UNexusCore::CriticalTests{0};
+std::atomic<int32> UNexusCore::QuarantinedTests{0};
+std::atomic<int32> UNexusCore::QuarantinedFailures{0};
 
 TArray<FNexusTest*> UNexusCore::DiscoveredTests;
 
@@ -109,6 +189,12 @@ void UNexusCore::Execute(const TArray<FString>& Args)
 {
     UE_LOG(LogTemp, Warning, TEXT("NEXUS CORE ONLINE — DUAL-STACK ORCHESTRATOR"));
 
+    // Farm workers are driven by their coordinator (see FNexusWorkerFarm::StartWorker), never run the suite themselves
+    if (FNexusWorkerFarm::IsWorkerProcess())
+    {
+        return;
+    }
+
     if (Args.Contains(TEXT("-legacy")))
     {
         UE_LOG(LogTemp, Display, TEXT("Legacy mode — Running UE Automation Framework tests via Asgard"));
@@ -120,17 +206,71 @@ void UNexusCore::Execute(const TArray<FString>& Args)
     FPalantirObserver::Initialize();
     DiscoverAllTests();
 
-    TotalTests = DiscoveredTests.Num();
-    if (TotalTests == 0)
+    if (DiscoveredTests.Num() == 0)
     {
         UE_LOG(LogTemp, Error, TEXT("NO NEXUS TESTS DISCOVERED — DID YOU FORGET NEXUS_TEST()?"));
         return;
     }
 
+    // -NexusFilter="tag:Networking && !tag:Stress": compiled once, selects over the whole suite
+    // (benchmarks only run when the filter names tag:Benchmark)
+    FNexusTestFilter Filter;
+    FString FilterExpression;
+    if (FNexusTestFilter::ParseFromArgs(Args, FilterExpression))
+    {
+        FString FilterError;
+        if (!FNexusTestFilter::Compile(FilterExpression, Filter, FilterError))
+        {
+            UE_LOG(LogNexus, Error, TEXT("NEXUS: Invalid -NexusFilter \"%s\": %s"), *FilterExpression, *FilterError);
+            return;
+        }
+    }
+    TArray<FNexusTest*> SelectedTests = Filter.SelectForRun(DiscoveredTests);
+    if (!Filter.IsEmpty())
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Filter \"%s\" selected %d of %d tests"), *FilterExpression, SelectedTests.Num(), DiscoveredTests.Num());
+    }
+
+    // -Shard=K/N: run only this process's slice of the suite
+    FNexusShardSpec Shard;
+    const bool bSharded = FNexusSharding::ParseFromArgs(Args, Shard) && Shard.IsSharded();
+    if (bSharded)
+    {
+        SelectedTests = FNexusSharding::Partition(SelectedTests, Shard);
+    }
+
+    // Every run refreshes the result cache; -Incremental also skips tests whose inputs are unchanged since a pass
+    FNexusResultCache ResultCache(Shard);
+    ResultCache.Load();
+    TArray<FNexusTest*> TestsToRun = SelectedTests;
+    int32 CachedCount = 0;
+    if (FNexusResultCache::IsIncremental(Args))
+    {
+        TestsToRun = ResultCache.FilterUnchanged(SelectedTests, CachedCount);
+    }
+
+    // Tests whose pass/fail history flips too often run last, once, and can't fail the run
+    FNexusFlakiness& Flakiness = FNexusFlakiness::Get();
+    Flakiness.Load();
+    Flakiness.ApplyQuarantine(TestsToRun);
+
     // Ensure PIE world is active before running tests (required for game-thread tests)
     EnsurePIEWorldActive();
 
-    RunAllTests(true);
+    const FDateTime RunStart = FDateTime::Now();
+    RunTests(TestsToRun, true);
+    TotalTests += CachedCount;
+    PassedTests += CachedCount;
+
+    ResultCache.RecordResults(SelectedTests, RunStart);
+    ResultCache.Save();
+    Flakiness.RecordResults(SelectedTests, RunStart);
+    FNexusRunHistory::Get().RecordResults(SelectedTests, RunStart, Shard);
+
+    if (bSharded)
+    {
+        FNexusSharding::WriteShardResults(Shard);
+    }
     FPalantirObserver::GenerateFinalReport();
 }
 
@@ -184,28 +324,29 @@ FString UNexusCore::GetConfiguredTestMap()
 
 void UNexusCore::DiscoverAllTests()
 {
-    // Copy discovered tests from FNexusTest::AllTests into UNexusCore::DiscoveredTests
-    // FNexusTest::AllTests is populated automatically when NEXUS_TEST() static objects
-    // are constructed at module load time
+    // NEXUS_TEST() macros only register descriptors at module load; build the test objects of every
+    // module loaded so far (no-op for tests built by an earlier discovery), then copy FNexusTest::AllTests
+    const int32 Materialized = FNexusTestDescriptor::MaterializeAll();
     DiscoveredTests = FNexusTest::AllTests;
     
-    // Check for duplicate tests (possible if macros were instantiated multiple times)
-    TSet<FString> SeenTestNames;
+    // Register with the test registry; a name already owned by another test object is a duplicate
+    // (possible if macros were instantiated multiple times)
+    FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
     TArray<FNexusTest*> DedupedTests;
+    DedupedTests.Reserve(DiscoveredTests.Num());
     int32 DuplicateCount = 0;
     
     for (FNexusTest* Test : DiscoveredTests)
     {
         if (!Test) continue;
         
-        if (SeenTestNames.Contains(Test->TestName))
+        if (Registry.GetTest(Registry.Register(Test)) != Test)
         {
             ++DuplicateCount;
             UE_LOG(LogNexus, Warning, TEXT("⚠️  Duplicate test detected: %s — This test is registered multiple times"), *Test->TestName);
         }
         else
         {
-            SeenTestNames.Add(Test->TestName);
             DedupedTests.Add(Test);
         }
     }
@@ -217,40 +358,130 @@ void UNexusCore::DiscoverAllTests()
     }
     
     TotalTests = DiscoveredTests.Num();
-    UE_LOG(LogNexus, Display, TEXT("NEXUS: Discovered %d test(s)"), DiscoveredTests.Num());
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Discovered %d test(s) (%d newly materialized)"), DiscoveredTests.Num(), Materialized);
 }
 
 void UNexusCore::RunAllTests(bool bParallel)
 {
+    // Every test but the opt-in benchmarks
+    RunTests(FNexusTestFilter().SelectForRun(DiscoveredTests), bParallel);
+}
+
+int32 UNexusCore::RunTestsMatching(const FString& FilterExpression, bool bParallel)
+{
+    FNexusTestFilter Filter;
+    FString Error;
+    if (!FNexusTestFilter::Compile(FilterExpression, Filter, Error))
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS: Invalid test filter \"%s\": %s"), *FilterExpression, *Error);
+        return INDEX_NONE;
+    }
+
+    const TArray<FNexusTest*> Selected = Filter.SelectForRun(DiscoveredTests);
+    if (Selected.Num() == 0)
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: No tests match \"%s\""), *FilterExpression);
+        return 0;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d of %d tests matching \"%s\""), Selected.Num(), DiscoveredTests.Num(), *FilterExpression);
+    RunTests(Selected, bParallel);
+    return Selected.Num();
+}
+
+void UNexusCore::RunTests(const TArray<FNexusTest*>& InTests, bool bParallel)
+{
+    TArray<FNexusTest*> Tests = InTests;
+
     // Reset counters for this test run
     PassedTests = 0;
     FailedTests = 0;
     SkippedTests = 0;
     CriticalTests = 0;
-    TotalTests = DiscoveredTests.Num();  // Ensure counter is set correctly
+    QuarantinedTests = 0;
+    QuarantinedFailures = 0;
+    TotalTests = Tests.Num();  // Ensure counter is set correctly
+
+    // Fresh run-wide cancellation; also picks up aborts other processes signal through the sentinel
+    FNexusRunCancellation::BeginRun();
+    FNexusActorPool::Get().ResetStats();
+    FPalantirTimeline::BeginRun();
+    FPalantirOtlpExporter::BeginRun();
     
-    // Sort: Critical first, then Smoke, then Normal
-    DiscoveredTests.Sort([](const FNexusTest& A, const FNexusTest& B) {
-        return (int32)A.Priority > (int32)B.Priority;
+    // Sort: Critical first, then Smoke, then Normal (stable, so discovery order is kept within a class);
+    // within a class, tests sharing a suite fixture are grouped so it is built once and released early
+    Tests.StableSort([](const FNexusTest& A, const FNexusTest& B) {
+        const int32 RankA = FNexusScheduler::GetPriorityRank(&A);
+        const int32 RankB = FNexusScheduler::GetPriorityRank(&B);
+        if (RankA != RankB)
+        {
+            return RankA > RankB;
+        }
+        return FNexusFixture::GetAffinityKey(A) < FNexusFixture::GetAffinityKey(B);
     });
 
-    // Separate game-thread tests from parallel-safe tests
+    // Dependency DAG (NEXUS_TEST_DEPENDS); topological order keeps the priority order wherever dependencies allow
+    FNexusTestGraph Graph;
+    Graph.Build(Tests);
+    TGuardValue<FNexusTestGraph*> ActiveGraphGuard(GActiveTestGraph, &Graph);
+    FNexusFixture::BeginRun(Tests);
+
+    for (FNexusTest* Test : Graph.GetUnreachableTests())
+    {
+        Test->LastResult = FNexusTestResult();
+        Test->LastResult.TestName = Test->TestName;
+        Test->LastResult.bSkipped = true;
+        Test->LastResult.ErrorMessage = TEXT("Dependency cycle");
+        NotifyTestSkipped(Test->TestName);
+        FPalantirObserver::OnTestSkipped(Test->GetId());
+    }
+
+    // Separate game-thread tests from parallel-safe tests. Game-thread tests run after the scheduler,
+    // so a parallel-safe test that depends on one has to run on the game-thread lane as well.
+    // Latent tests are interleaved before the other game-thread tests, so they can only stay
+    // latent if none of their prerequisites is a plain game-thread test.
+    // Quarantined tests (and anything depending on one) make up a low-priority lane that runs after all of them.
     TArray<FNexusTest*> GameThreadTests;
+    TArray<FNexusTest*> LatentTests;
     TArray<FNexusTest*> ParallelTests;
+    TArray<FNexusTest*> QuarantineTests;
+    TSet<const FNexusTest*> GameThreadLane;
+    TSet<const FNexusTest*> LatentLane;
+    TSet<const FNexusTest*> QuarantineLane;
     
-    for (FNexusTest* Test : DiscoveredTests)
+    for (FNexusTest* Test : Graph.GetTopologicalOrder())
     {
-        if (!Test) continue;
-        
         // Count critical tests
         if (NexusHasFlag(Test->Priority, ETestPriority::Critical))
         {
             ++CriticalTests;
         }
         
-        if (Test->bRequiresGameThread)
+        bool bGameThreadLane = Test->bRequiresGameThread;
+        bool bLatentLane = Test->IsLatent();
+        bool bQuarantineLane = Test->bQuarantined;
+        for (const FNexusTest* Prerequisite : Graph.GetPrerequisites(Test))
+        {
+            bGameThreadLane |= GameThreadLane.Contains(Prerequisite);
+            bLatentLane &= !GameThreadLane.Contains(Prerequisite) || LatentLane.Contains(Prerequisite);
+            bQuarantineLane |= QuarantineLane.Contains(Prerequisite);
+        }
+
+        if (bQuarantineLane)
+        {
+            QuarantineTests.Add(Test);
+            QuarantineLane.Add(Test);
+        }
+        else if (bLatentLane)
+        {
+            LatentTests.Add(Test);
+            LatentLane.Add(Test);
+            GameThreadLane.Add(Test);
+        }
+        else if (bGameThreadLane)
         {
             GameThreadTests.Add(Test);
+            GameThreadLane.Add(Test);
         }
         else
         {
@@ -258,79 +489,124 @@ void UNexusCore::RunAllTests(bool bParallel)
         }
     }
 
-    // Run parallel-safe tests with parallel execution (if enabled)
+    // Game-thread tests go to a local worker farm when enabled; start it now so the
+    // worker processes boot while the parallel-safe tests run
+    TUniquePtr<FNexusWorkerFarm> Farm;
+    const int32 FarmProcesses = bParallel ? FNexusWorkerFarm::GetConfiguredProcessCount() : 0;
+    if (FarmProcesses > 0 && GameThreadTests.Num() > 0)
+    {
+        Farm = MakeUnique<FNexusWorkerFarm>(FMath::Min(FarmProcesses, GameThreadTests.Num()));
+        if (!Farm->Start())
+        {
+            Farm.Reset();
+        }
+    }
+
+    // Run parallel-safe tests on the Nexus work-stealing scheduler (if enabled)
     if (bParallel && ParallelTests.Num() > 1)
     {
         UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d parallel-safe tests in parallel"), ParallelTests.Num());
 
-        TArray<TFuture<bool>> Futures;
-        std::atomic<bool> bCriticalFailed{false};
-
+        // Tests without prerequisites start immediately; the rest are released as their prerequisites pass
+        TArray<FNexusTest*> RootTests;
+        TSet<const FNexusTest*> SchedulerLane;
+        TArray<FNexusTest*> WaitingTests;
         for (FNexusTest* Test : ParallelTests)
         {
-            if (!Test) continue;
-            
-            // Check if test is being skipped
-            if (Test->bSkip)
+            SchedulerLane.Add(Test);
+            if (Graph.HasPrerequisites(Test))
             {
-                UNexusCore::NotifyTestSkipped(Test->TestName);
-                FPalantirObserver::OnTestSkipped(Test->TestName);
-                continue;
+                WaitingTests.Add(Test);
             }
+            else
+            {
+                RootTests.Add(Test);
+            }
+        }
 
-            // Early exit if critical test already failed
-            if (bCriticalFailed.load())
+        // The concurrency governor gets headroom threads for IO-bound tests and moves its limit with CPU and memory load
+        const int32 DefaultWorkers = FMath::Min(FNexusScheduler::GetDefaultWorkerCount(), ParallelTests.Num());
+        const bool bAdaptiveConcurrency = FNexusConcurrencyGovernor::IsEnabled();
+        FNexusScheduler Scheduler(bAdaptiveConcurrency
+            ? FMath::Min(FNexusConcurrencyGovernor::GetMaxWorkerCount(DefaultWorkers), ParallelTests.Num())
+            : DefaultWorkers);
+        if (bAdaptiveConcurrency)
+        {
+            Scheduler.EnableGovernor(DefaultWorkers);
+        }
+        Scheduler.AddPending(WaitingTests);
+        Scheduler.Enqueue(RootTests);
+        Scheduler.SetAbandonHandler([&Scheduler, &Graph, &SchedulerLane](FNexusScheduledTest& Job, int32 WorkerIndex, double HungSeconds)
+        {
+            // The watchdog gave up on the worker running this attempt; its replacement reports it as timed out
+            Job.Test->AbandonHungAttempt(Job.Attempt + 1, HungSeconds);
+            ReportParallelResult(Scheduler, Graph, SchedulerLane, Job.Test, false, WorkerIndex);
+        });
+        Scheduler.SetSkipHandler([&Scheduler, &Graph, &SchedulerLane](FNexusScheduledTest& Job, int32 WorkerIndex)
+        {
+            // Queued or waiting on prerequisites when the run was aborted: reported (and its fixtures released)
+            // like the sequential lane's, unless a failed prerequisite already skipped it
+            FNexusTest* Test = Job.Test;
+            if (!Graph.TrySkip(Test))
             {
-                UE_LOG(LogNexus, Warning, TEXT("Skipping test %s due to critical failure"), *Test->TestName);
-                continue;
+                return;
             }
+            Test->LastResult = FNexusTestResult();
+            Test->LastResult.TestName = Test->TestName;
+            Test->LastResult.bSkipped = true;
+            Test->LastResult.ErrorMessage = TEXT("Run aborted");
+            ReportParallelResult(Scheduler, Graph, SchedulerLane, Test, false, WorkerIndex);
+        });
+        Scheduler.Run([&Scheduler, &Graph, &SchedulerLane](FNexusScheduledTest& Job, int32 WorkerIndex) -> ENexusJobResult
+        {
+            FNexusTest* Test = Job.Test;
 
-            // Launch test on thread pool
-            Futures.Add(Async(EAsyncExecution::ThreadPool, [Test, &bCriticalFailed]() -> bool
+            if (Job.Attempt == 0)
             {
-                // Check again inside task in case failure happened during launch
-                if (bCriticalFailed.load())
+                // Check if test is being skipped
+                if (Test->bSkip)
                 {
-                    return false;
+                    Test->LastResult = FNexusTestResult();
+                    Test->LastResult.TestName = Test->TestName;
+                    Test->LastResult.bSkipped = true;
+                    ReportParallelResult(Scheduler, Graph, SchedulerLane, Test, false, WorkerIndex);
+                    return ENexusJobResult::Completed;
                 }
 
                 FPalantirObserver::OnTestStarted(Test);  // Pass the test object to capture metadata
                 UNexusCore::NotifyTestStarted(Test->TestName);
+                Test->BeginExecution();
+            }
+            else if (Scheduler.IsCancelled())
+            {
+                // Abort arrived while this test was backing off - keep its last failed attempt
+                Test->AbandonRetry(Job.Attempt);
+                ReportParallelResult(Scheduler, Graph, SchedulerLane, Test, false, WorkerIndex);
+                return ENexusJobResult::Completed;
+            }
 
-                // Parallel tests typically don't have world access, but we create an empty context
-                FNexusTestContext EmptyContext;
-                bool bPassed = Test->Execute(EmptyContext);
-
-                // Handle skipped tests separately
-                if (Test->LastResult.bSkipped)
-                {
-                    UNexusCore::NotifyTestSkipped(Test->TestName);
-                    FPalantirObserver::OnTestSkipped(Test->TestName);
-                }
-                else
-                {
-                    UNexusCore::NotifyTestFinished(Test->TestName, bPassed);
-                    FPalantirObserver::OnTestFinished(Test->TestName, bPassed);
-                }
-
-                // Signal critical failure for fail-fast behavior
-                if (!bPassed && !Test->LastResult.bSkipped && NexusHasFlag(Test->Priority, ETestPriority::Critical))
-                {
-                    bCriticalFailed.store(true);
-                    UE_LOG(LogNexus, Error, TEXT("CRITICAL TEST FAILED: %s — Aborting remaining tests"), *Test->TestName);
-                }
+            // Parallel tests typically don't have world access, but we create an empty context
+            FNexusTestContext EmptyContext;
+            ++Job.Attempt;
+            const ENexusAttemptOutcome Outcome = Test->ExecuteAttempt(EmptyContext, Job.Attempt);
+            if (FNexusWatchdog::IsCurrentThreadAbandoned())
+            {
+                // Reported by the replacement worker; the captures may no longer be alive
+                return ENexusJobResult::Completed;
+            }
 
-                return bPassed;
-            }));
-        }
+            if (Outcome == ENexusAttemptOutcome::Retry)
+            {
+                // Back to the scheduler instead of sleeping - this worker picks up other tests meanwhile
+                Job.NotBeforeSeconds = FPlatformTime::Seconds() + Test->GetRetryDelaySeconds(Job.Attempt);
+                return ENexusJobResult::Reschedule;
+            }
 
-        // Wait for all async tasks to complete
-        for (auto& Future : Futures)
-        {
-            Future.Get();
-        }
+            ReportParallelResult(Scheduler, Graph, SchedulerLane, Test, Outcome == ENexusAttemptOutcome::Passed, WorkerIndex);
+            return ENexusJobResult::Completed;
+        });
 
-        if (bCriticalFailed.load())
+        if (Scheduler.IsCancelled())
         {
             UE_LOG(LogNexus, Error, TEXT("CRITICAL FAILURE DETECTED — Test suite aborted"));
         }
@@ -342,29 +618,48 @@ void UNexusCore::RunAllTests(bool bParallel)
         // 1. bParallel=false (sequential mode requested)
         // 2. bParallel=true but only 1 test (no benefit from parallelization)
         UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d parallel-safe tests sequentially"), ParallelTests.Num());
-        DiscoveredTests = ParallelTests;
-        RunSequentialWithFailFast();
+        RunSequentialWithFailFast(ParallelTests);
     }
 
-    // Run game-thread tests sequentially on game thread
-    if (GameThreadTests.Num() > 0)
+    // Latent tests next, interleaved on one frame loop: game-thread tests may depend on them, never the other way round
+    if (LatentTests.Num() > 0)
     {
-        UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d game-thread tests on main thread"), GameThreadTests.Num());
-        
-        // Auto-detect if PIE world is available before running game-thread tests
-        // Game-thread tests require an active world context to function properly
-        bool bHasActiveWorld = false;
-        for (TObjectIterator<UWorld> It; It; ++It)
+        if (HasActiveGameWorld())
         {
-            UWorld* World = *It;
-            if (World && World->WorldType != EWorldType::Editor && !World->bIsTearingDown)
+            UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d latent tests interleaved on the game thread"), LatentTests.Num());
+            FNexusTestContext LatentContext = CreateTestContext();
+            FNexusLatentRunner Runner(LatentContext);
+            Runner.Run(LatentTests, &Graph);
+        }
+        else
+        {
+            UE_LOG(LogNexus, Warning, TEXT("⚠️  No active game world detected — Skipping %d latent tests"), LatentTests.Num());
+            for (FNexusTest* Test : LatentTests)
             {
-                bHasActiveWorld = true;
-                break;
+                if (Graph.IsSkipped(Test)) continue;
+                NotifyTestSkipped(Test->TestName);
+                FPalantirObserver::OnTestSkipped(Test->GetId());
+                Graph.SkipDependentsOf(Test);
             }
         }
+    }
+
+    // Farm workers have their own worlds - anything the farm could not run falls through to the game thread below
+    if (Farm && GameThreadTests.Num() > 0)
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d game-thread tests across worker processes"), GameThreadTests.Num());
+        GameThreadTests = Farm->Run(GameThreadTests, &Graph);
+        Farm.Reset();
+    }
+
+    // Run game-thread tests sequentially on game thread
+    if (GameThreadTests.Num() > 0)
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d game-thread tests on main thread"), GameThreadTests.Num());
         
-        if (!bHasActiveWorld)
+        // Auto-detect if PIE world is available before running game-thread tests
+        // Game-thread tests require an active world context to function properly (a PIE world or pooled ones)
+        if (!HasActiveGameWorld() && FNexusWorldPool::Get().Prewarm() == 0)
         {
             UE_LOG(LogNexus, Warning, TEXT("⚠️  No active game world detected — Skipping %d game-thread tests"), GameThreadTests.Num());
             UE_LOG(LogNexus, Display, TEXT("💡 To run game-thread tests with full world context, click 'Play' in the editor first"));
@@ -372,18 +667,46 @@ void UNexusCore::RunAllTests(bool bParallel)
             // Auto-skip all game-thread tests since there's no world
             for (FNexusTest* Test : GameThreadTests)
             {
-                if (!Test) continue;
+                if (!Test || Graph.IsSkipped(Test)) continue;
                 NotifyTestSkipped(Test->TestName);
-                FPalantirObserver::OnTestSkipped(Test->TestName);
+                FPalantirObserver::OnTestSkipped(Test->GetId());
             }
         }
         else
         {
-            DiscoveredTests = GameThreadTests;
-            RunSequentialWithFailFast();
+            RunSequentialWithFailFast(GameThreadTests);
+        }
+    }
+
+    // Quarantined tests last, sequentially and with a single attempt each: their outcomes keep feeding
+    // FNexusFlakiness, but they never hold up or abort the rest of the suite
+    if (QuarantineTests.Num() > 0)
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d quarantined tests in the low-priority lane"), QuarantineTests.Num());
+
+        const bool bHasWorld = HasActiveGameWorld() || FNexusWorldPool::Get().Prewarm() > 0;
+        TArray<FNexusTest*> RunnableQuarantine;
+        for (FNexusTest* Test : QuarantineTests)
+        {
+            if (bHasWorld || (!Test->bRequiresGameThread && !Test->IsLatent()))
+            {
+                RunnableQuarantine.Add(Test);
+            }
+            else if (!Graph.IsSkipped(Test))
+            {
+                NotifyTestSkipped(Test->TestName);
+                FPalantirObserver::OnTestSkipped(Test->GetId());
+                Graph.SkipDependentsOf(Test);
+            }
         }
+        RunSequentialWithFailFast(RunnableQuarantine);
     }
 
+    // Merge the results workers queued during the run into AllResults
+    FNexusResultCollector::Flush();
+    FNexusFixture::EndRun();
+    FNexusRunCancellation::EndRun();
+
     FPalantirObserver::GenerateFinalReport();
 }
 
@@ -425,68 +748,34 @@ int32 UNexusCore::CountTestsWithTags(ETestTag Tags)
 
 TArray<FNexusTest*> UNexusCore::GetTestsWithCustomTag(const FString& CustomTag)
 {
-    TArray<FNexusTest*> FilteredTests;
-    
     if (CustomTag.IsEmpty())
     {
-        return FilteredTests;
-    }
-    
-    for (FNexusTest* Test : DiscoveredTests)
-    {
-        if (Test && Test->HasCustomTag(CustomTag))
-        {
-            FilteredTests.Add(Test);
-        }
+        return TArray<FNexusTest*>();
     }
     
-    return FilteredTests;
+    // Per-tag bitset over test IDs - no scan of the suite
+    return FNexusTestRegistry::Get().GetTestsWithTag(CustomTag);
 }
 
 int32 UNexusCore::CountTestsWithCustomTag(const FString& CustomTag)
 {
-    int32 Count = 0;
-    
     if (CustomTag.IsEmpty())
     {
         return 0;
     }
     
-    for (FNexusTest* Test : DiscoveredTests)
-    {
-        if (Test && Test->HasCustomTag(CustomTag))
-        {
-            ++Count;
-        }
-    }
-    return Count;
+    return FNexusTestRegistry::Get().CountTestsWithTag(CustomTag);
 }
 
 TArray<FString> UNexusCore::GetAllCustomTags()
 {
-    TArray<FString> AllTags;
-    
-    for (FNexusTest* Test : DiscoveredTests)
-    {
-        if (Test)
-        {
-            for (const FString& CustomTag : Test->GetCustomTags())
-            {
-                if (!AllTags.Contains(CustomTag))
-                {
-                    AllTags.Add(CustomTag);
-                }
-            }
-        }
-    }
-    
-    AllTags.Sort();
-    return AllTags;
+    return FNexusTestRegistry::Get().GetAllTags();
 }
 
 void UNexusCore::RunTestsWithTags(ETestTag Tags, bool bParallel)
 {
-    TArray<FNexusTest*> FilteredTests = GetTestsWithTags(Tags);
+    // Matches the ETestTag flags and custom tags of the same name (the macros only set custom tags)
+    TArray<FNexusTest*> FilteredTests = FNexusTestFilter::FromTags(Tags).Select(DiscoveredTests);
     
     if (FilteredTests.Num() == 0)
     {
@@ -495,19 +784,7 @@ void UNexusCore::RunTestsWithTags(ETestTag Tags, bool bParallel)
     }
     
     UE_LOG(LogNexus, Display, TEXT("NEXUS: Running %d tests matching tags"), FilteredTests.Num());
-    
-    // Temporarily replace DiscoveredTests and TotalTests with filtered tests
-    TArray<FNexusTest*> OriginalTests = DiscoveredTests;
-    int32 OriginalTotalTests = TotalTests;
-    
-    DiscoveredTests = FilteredTests;
-    TotalTests = FilteredTests.Num();
-    
-    RunAllTests(bParallel);
-    
-    // Restore original tests and counters
-    DiscoveredTests = OriginalTests;
-    TotalTests = OriginalTotalTests;
+    RunTests(FilteredTests, bParallel);
 }
 
 void UNexusCore::NotifyTestStarted(const FString& Name)
@@ -529,10 +806,27 @@ void UNexusCore::NotifyTestFinished(const FString& Name, bool bPassed)
     }
 }
 
+void UNexusCore::NotifyQuarantinedTestFinished(const FString& Name, bool bPassed)
+{
+    ++QuarantinedTests;
+    if (bPassed)
+    {
+        UE_LOG(LogNexus, Display, TEXT("TEST PASSED (quarantined): %s"), *Name);
+    }
+    else
+    {
+        ++QuarantinedFailures;
+        UE_LOG(LogNexus, Warning, TEXT("TEST FAILED (quarantined): %s"), *Name);
+    }
+}
+
 void UNexusCore::NotifyTestSkipped(const FString& Name)
 {
     ++SkippedTests;
     UE_LOG(LogNexus, Warning, TEXT("TEST SKIPPED: %s"), *Name);
+
+    // A test that will never run no longer keeps its suite fixtures alive
+    FNexusFixture::Release(FNexusTestRegistry::Get().FindId(Name));
 }
 
 FString UNexusCore::GetAbortFilePath()
@@ -542,6 +836,9 @@ FString UNexusCore::GetAbortFilePath()
 
 void UNexusCore::SignalAbort(const FString& Reason)
 {
+    // Stop in-flight tests in this process right away; other processes pick the abort up from the sentinel
+    FNexusRunCancellation::Cancel(Reason);
+
     static std::atomic<bool> bAbortSignalled(false);
 
     // First-writer wins: only the first caller will write the sentinel file.
@@ -567,37 +864,128 @@ void UNexusCore::SignalAbort(const FString& Reason)
 
 void UNexusCore::RunSequentialWithFailFast()
 {
-    // Create context once for all sequential tests (game-thread tests especially need this)
-    FNexusTestContext TestContext = CreateTestContext();
+    RunSequentialWithFailFast(DiscoveredTests);
+}
+
+void UNexusCore::RunSequentialWithFailFast(const TArray<FNexusTest*>& Tests)
+{
+    // Game-thread tests lease an isolated pooled world each; the shared context is only built for tests
+    // that go without one
+    FNexusWorldPool& WorldPool = FNexusWorldPool::Get();
+    const bool bUseWorldPool = WorldPool.Prewarm() > 0;
+    TOptional<FNexusTestContext> SharedContext;
     
-    for (FNexusTest* Test : DiscoveredTests)
+    for (FNexusTest* Test : Tests)
     {
         if (!Test) continue;
 
         const FString Name = Test->TestName;
+
+        // Already reported when its prerequisite failed (or it sits on a dependency cycle)
+        if (GActiveTestGraph && GActiveTestGraph->IsSkipped(Test))
+        {
+            continue;
+        }
         
         // Check if test is being skipped
         if (Test->bSkip)
         {
             NotifyTestSkipped(Name);
-            FPalantirObserver::OnTestSkipped(Name);
+            FPalantirObserver::OnTestSkipped(Test->GetId());
+            if (GActiveTestGraph)
+            {
+                GActiveTestGraph->SkipDependentsOf(Test);
+            }
+            continue;
+        }
+
+        // A prerequisite that never produced a result (aborted parallel lane) leaves this test unrunnable
+        if (GActiveTestGraph && !GActiveTestGraph->IsReady(Test))
+        {
+            UE_LOG(LogNexus, Warning, TEXT("Skipping test %s — a prerequisite did not run"), *Name);
+            Test->LastResult = FNexusTestResult();
+            Test->LastResult.TestName = Name;
+            Test->LastResult.bSkipped = true;
+            Test->LastResult.ErrorMessage = TEXT("Prerequisite did not run");
+            NotifyTestSkipped(Name);
+            FPalantirObserver::OnTestSkipped(Test->GetId());
+            GActiveTestGraph->SkipDependentsOf(Test);
+            continue;
+        }
+
+        // Aborted by another lane or process while earlier tests ran
+        if (FNexusRunCancellation::IsCancelled())
+        {
+            UE_LOG(LogNexus, Warning, TEXT("Skipping test %s — run aborted"), *Name);
+            NotifyTestSkipped(Name);
+            FPalantirObserver::OnTestSkipped(Test->GetId());
             continue;
         }
 
         FPalantirObserver::OnTestStarted(Test);  // Pass the test object to capture metadata
         NotifyTestStarted(Name);
 
+        UWorld* PooledWorld = nullptr;
+        if (bUseWorldPool && Test->bRequiresGameThread && !Test->HasCustomTag(FNexusWorldPool::NoPoolTag))
+        {
+            PooledWorld = WorldPool.Acquire(Test->Fixtures);
+        }
+
+        FNexusTestContext PooledContext;
+        if (PooledWorld)
+        {
+            PooledContext.World = PooledWorld;
+            PooledContext.GameState = PooledWorld->GetGameState();
+        }
+        else if (!SharedContext.IsSet())
+        {
+            SharedContext.Emplace(CreateTestContext());
+        }
+        FNexusTestContext& TestContext = PooledWorld ? PooledContext : SharedContext.GetValue();
+
         bool bPassed = Test->Execute(TestContext);
         
         // Populate performance metrics after test execution if available
         PopulatePerformanceMetrics(TestContext.PerformanceMetrics);
 
-        NotifyTestFinished(Name, bPassed);
-        FPalantirObserver::OnTestFinished(Name, bPassed);
+        // Roll the world back so the next test starts from the map's initial state
+        if (PooledWorld)
+        {
+            PooledContext.CleanupSpawnedActors();
+            WorldPool.Release(PooledWorld);
+        }
 
-        // If a critical test failed, signal abort and stop immediately
-        if (!bPassed && (static_cast<uint8>(Test->Priority) & static_cast<uint8>(ETestPriority::Critical)) != 0)
+        if (Test->bQuarantined)
         {
+            NotifyQuarantinedTestFinished(Name, bPassed);
+        }
+        else
+        {
+            NotifyTestFinished(Name, bPassed);
+        }
+        FPalantirObserver::OnTestFinished(Test->GetId(), bPassed);
+
+        if (GActiveTestGraph)
+        {
+            if (bPassed)
+            {
+                GActiveTestGraph->MarkPassed(Test);
+            }
+            else
+            {
+                GActiveTestGraph->SkipDependentsOf(Test);
+            }
+        }
+
+        // If a critical test failed, signal abort and stop immediately - unless it gates dependents,
+        // in which case only its subtree is skipped. Quarantined tests are known to be flaky and never abort.
+        if (!bPassed && !Test->bQuarantined && (static_cast<uint8>(Test->Priority) & static_cast<uint8>(ETestPriority::Critical)) != 0)
+        {
+            if (!FNexusTestGraph::ShouldAbortRun(Test, GActiveTestGraph))
+            {
+                UE_LOG(LogNexus, Error, TEXT("CRITICAL TEST FAILED: %s — Skipped its dependents, continuing with independent tests"), *Name);
+                continue;
+            }
             const FString Reason = FString::Printf(TEXT("Critical test failed during sequential run: %s"), *Name);
             SignalAbort(Reason);
             break;
@@ -607,66 +995,34 @@ void UNexusCore::RunSequentialWithFailFast()
 
 double UNexusCore::GetAverageTestDuration(const FString& TestName)
 {
-    // Calculate average from test results
-    double TotalDuration = 0.0;
-    int32 Count = 0;
-    
-    for (const FNexusTestResult& Result : FNexusTest::AllResults)
-    {
-        if (TestName.IsEmpty() || Result.TestName == TestName)
-        {
-            TotalDuration += Result.DurationSeconds;
-            ++Count;
-        }
-    }
-    
-    return Count > 0 ? TotalDuration / Count : 0.0;
+    return FNexusRunHistory::Get().GetAverageDuration(TestName);
 }
 
 double UNexusCore::GetMedianTestDuration(const FString& TestName)
 {
-    TArray<double> Durations;
-    
-    for (const FNexusTestResult& Result : FNexusTest::AllResults)
-    {
-        if (TestName.IsEmpty() || Result.TestName == TestName)
-        {
-            Durations.Add(Result.DurationSeconds);
-        }
-    }
-    
-    if (Durations.Num() == 0)
-    {
-        return 0.0;
-    }
-    
-    Durations.Sort();
-    int32 MiddleIndex = Durations.Num() / 2;
-    return Durations[MiddleIndex];
+    return FNexusRunHistory::Get().GetMedianDuration(TestName);
 }
 
 int32 UNexusCore::DetectRegressions(double MaxAllowedDurationMs)
 {
+    FNexusRunHistory& History = FNexusRunHistory::Get();
+
     if (MaxAllowedDurationMs <= 0.0)
     {
         // Use median * 1.5 as baseline if not specified
-        MaxAllowedDurationMs = GetMedianTestDuration() * 1500.0;  // Convert to ms
+        MaxAllowedDurationMs = History.GetMedianDuration() * 1500.0;  // Convert to ms
     }
     
     int32 RegressionCount = 0;
-    TMap<FString, TArray<double>> TestDurations;
     
-    // Group results by test name
-    for (const FNexusTestResult& Result : FNexusTest::AllResults)
+    // Check each test's recent executions for regressions
+    for (const FString& TestName : History.GetTestNames())
     {
-        TestDurations.FindOrAdd(Result.TestName).Add(Result.DurationSeconds * 1000.0);  // Convert to ms
-    }
-    
-    // Check each test for regressions
-    for (const auto& Pair : TestDurations)
-    {
-        const FString& TestName = Pair.Key;
-        const TArray<double>& Durations = Pair.Value;
+        TArray<double> Durations;
+        for (const FNexusHistoryRun& Run : History.GetRecentRuns(TestName))
+        {
+            Durations.Add(Run.DurationSeconds * 1000.0);  // Convert to ms
+        }
         
         if (Durations.Num() >= 2)
         {
@@ -709,64 +1065,70 @@ void UNexusCore::ExportTestTrends(const FString& OutputPath)
         FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*ExportPath);
     }
     
-    // Export CSV with all results
-    FString CSVPath = FPaths::Combine(ExportPath, TEXT("test_trends.csv"));
-    FString CSVContent = TEXT("TestName,Timestamp,DurationSeconds,Passed,Attempts\n");
+    FNexusRunHistory& History = FNexusRunHistory::Get();
     
-    for (const FNexusTestResult& Result : FNexusTest::AllResults)
+    // Export CSV with every recorded execution, streamed row by row from the history store
+    FString CSVPath = FPaths::Combine(ExportPath, TEXT("test_trends.csv"));
+    TUniquePtr<FArchive> CSVWriter(IFileManager::Get().CreateFileWriter(*CSVPath));
+    if (!CSVWriter)
     {
-        CSVContent += FString::Printf(TEXT("%s,%s,%.4f,%d,%d\n"), 
-            *Result.TestName,
-            *Result.Timestamp.ToIso8601(),
-            Result.DurationSeconds,
-            Result.bPassed ? 1 : 0,
-            Result.Attempts);
+        UE_LOG(LogNexus, Error, TEXT("Failed to write test trends to %s"), *CSVPath);
+        return;
     }
     
-    FFileHelper::SaveStringToFile(CSVContent, *CSVPath);
-    UE_LOG(LogNexus, Display, TEXT("Exported test trends to %s"), *CSVPath);
-    
-    // Export summary JSON
-    FString JSONPath = FPaths::Combine(ExportPath, TEXT("test_trends_summary.json"));
-    FString JSONContent = TEXT("{\n  \"tests\": [\n");
-    
-    TMap<FString, int32> TestPassCounts;
-    TMap<FString, double> TestAvgDurations;
-    
-    for (const FNexusTestResult& Result : FNexusTest::AllResults)
+    auto WriteLine = [&CSVWriter](const FString& Line)
     {
-        if (Result.bPassed)
-        {
-            TestPassCounts.FindOrAdd(Result.TestName)++;
-        }
-        TestAvgDurations.FindOrAdd(Result.TestName) += Result.DurationSeconds;
-    }
+        const FTCHARToUTF8 Utf8(*Line);
+        CSVWriter->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+    };
     
-    // Calculate averages
-    for (auto& Pair : TestAvgDurations)
+    WriteLine(TEXT("TestName,Timestamp,DurationSeconds,Passed,Attempts,Status,TraceID\n"));
+    History.ForEachRun([&WriteLine](const FString& TestName, const FNexusHistoryRun& Run)
     {
-        Pair.Value /= FNexusTest::AllResults.Num();
-    }
+        WriteLine(FString::Printf(TEXT("%s,%s,%.4f,%d,%d,%s,%s\n"), 
+            *TestName,
+            *Run.Timestamp.ToIso8601(),
+            Run.DurationSeconds,
+            Run.Passed() ? 1 : 0,
+            Run.Attempts,
+            LexToString(Run.Status),
+            *Run.TraceID));
+    });
+    CSVWriter->Close();
+    UE_LOG(LogNexus, Display, TEXT("Exported test trends to %s"), *CSVPath);
     
-    bool bFirst = true;
-    for (const auto& Pair : TestAvgDurations)
+    // Export summary JSON (one entry per test, from the history index)
+    FString JSONPath = FPaths::Combine(ExportPath, TEXT("test_trends_summary.json"));
+    TArray<TSharedPtr<FJsonValue>> TestsArray;
+    
+    TArray<FString> TestNames = History.GetTestNames();
+    TestNames.Sort();
+    for (const FString& TestName : TestNames)
     {
-        if (!bFirst) JSONContent += TEXT(",\n");
+        const FNexusHistorySummary Summary = History.GetSummary(TestName);
         
-        int32 PassCount = TestPassCounts.FindRef(Pair.Key);
-        JSONContent += FString::Printf(TEXT("    {\n      \"name\": \"%s\",\n      \"avg_duration_s\": %.4f,\n      \"pass_rate\": %.1f%%\n    }"),
-            *Pair.Key, Pair.Value, (PassCount * 100.0) / FNexusTest::AllResults.Num());
-        
-        bFirst = false;
+        TSharedPtr<FJsonObject> TestObj = MakeShareable(new FJsonObject());
+        TestObj->SetStringField(TEXT("name"), TestName);
+        TestObj->SetNumberField(TEXT("runs"), static_cast<double>(Summary.Runs));
+        TestObj->SetNumberField(TEXT("avg_duration_s"), Summary.AverageSeconds);
+        TestObj->SetNumberField(TEXT("median_duration_s"), Summary.MedianSeconds);
+        TestObj->SetNumberField(TEXT("pass_rate"), Summary.GetPassRate() * 100.0);
+        TestsArray.Add(MakeShareable(new FJsonValueObject(TestObj)));
     }
     
-    JSONContent += TEXT("\n  ]\n}\n");
+    TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject());
+    Root->SetArrayField(TEXT("tests"), TestsArray);
+    
+    FString JSONContent;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JSONContent);
+    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
     FFileHelper::SaveStringToFile(JSONContent, *JSONPath);
     UE_LOG(LogNexus, Display, TEXT("Exported test trends summary to %s"), *JSONPath);
 }
 
 void UNexusCore::ClearTestHistory()
 {
+    FNexusResultCollector::Discard();
     FNexusTest::AllResults.Empty();
     UE_LOG(LogNexus, Display, TEXT("Cleared all test result history"));
 }
\ No newline at end of file
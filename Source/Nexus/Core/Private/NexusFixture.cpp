@@ -0,0 +1,190 @@
+#include "NexusFixture.h"
+#include "NexusTest.h"
+#include "NexusWorldPool.h"
+#include "Misc/ScopeLock.h"
+
+// Fixtures register from static constructors in other translation units, so the map is constructed on first use
+static TMap<FString, FNexusFixture*>& GetNexusFixtures()
+{
+    static TMap<FString, FNexusFixture*> Fixtures;
+    return Fixtures;
+}
+
+// Run bookkeeping: fixtures of every test that has not finished yet, and RemainingUsers of each fixture
+static FCriticalSection GNexusFixtureRunLock;
+static TMap<FNexusTestId, TArray<FNexusFixture*>> GNexusFixtureUsers;
+
+FNexusFixture::FNexusFixture(const FString& InName)
+    : Name(InName)
+{
+    TMap<FString, FNexusFixture*>& Fixtures = GetNexusFixtures();
+    if (Fixtures.Contains(Name))
+    {
+        UE_LOG(LogNexus, Warning, TEXT("Duplicate suite fixture '%s' — the first definition is used"), *Name);
+        return;
+    }
+    Fixtures.Add(Name, this);
+}
+
+FNexusFixture::~FNexusFixture()
+{
+    TMap<FString, FNexusFixture*>& Fixtures = GetNexusFixtures();
+    if (FNexusFixture** Registered = Fixtures.Find(Name); Registered && *Registered == this)
+    {
+        Fixtures.Remove(Name);
+    }
+}
+
+FNexusFixture* FNexusFixture::Find(const FString& Name)
+{
+    FNexusFixture** Fixture = GetNexusFixtures().Find(Name);
+    return Fixture ? *Fixture : nullptr;
+}
+
+const FString& FNexusFixture::GetAffinityKey(const FNexusTest& Test)
+{
+    static const FString None;
+    return Test.Fixtures.Num() > 0 ? Test.Fixtures[0] : None;
+}
+
+void FNexusFixture::BeginRun(const TArray<FNexusTest*>& Tests)
+{
+    FScopeLock Lock(&GNexusFixtureRunLock);
+    GNexusFixtureUsers.Reset();
+    for (const TPair<FString, FNexusFixture*>& Pair : GetNexusFixtures())
+    {
+        Pair.Value->RemainingUsers = 0;
+        EState Failed = EState::Failed;
+        Pair.Value->State.compare_exchange_strong(Failed, EState::Idle);
+    }
+
+    for (const FNexusTest* Test : Tests)
+    {
+        if (!Test || Test->Fixtures.Num() == 0)
+        {
+            continue;
+        }
+
+        TArray<FNexusFixture*>& Used = GNexusFixtureUsers.FindOrAdd(Test->GetId());
+        for (const FString& FixtureName : Test->Fixtures)
+        {
+            FNexusFixture* Fixture = Find(FixtureName);
+            if (!Fixture)
+            {
+                UE_LOG(LogNexus, Warning, TEXT("Test %s uses unknown suite fixture '%s'"), *Test->TestName, *FixtureName);
+                continue;
+            }
+            Used.Add(Fixture);
+            ++Fixture->RemainingUsers;
+        }
+    }
+}
+
+bool FNexusFixture::Acquire(const FNexusTest& Test, const FNexusTestContext& Context, FString& OutError)
+{
+    for (const FString& FixtureName : Test.Fixtures)
+    {
+        FNexusFixture* Fixture = Find(FixtureName);
+        if (!Fixture)
+        {
+            OutError = FString::Printf(TEXT("Unknown fixture '%s'"), *FixtureName);
+            return false;
+        }
+        if (!Fixture->EnsureBuilt(Context))
+        {
+            OutError = FString::Printf(TEXT("Fixture '%s' failed to set up"), *FixtureName);
+            return false;
+        }
+    }
+    return true;
+}
+
+void FNexusFixture::Release(FNexusTestId TestId)
+{
+    TArray<FNexusFixture*> Unused;
+    {
+        FScopeLock Lock(&GNexusFixtureRunLock);
+        TArray<FNexusFixture*> Used;
+        if (!GNexusFixtureUsers.RemoveAndCopyValue(TestId, Used))
+        {
+            return;  // Not part of the run, or already released
+        }
+        for (FNexusFixture* Fixture : Used)
+        {
+            if (--Fixture->RemainingUsers == 0)
+            {
+                Unused.Add(Fixture);
+            }
+        }
+    }
+
+    for (FNexusFixture* Fixture : Unused)
+    {
+        Fixture->TearDownIfBuilt();
+    }
+}
+
+void FNexusFixture::EndRun()
+{
+    {
+        FScopeLock Lock(&GNexusFixtureRunLock);
+        GNexusFixtureUsers.Reset();
+    }
+
+    for (const TPair<FString, FNexusFixture*>& Pair : GetNexusFixtures())
+    {
+        Pair.Value->RemainingUsers = 0;
+        Pair.Value->TearDownIfBuilt();
+    }
+}
+
+bool FNexusFixture::EnsureBuilt(const FNexusTestContext& Context)
+{
+    // Fast path for every user after the first
+    const EState Current = State.load();
+    if (Current != EState::Idle)
+    {
+        return Current == EState::Ready;
+    }
+
+    FScopeLock Lock(&BuildLock);
+    if (State.load() == EState::Idle)
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Setting up suite fixture '%s'"), *Name);
+        const double StartTime = FPlatformTime::Seconds();
+        const bool bBuilt = Setup(Context);
+        State = bBuilt ? EState::Ready : EState::Failed;
+        if (bBuilt)
+        {
+            UE_LOG(LogNexus, Display, TEXT("NEXUS: Suite fixture '%s' ready in %.2fs"), *Name, FPlatformTime::Seconds() - StartTime);
+
+            // Keep what Setup spawned in a pooled world across the rollback after each of our tests
+            if (FNexusWorldPool::IsPooledWorld(Context.World))
+            {
+                PinnedWorld = Context.World;
+                FNexusWorldPool::Get().Pin(Context.World, Name);
+            }
+        }
+        else
+        {
+            UE_LOG(LogNexus, Error, TEXT("NEXUS: Suite fixture '%s' failed to set up — its tests will fail"), *Name);
+        }
+    }
+    return State.load() == EState::Ready;
+}
+
+void FNexusFixture::TearDownIfBuilt()
+{
+    FScopeLock Lock(&BuildLock);
+    if (State.load() == EState::Ready)
+    {
+        Teardown();
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Tore down suite fixture '%s'"), *Name);
+    }
+    if (UWorld* World = PinnedWorld.Get())
+    {
+        FNexusWorldPool::Get().Unpin(World, Name);
+    }
+    PinnedWorld.Reset();
+    State = EState::Idle;
+}
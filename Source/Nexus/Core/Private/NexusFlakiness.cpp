@@ -0,0 +1,227 @@
+#include "NexusFlakiness.h"
+#include "NexusTest.h"
+#include "NexusRunHistory.h"
+#include "NexusModule.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+
+static constexpr double GNexusFlakyDefaultThreshold = 0.2;
+static constexpr int32 GNexusFlakyDefaultMinObservations = 10;
+static constexpr int32 GNexusFlakyDefaultWindow = 30;
+
+// z for a two-sided 95% interval
+static constexpr double GNexusWilsonZ = 1.96;
+
+FNexusFlakiness& FNexusFlakiness::Get()
+{
+    static FNexusFlakiness Instance;
+    return Instance;
+}
+
+bool FNexusFlakiness::IsQuarantineEnabled()
+{
+    if (FParse::Param(FCommandLine::Get(), TEXT("NexusNoQuarantine")))
+    {
+        return false;
+    }
+
+    bool bEnabled = true;
+    if (GConfig)
+    {
+        GConfig->GetBool(TEXT("/Script/Nexus.NexusSettings"), TEXT("bQuarantineEnabled"), bEnabled, GGameIni);
+    }
+    return bEnabled;
+}
+
+double FNexusFlakiness::GetThreshold()
+{
+    double Threshold = GNexusFlakyDefaultThreshold;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusFlakyThreshold="), Threshold) && GConfig)
+    {
+        GConfig->GetDouble(TEXT("/Script/Nexus.NexusSettings"), TEXT("FlakyFlipThreshold"), Threshold, GGameIni);
+    }
+    return FMath::Clamp(Threshold, 0.0, 1.0);
+}
+
+int32 FNexusFlakiness::GetMinObservations()
+{
+    int32 Count = GNexusFlakyDefaultMinObservations;
+    if (GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("FlakyMinObservations"), Count, GGameIni);
+    }
+    return FMath::Max(2, Count);
+}
+
+int32 FNexusFlakiness::GetWindowSize()
+{
+    int32 Count = GNexusFlakyDefaultWindow;
+    if (GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("FlakyWindow"), Count, GGameIni);
+    }
+    return FMath::Max(GetMinObservations(), Count);
+}
+
+void FNexusFlakiness::ComputeWilsonInterval(int32 Successes, int32 Trials, double& OutLower, double& OutUpper)
+{
+    if (Trials <= 0)
+    {
+        OutLower = 0.0;
+        OutUpper = 1.0;
+        return;
+    }
+
+    const double N = static_cast<double>(Trials);
+    const double P = FMath::Clamp(static_cast<double>(Successes) / N, 0.0, 1.0);
+    const double Z2 = GNexusWilsonZ * GNexusWilsonZ;
+    const double Denominator = 1.0 + Z2 / N;
+    const double Center = (P + Z2 / (2.0 * N)) / Denominator;
+    const double HalfWidth = GNexusWilsonZ * FMath::Sqrt(P * (1.0 - P) / N + Z2 / (4.0 * N * N)) / Denominator;
+
+    OutLower = FMath::Max(0.0, Center - HalfWidth);
+    OutUpper = FMath::Min(1.0, Center + HalfWidth);
+}
+
+void FNexusFlakiness::Load()
+{
+    Entries.Reset();
+
+    const double Threshold = GetThreshold();
+    const int32 MinObservations = GetMinObservations();
+    const int32 Window = GetWindowSize();
+
+    FNexusRunHistory& History = FNexusRunHistory::Get();
+    for (const FString& TestName : History.GetTestNames())
+    {
+        const TArray<FNexusHistoryRun> Runs = History.GetRecentRuns(TestName);
+        if (Runs.Num() == 0)
+        {
+            continue;
+        }
+
+        // Retries stop at the first pass, so each run's attempts are its failures followed by the final outcome
+        FEntry Entry;
+        for (const FNexusHistoryRun& Run : Runs)
+        {
+            for (uint32 Attempt = 1; Attempt < Run.Attempts; ++Attempt)
+            {
+                Entry.Outcomes.AppendChar(TEXT('F'));
+            }
+            Entry.Outcomes.AppendChar(Run.Passed() ? TEXT('P') : TEXT('F'));
+        }
+        if (Entry.Outcomes.Len() > Window)
+        {
+            Entry.Outcomes.RightInline(Window, EAllowShrinking::No);
+        }
+        Entry.UpdatedAt = Runs.Last().Timestamp;
+
+        // Quarantine carries over from the lane the last run used, re-judged against the window it ended
+        const FNexusFlakinessStats Stats = ComputeStats(Entry);
+        Entry.bQuarantined = Runs.Last().bQuarantined
+            ? Stats.UpperBound >= Threshold
+            : Stats.Observations >= MinObservations && Stats.LowerBound >= Threshold;
+        Entries.Add(TestName, MoveTemp(Entry));
+    }
+
+    int32 QuarantinedCount = 0;
+    for (const auto& Pair : Entries)
+    {
+        QuarantinedCount += Pair.Value.bQuarantined ? 1 : 0;
+    }
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Flakiness history loaded — %d test(s), %d quarantined"), Entries.Num(), QuarantinedCount);
+}
+
+int32 FNexusFlakiness::ApplyQuarantine(const TArray<FNexusTest*>& Tests) const
+{
+    const bool bEnabled = IsQuarantineEnabled();
+    int32 QuarantinedCount = 0;
+    for (FNexusTest* Test : Tests)
+    {
+        const FEntry* Entry = Entries.Find(Test->TestName);
+        Test->bQuarantined = bEnabled && Entry && Entry->bQuarantined;
+        if (Test->bQuarantined)
+        {
+            const FNexusFlakinessStats Stats = ComputeStats(*Entry);
+            UE_LOG(LogNexus, Display, TEXT("TEST QUARANTINED: %s (flip rate %.2f, 95%% CI [%.2f, %.2f] over %d outcomes)"),
+                *Test->TestName, Stats.FlipRate, Stats.LowerBound, Stats.UpperBound, Stats.Observations);
+            ++QuarantinedCount;
+        }
+    }
+
+    if (QuarantinedCount > 0)
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: %d flaky test(s) quarantined to the low-priority lane"), QuarantinedCount);
+    }
+    return QuarantinedCount;
+}
+
+void FNexusFlakiness::RecordResults(const TArray<FNexusTest*>& Tests, const FDateTime& RunStart)
+{
+    const double Threshold = GetThreshold();
+    const int32 MinObservations = GetMinObservations();
+    const int32 Window = GetWindowSize();
+
+    for (const FNexusTest* Test : Tests)
+    {
+        const FNexusTestResult& Result = Test->LastResult;
+        if (Result.bSkipped || Result.Timestamp < RunStart || Result.AttemptHistory.Num() == 0)
+        {
+            continue;  // Skipped, cached or never reached - nothing was observed this run
+        }
+
+        FEntry& Entry = Entries.FindOrAdd(Test->TestName);
+        for (const FNexusAttemptRecord& Attempt : Result.AttemptHistory)
+        {
+            Entry.Outcomes.AppendChar(Attempt.bPassed ? TEXT('P') : TEXT('F'));
+        }
+        if (Entry.Outcomes.Len() > Window)
+        {
+            Entry.Outcomes.RightInline(Window, EAllowShrinking::No);
+        }
+        Entry.UpdatedAt = Result.Timestamp;
+
+        const FNexusFlakinessStats Stats = ComputeStats(Entry);
+        if (!Entry.bQuarantined && Stats.Observations >= MinObservations && Stats.LowerBound >= Threshold)
+        {
+            Entry.bQuarantined = true;
+            UE_LOG(LogNexus, Warning, TEXT("FLAKY: %s quarantined — flip rate %.2f (95%% CI [%.2f, %.2f]) over %d outcomes: %s"),
+                *Test->TestName, Stats.FlipRate, Stats.LowerBound, Stats.UpperBound, Stats.Observations, *Entry.Outcomes);
+        }
+        else if (Entry.bQuarantined && Stats.UpperBound < Threshold)
+        {
+            Entry.bQuarantined = false;
+            UE_LOG(LogNexus, Display, TEXT("FLAKY: %s released from quarantine — flip rate %.2f (95%% CI [%.2f, %.2f])"),
+                *Test->TestName, Stats.FlipRate, Stats.LowerBound, Stats.UpperBound);
+        }
+    }
+}
+
+FNexusFlakinessStats FNexusFlakiness::GetStats(const FString& TestName) const
+{
+    const FEntry* Entry = Entries.Find(TestName);
+    return Entry ? ComputeStats(*Entry) : FNexusFlakinessStats();
+}
+
+FString FNexusFlakiness::GetHistory(const FString& TestName) const
+{
+    const FEntry* Entry = Entries.Find(TestName);
+    return Entry ? Entry->Outcomes : FString();
+}
+
+FNexusFlakinessStats FNexusFlakiness::ComputeStats(const FEntry& Entry)
+{
+    FNexusFlakinessStats Stats;
+    Stats.Observations = Entry.Outcomes.Len();
+    Stats.bQuarantined = Entry.bQuarantined;
+    for (int32 Index = 1; Index < Entry.Outcomes.Len(); ++Index)
+    {
+        Stats.Flips += Entry.Outcomes[Index] != Entry.Outcomes[Index - 1] ? 1 : 0;
+    }
+
+    const int32 Transitions = FMath::Max(0, Stats.Observations - 1);
+    Stats.FlipRate = Transitions > 0 ? static_cast<double>(Stats.Flips) / Transitions : 0.0;
+    ComputeWilsonInterval(Stats.Flips, Transitions, Stats.LowerBound, Stats.UpperBound);
+    return Stats;
+}
@@ -0,0 +1,382 @@
+#include "NexusLatent.h"
+#include "NexusTest.h"
+#include "NexusCore.h"
+#include "NexusModule.h"
+#include "NexusTestGraph.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "Nexus/Palantir/Public/PalantirTrace.h"
+#include "Engine/World.h"
+#include "HttpModule.h"
+#include "HttpManager.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ConfigCacheIni.h"
+
+// Frame step the runner paces itself to, so stepped game time tracks wall time
+static constexpr double GNexusLatentFrameSeconds = 1.0 / 60.0;
+
+// Largest delta handed to the world in one step (a slow frame must not teleport the simulation)
+static constexpr double GNexusLatentMaxDeltaSeconds = 0.1;
+
+static constexpr int32 GNexusLatentDefaultConcurrency = 64;
+
+// Latent clock - only advanced by StepFrame, so waits count frames and game time the runner actually stepped
+static uint64 GNexusLatentFrame = 0;
+static double GNexusLatentTime = 0.0;
+
+/**
+ * Resume Task inside TraceID and keep the breadcrumbs it recorded
+ * (interleaved tests share the game thread, so each slice re-enters its own trace and cancellation token)
+ */
+static void ResumeInTrace(FNexusLatentTask& Task, const FString& TestName, const FString& TraceID, const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& Token, FPalantirBreadcrumbSnapshot& OutBreadcrumbs)
+{
+    FPalantirTraceGuard TraceGuard(TraceID);
+    FNexusCancellationScope CancellationScope(Token);
+    {
+        FPalantirSpan SliceSpan(TestName, TEXT("latent"));
+        Task.Resume();
+    }
+    OutBreadcrumbs.Append(FPalantirTrace::SnapshotBreadcrumbs());
+}
+
+FNexusLatentRunner::FNexusLatentRunner(const FNexusTestContext& InContext)
+    : Context(InContext)
+{
+}
+
+uint64 FNexusLatentRunner::GetFrameNumber()
+{
+    return GNexusLatentFrame;
+}
+
+double FNexusLatentRunner::GetTimeSeconds()
+{
+    return GNexusLatentTime;
+}
+
+int32 FNexusLatentRunner::GetConfiguredConcurrency()
+{
+    int32 Concurrency = 0;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusLatentConcurrency="), Concurrency) && GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("LatentConcurrency"), Concurrency, GGameIni);
+    }
+    return Concurrency > 0 ? Concurrency : GNexusLatentDefaultConcurrency;
+}
+
+void FNexusLatentRunner::StepFrame(UWorld* World, double& InOutLastFrameTime)
+{
+    const double Elapsed = FPlatformTime::Seconds() - InOutLastFrameTime;
+    if (Elapsed < GNexusLatentFrameSeconds)
+    {
+        FPlatformProcess::Sleep(static_cast<float>(GNexusLatentFrameSeconds - Elapsed));
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const double DeltaSeconds = FMath::Min(Now - InOutLastFrameTime, GNexusLatentMaxDeltaSeconds);
+    InOutLastFrameTime = Now;
+
+    ++GNexusLatentFrame;
+    GNexusLatentTime += DeltaSeconds;
+
+    // The engine loop is blocked while tests run, so pump what it would: game-thread tasks, HTTP completions, the world
+    if (!FTaskGraphInterface::Get().IsThreadProcessingTasks(ENamedThreads::GameThread))
+    {
+        FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+    }
+    if (FHttpModule* Http = FModuleManager::GetModulePtr<FHttpModule>(TEXT("HTTP")))
+    {
+        Http->GetHttpManager().Tick(static_cast<float>(DeltaSeconds));
+    }
+    if (World && !World->bIsTearingDown)
+    {
+        World->Tick(LEVELTICK_All, static_cast<float>(DeltaSeconds));
+    }
+}
+
+bool FNexusLatentRunner::RunToCompletion(FNexusLatentTask Task, const FNexusTestContext& InContext, double TimeoutSeconds)
+{
+    if (!Task.IsValid())
+    {
+        return false;
+    }
+
+    // Called from ExecuteAttempt, already inside the test's trace
+    const double StartTime = FPlatformTime::Seconds();
+    double LastFrameTime = StartTime;
+    while (true)
+    {
+        if (Task.IsReadyToResume())
+        {
+            Task.Resume();
+        }
+        if (Task.IsDone())
+        {
+            return Task.GetResult();
+        }
+        if (FNexusCancellationToken::IsCurrentCancelled())
+        {
+            // Deadline passed or the run was aborted; destroying the suspended frame unwinds the test's locals
+            return false;
+        }
+        if (TimeoutSeconds > 0.0 && FPlatformTime::Seconds() - StartTime > TimeoutSeconds)
+        {
+            // ExecuteAttempt reports the TIMEOUT from the measured duration
+            return false;
+        }
+        StepFrame(InContext.World, LastFrameTime);
+    }
+}
+
+void FNexusLatentRunner::Run(const TArray<FNexusTest*>& Tests, FNexusTestGraph* InGraph)
+{
+    Graph = InGraph;
+    bAborted = false;
+
+    TArray<FNexusTest*> Queue;
+    for (FNexusTest* Test : Tests)
+    {
+        if (!Test || (Graph && Graph->IsSkipped(Test))) continue;
+
+        if (Test->bSkip)
+        {
+            UNexusCore::NotifyTestSkipped(Test->TestName);
+            FPalantirObserver::OnTestSkipped(Test->GetId());
+            if (Graph)
+            {
+                Graph->SkipDependentsOf(Test);
+            }
+            continue;
+        }
+        Queue.Add(Test);
+    }
+
+    const int32 MaxConcurrent = GetConfiguredConcurrency();
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Interleaving %d latent test(s), up to %d at a time"), Queue.Num(), MaxConcurrent);
+
+    // Slots own suspended coroutine frames; keep them at stable addresses
+    TArray<TUniquePtr<FLatentSlot>> Running;
+    double LastFrameTime = FPlatformTime::Seconds();
+    while (Queue.Num() > 0 || Running.Num() > 0)
+    {
+        // Aborted elsewhere (another lane, another process): start nothing new, running slots see their tokens cancelled
+        bAborted |= FNexusRunCancellation::IsCancelled();
+
+        // Tests whose prerequisite failed were already reported as skipped
+        if (Graph)
+        {
+            Queue.RemoveAll([this](const FNexusTest* Test) { return Graph->IsSkipped(Test); });
+        }
+
+        // Fill free slots with tests whose prerequisites have passed, in queue (priority/topological) order
+        for (int32 i = 0; i < Queue.Num() && Running.Num() < MaxConcurrent && !bAborted; )
+        {
+            FNexusTest* Test = Queue[i];
+            if (Graph && !Graph->IsReady(Test))
+            {
+                ++i;
+                continue;
+            }
+            Queue.RemoveAt(i);
+
+            FPalantirObserver::OnTestStarted(Test);  // Pass the test object to capture metadata
+            UNexusCore::NotifyTestStarted(Test->TestName);
+            Test->BeginExecution();
+
+            TUniquePtr<FLatentSlot> Slot = MakeUnique<FLatentSlot>();
+            Slot->Test = Test;
+            Running.Add(MoveTemp(Slot));
+        }
+
+        if (bAborted && Queue.Num() > 0)
+        {
+            for (FNexusTest* Test : Queue)
+            {
+                UE_LOG(LogNexus, Warning, TEXT("Skipping test %s due to critical failure"), *Test->TestName);
+                UNexusCore::NotifyTestSkipped(Test->TestName);
+                FPalantirObserver::OnTestSkipped(Test->GetId());
+            }
+            Queue.Reset();
+        }
+
+        // Nothing running and nothing runnable: the rest wait on prerequisites that never ran
+        if (Running.Num() == 0)
+        {
+            for (FNexusTest* Test : Queue)
+            {
+                SkipUnrunnable(Test, TEXT("Prerequisite did not run"));
+            }
+            Queue.Reset();
+            break;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        for (int32 i = 0; i < Running.Num(); )
+        {
+            if (TickSlot(*Running[i], Now))
+            {
+                Running.RemoveAt(i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+
+        if (Running.Num() > 0)
+        {
+            StepFrame(Context.World, LastFrameTime);
+        }
+    }
+
+    Graph = nullptr;
+}
+
+bool FNexusLatentRunner::TickSlot(FLatentSlot& Slot, double Now)
+{
+    FNexusTest* Test = Slot.Test;
+
+    if (!Slot.Task.IsValid())
+    {
+        // Between attempts: wait out the retry backoff, unless an abort means no further attempts
+        if (Slot.Attempt > 0 && bAborted)
+        {
+            Test->AbandonRetry(Slot.Attempt);
+            ReportResult(Test, false);
+            return true;
+        }
+        if (Now < Slot.NotBeforeSeconds)
+        {
+            return false;
+        }
+
+        ++Slot.Attempt;
+        Slot.AttemptStartTime = Now;
+        Slot.Breadcrumbs.Reset();
+        Slot.Token = FNexusRunCancellation::MakeAttemptToken();
+
+        bool bSetupSuccess = false;
+        {
+            FPalantirTraceGuard TraceGuard(Test->LastResult.TraceID);
+            FNexusCancellationScope CancellationScope(Slot.Token);
+            bSetupSuccess = Test->BeginAttempt(Context, Slot.Attempt);
+            if (bSetupSuccess)
+            {
+                Slot.Task = Test->LatentFunc(Context);
+            }
+            Slot.Breadcrumbs.Append(FPalantirTrace::SnapshotBreadcrumbs());
+        }
+
+        if (!bSetupSuccess || !Slot.Task.IsValid())
+        {
+            Slot.AttemptStartTime = FPlatformTime::Seconds();  // Body never ran
+            return FinishAttempt(Slot, false);
+        }
+    }
+
+    if (Slot.Task.IsReadyToResume())
+    {
+        ResumeInTrace(Slot.Task, Test->TestName, Test->LastResult.TraceID, Slot.Token, Slot.Breadcrumbs);
+    }
+
+    if (Slot.Task.IsDone())
+    {
+        return FinishAttempt(Slot, Slot.Task.GetResult());
+    }
+
+    // Cancelled while suspended: fail now rather than when the wait would have ended
+    if (Slot.Token->IsCancellationRequested())
+    {
+        UE_LOG(LogNexus, Warning, TEXT("CANCELLED: %s (%s)"), *Test->TestName, *Slot.Token->GetReason());
+        return FinishAttempt(Slot, false);
+    }
+
+    // Enforce MaxDurationSeconds while suspended; FinishAttempt logs the TIMEOUT from the measured duration
+    if (Test->MaxDurationSeconds > 0.0 && FPlatformTime::Seconds() - Slot.AttemptStartTime > Test->MaxDurationSeconds)
+    {
+        return FinishAttempt(Slot, false);
+    }
+    return false;
+}
+
+bool FNexusLatentRunner::FinishAttempt(FLatentSlot& Slot, bool bResult)
+{
+    FNexusTest* Test = Slot.Test;
+
+    // Abandon a body that is still suspended (timeout); its locals are destroyed here
+    Slot.Task.Reset();
+
+    FNexusAttemptRecord Record;
+    Record.Attempt = Slot.Attempt;
+    Record.DurationSeconds = FPlatformTime::Seconds() - Slot.AttemptStartTime;
+    Record.Breadcrumbs = MoveTemp(Slot.Breadcrumbs);
+
+    ENexusAttemptOutcome Outcome;
+    {
+        FPalantirTraceGuard TraceGuard(Test->LastResult.TraceID);
+        FNexusCancellationScope CancellationScope(Slot.Token);
+        Outcome = Test->FinishAttempt(Context, MoveTemp(Record), bResult);
+    }
+    Slot.Token.Reset();
+
+    if (Outcome == ENexusAttemptOutcome::Retry)
+    {
+        // Back off in frames; the other latent tests keep running meanwhile
+        Slot.NotBeforeSeconds = FPlatformTime::Seconds() + Test->GetRetryDelaySeconds(Slot.Attempt);
+        return false;
+    }
+
+    ReportResult(Test, Outcome == ENexusAttemptOutcome::Passed);
+    return true;
+}
+
+void FNexusLatentRunner::ReportResult(FNexusTest* Test, bool bPassed)
+{
+    const bool bSkipped = Test->LastResult.bSkipped;
+    if (bSkipped)
+    {
+        UNexusCore::NotifyTestSkipped(Test->TestName);
+        FPalantirObserver::OnTestSkipped(Test->GetId());
+    }
+    else
+    {
+        UNexusCore::NotifyTestFinished(Test->TestName, bPassed);
+        FPalantirObserver::OnTestFinished(Test->GetId(), bPassed);
+    }
+
+    if (Graph)
+    {
+        if (bPassed && !bSkipped)
+        {
+            Graph->MarkPassed(Test);
+        }
+        else
+        {
+            Graph->SkipDependentsOf(Test);
+        }
+    }
+
+    // Fail fast like the sequential lane; a critical test with dependents only takes its subtree down
+    if (!bPassed && !bSkipped && FNexusTestGraph::ShouldAbortRun(Test, Graph))
+    {
+        bAborted = true;
+        UE_LOG(LogNexus, Error, TEXT("CRITICAL TEST FAILED: %s — Aborting remaining latent tests"), *Test->TestName);
+        UNexusCore::SignalAbort(FString::Printf(TEXT("Critical latent test failed: %s"), *Test->TestName));
+    }
+}
+
+void FNexusLatentRunner::SkipUnrunnable(FNexusTest* Test, const FString& Reason)
+{
+    UE_LOG(LogNexus, Warning, TEXT("Skipping test %s — %s"), *Test->TestName, *Reason);
+    Test->LastResult = FNexusTestResult();
+    Test->LastResult.TestName = Test->TestName;
+    Test->LastResult.bSkipped = true;
+    Test->LastResult.ErrorMessage = Reason;
+    UNexusCore::NotifyTestSkipped(Test->TestName);
+    FPalantirObserver::OnTestSkipped(Test->GetId());
+    if (Graph)
+    {
+        Graph->SkipDependentsOf(Test);
+    }
+}
@@ -1,7 +1,15 @@
 #include "NexusModule.h"
 #include "Nexus/Core/Public/NexusCore.h"
 #include "Nexus/Core/Public/NexusConsoleCommands.h"
+#include "Nexus/Core/Public/NexusWorkerFarm.h"
+#include "Nexus/Core/Public/NexusWatchdog.h"
+#include "Nexus/Core/Public/NexusSymbolication.h"
+#include "Nexus/Core/Public/NexusWorldPool.h"
+#include "Nexus/Core/Public/NexusFixture.h"
+#include "Nexus/Core/Public/NexusActorPool.h"
+#include "Nexus/Core/Public/NexusTestDescriptor.h"
 #include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "Nexus/Palantir/Public/PalantirExporter.h"
 
 #define LOCTEXT_NAMESPACE "FNexusModule"
 
@@ -14,18 +22,23 @@ void FNexusModule::StartupModule()
 {
 	UE_LOG(LogNexusModule, Warning, TEXT("🧪 NEXUS TEST FRAMEWORK INITIALIZING — UE 5.7"));
 
-	// Discover all NEXUS_TEST macros in loaded modules
-	UNexusCore::DiscoverAllTests();
-
+	// Tests are only registered here (FNexusTestDescriptor); their objects are built when a run discovers them
 	// Initialize PalantirOracle for test result tracking
 	FPalantirOracle::Get();
 
 	// Register console commands
 	FNexusConsoleCommands::Register();
 
+	// Launched by a coordinator's worker farm: serve tests over the loopback connection
+	if (FNexusWorkerFarm::IsWorkerProcess() && !FNexusWorkerFarm::StartWorker())
+	{
+		UE_LOG(LogNexusModule, Error, TEXT("❌ NEXUS worker could not reach its coordinator — exiting"));
+		RequestEngineExit(TEXT("Nexus worker failed to connect"));
+	}
+
 	bNexusModuleInitialized = true;
 
-	UE_LOG(LogNexusModule, Display, TEXT("✅ NEXUS FRAMEWORK ONLINE — %d tests discovered"), UNexusCore::TotalTests);
+	UE_LOG(LogNexusModule, Display, TEXT("✅ NEXUS FRAMEWORK ONLINE — %d tests registered"), FNexusTestDescriptor::Num());
 	UE_LOG(LogNexusModule, Display, TEXT("✅ NEXUS console commands registered"));
 }
 
@@ -33,11 +46,21 @@ void FNexusModule::ShutdownModule()
 {
 	UE_LOG(LogNexusModule, Warning, TEXT("🧪 NEXUS TEST FRAMEWORK SHUTTING DOWN"));
 
+	FNexusWatchdog::Shutdown();
+	FNexusSymbolicator::Shutdown();
+	FPalantirOtlpExporter::Shutdown();
+	FNexusFixture::EndRun();
+	FNexusActorPool::Get().Empty();
+	FNexusWorldPool::Get().Shutdown();
+
 	// Clean up test data
 	UNexusCore::TotalTests = 0;
 	UNexusCore::PassedTests = 0;
 	UNexusCore::FailedTests = 0;
+	UNexusCore::SkippedTests = 0;
 	UNexusCore::CriticalTests = 0;
+	UNexusCore::QuarantinedTests = 0;
+	UNexusCore::QuarantinedFailures = 0;
 	UNexusCore::DiscoveredTests.Empty();
 
 	// Clear PalantirOracle results
@@ -0,0 +1,352 @@
+#include "NexusResultCache.h"
+#include "NexusCore.h"
+#include "NexusTest.h"
+#include "NexusModule.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "Modules/ModuleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Json.h"
+
+// Bump when the inputs hash changes meaning, so stale entries are never matched
+static constexpr int32 GNexusResultCacheVersion = 1;
+
+static void AppendToHash(FMD5& Md5, const FString& Value)
+{
+    const FTCHARToUTF8 Utf8(*Value);
+    Md5.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+    Md5.Update(reinterpret_cast<const uint8*>("\n"), 1);
+}
+
+FNexusResultCache::FNexusResultCache(const FNexusShardSpec& InShard)
+    : Shard(InShard)
+{
+}
+
+bool FNexusResultCache::IsIncremental(const TArray<FString>& Args)
+{
+    for (const FString& Arg : Args)
+    {
+        if (Arg.Equals(TEXT("-Incremental"), ESearchCase::IgnoreCase) || Arg.Equals(TEXT("Incremental"), ESearchCase::IgnoreCase))
+        {
+            return true;
+        }
+    }
+    return FParse::Param(FCommandLine::Get(), TEXT("Incremental")) || FParse::Param(FCommandLine::Get(), TEXT("NexusIncremental"));
+}
+
+FString FNexusResultCache::GetCacheDir()
+{
+    return FPaths::ProjectSavedDir() / TEXT("NexusReports");
+}
+
+void FNexusResultCache::Load()
+{
+    const FString CacheDir = GetCacheDir();
+    TArray<FString> CacheFiles;
+    IFileManager::Get().FindFiles(CacheFiles, *(CacheDir / TEXT("result_cache*.json")), true, false);
+
+    for (const FString& File : CacheFiles)
+    {
+        FString JsonContent;
+        TSharedPtr<FJsonObject> Root;
+        if (!FFileHelper::LoadFileToString(JsonContent, *(CacheDir / File)) ||
+            !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonContent), Root) || !Root.IsValid())
+        {
+            UE_LOG(LogNexus, Warning, TEXT("NEXUS: Ignoring unreadable result cache %s"), *File);
+            continue;
+        }
+
+        int32 Version = 0;
+        if (!Root->TryGetNumberField(TEXT("version"), Version) || Version != GNexusResultCacheVersion)
+        {
+            continue;
+        }
+
+        const TSharedPtr<FJsonObject>* FilesObj = nullptr;
+        if (Root->TryGetObjectField(TEXT("files"), FilesObj))
+        {
+            for (const auto& Pair : (*FilesObj)->Values)
+            {
+                const TSharedPtr<FJsonObject> StampObj = Pair.Value->AsObject();
+                if (!StampObj.IsValid())
+                {
+                    continue;
+                }
+
+                FFileStamp Stamp;
+                Stamp.Size = static_cast<int64>(StampObj->GetNumberField(TEXT("size")));
+                FDateTime::ParseIso8601(*StampObj->GetStringField(TEXT("modified")), Stamp.Modified);
+                Stamp.Hash = StampObj->GetStringField(TEXT("md5"));
+                Files.Add(Pair.Key, Stamp);
+            }
+        }
+
+        const TSharedPtr<FJsonObject>* TestsObj = nullptr;
+        if (Root->TryGetObjectField(TEXT("tests"), TestsObj))
+        {
+            for (const auto& Pair : (*TestsObj)->Values)
+            {
+                const TSharedPtr<FJsonObject> EntryObj = Pair.Value->AsObject();
+                if (!EntryObj.IsValid())
+                {
+                    continue;
+                }
+
+                FEntry Entry;
+                Entry.Inputs = EntryObj->GetStringField(TEXT("inputs"));
+                Entry.bPassed = EntryObj->GetBoolField(TEXT("passed"));
+                Entry.DurationSeconds = EntryObj->GetNumberField(TEXT("duration"));
+                FDateTime::ParseIso8601(*EntryObj->GetStringField(TEXT("recorded_at")), Entry.RecordedAt);
+
+                // Shards that ran the same test at different times: keep the latest outcome
+                const FEntry* Existing = Entries.Find(Pair.Key);
+                if (!Existing || Existing->RecordedAt < Entry.RecordedAt)
+                {
+                    Entries.Add(Pair.Key, Entry);
+                }
+            }
+        }
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Result cache loaded — %d test(s), %d file hash(es)"), Entries.Num(), Files.Num());
+}
+
+TArray<FNexusTest*> FNexusResultCache::FilterUnchanged(const TArray<FNexusTest*>& Tests, int32& OutCachedCount)
+{
+    OutCachedCount = 0;
+
+    TSet<FString> InRun;
+    for (const FNexusTest* Test : Tests)
+    {
+        InRun.Add(Test->TestName);
+    }
+
+    TSet<FString> Cacheable;
+    for (FNexusTest* Test : Tests)
+    {
+        if (Test->bSkip)
+        {
+            continue;  // Skips are reported as skips, not as cached passes
+        }
+
+        const FEntry* Entry = Entries.Find(Test->TestName);
+        if (!Entry || !Entry->bPassed)
+        {
+            continue;
+        }
+
+        const FString Inputs = ComputeInputsHash(*Test);
+        if (!Inputs.IsEmpty() && Inputs == Entry->Inputs)
+        {
+            Cacheable.Add(Test->TestName);
+        }
+    }
+
+    // A prerequisite that runs again may fail this time, so everything downstream of it runs too
+    bool bChanged = true;
+    while (bChanged)
+    {
+        bChanged = false;
+        for (const FNexusTest* Test : Tests)
+        {
+            if (!Cacheable.Contains(Test->TestName))
+            {
+                continue;
+            }
+            for (const FString& Prerequisite : Test->Prerequisites)
+            {
+                if (InRun.Contains(Prerequisite) && !Cacheable.Contains(Prerequisite))
+                {
+                    Cacheable.Remove(Test->TestName);
+                    bChanged = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    TArray<FNexusTest*> ToRun;
+    ToRun.Reserve(Tests.Num());
+    for (FNexusTest* Test : Tests)
+    {
+        if (!Cacheable.Contains(Test->TestName))
+        {
+            ToRun.Add(Test);
+            continue;
+        }
+
+        const FEntry& Entry = Entries.FindChecked(Test->TestName);
+        Test->LastResult = FNexusTestResult();
+        Test->LastResult.TestName = Test->TestName;
+        Test->LastResult.bPassed = true;
+        Test->LastResult.DurationSeconds = Entry.DurationSeconds;
+        Test->LastResult.Attempts = 0;
+        Test->LastResult.ErrorMessage = TEXT("Cached");
+        Test->LastResult.Timestamp = Entry.RecordedAt;
+
+        FPalantirTestResult Result;
+        Result.bPassed = true;
+        Result.bCached = true;
+        Result.Duration = Entry.DurationSeconds;
+        Result.Priority = static_cast<uint8>(Test->Priority);
+        FPalantirObserver::RecordExternalResult(Test->TestName, Result, Test->GetCustomTags(), TArray<FString>());
+
+        UE_LOG(LogNexus, Display, TEXT("TEST CACHED: %s (inputs unchanged since %s)"), *Test->TestName, *Entry.RecordedAt.ToString());
+        ++OutCachedCount;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Incremental run — %d test(s) cached, %d to run"), OutCachedCount, ToRun.Num());
+    return ToRun;
+}
+
+void FNexusResultCache::RecordResults(const TArray<FNexusTest*>& Tests, const FDateTime& RunStart)
+{
+    for (FNexusTest* Test : Tests)
+    {
+        const FNexusTestResult& Result = Test->LastResult;
+        if (Result.bSkipped || Result.Timestamp < RunStart)
+        {
+            continue;  // Skipped or never reached (aborted run) - the previous entry still describes these inputs
+        }
+
+        const FString Inputs = ComputeInputsHash(*Test);
+        if (Inputs.IsEmpty())
+        {
+            continue;
+        }
+
+        FEntry& Entry = Entries.FindOrAdd(Test->TestName);
+        Entry.Inputs = Inputs;
+        Entry.bPassed = Result.bPassed;
+        Entry.DurationSeconds = Result.DurationSeconds;
+        Entry.RecordedAt = Result.Timestamp;
+    }
+}
+
+bool FNexusResultCache::Save() const
+{
+    TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject());
+    Root->SetNumberField(TEXT("version"), GNexusResultCacheVersion);
+    Root->SetStringField(TEXT("generated_at"), FDateTime::UtcNow().ToIso8601());
+
+    TSharedPtr<FJsonObject> FilesObj = MakeShareable(new FJsonObject());
+    for (const auto& Pair : Files)
+    {
+        TSharedPtr<FJsonObject> StampObj = MakeShareable(new FJsonObject());
+        StampObj->SetNumberField(TEXT("size"), static_cast<double>(Pair.Value.Size));
+        StampObj->SetStringField(TEXT("modified"), Pair.Value.Modified.ToIso8601());
+        StampObj->SetStringField(TEXT("md5"), Pair.Value.Hash);
+        FilesObj->SetObjectField(Pair.Key, StampObj);
+    }
+    Root->SetObjectField(TEXT("files"), FilesObj);
+
+    TSharedPtr<FJsonObject> TestsObj = MakeShareable(new FJsonObject());
+    for (const auto& Pair : Entries)
+    {
+        TSharedPtr<FJsonObject> EntryObj = MakeShareable(new FJsonObject());
+        EntryObj->SetStringField(TEXT("inputs"), Pair.Value.Inputs);
+        EntryObj->SetBoolField(TEXT("passed"), Pair.Value.bPassed);
+        EntryObj->SetNumberField(TEXT("duration"), Pair.Value.DurationSeconds);
+        EntryObj->SetStringField(TEXT("recorded_at"), Pair.Value.RecordedAt.ToIso8601());
+        TestsObj->SetObjectField(Pair.Key, EntryObj);
+    }
+    Root->SetObjectField(TEXT("tests"), TestsObj);
+
+    FString JsonContent;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonContent);
+    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+    // Shards write their own file so concurrent shard processes never clobber each other
+    const FString FileName = Shard.IsSharded()
+        ? FString::Printf(TEXT("result_cache_shard-%d-of-%d.json"), Shard.Index + 1, Shard.Count)
+        : FString(TEXT("result_cache.json"));
+    const FString CachePath = GetCacheDir() / FileName;
+
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*GetCacheDir());
+    if (!FFileHelper::SaveStringToFile(JsonContent, *CachePath))
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: Failed to write result cache %s"), *CachePath);
+        return false;
+    }
+    return true;
+}
+
+FString FNexusResultCache::ComputeInputsHash(const FNexusTest& Test)
+{
+    if (const FString* Known = InputsByTest.Find(Test.TestName))
+    {
+        return *Known;
+    }
+
+    FString Inputs;
+    if (!Test.ModuleName.IsEmpty())
+    {
+        FMD5 Md5;
+        AppendToHash(Md5, Test.ModuleName);
+        AppendToHash(Md5, HashModule(Test.ModuleName));
+
+        // The framework decides how a test is run and judged, so it counts as an input as well
+        if (Test.ModuleName != TEXT("Nexus"))
+        {
+            AppendToHash(Md5, HashModule(TEXT("Nexus")));
+        }
+
+        TArray<FString> DataFiles = Test.DataDependencies;
+        DataFiles.Sort();
+        for (const FString& DataFile : DataFiles)
+        {
+            AppendToHash(Md5, DataFile);
+            AppendToHash(Md5, HashFile(FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), DataFile)));
+        }
+
+        FMD5Hash Hash;
+        Hash.Set(Md5);
+        Inputs = LexToString(Hash);
+    }
+
+    InputsByTest.Add(Test.TestName, Inputs);
+    return Inputs;
+}
+
+FString FNexusResultCache::HashFile(const FString& Path)
+{
+    const FFileStatData Stat = IFileManager::Get().GetStatData(*Path);
+    if (!Stat.bIsValid || Stat.bIsDirectory)
+    {
+        return TEXT("missing");
+    }
+
+    FFileStamp& Stamp = Files.FindOrAdd(Path);
+    if (Stamp.Size != Stat.FileSize || Stamp.Modified != Stat.ModificationTime || Stamp.Hash.IsEmpty())
+    {
+        Stamp.Size = Stat.FileSize;
+        Stamp.Modified = Stat.ModificationTime;
+        Stamp.Hash = LexToString(FMD5Hash::HashFile(*Path));
+    }
+    return Stamp.Hash;
+}
+
+FString FNexusResultCache::HashModule(const FString& ModuleName)
+{
+    if (const FString* Known = ModuleHashes.Find(ModuleName))
+    {
+        return *Known;
+    }
+
+    // Monolithic builds link every module into the executable
+    FString BinaryPath = FModuleManager::Get().GetModuleFilename(FName(*ModuleName));
+    if (BinaryPath.IsEmpty() || !FPaths::FileExists(BinaryPath))
+    {
+        BinaryPath = FPlatformProcess::ExecutablePath();
+    }
+
+    const FString Hash = HashFile(FPaths::ConvertRelativePathToFull(BinaryPath));
+    ModuleHashes.Add(ModuleName, Hash);
+    return Hash;
+}
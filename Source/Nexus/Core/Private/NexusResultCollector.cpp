@@ -0,0 +1,68 @@
+#include "NexusResultCollector.h"
+#include "NexusTest.h"
+#include "NexusSymbolication.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+static TQueue<FNexusTestResult, EQueueMode::Mpsc> GNexusPendingResults;
+static std::atomic<int32> GNexusPendingResultCount{0};
+
+// Serializes consumers only (the queue allows a single one); producers never touch it
+static FCriticalSection GNexusResultConsumerLock;
+
+void FNexusResultCollector::Record(const FNexusTestResult& Result)
+{
+    GNexusPendingResults.Enqueue(Result);
+    GNexusPendingResultCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+int32 FNexusResultCollector::Flush()
+{
+    FScopeLock Lock(&GNexusResultConsumerLock);
+
+    int32 Merged = 0;
+    FNexusTestResult Result;
+    while (GNexusPendingResults.Dequeue(Result))
+    {
+        FNexusTest::AllResults.Add(MoveTemp(Result));
+        ++Merged;
+    }
+    GNexusPendingResultCount.fetch_sub(Merged, std::memory_order_relaxed);
+
+    // Failures only queued their program counters; wait for the background symbolicator, then every frame is a cache hit
+    bool bWaited = false;
+    for (int32 Index = FNexusTest::AllResults.Num() - Merged; Index < FNexusTest::AllResults.Num(); ++Index)
+    {
+        FNexusTestResult& MergedResult = FNexusTest::AllResults[Index];
+        if (MergedResult.StackFrames.Num() > 0 && MergedResult.StackTrace.Num() == 0)
+        {
+            if (!bWaited)
+            {
+                FNexusSymbolicator::WaitForPending();
+                bWaited = true;
+            }
+            MergedResult.StackTrace = FNexusSymbolicator::Symbolicate(MergedResult.StackFrames);
+        }
+    }
+    return Merged;
+}
+
+void FNexusResultCollector::Discard()
+{
+    FScopeLock Lock(&GNexusResultConsumerLock);
+
+    int32 Dropped = 0;
+    FNexusTestResult Result;
+    while (GNexusPendingResults.Dequeue(Result))
+    {
+        ++Dropped;
+    }
+    GNexusPendingResultCount.fetch_sub(Dropped, std::memory_order_relaxed);
+}
+
+int32 FNexusResultCollector::GetPendingCount()
+{
+    return GNexusPendingResultCount.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,635 @@
+#include "NexusRunHistory.h"
+#include "NexusTest.h"
+#include "NexusFlakiness.h"
+#include "NexusResultCache.h"
+#include "NexusModule.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+static constexpr int32 GNexusDefaultRecentRuns = 32;
+
+// Duration histogram for the all-history median: 2% wide buckets from 0.1 ms to well past a day
+static constexpr double GNexusHistogramMinSeconds = 0.0001;
+static constexpr double GNexusHistogramRatio = 1.02;
+static constexpr int32 GNexusHistogramBuckets = 1100;
+
+static constexpr uint8 GNexusStatusMask = 0x0F;
+static constexpr uint8 GNexusQuarantinedFlag = 0x80;
+
+enum ENexusHistoryColumn : int32
+{
+    TestIdColumn,
+    TimestampColumn,
+    DurationColumn,
+    StatusColumn,
+    AttemptsColumn,
+    TraceIdColumn,
+    NumHistoryColumns
+};
+
+struct FNexusHistoryColumnSpec
+{
+    const TCHAR* FileName;
+    int64 Width;
+};
+
+static const FNexusHistoryColumnSpec GNexusHistoryColumns[NumHistoryColumns] =
+{
+    { TEXT("test_id.col"),   sizeof(uint32) },
+    { TEXT("timestamp.col"), sizeof(int64) },
+    { TEXT("duration.col"),  sizeof(float) },
+    { TEXT("status.col"),    sizeof(uint8) },
+    { TEXT("attempts.col"),  sizeof(uint8) },
+    { TEXT("trace_id.col"),  16 },
+};
+
+static const TCHAR* GNexusHistoryDictionary = TEXT("tests.txt");
+
+/**
+ * Read-only view of one column file; memory-mapped, or read in when the platform cannot map files
+ */
+class FNexusMappedColumn
+{
+public:
+    bool Map(const FString& Path, int64 Bytes)
+    {
+        if (Bytes <= 0)
+        {
+            return true;
+        }
+
+        FOpenMappedResult Opened = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+        if (Opened.HasValue())
+        {
+            Handle = Opened.StealValue();
+            Region.Reset(Handle->MapRegion(0, Bytes));
+        }
+        if (Region.IsValid())
+        {
+            Data = Region->GetMappedPtr();
+            return true;
+        }
+
+        Region.Reset();
+        Handle.Reset();
+        if (!FFileHelper::LoadFileToArray(Fallback, *Path) || Fallback.Num() < Bytes)
+        {
+            return false;
+        }
+        Data = Fallback.GetData();
+        return true;
+    }
+
+    template <typename T>
+    T Get(int64 Row) const
+    {
+        T Value;
+        FMemory::Memcpy(&Value, Data + Row * sizeof(T), sizeof(T));
+        return Value;
+    }
+
+    const uint8* GetRow(int64 Row, int64 Width) const
+    {
+        return Data + Row * Width;
+    }
+
+private:
+    TUniquePtr<IMappedFileHandle> Handle;
+    TUniquePtr<IMappedFileRegion> Region;  // Declared after Handle so it is unmapped first
+    TArray64<uint8> Fallback;
+    const uint8* Data = nullptr;
+};
+
+// Trace IDs are "nexus-test-<uuid>" (FPalantirTraceId); the column keeps its 16 bytes as four 32-bit words
+static void EncodeTraceId(const FString& TraceID, uint8* OutBytes)
+{
+    FMemory::Memzero(OutBytes, 16);
+    FPalantirTraceId Id;
+    if (FPalantirTraceId::Parse(TraceID, Id))
+    {
+        const uint32 Words[4] = { static_cast<uint32>(Id.High >> 32), static_cast<uint32>(Id.High), static_cast<uint32>(Id.Low >> 32), static_cast<uint32>(Id.Low) };
+        FMemory::Memcpy(OutBytes, Words, 16);
+    }
+}
+
+static FString DecodeTraceId(const uint8* Bytes)
+{
+    uint32 Words[4];
+    FMemory::Memcpy(Words, Bytes, 16);
+    FPalantirTraceId Id;
+    Id.High = (static_cast<uint64>(Words[0]) << 32) | Words[1];
+    Id.Low = (static_cast<uint64>(Words[2]) << 32) | Words[3];
+    return Id.IsValid() ? Id.ToTraceID() : FString();
+}
+
+static int32 GetHistogramBucket(double Seconds)
+{
+    if (Seconds <= GNexusHistogramMinSeconds)
+    {
+        return 0;
+    }
+    const int32 Bucket = 1 + FMath::FloorToInt32(FMath::Loge(Seconds / GNexusHistogramMinSeconds) / FMath::Loge(GNexusHistogramRatio));
+    return FMath::Clamp(Bucket, 0, GNexusHistogramBuckets - 1);
+}
+
+static double GetHistogramBucketCenter(int32 Bucket)
+{
+    return Bucket == 0 ? GNexusHistogramMinSeconds : GNexusHistogramMinSeconds * FMath::Pow(GNexusHistogramRatio, Bucket - 0.5);
+}
+
+static double MedianOf(TArray<double>& Values)
+{
+    if (Values.Num() == 0)
+    {
+        return 0.0;
+    }
+    Values.Sort();
+    return Values[Values.Num() / 2];
+}
+
+const TCHAR* LexToString(ENexusHistoryStatus Status)
+{
+    switch (Status)
+    {
+    case ENexusHistoryStatus::Passed:   return TEXT("Passed");
+    case ENexusHistoryStatus::TimedOut: return TEXT("TimedOut");
+    default:                            return TEXT("Failed");
+    }
+}
+
+FNexusRunHistory& FNexusRunHistory::Get()
+{
+    static FNexusRunHistory Instance;
+    return Instance;
+}
+
+FString FNexusRunHistory::GetHistoryDir()
+{
+    return FNexusResultCache::GetCacheDir() / TEXT("history");
+}
+
+int32 FNexusRunHistory::GetRecentWindow()
+{
+    int32 Count = GNexusDefaultRecentRuns;
+    if (GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("HistoryRecentRuns"), Count, GGameIni);
+    }
+    // Each run adds at least one outcome, so this many runs always fill the flakiness window
+    return FMath::Max(FMath::Max(2, Count), FNexusFlakiness::GetWindowSize());
+}
+
+int32 FNexusRunHistory::FindOrAddStoreLocked(const FString& Dir)
+{
+    for (int32 Index = 0; Index < Stores.Num(); ++Index)
+    {
+        if (Stores[Index].Dir == Dir)
+        {
+            return Index;
+        }
+    }
+
+    FStore& Store = Stores.AddDefaulted_GetRef();
+    Store.Dir = Dir;
+    FFileHelper::LoadFileToStringArray(Store.TestNames, *(Dir / GNexusHistoryDictionary));
+    for (int32 Id = 0; Id < Store.TestNames.Num(); ++Id)
+    {
+        Store.TestIds.Add(Store.TestNames[Id], Id);
+    }
+    Store.Slots.Init(INDEX_NONE, Store.TestNames.Num());
+
+    // Rows every column has; anything past that is a torn append and is cut off by the next write
+    Store.Rows = MAX_int64;
+    for (const FNexusHistoryColumnSpec& Column : GNexusHistoryColumns)
+    {
+        const int64 Size = IFileManager::Get().FileSize(*(Dir / Column.FileName));
+        Store.Rows = FMath::Min(Store.Rows, Size > 0 ? Size / Column.Width : 0);
+    }
+    return Stores.Num() - 1;
+}
+
+int32 FNexusRunHistory::FindOrAddSlotLocked(const FString& Name)
+{
+    if (const int32* Slot = TestSlots.Find(Name))
+    {
+        return *Slot;
+    }
+    const int32 Slot = Tests.AddDefaulted();
+    Tests[Slot].Name = Name;
+    TestSlots.Add(Name, Slot);
+    return Slot;
+}
+
+void FNexusRunHistory::AddRowLocked(FStore& Store, int32 StoreIndex, int64 Row, uint32 LocalTestId, int64 Ticks, float DurationSeconds, uint8 Status, uint8 Attempts)
+{
+    if (!Store.Slots.IsValidIndex(LocalTestId))
+    {
+        return;  // ID past the dictionary - the name write was lost, so the row cannot be attributed
+    }
+    if (Store.Slots[LocalTestId] == INDEX_NONE)
+    {
+        Store.Slots[LocalTestId] = FindOrAddSlotLocked(Store.TestNames[LocalTestId]);
+    }
+
+    FTestIndex& Test = Tests[Store.Slots[LocalTestId]];
+    ++Test.Runs;
+    Test.Passes += (Status & GNexusStatusMask) == static_cast<uint8>(ENexusHistoryStatus::Passed) ? 1 : 0;
+    Test.TotalSeconds += DurationSeconds;
+    ++TotalRuns;
+    TotalSeconds += DurationSeconds;
+    ++DurationHistogram[GetHistogramBucket(DurationSeconds)];
+
+    FRecentEntry& Entry = Test.Recent.AddDefaulted_GetRef();
+    Entry.Ticks = Ticks;
+    Entry.DurationSeconds = DurationSeconds;
+    Entry.Status = Status;
+    Entry.Attempts = Attempts;
+    Entry.StoreIndex = StoreIndex;
+    Entry.Row = Row;
+    if (Test.Recent.Num() >= Window * 2)
+    {
+        CompactLocked(Test);
+    }
+}
+
+void FNexusRunHistory::CompactLocked(FTestIndex& Test) const
+{
+    // Stores are scanned one after another, so a test run by several shards arrives out of time order
+    Test.Recent.StableSort([](const FRecentEntry& A, const FRecentEntry& B) { return A.Ticks < B.Ticks; });
+    if (Test.Recent.Num() > Window)
+    {
+        Test.Recent.RemoveAt(0, Test.Recent.Num() - Window, EAllowShrinking::No);
+    }
+}
+
+void FNexusRunHistory::EnsureIndexLocked()
+{
+    if (bIndexed)
+    {
+        return;
+    }
+    bIndexed = true;
+    Window = GetRecentWindow();
+    DurationHistogram.Init(0, GNexusHistogramBuckets);
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    const FString HistoryDir = GetDirectoryLocked();
+    TArray<FString> StoreDirs = { HistoryDir };
+    TArray<FString> ShardDirs;
+    IFileManager::Get().FindFiles(ShardDirs, *(HistoryDir / TEXT("shard-*")), false, true);
+    for (const FString& ShardDir : ShardDirs)
+    {
+        StoreDirs.Add(HistoryDir / ShardDir);
+    }
+
+    for (const FString& Dir : StoreDirs)
+    {
+        const int32 StoreIndex = FindOrAddStoreLocked(Dir);
+        FStore& Store = Stores[StoreIndex];
+        if (Store.Rows == 0)
+        {
+            continue;
+        }
+
+        FNexusMappedColumn TestIdCol, TimestampCol, DurationCol, StatusCol, AttemptsCol;
+        if (!TestIdCol.Map(Dir / GNexusHistoryColumns[TestIdColumn].FileName, Store.Rows * sizeof(uint32)) ||
+            !TimestampCol.Map(Dir / GNexusHistoryColumns[TimestampColumn].FileName, Store.Rows * sizeof(int64)) ||
+            !DurationCol.Map(Dir / GNexusHistoryColumns[DurationColumn].FileName, Store.Rows * sizeof(float)) ||
+            !StatusCol.Map(Dir / GNexusHistoryColumns[StatusColumn].FileName, Store.Rows * sizeof(uint8)) ||
+            !AttemptsCol.Map(Dir / GNexusHistoryColumns[AttemptsColumn].FileName, Store.Rows * sizeof(uint8)))
+        {
+            UE_LOG(LogNexus, Warning, TEXT("NEXUS: Ignoring unreadable run history in %s"), *Dir);
+            continue;
+        }
+
+        for (int64 Row = 0; Row < Store.Rows; ++Row)
+        {
+            AddRowLocked(Store, StoreIndex, Row, TestIdCol.Get<uint32>(Row), TimestampCol.Get<int64>(Row),
+                DurationCol.Get<float>(Row), StatusCol.Get<uint8>(Row), AttemptsCol.Get<uint8>(Row));
+        }
+    }
+
+    for (FTestIndex& Test : Tests)
+    {
+        CompactLocked(Test);
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Run history indexed — %lld execution(s) of %d test(s) in %.2fs"),
+        TotalRuns, Tests.Num(), FPlatformTime::Seconds() - StartSeconds);
+}
+
+FNexusRunHistory::FTestIndex* FNexusRunHistory::FindTestLocked(const FString& TestName)
+{
+    EnsureIndexLocked();
+    const int32* Slot = TestSlots.Find(TestName);
+    if (!Slot)
+    {
+        return nullptr;
+    }
+    FTestIndex& Test = Tests[*Slot];
+    CompactLocked(Test);
+    return &Test;
+}
+
+int32 FNexusRunHistory::RecordResults(const TArray<FNexusTest*>& Tests, const FDateTime& RunStart, const FNexusShardSpec& Shard)
+{
+    FScopeLock ScopeLock(&Lock);
+    EnsureIndexLocked();
+
+    // Shards append to their own store so concurrent shard processes never write the same file
+    const FString Dir = Shard.IsSharded()
+        ? GetDirectoryLocked() / FString::Printf(TEXT("shard-%d-of-%d"), Shard.Index + 1, Shard.Count)
+        : GetDirectoryLocked();
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    PlatformFile.CreateDirectoryTree(*Dir);
+
+    const int32 StoreIndex = FindOrAddStoreLocked(Dir);
+    FStore& Store = Stores[StoreIndex];
+
+    TArray<uint8> Columns[NumHistoryColumns];
+    TArray<FString> NewNames;
+    int32 Appended = 0;
+    for (const FNexusTest* Test : Tests)
+    {
+        const FNexusTestResult& Result = Test->LastResult;
+        if (Result.bSkipped || Result.Timestamp < RunStart || Result.AttemptHistory.Num() == 0)
+        {
+            continue;  // Skipped, cached or never reached
+        }
+
+        uint32 TestId = 0;
+        if (const uint32* Existing = Store.TestIds.Find(Test->TestName))
+        {
+            TestId = *Existing;
+        }
+        else
+        {
+            TestId = Store.TestNames.Add(Test->TestName);
+            Store.TestIds.Add(Test->TestName, TestId);
+            Store.Slots.Add(INDEX_NONE);
+            NewNames.Add(Test->TestName);
+        }
+
+        const int64 Ticks = Result.Timestamp.GetTicks();
+        const float Duration = static_cast<float>(Result.DurationSeconds);
+        const uint8 Status = static_cast<uint8>(Result.bPassed ? ENexusHistoryStatus::Passed
+            : Result.bTimedOut ? ENexusHistoryStatus::TimedOut : ENexusHistoryStatus::Failed)
+            | (Result.bQuarantined ? GNexusQuarantinedFlag : 0);
+        const uint8 Attempts = static_cast<uint8>(FMath::Clamp<uint32>(Result.Attempts, 1, MAX_uint8));
+        uint8 TraceBytes[16];
+        EncodeTraceId(Result.TraceID, TraceBytes);
+
+        Columns[TestIdColumn].Append(reinterpret_cast<const uint8*>(&TestId), sizeof(TestId));
+        Columns[TimestampColumn].Append(reinterpret_cast<const uint8*>(&Ticks), sizeof(Ticks));
+        Columns[DurationColumn].Append(reinterpret_cast<const uint8*>(&Duration), sizeof(Duration));
+        Columns[StatusColumn].Add(Status);
+        Columns[AttemptsColumn].Add(Attempts);
+        Columns[TraceIdColumn].Append(TraceBytes, UE_ARRAY_COUNT(TraceBytes));
+        ++Appended;
+    }
+
+    if (Appended == 0)
+    {
+        return 0;
+    }
+
+    // Names first: a row whose name write was lost could not be attributed, a name without rows is harmless
+    if (NewNames.Num() > 0 &&
+        !FFileHelper::SaveStringToFile(FString::Join(NewNames, TEXT("\n")) + TEXT("\n"), *(Dir / GNexusHistoryDictionary),
+            FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: Failed to append to run history %s"), *Dir);
+        return 0;
+    }
+
+    for (int32 Column = 0; Column < NumHistoryColumns; ++Column)
+    {
+        const int64 CommittedBytes = Store.Rows * GNexusHistoryColumns[Column].Width;
+        TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*(Dir / GNexusHistoryColumns[Column].FileName), true));
+        if (!Handle || (Handle->Size() > CommittedBytes && !Handle->Truncate(CommittedBytes)) ||
+            !Handle->Write(Columns[Column].GetData(), Columns[Column].Num()))
+        {
+            // The columns now disagree on length; the next load or append cuts them back to the shortest
+            UE_LOG(LogNexus, Warning, TEXT("NEXUS: Failed to append to run history %s"), *(Dir / GNexusHistoryColumns[Column].FileName));
+            return 0;
+        }
+    }
+
+    for (int32 Index = 0; Index < Appended; ++Index)
+    {
+        uint32 TestId = 0;
+        int64 Ticks = 0;
+        float Duration = 0.0f;
+        FMemory::Memcpy(&TestId, Columns[TestIdColumn].GetData() + Index * sizeof(uint32), sizeof(uint32));
+        FMemory::Memcpy(&Ticks, Columns[TimestampColumn].GetData() + Index * sizeof(int64), sizeof(int64));
+        FMemory::Memcpy(&Duration, Columns[DurationColumn].GetData() + Index * sizeof(float), sizeof(float));
+        AddRowLocked(Store, StoreIndex, Store.Rows + Index, TestId, Ticks, Duration, Columns[StatusColumn][Index], Columns[AttemptsColumn][Index]);
+    }
+    Store.Rows += Appended;
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Run history — appended %d execution(s) to %s"), Appended, *Dir);
+    return Appended;
+}
+
+double FNexusRunHistory::GetAverageDuration(const FString& TestName)
+{
+    if (!TestName.IsEmpty())
+    {
+        return GetSummary(TestName).AverageSeconds;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    EnsureIndexLocked();
+    return TotalRuns > 0 ? TotalSeconds / TotalRuns : 0.0;
+}
+
+double FNexusRunHistory::GetMedianDuration(const FString& TestName)
+{
+    if (!TestName.IsEmpty())
+    {
+        return GetSummary(TestName).MedianSeconds;
+    }
+
+    FScopeLock ScopeLock(&Lock);
+    EnsureIndexLocked();
+    int64 Remaining = TotalRuns / 2 + 1;
+    for (int32 Bucket = 0; Bucket < DurationHistogram.Num() && TotalRuns > 0; ++Bucket)
+    {
+        Remaining -= DurationHistogram[Bucket];
+        if (Remaining <= 0)
+        {
+            return GetHistogramBucketCenter(Bucket);
+        }
+    }
+    return 0.0;
+}
+
+FNexusHistorySummary FNexusRunHistory::GetSummary(const FString& TestName)
+{
+    FScopeLock ScopeLock(&Lock);
+    FNexusHistorySummary Summary;
+    const FTestIndex* Test = FindTestLocked(TestName);
+    if (!Test || Test->Runs == 0)
+    {
+        return Summary;
+    }
+
+    Summary.Runs = Test->Runs;
+    Summary.Passes = Test->Passes;
+    Summary.AverageSeconds = Test->TotalSeconds / Test->Runs;
+    TArray<double> Durations;
+    for (const FRecentEntry& Entry : Test->Recent)
+    {
+        Durations.Add(Entry.DurationSeconds);
+    }
+    Summary.MedianSeconds = MedianOf(Durations);
+    return Summary;
+}
+
+bool FNexusRunHistory::GetExpectedDuration(const FString& TestName, double& OutSeconds)
+{
+    FScopeLock ScopeLock(&Lock);
+    const FTestIndex* Test = FindTestLocked(TestName);
+    if (!Test)
+    {
+        return false;
+    }
+
+    // Failed runs stop early or run into timeouts; neither predicts how long the test takes
+    TArray<double> Durations;
+    for (const FRecentEntry& Entry : Test->Recent)
+    {
+        if ((Entry.Status & GNexusStatusMask) == static_cast<uint8>(ENexusHistoryStatus::Passed))
+        {
+            Durations.Add(Entry.DurationSeconds);
+        }
+    }
+    if (Durations.Num() == 0)
+    {
+        return false;
+    }
+    OutSeconds = MedianOf(Durations);
+    return true;
+}
+
+FNexusHistoryRun FNexusRunHistory::MakeRun(const FRecentEntry& Entry) const
+{
+    FNexusHistoryRun Run;
+    Run.Timestamp = FDateTime(Entry.Ticks);
+    Run.DurationSeconds = Entry.DurationSeconds;
+    Run.Status = static_cast<ENexusHistoryStatus>(Entry.Status & GNexusStatusMask);
+    Run.bQuarantined = (Entry.Status & GNexusQuarantinedFlag) != 0;
+    Run.Attempts = Entry.Attempts;
+    return Run;
+}
+
+FString FNexusRunHistory::ReadTraceIdLocked(const FRecentEntry& Entry) const
+{
+    const int64 Width = GNexusHistoryColumns[TraceIdColumn].Width;
+    const FString Path = Stores[Entry.StoreIndex].Dir / GNexusHistoryColumns[TraceIdColumn].FileName;
+    TUniquePtr<IFileHandle> Handle(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*Path));
+    uint8 Bytes[16];
+    if (!Handle || !Handle->Seek(Entry.Row * Width) || !Handle->Read(Bytes, Width))
+    {
+        return FString();
+    }
+    return DecodeTraceId(Bytes);
+}
+
+TArray<FNexusHistoryRun> FNexusRunHistory::GetRecentRuns(const FString& TestName, bool bResolveTraceIds)
+{
+    FScopeLock ScopeLock(&Lock);
+    TArray<FNexusHistoryRun> Runs;
+    if (const FTestIndex* Test = FindTestLocked(TestName))
+    {
+        Runs.Reserve(Test->Recent.Num());
+        for (const FRecentEntry& Entry : Test->Recent)
+        {
+            FNexusHistoryRun& Run = Runs.Add_GetRef(MakeRun(Entry));
+            if (bResolveTraceIds)
+            {
+                Run.TraceID = ReadTraceIdLocked(Entry);
+            }
+        }
+    }
+    return Runs;
+}
+
+TArray<FString> FNexusRunHistory::GetTestNames()
+{
+    FScopeLock ScopeLock(&Lock);
+    EnsureIndexLocked();
+    TArray<FString> Names;
+    TestSlots.GenerateKeyArray(Names);
+    return Names;
+}
+
+void FNexusRunHistory::ForEachRun(TFunctionRef<void(const FString& TestName, const FNexusHistoryRun& Run)> Visitor)
+{
+    FScopeLock ScopeLock(&Lock);
+    EnsureIndexLocked();
+
+    for (const FStore& Store : Stores)
+    {
+        FNexusMappedColumn Mapped[NumHistoryColumns];
+        bool bMapped = true;
+        for (int32 Column = 0; Column < NumHistoryColumns && bMapped; ++Column)
+        {
+            bMapped = Mapped[Column].Map(Store.Dir / GNexusHistoryColumns[Column].FileName, Store.Rows * GNexusHistoryColumns[Column].Width);
+        }
+        if (!bMapped)
+        {
+            continue;
+        }
+
+        for (int64 Row = 0; Row < Store.Rows; ++Row)
+        {
+            const uint32 TestId = Mapped[TestIdColumn].Get<uint32>(Row);
+            if (!Store.TestNames.IsValidIndex(TestId))
+            {
+                continue;
+            }
+
+            FRecentEntry Entry;
+            Entry.Ticks = Mapped[TimestampColumn].Get<int64>(Row);
+            Entry.DurationSeconds = Mapped[DurationColumn].Get<float>(Row);
+            Entry.Status = Mapped[StatusColumn].Get<uint8>(Row);
+            Entry.Attempts = Mapped[AttemptsColumn].Get<uint8>(Row);
+            FNexusHistoryRun Run = MakeRun(Entry);
+            Run.TraceID = DecodeTraceId(Mapped[TraceIdColumn].GetRow(Row, GNexusHistoryColumns[TraceIdColumn].Width));
+            Visitor(Store.TestNames[TestId], Run);
+        }
+    }
+}
+
+int64 FNexusRunHistory::GetRowCount()
+{
+    FScopeLock ScopeLock(&Lock);
+    EnsureIndexLocked();
+    return TotalRuns;
+}
+
+void FNexusRunHistory::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    bIndexed = false;
+    Stores.Empty();
+    Tests.Empty();
+    TestSlots.Empty();
+    TotalRuns = 0;
+    TotalSeconds = 0.0;
+    DurationHistogram.Empty();
+}
+
+void FNexusRunHistory::SetDirectory(const FString& Dir)
+{
+    {
+        FScopeLock ScopeLock(&Lock);
+        Directory = Dir;
+    }
+    Reset();
+}
@@ -0,0 +1,567 @@
+#include "NexusScheduler.h"
+#include "NexusTest.h"
+#include "NexusModule.h"
+#include "NexusWatchdog.h"
+#include "NexusCancellation.h"
+#include "NexusRunHistory.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/Event.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/ConfigCacheIni.h"
+
+// Fallback weight for tests that have never been timed - long enough that new tests
+// are not starved behind the whole suite, short enough not to displace known long tests
+static constexpr double GNexusDefaultPredictedSeconds = 1.0;
+
+// Idle workers re-check for stealable work at least this often
+static constexpr uint32 GNexusIdleWaitMs = 5;
+
+/**
+ * Worker thread - drains its own deque, then steals from peers
+ */
+class FNexusScheduler::FWorker : public FRunnable
+{
+public:
+    FWorker(FNexusScheduler& InOwner, int32 InIndex)
+        : Owner(InOwner), Index(InIndex)
+    {
+    }
+
+    virtual uint32 Run() override
+    {
+        Owner.WorkerLoop(*this);
+        return 0;
+    }
+
+    FNexusScheduler& Owner;
+    const int32 Index;
+    FRunnableThread* Thread = nullptr;
+
+    // Job inside Body and when it started; written by this worker before Body, read by the watchdog
+    // thread only while the job's watch is registered (the watchdog lock orders the two)
+    FNexusScheduledTest CurrentJob;
+    double CurrentJobStartSeconds = 0.0;
+
+    // Replacement workers report the hung job of the worker they replace before starting their loop
+    bool bHasInheritedJob = false;
+    FNexusScheduledTest InheritedJob;
+    double InheritedHungSeconds = 0.0;
+
+    bool bAbandoned = false;  // Guarded by Owner.WorkersLock
+};
+
+FNexusScheduler::FNexusScheduler(int32 InNumWorkers)
+{
+    NumWorkers = InNumWorkers > 0 ? InNumWorkers : GetDefaultWorkerCount();
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        Queues.Add(MakeUnique<FWorkerQueue>());
+    }
+    WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+}
+
+FNexusScheduler::~FNexusScheduler()
+{
+    if (WorkEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(WorkEvent);
+        WorkEvent = nullptr;
+    }
+    if (DoneEvent)
+    {
+        FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+        DoneEvent = nullptr;
+    }
+}
+
+int32 FNexusScheduler::GetDefaultWorkerCount()
+{
+    int32 Workers = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("NexusWorkers="), Workers) && Workers > 0)
+    {
+        return Workers;
+    }
+
+    if (GConfig && GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("MaxParallelWorkers"), Workers, GGameIni) && Workers > 0)
+    {
+        return Workers;
+    }
+
+    return FMath::Max(1, FPlatformMisc::NumberOfWorkerThreadsToSpawn());
+}
+
+int32 FNexusScheduler::GetPriorityRank(const FNexusTest* Test)
+{
+    if (!Test)
+    {
+        return 0;
+    }
+    if (NexusHasFlag(Test->Priority, ETestPriority::Critical))
+    {
+        return 2;
+    }
+    if (NexusHasFlag(Test->Priority, ETestPriority::Smoke))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+// Median of recent passing runs from the history store, else the last baseline duration
+static bool LookupDuration(const FNexusTest* Test, double& OutSeconds)
+{
+    return Test &&
+        ((FNexusRunHistory::Get().GetExpectedDuration(Test->TestName, OutSeconds) && OutSeconds > 0.0) ||
+         (FPalantirObserver::GetBaselineDuration(Test->TestName, OutSeconds) && OutSeconds > 0.0));
+}
+
+double FNexusScheduler::PredictDuration(const FNexusTest* Test, double DefaultSeconds)
+{
+    double Seconds = 0.0;
+    if (LookupDuration(Test, Seconds))
+    {
+        return Seconds;
+    }
+    return DefaultSeconds;
+}
+
+void FNexusScheduler::Enqueue(const TArray<FNexusTest*>& Tests)
+{
+    // Tests without history are weighted with the mean of the ones we do know about
+    double KnownTotal = 0.0;
+    int32 KnownCount = 0;
+    for (FNexusTest* Test : Tests)
+    {
+        double Seconds = 0.0;
+        if (LookupDuration(Test, Seconds))
+        {
+            KnownTotal += Seconds;
+            ++KnownCount;
+        }
+    }
+    const double DefaultSeconds = KnownCount > 0 ? KnownTotal / KnownCount : GNexusDefaultPredictedSeconds;
+
+    TArray<FNexusScheduledTest> Jobs;
+    Jobs.Reserve(Tests.Num());
+    for (FNexusTest* Test : Tests)
+    {
+        if (!Test) continue;
+
+        FNexusScheduledTest Job;
+        Job.Test = Test;
+        Job.PredictedSeconds = PredictDuration(Test, DefaultSeconds);
+        Job.PriorityRank = GetPriorityRank(Test);
+        Job.ResourceClass = Test->ResourceClass;
+        Jobs.Add(Job);
+    }
+
+    // Priority class first, then longest-processing-time-first; name breaks ties so the order is deterministic
+    Jobs.Sort([](const FNexusScheduledTest& A, const FNexusScheduledTest& B)
+    {
+        if (A.PriorityRank != B.PriorityRank)
+        {
+            return A.PriorityRank > B.PriorityRank;
+        }
+        if (A.PredictedSeconds != B.PredictedSeconds)
+        {
+            return A.PredictedSeconds > B.PredictedSeconds;
+        }
+        return A.Test->TestName < B.Test->TestName;
+    });
+
+    // Greedy LPT: each job goes to the worker with the least predicted load so far. Users of a suite
+    // fixture stay on the worker its first user went to, unless that puts the worker more than this job ahead.
+    TMap<FString, int32> FixtureWorkers;
+    for (const FNexusScheduledTest& Job : Jobs)
+    {
+        int32 Target = 0;
+        for (int32 i = 1; i < NumWorkers; ++i)
+        {
+            if (Queues[i]->RemainingSeconds < Queues[Target]->RemainingSeconds)
+            {
+                Target = i;
+            }
+        }
+
+        const FString& FixtureKey = FNexusFixture::GetAffinityKey(*Job.Test);
+        if (!FixtureKey.IsEmpty())
+        {
+            const int32* FixtureWorker = FixtureWorkers.Find(FixtureKey);
+            if (FixtureWorker && Queues[*FixtureWorker]->RemainingSeconds - Queues[Target]->RemainingSeconds <= Job.PredictedSeconds)
+            {
+                Target = *FixtureWorker;
+            }
+            FixtureWorkers.Add(FixtureKey, Target);
+        }
+
+        FWorkerQueue& Queue = *Queues[Target];
+        FScopeLock Lock(&Queue.Lock);
+        // Insert at the front: the back of the deque always holds the next job to run
+        Queue.Jobs.Insert(Job, 0);
+        Queue.RemainingSeconds += Job.PredictedSeconds;
+        Outstanding.fetch_add(1);
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Scheduled %d test(s) across %d worker(s) (LPT, default weight %.3fs)"),
+        Jobs.Num(), NumWorkers, DefaultSeconds);
+}
+
+void FNexusScheduler::EnableGovernor(int32 InitialConcurrency)
+{
+    Governor = MakeUnique<FNexusConcurrencyGovernor>(FMath::Min(InitialConcurrency, NumWorkers), NumWorkers);
+}
+
+void FNexusScheduler::Run(FTestBody InBody)
+{
+    Body = MoveTemp(InBody);
+
+    if (Outstanding.load() == 0)
+    {
+        return;
+    }
+
+    LiveWorkers.store(NumWorkers);
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        StartWorker(MakeUnique<FWorker>(*this, i));
+    }
+
+    // Joining threads directly would block forever on one the watchdog abandons mid-wait
+    DoneEvent->Wait();
+
+    FScopeLock Lock(&WorkersLock);
+    int32 AbandonedCount = 0;
+    for (TUniquePtr<FWorker>& Worker : Workers)
+    {
+        if (Worker->bAbandoned)
+        {
+            // Still running the hung test; it needs its runnable and thread object if the test ever returns
+            (void)Worker.Release();
+            ++AbandonedCount;
+        }
+        else if (Worker->Thread)
+        {
+            Worker->Thread->WaitForCompletion();
+            delete Worker->Thread;
+        }
+    }
+    Workers.Empty();
+
+    if (AbandonedCount > 0)
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: Left %d hung worker thread(s) behind"), AbandonedCount);
+    }
+
+    if (Governor)
+    {
+        const FNexusConcurrencyStats Stats = Governor->GetStats();
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Concurrency governor — started at %d, ranged %d-%d of %d worker(s) (%d up, %d down, %d memory-pressure sample(s)), peak %d running, peak CPU %.0f%%"),
+            Stats.InitialTarget, Stats.MinTarget, Stats.MaxTarget, NumWorkers, Stats.Raises, Stats.Lowers,
+            Stats.MemoryPressureSamples, Stats.PeakActive, Stats.PeakCpuUtilization);
+    }
+}
+
+void FNexusScheduler::StartWorker(TUniquePtr<FWorker> Worker)
+{
+    FScopeLock Lock(&WorkersLock);
+    FWorker& Started = *Workers.Add_GetRef(MoveTemp(Worker));
+    Started.Thread = FRunnableThread::Create(&Started, *FString::Printf(TEXT("NexusWorker%d"), Started.Index));
+}
+
+void FNexusScheduler::AbandonWorker(FWorker& Worker)
+{
+    // Watchdog thread: the worker is stuck inside Body, so its CurrentJob is stable
+    TUniquePtr<FWorker> Replacement = MakeUnique<FWorker>(*this, Worker.Index);
+    Replacement->bHasInheritedJob = true;
+    Replacement->InheritedJob = Worker.CurrentJob;
+    Replacement->InheritedHungSeconds = FPlatformTime::Seconds() - Worker.CurrentJobStartSeconds;
+    {
+        FScopeLock Lock(&WorkersLock);
+        Worker.bAbandoned = true;
+    }
+
+    UE_LOG(LogNexus, Warning, TEXT("NEXUS: Replacing worker %d (hung in %s)"), Worker.Index, *Worker.CurrentJob.Test->TestName);
+    StartWorker(MoveTemp(Replacement));
+}
+
+void FNexusScheduler::Cancel()
+{
+    bCancelled.store(true);
+
+    // Tests still waiting on prerequisites will never be released now; whoever empties the set reports them
+    TSet<FNexusTest*> Dropped;
+    {
+        FScopeLock Lock(&PendingLock);
+        Dropped = MoveTemp(PendingTests);
+        PendingTests.Reset();
+    }
+    for (FNexusTest* Test : Dropped)
+    {
+        UE_LOG(LogNexus, Warning, TEXT("Skipping test %s due to critical failure"), *Test->TestName);
+        if (SkipHandler)
+        {
+            FNexusScheduledTest Job;
+            Job.Test = Test;
+            Job.PriorityRank = GetPriorityRank(Test);
+            Job.ResourceClass = Test->ResourceClass;
+            SkipHandler(Job, INDEX_NONE);
+        }
+    }
+    if (Dropped.Num() > 0)
+    {
+        CompleteJobs(Dropped.Num());
+    }
+
+    if (WorkEvent)
+    {
+        WorkEvent->Trigger();
+    }
+}
+
+void FNexusScheduler::AddPending(const TArray<FNexusTest*>& Tests)
+{
+    FScopeLock Lock(&PendingLock);
+    for (FNexusTest* Test : Tests)
+    {
+        bool bAlreadyPending = true;
+        if (Test)
+        {
+            PendingTests.Add(Test, &bAlreadyPending);
+        }
+        if (!bAlreadyPending)
+        {
+            Outstanding.fetch_add(1);
+        }
+    }
+}
+
+bool FNexusScheduler::ClaimPending(FNexusTest* Test)
+{
+    // Whoever removes the test first (release/drop vs. Cancel) owns it, so no test is counted twice
+    FScopeLock Lock(&PendingLock);
+    return PendingTests.Remove(Test) > 0;
+}
+
+bool FNexusScheduler::ReleasePending(FNexusTest* Test, int32 WorkerIndex)
+{
+    if (!Test || !ClaimPending(Test))
+    {
+        return false;
+    }
+
+    FNexusScheduledTest Job;
+    Job.Test = Test;
+    Job.PredictedSeconds = PredictDuration(Test, GNexusDefaultPredictedSeconds);
+    Job.PriorityRank = GetPriorityRank(Test);
+    Job.ResourceClass = Test->ResourceClass;
+
+    // Back of the releasing worker's deque: it runs next on a warm worker, and idle peers can steal it
+    Reschedule(FMath::Clamp(WorkerIndex, 0, NumWorkers - 1), Job);
+    WorkEvent->Trigger();
+    return true;
+}
+
+void FNexusScheduler::DropPending(FNexusTest* Test)
+{
+    if (Test && ClaimPending(Test))
+    {
+        CompleteJobs(1);
+    }
+}
+
+void FNexusScheduler::CompleteJobs(int32 Count)
+{
+    if (Outstanding.fetch_sub(Count) == Count)
+    {
+        // Last job done - wake idle workers so they can exit
+        WorkEvent->Trigger();
+    }
+}
+
+bool FNexusScheduler::IsRunnable(const FNexusScheduledTest& Job, double Now) const
+{
+    // After Cancel, pending retries are released at once so the body can finalize them
+    return Job.NotBeforeSeconds <= Now || bCancelled.load();
+}
+
+bool FNexusScheduler::TryAdmit(const FNexusScheduledTest& Job)
+{
+    // After Cancel, jobs only run long enough to be finalized - never hold them back
+    return !Governor || Governor->TryAdmit(Job.ResourceClass, bCancelled.load());
+}
+
+int32 FNexusScheduler::CountRunnableJobs() const
+{
+    const double Now = FPlatformTime::Seconds();
+    int32 Count = 0;
+    for (const TUniquePtr<FWorkerQueue>& Queue : Queues)
+    {
+        FScopeLock Lock(&Queue->Lock);
+        for (const FNexusScheduledTest& Job : Queue->Jobs)
+        {
+            Count += IsRunnable(Job, Now) ? 1 : 0;
+        }
+    }
+    return Count;
+}
+
+bool FNexusScheduler::TryPopLocal(int32 WorkerIndex, FNexusScheduledTest& OutJob)
+{
+    FWorkerQueue& Queue = *Queues[WorkerIndex];
+    const double Now = FPlatformTime::Seconds();
+
+    FScopeLock Lock(&Queue.Lock);
+    for (int32 i = Queue.Jobs.Num() - 1; i >= 0; --i)
+    {
+        if (IsRunnable(Queue.Jobs[i], Now) && TryAdmit(Queue.Jobs[i]))
+        {
+            OutJob = Queue.Jobs[i];
+            Queue.Jobs.RemoveAt(i, 1, EAllowShrinking::No);
+            Queue.RemainingSeconds -= OutJob.PredictedSeconds;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FNexusScheduler::TrySteal(int32 ThiefIndex, FNexusScheduledTest& OutJob)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    // Victim is the peer with the most predicted work left (re-checked under its lock below)
+    int32 Victim = INDEX_NONE;
+    double VictimSeconds = 0.0;
+    for (int32 i = 0; i < NumWorkers; ++i)
+    {
+        if (i == ThiefIndex) continue;
+
+        FScopeLock PeekLock(&Queues[i]->Lock);
+        if (Queues[i]->Jobs.Num() > 0 && (Victim == INDEX_NONE || Queues[i]->RemainingSeconds > VictimSeconds))
+        {
+            Victim = i;
+            VictimSeconds = Queues[i]->RemainingSeconds;
+        }
+    }
+
+    if (Victim == INDEX_NONE)
+    {
+        return false;
+    }
+
+    // Take the shortest runnable job the governor admits; jobs still backing off stay with their owner
+    FWorkerQueue& Queue = *Queues[Victim];
+    FScopeLock Lock(&Queue.Lock);
+    for (int32 i = 0; i < Queue.Jobs.Num(); ++i)
+    {
+        if (IsRunnable(Queue.Jobs[i], Now) && TryAdmit(Queue.Jobs[i]))
+        {
+            OutJob = Queue.Jobs[i];
+            Queue.Jobs.RemoveAt(i, 1, EAllowShrinking::No);
+            Queue.RemainingSeconds -= OutJob.PredictedSeconds;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FNexusScheduler::Reschedule(int32 WorkerIndex, const FNexusScheduledTest& Job)
+{
+    FWorkerQueue& Queue = *Queues[WorkerIndex];
+    FScopeLock Lock(&Queue.Lock);
+    Queue.Jobs.Add(Job);
+    Queue.RemainingSeconds += Job.PredictedSeconds;
+}
+
+void FNexusScheduler::WorkerLoop(FWorker& Worker)
+{
+    const int32 WorkerIndex = Worker.Index;
+
+    // Own copy of the body: an abandoned worker may still be inside it after Run has returned
+    const FTestBody LocalBody = Body;
+    FNexusWatchdog::SetThreadAbandonHandler([this, &Worker]() { AbandonWorker(Worker); });
+
+    if (Worker.bHasInheritedJob)
+    {
+        if (AbandonHandler)
+        {
+            AbandonHandler(Worker.InheritedJob, WorkerIndex, Worker.InheritedHungSeconds);
+        }
+        if (Governor)
+        {
+            Governor->Release(Worker.InheritedJob.ResourceClass);  // The hung worker never will
+        }
+        CompleteJobs(1);
+    }
+
+    while (Outstanding.load() > 0)
+    {
+        // A run-wide abort (SignalAbort here or the sentinel from another process) cancels the schedule too
+        if (!bCancelled.load() && FNexusRunCancellation::IsCancelled())
+        {
+            Cancel();
+        }
+
+        if (Governor)
+        {
+            Governor->Tick([this]() { return CountRunnableJobs(); });
+        }
+
+        FNexusScheduledTest Job;
+        if (!TryPopLocal(WorkerIndex, Job) && !TrySteal(WorkerIndex, Job))
+        {
+            // Nothing runnable right now; peers may still be running or retries may be backing off
+            WorkEvent->Wait(GNexusIdleWaitMs);
+            continue;
+        }
+
+        ENexusJobResult Result = ENexusJobResult::Completed;
+        if (bCancelled.load() && Job.Attempt == 0)
+        {
+            UE_LOG(LogNexus, Warning, TEXT("Skipping test %s due to critical failure"), *Job.Test->TestName);
+            if (SkipHandler)
+            {
+                SkipHandler(Job, WorkerIndex);
+            }
+        }
+        else
+        {
+            Worker.CurrentJob = Job;
+            Worker.CurrentJobStartSeconds = FPlatformTime::Seconds();
+            Result = LocalBody(Job, WorkerIndex);
+            if (FNexusWatchdog::IsCurrentThreadAbandoned())
+            {
+                // A replacement already reported this job and owns our deque; the scheduler may be gone
+                return;
+            }
+        }
+
+        if (Governor)
+        {
+            // Free the slot and let a worker waiting on admission pick up the next job
+            Governor->Release(Job.ResourceClass);
+            WorkEvent->Trigger();
+        }
+
+        if (Result == ENexusJobResult::Reschedule)
+        {
+            // Still outstanding - back on our own deque until NotBeforeSeconds
+            Reschedule(WorkerIndex, Job);
+            continue;
+        }
+
+        CompleteJobs(1);
+    }
+
+    FNexusWatchdog::SetThreadAbandonHandler(nullptr);
+    if (LiveWorkers.fetch_sub(1) == 1)
+    {
+        DoneEvent->Trigger();
+    }
+}
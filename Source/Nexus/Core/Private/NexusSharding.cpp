@@ -0,0 +1,315 @@
+#include "NexusSharding.h"
+#include "NexusTestGraph.h"
+#include "NexusCore.h"
+#include "NexusTest.h"
+#include "NexusModule.h"
+#include "NexusRunHistory.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Crc.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Json.h"
+
+bool FNexusShardSpec::Parse(const FString& Spec, FNexusShardSpec& OutSpec)
+{
+    FString Left, Right;
+    if (!Spec.TrimStartAndEnd().Split(TEXT("/"), &Left, &Right) || !Left.IsNumeric() || !Right.IsNumeric())
+    {
+        return false;
+    }
+
+    const int32 K = FCString::Atoi(*Left);
+    const int32 N = FCString::Atoi(*Right);
+    if (N < 1 || K < 1 || K > N)
+    {
+        return false;
+    }
+
+    OutSpec.Index = K - 1;
+    OutSpec.Count = N;
+    return true;
+}
+
+FString FNexusShardSpec::ToString() const
+{
+    return FString::Printf(TEXT("%d/%d"), Index + 1, Count);
+}
+
+bool FNexusSharding::ParseFromArgs(const TArray<FString>& Args, FNexusShardSpec& OutSpec)
+{
+    FString Value;
+    for (const FString& Arg : Args)
+    {
+        if (FParse::Value(*Arg, TEXT("Shard="), Value))
+        {
+            break;
+        }
+    }
+
+    if (Value.IsEmpty())
+    {
+        FParse::Value(FCommandLine::Get(), TEXT("Shard="), Value);
+    }
+
+    if (Value.IsEmpty())
+    {
+        return false;
+    }
+
+    if (!FNexusShardSpec::Parse(Value, OutSpec))
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS: Invalid shard '%s' — expected -Shard=K/N with 1 <= K <= N"), *Value);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Durations come from FNexusRunHistory (median of each test's recent passing executions), falling back
+ * to the baseline for tests with no recorded history
+ */
+TArray<FNexusTest*> FNexusSharding::Partition(const TArray<FNexusTest*>& Tests, const FNexusShardSpec& Spec)
+{
+    if (!Spec.IsSharded())
+    {
+        return Tests;
+    }
+
+    // Sort by name so every process sees the same order regardless of module load order
+    TArray<FNexusTest*> Sorted;
+    for (FNexusTest* Test : Tests)
+    {
+        if (Test)
+        {
+            Sorted.Add(Test);
+        }
+    }
+    Sorted.Sort([](const FNexusTest& A, const FNexusTest& B) { return A.TestName < B.TestName; });
+
+    TMap<const FNexusTest*, double> Durations;
+    int32 KnownCount = 0;
+    double KnownTotal = 0.0;
+    for (FNexusTest* Test : Sorted)
+    {
+        double Seconds = 0.0;
+        if (!FNexusRunHistory::Get().GetExpectedDuration(Test->TestName, Seconds) || Seconds <= 0.0)
+        {
+            FPalantirObserver::GetBaselineDuration(Test->TestName, Seconds);
+        }
+
+        if (Seconds > 0.0)
+        {
+            Durations.Add(Test, Seconds);
+            KnownTotal += Seconds;
+            ++KnownCount;
+        }
+    }
+
+    // Tests connected by dependencies are placed as one unit so a prerequisite never ends up on another shard
+    FNexusTestGraph Graph;
+    Graph.Build(Sorted);
+
+    TArray<TPair<const TArray<FNexusTest*>*, double>> Known;
+    TArray<const TArray<FNexusTest*>*> Unknown;
+    const TArray<TArray<FNexusTest*>> Groups = Graph.GetConnectedGroups();
+    const double UnknownWeight = KnownCount > 0 ? KnownTotal / KnownCount : 1.0;
+    for (const TArray<FNexusTest*>& Group : Groups)
+    {
+        bool bAnyKnown = false;
+        double Weight = 0.0;
+        for (const FNexusTest* Test : Group)
+        {
+            const double* Seconds = Durations.Find(Test);
+            bAnyKnown |= Seconds != nullptr;
+            Weight += Seconds ? *Seconds : UnknownWeight;
+        }
+
+        if (bAnyKnown)
+        {
+            Known.Add(TPair<const TArray<FNexusTest*>*, double>(&Group, Weight));
+        }
+        else
+        {
+            Unknown.Add(&Group);
+        }
+    }
+
+    TArray<double> ShardLoad;
+    ShardLoad.SetNumZeroed(Spec.Count);
+    TArray<FNexusTest*> Selected;
+
+    // Groups with no history: stable hash of the first name, weighted with the mean so LPT can balance around them
+    for (const TArray<FNexusTest*>* Group : Unknown)
+    {
+        const int32 Shard = static_cast<int32>(FCrc::StrCrc32(*(*Group)[0]->TestName) % static_cast<uint32>(Spec.Count));
+        ShardLoad[Shard] += UnknownWeight * Group->Num();
+        if (Shard == Spec.Index)
+        {
+            Selected.Append(*Group);
+        }
+    }
+
+    // Groups with history: longest first onto the least loaded shard (lowest index wins ties)
+    Known.StableSort([](const TPair<const TArray<FNexusTest*>*, double>& A, const TPair<const TArray<FNexusTest*>*, double>& B)
+    {
+        return A.Value > B.Value;
+    });
+    for (const TPair<const TArray<FNexusTest*>*, double>& Entry : Known)
+    {
+        int32 Target = 0;
+        for (int32 i = 1; i < Spec.Count; ++i)
+        {
+            if (ShardLoad[i] < ShardLoad[Target])
+            {
+                Target = i;
+            }
+        }
+        ShardLoad[Target] += Entry.Value;
+        if (Target == Spec.Index)
+        {
+            Selected.Append(*Entry.Key);
+        }
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Shard %s owns %d of %d test(s) (predicted %.1fs, %d without history)"),
+        *Spec.ToString(), Selected.Num(), Sorted.Num(), ShardLoad[Spec.Index], Sorted.Num() - KnownCount);
+
+    return Selected;
+}
+
+FString FNexusSharding::GetShardResultsDir()
+{
+    return FPaths::ProjectSavedDir() / TEXT("NexusReports") / TEXT("shards");
+}
+
+FString FNexusSharding::WriteShardResults(const FNexusShardSpec& Spec)
+{
+    const FString ShardDir = GetShardResultsDir();
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*ShardDir);
+
+    TSharedPtr<FJsonObject> Root = MakeShareable(new FJsonObject());
+    Root->SetNumberField(TEXT("shard"), Spec.Index + 1);
+    Root->SetNumberField(TEXT("shard_count"), Spec.Count);
+    Root->SetStringField(TEXT("generated_at"), FDateTime::UtcNow().ToIso8601());
+
+    TArray<TSharedPtr<FJsonValue>> Tests;
+    for (const auto& Pair : FPalantirOracle::Get().GetAllTestResults())
+    {
+        const FPalantirTestResult& Result = Pair.Value;
+
+        TSharedPtr<FJsonObject> TestObj = MakeShareable(new FJsonObject());
+        TestObj->SetStringField(TEXT("name"), Pair.Key);
+        TestObj->SetBoolField(TEXT("passed"), Result.bPassed);
+        TestObj->SetBoolField(TEXT("skipped"), Result.bSkipped);
+        TestObj->SetBoolField(TEXT("timed_out"), Result.bTimedOut);
+        TestObj->SetBoolField(TEXT("cached"), Result.bCached);
+        TestObj->SetBoolField(TEXT("quarantined"), Result.bQuarantined);
+        TestObj->SetNumberField(TEXT("duration"), Result.Duration);
+        TestObj->SetNumberField(TEXT("priority"), Result.Priority);
+        TestObj->SetStringField(TEXT("error"), Result.ErrorMessage);
+
+        TArray<TSharedPtr<FJsonValue>> TagValues;
+        for (const FString& Tag : FPalantirObserver::GetTestTags(Pair.Key))
+        {
+            TagValues.Add(MakeShareable(new FJsonValueString(Tag)));
+        }
+        TestObj->SetArrayField(TEXT("tags"), TagValues);
+
+        TArray<TSharedPtr<FJsonValue>> ArtifactValues;
+        for (const FString& Artifact : FPalantirObserver::GetArtifacts(Pair.Key))
+        {
+            ArtifactValues.Add(MakeShareable(new FJsonValueString(Artifact)));
+        }
+        TestObj->SetArrayField(TEXT("artifacts"), ArtifactValues);
+
+        Tests.Add(MakeShareable(new FJsonValueObject(TestObj)));
+    }
+    Root->SetArrayField(TEXT("tests"), Tests);
+
+    FString JsonOutput;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonOutput);
+    FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+    const FString ShardPath = ShardDir / FString::Printf(TEXT("nexus-shard-%d-of-%d.json"), Spec.Index + 1, Spec.Count);
+    if (FFileHelper::SaveStringToFile(JsonOutput, *ShardPath))
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: Shard %s results written to %s"), *Spec.ToString(), *ShardPath);
+    }
+    else
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS: Failed to write shard results to %s"), *ShardPath);
+    }
+    return ShardPath;
+}
+
+int32 FNexusSharding::MergeShardResults(const FString& Directory)
+{
+    const FString ShardDir = Directory.IsEmpty() ? GetShardResultsDir() : Directory;
+
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *(ShardDir / TEXT("nexus-shard-*.json")), true, false);
+    Files.Sort();
+
+    UNexusCore::PassedTests = 0;
+    UNexusCore::FailedTests = 0;
+    UNexusCore::SkippedTests = 0;
+    UNexusCore::CriticalTests = 0;
+    UNexusCore::QuarantinedTests = 0;
+    UNexusCore::QuarantinedFailures = 0;
+    UNexusCore::TotalTests = 0;
+
+    int32 Merged = 0;
+    for (const FString& File : Files)
+    {
+        FString JsonContent;
+        TSharedPtr<FJsonObject> Root;
+        if (!FFileHelper::LoadFileToString(JsonContent, *(ShardDir / File)) ||
+            !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(JsonContent), Root) || !Root.IsValid())
+        {
+            UE_LOG(LogNexus, Warning, TEXT("NEXUS: Skipping unreadable shard file %s"), *File);
+            continue;
+        }
+
+        for (const TSharedPtr<FJsonValue>& Value : Root->GetArrayField(TEXT("tests")))
+        {
+            const TSharedPtr<FJsonObject> TestObj = Value->AsObject();
+            if (!TestObj.IsValid())
+            {
+                continue;
+            }
+
+            const FString Name = TestObj->GetStringField(TEXT("name"));
+            FPalantirTestResult Result;
+            Result.bPassed = TestObj->GetBoolField(TEXT("passed"));
+            Result.bSkipped = TestObj->GetBoolField(TEXT("skipped"));
+            TestObj->TryGetBoolField(TEXT("timed_out"), Result.bTimedOut);
+            TestObj->TryGetBoolField(TEXT("cached"), Result.bCached);
+            TestObj->TryGetBoolField(TEXT("quarantined"), Result.bQuarantined);
+            Result.Duration = TestObj->GetNumberField(TEXT("duration"));
+            Result.Priority = static_cast<uint8>(TestObj->GetIntegerField(TEXT("priority")));
+            Result.ErrorMessage = TestObj->GetStringField(TEXT("error"));
+
+            TArray<FString> Tags;
+            TestObj->TryGetStringArrayField(TEXT("tags"), Tags);
+            TArray<FString> Artifacts;
+            TestObj->TryGetStringArrayField(TEXT("artifacts"), Artifacts);
+
+            FPalantirObserver::RecordExternalResult(Name, Result, Tags, Artifacts);
+
+            ++UNexusCore::TotalTests;
+            if (Result.bSkipped) ++UNexusCore::SkippedTests;
+            else if (Result.bQuarantined) { ++UNexusCore::QuarantinedTests; UNexusCore::QuarantinedFailures += Result.bPassed ? 0 : 1; }
+            else if (Result.bPassed) ++UNexusCore::PassedTests;
+            else ++UNexusCore::FailedTests;
+            if ((Result.Priority & static_cast<uint8>(ETestPriority::Critical)) != 0) ++UNexusCore::CriticalTests;
+        }
+        ++Merged;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Merged %d shard file(s) from %s — %d test(s)"), Merged, *ShardDir, UNexusCore::TotalTests.load());
+    return Merged;
+}
@@ -0,0 +1,219 @@
+#include "NexusSymbolication.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformStackWalk.h"
+#include "HAL/PlatformProcess.h"
+#include "Containers/Queue.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+/**
+ * Background thread that drains queued frames into the address cache
+ */
+class FNexusSymbolicatorRunnable : public FRunnable
+{
+public:
+    static FNexusSymbolicatorRunnable& Get()
+    {
+        static FNexusSymbolicatorRunnable Instance;
+        return Instance;
+    }
+
+    void Enqueue(const TArray<uint64>& Frames)
+    {
+        if (Frames.Num() == 0)
+        {
+            return;
+        }
+
+        Pending.fetch_add(1);
+        Queue.Enqueue(Frames);
+        EnsureThread();
+        WorkEvent->Trigger();
+    }
+
+    void WaitForPending()
+    {
+        if (!HasThread())
+        {
+            // No thread on this platform (or shut down) - resolve on the caller instead
+            Drain();
+            return;
+        }
+        while (Pending.load() > 0)
+        {
+            IdleEvent->Wait(10);
+        }
+    }
+
+    TArray<FString> Symbolicate(const uint64* Frames, int32 NumFrames)
+    {
+        TArray<FString> Lines;
+        Lines.Reserve(NumFrames);
+
+        FScopeLock Lock(&CacheLock);
+        for (int32 Index = 0; Index < NumFrames && Frames[Index] != 0; ++Index)
+        {
+            Lines.Add(ResolveLocked(Index, Frames[Index]));
+        }
+        return Lines;
+    }
+
+    int32 GetCachedAddressCount()
+    {
+        FScopeLock Lock(&CacheLock);
+        return Cache.Num();
+    }
+
+    virtual uint32 Run() override
+    {
+        while (!bStopping.load())
+        {
+            WorkEvent->Wait(100);
+            Drain();
+        }
+        return 0;
+    }
+
+    virtual void Stop() override
+    {
+        bStopping = true;
+        WorkEvent->Trigger();
+    }
+
+    void Shutdown()
+    {
+        FRunnableThread* ToJoin = nullptr;
+        {
+            FScopeLock Lock(&ThreadLock);
+            ToJoin = Thread;
+            Thread = nullptr;
+        }
+        if (ToJoin)
+        {
+            ToJoin->Kill(true);
+            delete ToJoin;
+        }
+        bStopping = false;
+
+        Drain();
+        FScopeLock Lock(&CacheLock);
+        Cache.Empty();
+    }
+
+private:
+    FNexusSymbolicatorRunnable()
+    {
+        WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+        IdleEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    }
+
+    bool HasThread()
+    {
+        FScopeLock Lock(&ThreadLock);
+        return Thread != nullptr;
+    }
+
+    void EnsureThread()
+    {
+        FScopeLock Lock(&ThreadLock);
+        if (!Thread && FPlatformProcess::SupportsMultithreading())
+        {
+            Thread = FRunnableThread::Create(this, TEXT("NexusSymbolicator"), 0, TPri_BelowNormal);
+        }
+    }
+
+    void Drain()
+    {
+        FScopeLock DrainScope(&DrainLock);  // The queue allows a single consumer
+        TArray<uint64> Frames;
+        while (Queue.Dequeue(Frames))
+        {
+            {
+                FScopeLock Lock(&CacheLock);
+                for (int32 Index = 0; Index < Frames.Num() && Frames[Index] != 0; ++Index)
+                {
+                    ResolveLocked(Index, Frames[Index]);
+                }
+            }
+            Pending.fetch_sub(1);
+        }
+
+        IdleEvent->Trigger();
+    }
+
+    const FString& ResolveLocked(int32 CallDepth, uint64 ProgramCounter)
+    {
+        if (const FString* Cached = Cache.Find(ProgramCounter))
+        {
+            return *Cached;
+        }
+
+        if (!bSymbolsInitialized)
+        {
+            FPlatformStackWalk::InitStackWalking();
+            bSymbolsInitialized = true;
+        }
+
+        ANSICHAR Line[1024] = {};
+        FPlatformStackWalk::ProgramCounterToHumanReadableString(CallDepth, ProgramCounter, Line, sizeof(Line));
+        return Cache.Add(ProgramCounter, ANSI_TO_TCHAR(Line));
+    }
+
+    TQueue<TArray<uint64>, EQueueMode::Mpsc> Queue;
+    FCriticalSection DrainLock;
+    std::atomic<int32> Pending{0};
+    std::atomic<bool> bStopping{false};
+    FEvent* WorkEvent = nullptr;
+    FEvent* IdleEvent = nullptr;
+
+    FCriticalSection ThreadLock;
+    FRunnableThread* Thread = nullptr;
+
+    // Guards the cache and every call into the platform symbol engine
+    FCriticalSection CacheLock;
+    TMap<uint64, FString> Cache;
+    bool bSymbolsInitialized = false;
+};
+
+void FNexusSymbolicator::CaptureBackTrace(TArray<uint64>& OutFrames, int32 FramesToSkip)
+{
+    uint64 BackTrace[MaxFrames + 8] = {};
+    const int32 Depth = static_cast<int32>(FPlatformStackWalk::CaptureStackBackTrace(BackTrace, UE_ARRAY_COUNT(BackTrace)));
+
+    const int32 First = FMath::Clamp(FramesToSkip, 0, Depth);
+    const int32 Count = FMath::Min(Depth - First, MaxFrames);
+    OutFrames.Reset(Count);
+    OutFrames.Append(BackTrace + First, Count);
+}
+
+void FNexusSymbolicator::Enqueue(const TArray<uint64>& Frames)
+{
+    FNexusSymbolicatorRunnable::Get().Enqueue(Frames);
+}
+
+TArray<FString> FNexusSymbolicator::Symbolicate(const uint64* Frames, int32 NumFrames)
+{
+    return FNexusSymbolicatorRunnable::Get().Symbolicate(Frames, NumFrames);
+}
+
+TArray<FString> FNexusSymbolicator::Symbolicate(const TArray<uint64>& Frames)
+{
+    return Symbolicate(Frames.GetData(), Frames.Num());
+}
+
+void FNexusSymbolicator::WaitForPending()
+{
+    FNexusSymbolicatorRunnable::Get().WaitForPending();
+}
+
+int32 FNexusSymbolicator::GetCachedAddressCount()
+{
+    return FNexusSymbolicatorRunnable::Get().GetCachedAddressCount();
+}
+
+void FNexusSymbolicator::Shutdown()
+{
+    FNexusSymbolicatorRunnable::Get().Shutdown();
+}
@@ -0,0 +1,124 @@
+#include "NexusTestDescriptor.h"
+#include "NexusTest.h"
+#include "Misc/ScopeLock.h"
+
+// Constant-initialized, so descriptors of any module can link in before this file's dynamic initializers run.
+// Registration only pushes onto the head; the list is newest first and read back in reverse.
+static std::atomic<FNexusTestDescriptor*> GNexusDescriptorHead{nullptr};
+static std::atomic<int32> GNexusDescriptorCount{0};
+
+// Serializes MaterializeAll against unlinking at module unload; registration never takes it.
+// Constructed on first use, so it outlives every descriptor destroyed at unload.
+static FCriticalSection& GetNexusDescriptorLock()
+{
+    static FCriticalSection Lock;
+    return Lock;
+}
+
+/** Push Node onto an intrusive newest-first list (Node is not visible to readers until the swap succeeds) */
+template<typename NodeType>
+void FNexusTestDescriptor::PushFront(std::atomic<NodeType*>& Head, NodeType* Node)
+{
+    Node->Next = Head.load(std::memory_order_relaxed);
+    while (!Head.compare_exchange_weak(Node->Next, Node, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * Unlink Node; call with the descriptor lock held
+ * Statics are destroyed in reverse order of construction, so a module unloading finds its nodes at the head.
+ */
+template<typename NodeType>
+void FNexusTestDescriptor::Unlink(std::atomic<NodeType*>& Head, NodeType* Node)
+{
+    NodeType* Expected = Node;
+    if (Head.compare_exchange_strong(Expected, Node->Next, std::memory_order_acq_rel))
+    {
+        return;
+    }
+
+    // Something was pushed after Node (or modules unload out of order); only pushes touch the head, never Next
+    for (NodeType* Prev = Head.load(std::memory_order_acquire); Prev; Prev = Prev->Next)
+    {
+        if (Prev->Next == Node)
+        {
+            Prev->Next = Node->Next;
+            return;
+        }
+    }
+}
+
+FNexusTestDescriptor::FNexusTestDescriptor(const TCHAR* InName, FCreateFunc InCreate)
+    : Name(InName)
+    , Create(InCreate)
+{
+    PushFront(GNexusDescriptorHead, this);
+    GNexusDescriptorCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+FNexusTestDescriptor::~FNexusTestDescriptor()
+{
+    // The test object (if any) stays in FNexusTest::AllTests like the static objects the macros used to define
+    FScopeLock Lock(&GetNexusDescriptorLock());
+    Unlink(GNexusDescriptorHead, this);
+    GNexusDescriptorCount.fetch_sub(1, std::memory_order_relaxed);
+}
+
+int32 FNexusTestDescriptor::Num()
+{
+    return GNexusDescriptorCount.load(std::memory_order_relaxed);
+}
+
+int32 FNexusTestDescriptor::MaterializeAll()
+{
+    FScopeLock Lock(&GetNexusDescriptorLock());
+
+    // Oldest first, so tests are created (and discovered) in registration order
+    TArray<FNexusTestDescriptor*, TInlineAllocator<64>> Descriptors;
+    for (FNexusTestDescriptor* Descriptor = GNexusDescriptorHead.load(std::memory_order_acquire); Descriptor; Descriptor = Descriptor->Next)
+    {
+        Descriptors.Add(Descriptor);
+    }
+
+    int32 Created = 0;
+    TArray<FNexusTestAttribute*, TInlineAllocator<8>> Attributes;
+    for (int32 Index = Descriptors.Num() - 1; Index >= 0; --Index)
+    {
+        FNexusTestDescriptor* Descriptor = Descriptors[Index];
+        if (!Descriptor->Instance)
+        {
+            Descriptor->Instance = Descriptor->Create();  // Adds itself to FNexusTest::AllTests
+            ++Created;
+        }
+
+        Attributes.Reset();
+        for (FNexusTestAttribute* Attribute = Descriptor->Attributes.load(std::memory_order_acquire); Attribute; Attribute = Attribute->Next)
+        {
+            Attributes.Add(Attribute);
+        }
+        for (int32 AttributeIndex = Attributes.Num() - 1; AttributeIndex >= 0; --AttributeIndex)
+        {
+            FNexusTestAttribute* Attribute = Attributes[AttributeIndex];
+            if (!Attribute->bApplied)
+            {
+                Attribute->Apply(*Descriptor->Instance);
+                Attribute->bApplied = true;
+            }
+        }
+    }
+    return Created;
+}
+
+FNexusTestAttribute::FNexusTestAttribute(FNexusTestDescriptor& InTest, FApplyFunc InApply)
+    : Test(InTest)
+    , Apply(InApply)
+{
+    FNexusTestDescriptor::PushFront(Test.Attributes, this);
+}
+
+FNexusTestAttribute::~FNexusTestAttribute()
+{
+    FScopeLock Lock(&GetNexusDescriptorLock());
+    FNexusTestDescriptor::Unlink(Test.Attributes, this);
+}
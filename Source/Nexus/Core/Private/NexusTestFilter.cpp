@@ -0,0 +1,551 @@
+#include "NexusTestFilter.h"
+#include "NexusTest.h"
+#include "NexusTestRegistry.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+struct FNexusTagFlagName
+{
+    const TCHAR* Name;
+    ETestTag Flag;
+};
+
+static const FNexusTagFlagName GNexusTagFlagNames[] =
+{
+    { TEXT("Networking"), ETestTag::Networking },
+    { TEXT("Performance"), ETestTag::Performance },
+    { TEXT("Gameplay"), ETestTag::Gameplay },
+    { TEXT("Compliance"), ETestTag::Compliance },
+    { TEXT("Integration"), ETestTag::Integration },
+    { TEXT("Stress"), ETestTag::Stress },
+    { TEXT("Editor"), ETestTag::Editor },
+    { TEXT("Rendering"), ETestTag::Rendering }
+};
+
+static bool IsOperatorChar(TCHAR C)
+{
+    return C == TEXT('(') || C == TEXT(')') || C == TEXT('!') || C == TEXT('&') || C == TEXT('|');
+}
+
+/**
+ * Recursive-descent parser emitting the filter's postfix program
+ */
+class FNexusTestFilterParser
+{
+public:
+    FNexusTestFilterParser(const FString& InText, FNexusTestFilter& InFilter)
+        : Text(InText)
+        , Filter(InFilter)
+    {
+    }
+
+    bool Parse(FString& OutError)
+    {
+        if (!ParseOr())
+        {
+            OutError = Error;
+            return false;
+        }
+        SkipWhitespace();
+        if (Pos < Text.Len())
+        {
+            OutError = FString::Printf(TEXT("Unexpected '%c' at position %d"), Text[Pos], Pos + 1);
+            return false;
+        }
+        return true;
+    }
+
+private:
+    bool ParseOr()
+    {
+        if (!ParseAnd())
+        {
+            return false;
+        }
+        while (Consume(TEXT("||")))
+        {
+            if (!ParseAnd())
+            {
+                return false;
+            }
+            Emit(FNexusTestFilter::EOp::Or);
+        }
+        return true;
+    }
+
+    bool ParseAnd()
+    {
+        if (!ParseUnary())
+        {
+            return false;
+        }
+        while (Consume(TEXT("&&")))
+        {
+            if (!ParseUnary())
+            {
+                return false;
+            }
+            Emit(FNexusTestFilter::EOp::And);
+        }
+        return true;
+    }
+
+    bool ParseUnary()
+    {
+        if (Consume(TEXT("!")))
+        {
+            if (!ParseUnary())
+            {
+                return false;
+            }
+            Emit(FNexusTestFilter::EOp::Not);
+            return true;
+        }
+        if (Consume(TEXT("(")))
+        {
+            if (!ParseOr())
+            {
+                return false;
+            }
+            if (!Consume(TEXT(")")))
+            {
+                return Fail(TEXT("Expected ')'"));
+            }
+            return true;
+        }
+        return ParseAtom();
+    }
+
+    bool ParseAtom()
+    {
+        SkipWhitespace();
+        const int32 Start = Pos;
+
+        FString Key;
+        FString Value;
+        bool bRegex = false;
+        const int32 Colon = Text.Find(TEXT(":"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Pos);
+        if (Colon != INDEX_NONE && IsKey(Text.Mid(Pos, Colon - Pos)))
+        {
+            Key = Text.Mid(Pos, Colon - Pos).ToLower();
+            Pos = Colon + 1;
+            bRegex = Key == TEXT("name") && Pos < Text.Len() && Text[Pos] == TEXT('/');
+        }
+
+        if (bRegex)
+        {
+            if (!ReadDelimited(TEXT('/'), Value))
+            {
+                return Fail(TEXT("Unterminated /regex/"));
+            }
+        }
+        else if (Pos < Text.Len() && Text[Pos] == TEXT('"'))
+        {
+            if (!ReadDelimited(TEXT('"'), Value))
+            {
+                return Fail(TEXT("Unterminated quoted value"));
+            }
+        }
+        else
+        {
+            while (Pos < Text.Len() && !FChar::IsWhitespace(Text[Pos]) && !IsOperatorChar(Text[Pos]))
+            {
+                Value.AppendChar(Text[Pos++]);
+            }
+        }
+
+        if (Value.IsEmpty())
+        {
+            Pos = Start;
+            return Fail(Key.IsEmpty() ? TEXT("Expected a tag:, name: or priority: term") : TEXT("Expected a value"));
+        }
+
+        FNexusTestFilter::FInstruction Instruction;
+        if (Key == TEXT("tag"))
+        {
+            FNexusTestFilter::FTagOperand Tag;
+            Tag.Tag = Value;
+            for (const FNexusTagFlagName& Entry : GNexusTagFlagNames)
+            {
+                if (Value.Equals(Entry.Name, ESearchCase::IgnoreCase))
+                {
+                    Tag.EnumFlag = static_cast<uint8>(Entry.Flag);
+                }
+            }
+            Instruction.Op = FNexusTestFilter::EOp::Tag;
+            Instruction.Operand = Filter.Tags.Add(Tag);
+        }
+        else if (Key == TEXT("priority"))
+        {
+            Instruction.Op = FNexusTestFilter::EOp::Priority;
+            if (Value.Equals(TEXT("Critical"), ESearchCase::IgnoreCase)) Instruction.Operand = static_cast<int32>(ETestPriority::Critical);
+            else if (Value.Equals(TEXT("Smoke"), ESearchCase::IgnoreCase)) Instruction.Operand = static_cast<int32>(ETestPriority::Smoke);
+            else if (Value.Equals(TEXT("OnlineOnly"), ESearchCase::IgnoreCase)) Instruction.Operand = static_cast<int32>(ETestPriority::OnlineOnly);
+            else if (Value.Equals(TEXT("Normal"), ESearchCase::IgnoreCase)) Instruction.Operand = 0;
+            else
+            {
+                Pos = Start;
+                return Fail(FString::Printf(TEXT("Unknown priority '%s'"), *Value));
+            }
+        }
+        else if (bRegex)
+        {
+            Instruction.Op = FNexusTestFilter::EOp::NameRegex;
+            Instruction.Operand = Filter.Regexes.Add(FRegexPattern(Value, ERegexPatternFlags::CaseInsensitive));
+        }
+        else
+        {
+            Instruction.Op = FNexusTestFilter::EOp::NameGlob;
+            Instruction.Operand = Filter.Globs.Add(FNexusTestFilter::FGlob::Compile(Value));
+        }
+        Filter.Program.Add(Instruction);
+        return true;
+    }
+
+    static bool IsKey(const FString& Candidate)
+    {
+        return Candidate.Equals(TEXT("tag"), ESearchCase::IgnoreCase)
+            || Candidate.Equals(TEXT("name"), ESearchCase::IgnoreCase)
+            || Candidate.Equals(TEXT("priority"), ESearchCase::IgnoreCase);
+    }
+
+    /** Read from the opening Delimiter at Pos to the next unescaped one */
+    bool ReadDelimited(TCHAR Delimiter, FString& OutValue)
+    {
+        ++Pos;
+        while (Pos < Text.Len())
+        {
+            const TCHAR C = Text[Pos++];
+            if (C == Delimiter)
+            {
+                return true;
+            }
+            if (C == TEXT('\\') && Pos < Text.Len() && Text[Pos] == Delimiter)
+            {
+                OutValue.AppendChar(Text[Pos++]);
+                continue;
+            }
+            OutValue.AppendChar(C);
+        }
+        return false;
+    }
+
+    bool Consume(const TCHAR* Token)
+    {
+        SkipWhitespace();
+        const int32 Len = FCString::Strlen(Token);
+        if (Pos + Len <= Text.Len() && FCString::Strncmp(*Text + Pos, Token, Len) == 0)
+        {
+            Pos += Len;
+            return true;
+        }
+        return false;
+    }
+
+    void SkipWhitespace()
+    {
+        while (Pos < Text.Len() && FChar::IsWhitespace(Text[Pos]))
+        {
+            ++Pos;
+        }
+    }
+
+    void Emit(FNexusTestFilter::EOp Op)
+    {
+        FNexusTestFilter::FInstruction Instruction;
+        Instruction.Op = Op;
+        Filter.Program.Add(Instruction);
+    }
+
+    bool Fail(const FString& Message)
+    {
+        if (Error.IsEmpty())
+        {
+            Error = FString::Printf(TEXT("%s at position %d"), *Message, Pos + 1);
+        }
+        return false;
+    }
+
+    const FString& Text;
+    FNexusTestFilter& Filter;
+    int32 Pos = 0;
+    FString Error;
+};
+
+const TCHAR* FNexusTestFilter::OptInTag = TEXT("Benchmark");
+
+bool FNexusTestFilter::Compile(const FString& InExpression, FNexusTestFilter& OutFilter, FString& OutError)
+{
+    OutFilter = FNexusTestFilter();
+    OutFilter.Expression = InExpression.TrimStartAndEnd();
+    if (OutFilter.Expression.IsEmpty())
+    {
+        return true;
+    }
+
+    FNexusTestFilterParser Parser(OutFilter.Expression, OutFilter);
+    if (!Parser.Parse(OutError))
+    {
+        OutFilter = FNexusTestFilter();
+        return false;
+    }
+    return true;
+}
+
+FNexusTestFilter FNexusTestFilter::FromTags(ETestTag InTags)
+{
+    TArray<FString> Terms;
+    for (const FNexusTagFlagName& Entry : GNexusTagFlagNames)
+    {
+        if (NexusHasTag(InTags, Entry.Flag))
+        {
+            Terms.Add(FString::Printf(TEXT("tag:%s"), Entry.Name));
+        }
+    }
+
+    FNexusTestFilter Filter;
+    FString Error;
+    Compile(FString::Join(Terms, TEXT(" || ")), Filter, Error);
+    return Filter;
+}
+
+bool FNexusTestFilter::ParseFromArgs(const TArray<FString>& Args, FString& OutExpression)
+{
+    // Console arguments arrive split on whitespace, so the expression runs on until the next -Switch
+    for (int32 Index = 0; Index < Args.Num(); ++Index)
+    {
+        FString Value;
+        if (FParse::Value(*Args[Index], TEXT("NexusFilter="), Value, false))
+        {
+            for (int32 Rest = Index + 1; Rest < Args.Num() && !Args[Rest].StartsWith(TEXT("-")); ++Rest)
+            {
+                Value += TEXT(" ") + Args[Rest];
+            }
+            OutExpression = Value.TrimQuotes();
+            return !OutExpression.IsEmpty();
+        }
+    }
+    return FParse::Value(FCommandLine::Get(), TEXT("NexusFilter="), OutExpression, false) && !OutExpression.IsEmpty();
+}
+
+bool FNexusTestFilter::Matches(const FNexusTest& Test) const
+{
+    if (IsEmpty())
+    {
+        return true;
+    }
+
+    TArray<bool, TInlineAllocator<16>> Stack;
+    for (const FInstruction& Instruction : Program)
+    {
+        switch (Instruction.Op)
+        {
+        case EOp::Not:
+            Stack.Last() = !Stack.Last();
+            break;
+        case EOp::And:
+        {
+            const bool bRight = Stack.Pop(EAllowShrinking::No);
+            Stack.Last() = Stack.Last() && bRight;
+            break;
+        }
+        case EOp::Or:
+        {
+            const bool bRight = Stack.Pop(EAllowShrinking::No);
+            Stack.Last() = Stack.Last() || bRight;
+            break;
+        }
+        default:
+            Stack.Add(EvaluateAtom(Instruction, Test));
+            break;
+        }
+    }
+    return Stack.Num() == 1 && Stack[0];
+}
+
+TArray<FNexusTest*> FNexusTestFilter::Select(const TArray<FNexusTest*>& Tests) const
+{
+    if (IsEmpty())
+    {
+        return Tests;
+    }
+
+    // Resolve IDs first: tests that were never discovered are interned now, so the ID space is final
+    TArray<FNexusTestId> Ids;
+    Ids.Reserve(Tests.Num());
+    for (const FNexusTest* Test : Tests)
+    {
+        Ids.Add(Test ? Test->GetId() : INDEX_NONE);
+    }
+
+    FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
+    const int32 NumIds = Registry.Num();
+
+    TArray<TBitArray<>, TInlineAllocator<16>> Stack;
+    for (const FInstruction& Instruction : Program)
+    {
+        switch (Instruction.Op)
+        {
+        case EOp::Not:
+            Stack.Last().BitwiseNOT();
+            break;
+        case EOp::And:
+        {
+            const TBitArray<> Right = Stack.Pop(EAllowShrinking::No);
+            Stack.Last().CombineWithBitwiseAND(Right, EBitwiseOperatorFlags::MaxSize);
+            break;
+        }
+        case EOp::Or:
+        {
+            const TBitArray<> Right = Stack.Pop(EAllowShrinking::No);
+            Stack.Last().CombineWithBitwiseOR(Right, EBitwiseOperatorFlags::MaxSize);
+            break;
+        }
+        case EOp::Tag:
+        {
+            const FTagOperand& Tag = Tags[Instruction.Operand];
+            TBitArray<> Bits = Registry.GetTagBits(Tag.Tag);
+            Bits.SetNum(NumIds, false);
+            if (Tag.EnumFlag != 0)
+            {
+                for (int32 Index = 0; Index < Tests.Num(); ++Index)
+                {
+                    if (Ids[Index] != INDEX_NONE && (static_cast<uint8>(Tests[Index]->Tags) & Tag.EnumFlag) != 0)
+                    {
+                        Bits[Ids[Index]] = true;
+                    }
+                }
+            }
+            Stack.Add(MoveTemp(Bits));
+            break;
+        }
+        default:
+        {
+            TBitArray<> Bits(false, NumIds);
+            for (int32 Index = 0; Index < Tests.Num(); ++Index)
+            {
+                if (Ids[Index] != INDEX_NONE && EvaluateAtom(Instruction, *Tests[Index]))
+                {
+                    Bits[Ids[Index]] = true;
+                }
+            }
+            Stack.Add(MoveTemp(Bits));
+            break;
+        }
+        }
+    }
+
+    TArray<FNexusTest*> Selected;
+    if (Stack.Num() != 1)
+    {
+        return Selected;
+    }
+    for (int32 Index = 0; Index < Tests.Num(); ++Index)
+    {
+        if (Ids[Index] != INDEX_NONE && Stack[0][Ids[Index]])
+        {
+            Selected.Add(Tests[Index]);
+        }
+    }
+    return Selected;
+}
+
+TArray<FNexusTest*> FNexusTestFilter::SelectForRun(const TArray<FNexusTest*>& Tests) const
+{
+    TArray<FNexusTest*> Selected = Select(Tests);
+    const bool bNamesOptIn = Tags.ContainsByPredicate([](const FTagOperand& Operand) { return Operand.Tag.Equals(OptInTag, ESearchCase::IgnoreCase); });
+    if (!bNamesOptIn)
+    {
+        Selected.RemoveAll([](const FNexusTest* Test) { return Test && Test->HasCustomTag(OptInTag); });
+    }
+    return Selected;
+}
+
+bool FNexusTestFilter::EvaluateAtom(const FInstruction& Instruction, const FNexusTest& Test) const
+{
+    switch (Instruction.Op)
+    {
+    case EOp::Tag:
+    {
+        const FTagOperand& Tag = Tags[Instruction.Operand];
+        return Test.HasCustomTag(Tag.Tag) || (static_cast<uint8>(Test.Tags) & Tag.EnumFlag) != 0;
+    }
+    case EOp::NameGlob:
+        return Globs[Instruction.Operand].Matches(Test.TestName);
+    case EOp::NameRegex:
+    {
+        FRegexMatcher Matcher(Regexes[Instruction.Operand], Test.TestName);
+        return Matcher.FindNext();
+    }
+    case EOp::Priority:
+        return Instruction.Operand == 0
+            ? Test.Priority == ETestPriority::Normal
+            : (static_cast<int32>(Test.Priority) & Instruction.Operand) != 0;
+    default:
+        return false;
+    }
+}
+
+FNexusTestFilter::FGlob FNexusTestFilter::FGlob::Compile(const FString& Pattern)
+{
+    FGlob Glob;
+    Pattern.ParseIntoArray(Glob.Segments, TEXT("*"), false);
+    Glob.bHasStar = Glob.Segments.Num() > 1;
+    return Glob;
+}
+
+/** Segment equals Name at Offset, '?' matching any character, ignoring case */
+static bool NexusGlobSegmentAt(const FString& Name, int32 Offset, const FString& Segment)
+{
+    if (Offset < 0 || Offset + Segment.Len() > Name.Len())
+    {
+        return false;
+    }
+    for (int32 Index = 0; Index < Segment.Len(); ++Index)
+    {
+        const TCHAR P = Segment[Index];
+        if (P != TEXT('?') && FChar::ToLower(P) != FChar::ToLower(Name[Offset + Index]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FNexusTestFilter::FGlob::Matches(const FString& Name) const
+{
+    if (!bHasStar)
+    {
+        return Segments.Num() == 1 && Segments[0].Len() == Name.Len() && NexusGlobSegmentAt(Name, 0, Segments[0]);
+    }
+
+    // Anchored prefix and suffix; the middle segments are found leftmost-first, which is optimal for '*'
+    const FString& Prefix = Segments[0];
+    const FString& Suffix = Segments.Last();
+    if (Prefix.Len() + Suffix.Len() > Name.Len() || !NexusGlobSegmentAt(Name, 0, Prefix) || !NexusGlobSegmentAt(Name, Name.Len() - Suffix.Len(), Suffix))
+    {
+        return false;
+    }
+
+    int32 Cursor = Prefix.Len();
+    const int32 End = Name.Len() - Suffix.Len();
+    for (int32 SegmentIndex = 1; SegmentIndex < Segments.Num() - 1; ++SegmentIndex)
+    {
+        const FString& Segment = Segments[SegmentIndex];
+        bool bFound = false;
+        for (; Cursor + Segment.Len() <= End; ++Cursor)
+        {
+            if (NexusGlobSegmentAt(Name, Cursor, Segment))
+            {
+                bFound = true;
+                break;
+            }
+        }
+        if (!bFound)
+        {
+            return false;
+        }
+        Cursor += Segment.Len();
+    }
+    return true;
+}
@@ -0,0 +1,271 @@
+#include "NexusTestGraph.h"
+#include "NexusTest.h"
+#include "NexusModule.h"
+#include "NexusCore.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
+
+void FNexusTestGraph::Build(const TArray<FNexusTest*>& Tests)
+{
+    Nodes.Reset();
+    NodeIndex.Reset();
+    TopologicalOrder.Reset();
+    Unreachable.Reset();
+    bHasEdges = false;
+
+    TMap<FString, int32> NameIndex;
+    for (FNexusTest* Test : Tests)
+    {
+        if (!Test || NameIndex.Contains(Test->TestName))
+        {
+            continue;
+        }
+        TUniquePtr<FNode> Node = MakeUnique<FNode>();
+        Node->Test = Test;
+        NameIndex.Add(Test->TestName, Nodes.Num());
+        NodeIndex.Add(Test, Nodes.Num());
+        Nodes.Add(MoveTemp(Node));
+    }
+
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        FNode& Node = *Nodes[i];
+        for (const FString& PrerequisiteName : Node.Test->Prerequisites)
+        {
+            const int32* Prerequisite = NameIndex.Find(PrerequisiteName);
+            if (!Prerequisite)
+            {
+                UE_LOG(LogNexus, Display, TEXT("NEXUS: %s depends on %s, which is not part of this run — ignoring"),
+                    *Node.Test->TestName, *PrerequisiteName);
+                continue;
+            }
+            Node.Prerequisites.Add(*Prerequisite);
+            Nodes[*Prerequisite]->Dependents.Add(i);
+            bHasEdges = true;
+        }
+        Node.RemainingPrerequisites.store(Node.Prerequisites.Num());
+    }
+
+    // Kahn's algorithm, always taking the earliest ready node so priority order survives where deps allow
+    TArray<int32> InDegree;
+    InDegree.SetNumUninitialized(Nodes.Num());
+    TArray<int32> Ready;
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        InDegree[i] = Nodes[i]->Prerequisites.Num();
+        if (InDegree[i] == 0)
+        {
+            Ready.HeapPush(i, TGreater<int32>());
+        }
+    }
+
+    TBitArray<> Visited(false, Nodes.Num());
+    while (Ready.Num() > 0)
+    {
+        int32 Index = INDEX_NONE;
+        Ready.HeapPop(Index, TGreater<int32>(), EAllowShrinking::No);
+        Visited[Index] = true;
+        TopologicalOrder.Add(Nodes[Index]->Test);
+
+        for (int32 Dependent : Nodes[Index]->Dependents)
+        {
+            if (--InDegree[Dependent] == 0)
+            {
+                Ready.HeapPush(Dependent, TGreater<int32>());
+            }
+        }
+    }
+
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        if (!Visited[i])
+        {
+            Nodes[i]->State.store(static_cast<uint8>(ENodeState::Skipped));
+            Unreachable.Add(Nodes[i]->Test);
+            UE_LOG(LogNexus, Error, TEXT("NEXUS: %s is on (or depends on) a dependency cycle — it will be skipped"), *Nodes[i]->Test->TestName);
+        }
+    }
+}
+
+int32 FNexusTestGraph::FindNode(const FNexusTest* Test) const
+{
+    const int32* Index = NodeIndex.Find(Test);
+    return Index ? *Index : INDEX_NONE;
+}
+
+TArray<TArray<FNexusTest*>> FNexusTestGraph::GetConnectedGroups() const
+{
+    // Union-find over dependency edges
+    TArray<int32> Parent;
+    Parent.SetNumUninitialized(Nodes.Num());
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        Parent[i] = i;
+    }
+
+    auto FindRoot = [&Parent](int32 Index)
+    {
+        while (Parent[Index] != Index)
+        {
+            Parent[Index] = Parent[Parent[Index]];
+            Index = Parent[Index];
+        }
+        return Index;
+    };
+
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        for (int32 Prerequisite : Nodes[i]->Prerequisites)
+        {
+            const int32 A = FindRoot(i);
+            const int32 B = FindRoot(Prerequisite);
+            if (A != B)
+            {
+                Parent[FMath::Max(A, B)] = FMath::Min(A, B);
+            }
+        }
+    }
+
+    TArray<TArray<FNexusTest*>> Groups;
+    TMap<int32, int32> GroupOfRoot;
+    for (int32 i = 0; i < Nodes.Num(); ++i)
+    {
+        const int32 Root = FindRoot(i);
+        int32* Group = GroupOfRoot.Find(Root);
+        if (!Group)
+        {
+            Group = &GroupOfRoot.Add(Root, Groups.Num());
+            Groups.AddDefaulted();
+        }
+        Groups[*Group].Add(Nodes[i]->Test);
+    }
+    return Groups;
+}
+
+bool FNexusTestGraph::HasPrerequisites(const FNexusTest* Test) const
+{
+    const int32 Index = FindNode(Test);
+    return Index != INDEX_NONE && Nodes[Index]->Prerequisites.Num() > 0;
+}
+
+bool FNexusTestGraph::HasDependents(const FNexusTest* Test) const
+{
+    const int32 Index = FindNode(Test);
+    return Index != INDEX_NONE && Nodes[Index]->Dependents.Num() > 0;
+}
+
+bool FNexusTestGraph::ShouldAbortRun(const FNexusTest* Failed, const FNexusTestGraph* Graph)
+{
+    return Failed && !Failed->bQuarantined && NexusHasFlag(Failed->Priority, ETestPriority::Critical)
+        && !(Graph && Graph->HasDependents(Failed));
+}
+
+TArray<FNexusTest*> FNexusTestGraph::GetPrerequisites(const FNexusTest* Test) const
+{
+    TArray<FNexusTest*> Out;
+    const int32 Index = FindNode(Test);
+    if (Index != INDEX_NONE)
+    {
+        for (int32 Prerequisite : Nodes[Index]->Prerequisites)
+        {
+            Out.Add(Nodes[Prerequisite]->Test);
+        }
+    }
+    return Out;
+}
+
+bool FNexusTestGraph::IsReady(const FNexusTest* Test) const
+{
+    const int32 Index = FindNode(Test);
+    if (Index == INDEX_NONE)
+    {
+        return true;
+    }
+    const FNode& Node = *Nodes[Index];
+    return Node.RemainingPrerequisites.load() == 0 && Node.State.load() == static_cast<uint8>(ENodeState::Waiting);
+}
+
+bool FNexusTestGraph::IsSkipped(const FNexusTest* Test) const
+{
+    const int32 Index = FindNode(Test);
+    return Index != INDEX_NONE && Nodes[Index]->State.load() == static_cast<uint8>(ENodeState::Skipped);
+}
+
+TArray<FNexusTest*> FNexusTestGraph::MarkPassed(const FNexusTest* Test)
+{
+    TArray<FNexusTest*> Released;
+    const int32 Index = FindNode(Test);
+    if (Index == INDEX_NONE)
+    {
+        return Released;
+    }
+
+    FNode& Node = *Nodes[Index];
+    Node.State.store(static_cast<uint8>(ENodeState::Passed));
+    for (int32 DependentIndex : Node.Dependents)
+    {
+        FNode& Dependent = *Nodes[DependentIndex];
+        // A failed prerequisite never decrements, so reaching zero means every prerequisite passed
+        if (Dependent.RemainingPrerequisites.fetch_sub(1) == 1 &&
+            Dependent.State.load() == static_cast<uint8>(ENodeState::Waiting))
+        {
+            Released.Add(Dependent.Test);
+        }
+    }
+    return Released;
+}
+
+TArray<FNexusTest*> FNexusTestGraph::MarkFailed(const FNexusTest* Test)
+{
+    TArray<FNexusTest*> Skipped;
+    const int32 Index = FindNode(Test);
+    if (Index == INDEX_NONE)
+    {
+        return Skipped;
+    }
+
+    uint8 Expected = static_cast<uint8>(ENodeState::Waiting);
+    Nodes[Index]->State.compare_exchange_strong(Expected, static_cast<uint8>(ENodeState::Failed));
+
+    TArray<int32> Stack = Nodes[Index]->Dependents;
+    while (Stack.Num() > 0)
+    {
+        FNode& Dependent = *Nodes[Stack.Pop(EAllowShrinking::No)];
+        uint8 Waiting = static_cast<uint8>(ENodeState::Waiting);
+        // First failure to reach a node claims it, so each downstream test is skipped once
+        if (Dependent.State.compare_exchange_strong(Waiting, static_cast<uint8>(ENodeState::Skipped)))
+        {
+            Skipped.Add(Dependent.Test);
+            Stack.Append(Dependent.Dependents);
+        }
+    }
+    return Skipped;
+}
+
+bool FNexusTestGraph::TrySkip(const FNexusTest* Test)
+{
+    const int32 Index = FindNode(Test);
+    if (Index == INDEX_NONE)
+    {
+        return true;
+    }
+
+    uint8 Waiting = static_cast<uint8>(ENodeState::Waiting);
+    return Nodes[Index]->State.compare_exchange_strong(Waiting, static_cast<uint8>(ENodeState::Skipped));
+}
+
+TArray<FNexusTest*> FNexusTestGraph::SkipDependentsOf(const FNexusTest* Cause)
+{
+    TArray<FNexusTest*> Skipped = MarkFailed(Cause);
+    for (FNexusTest* Test : Skipped)
+    {
+        Test->LastResult = FNexusTestResult();
+        Test->LastResult.TestName = Test->TestName;
+        Test->LastResult.bSkipped = true;
+        Test->LastResult.ErrorMessage = FString::Printf(TEXT("Prerequisite %s did not pass"), *Cause->TestName);
+
+        UE_LOG(LogNexus, Warning, TEXT("Skipping test %s — prerequisite %s did not pass"), *Test->TestName, *Cause->TestName);
+        UNexusCore::NotifyTestSkipped(Test->TestName);
+        FPalantirObserver::OnTestSkipped(Test->GetId());
+    }
+    return Skipped;
+}
@@ -0,0 +1,204 @@
+#include "NexusTestRegistry.h"
+#include "NexusTest.h"
+#include "Misc/ScopeRWLock.h"
+
+FNexusTestRegistry& FNexusTestRegistry::Get()
+{
+    static FNexusTestRegistry Instance;
+    return Instance;
+}
+
+FNexusTestId FNexusTestRegistry::Register(FNexusTest* Test)
+{
+    if (!Test)
+    {
+        return INDEX_NONE;
+    }
+
+    FWriteScopeLock WriteLock(Lock);
+    if (Tests.IsValidIndex(Test->TestId) && Tests[Test->TestId] == Test)
+    {
+        return Test->TestId;
+    }
+
+    const FName Name(*Test->TestName);
+    const FNexusTestId* Existing = IdsByName.Find(Name);
+    const FNexusTestId Id = Existing ? *Existing : AddIdLocked(Name);
+    if (Tests[Id] && Tests[Id] != Test)
+    {
+        return Id;  // Duplicate registration; the first test keeps the name
+    }
+
+    // Names reported before discovery (e.g. by a shard file) adopt the test object here
+    Tests[Id] = Test;
+    Test->TestId = Id;
+    for (const FString& Tag : Test->GetCustomTags())
+    {
+        SetTagLocked(Id, FName(*Tag));
+    }
+    return Id;
+}
+
+FNexusTestId FNexusTestRegistry::FindOrAddId(const FString& Name)
+{
+    const FNexusTestId Known = FindId(Name);
+    if (Known != INDEX_NONE)
+    {
+        return Known;
+    }
+
+    const FName Interned(*Name);
+    FWriteScopeLock WriteLock(Lock);
+    if (const FNexusTestId* Existing = IdsByName.Find(Interned))
+    {
+        return *Existing;  // Interned by another thread in between
+    }
+    return AddIdLocked(Interned);
+}
+
+FNexusTestId FNexusTestRegistry::FindId(const FString& Name) const
+{
+    // FNAME_Find: looking up an unknown name must not grow the name table
+    const FName Existing(*Name, FNAME_Find);
+    if (Existing.IsNone())
+    {
+        return INDEX_NONE;
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    const FNexusTestId* Id = IdsByName.Find(Existing);
+    return Id ? *Id : INDEX_NONE;
+}
+
+FNexusTest* FNexusTestRegistry::GetTest(FNexusTestId Id) const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Tests.IsValidIndex(Id) ? Tests[Id] : nullptr;
+}
+
+FName FNexusTestRegistry::GetName(FNexusTestId Id) const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Names.IsValidIndex(Id) ? Names[Id] : NAME_None;
+}
+
+int32 FNexusTestRegistry::Num() const
+{
+    FReadScopeLock ReadLock(Lock);
+    return Names.Num();
+}
+
+void FNexusTestRegistry::AddTag(FNexusTestId Id, const FString& Tag)
+{
+    if (Tag.IsEmpty())
+    {
+        return;
+    }
+
+    const FName TagName(*Tag);
+    FWriteScopeLock WriteLock(Lock);
+    if (!Names.IsValidIndex(Id))
+    {
+        return;
+    }
+
+    SetTagLocked(Id, TagName);
+}
+
+bool FNexusTestRegistry::HasTag(FNexusTestId Id, const FString& Tag) const
+{
+    const FName TagName(*Tag, FNAME_Find);
+    if (TagName.IsNone())
+    {
+        return false;
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    const TBitArray<>* Bits = TagBits.Find(TagName);
+    return Bits && Bits->IsValidIndex(Id) && (*Bits)[Id];
+}
+
+TArray<FNexusTest*> FNexusTestRegistry::GetTestsWithTag(const FString& Tag) const
+{
+    TArray<FNexusTest*> Result;
+    const FName TagName(*Tag, FNAME_Find);
+    if (TagName.IsNone())
+    {
+        return Result;
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    if (const TBitArray<>* Bits = TagBits.Find(TagName))
+    {
+        for (TConstSetBitIterator<> It(*Bits); It; ++It)
+        {
+            if (FNexusTest* Test = Tests[It.GetIndex()])
+            {
+                Result.Add(Test);
+            }
+        }
+    }
+    return Result;
+}
+
+int32 FNexusTestRegistry::CountTestsWithTag(const FString& Tag) const
+{
+    const FName TagName(*Tag, FNAME_Find);
+    if (TagName.IsNone())
+    {
+        return 0;
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    const TBitArray<>* Bits = TagBits.Find(TagName);
+    return Bits ? Bits->CountSetBits() : 0;
+}
+
+TBitArray<> FNexusTestRegistry::GetTagBits(const FString& Tag) const
+{
+    const FName TagName(*Tag, FNAME_Find);
+    if (TagName.IsNone())
+    {
+        return TBitArray<>();
+    }
+
+    FReadScopeLock ReadLock(Lock);
+    const TBitArray<>* Bits = TagBits.Find(TagName);
+    return Bits ? *Bits : TBitArray<>();
+}
+
+TArray<FString> FNexusTestRegistry::GetAllTags() const
+{
+    TArray<FString> Result;
+    {
+        FReadScopeLock ReadLock(Lock);
+        Result.Reserve(TagBits.Num());
+        for (const auto& Pair : TagBits)
+        {
+            if (Pair.Value.Contains(true))
+            {
+                Result.Add(Pair.Key.ToString());
+            }
+        }
+    }
+    Result.Sort();
+    return Result;
+}
+
+FNexusTestId FNexusTestRegistry::AddIdLocked(FName Name)
+{
+    const FNexusTestId Id = Names.Add(Name);
+    Tests.Add(nullptr);
+    IdsByName.Add(Name, Id);
+    return Id;
+}
+
+void FNexusTestRegistry::SetTagLocked(FNexusTestId Id, FName Tag)
+{
+    TBitArray<>& Bits = TagBits.FindOrAdd(Tag);
+    if (Bits.Num() <= Id)
+    {
+        Bits.Add(false, Id + 1 - Bits.Num());
+    }
+    Bits[Id] = true;
+}
@@ -0,0 +1,299 @@
+#include "NexusWatchdog.h"
+#include "NexusCore.h"
+#include "PalantirOracle.h"
+#include "NexusSymbolication.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformStackWalk.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include <atomic>
+
+static constexpr double GNexusWatchdogDefaultTimeoutSeconds = 0.0;  // Opt-in: only MaxDurationSeconds is enforced unless configured
+static constexpr double GNexusWatchdogDefaultGraceSeconds = 5.0;
+static constexpr float GNexusWatchdogPollSeconds = 0.05f;
+static constexpr int32 GNexusWatchdogMaxStackDepth = 64;
+static constexpr int32 GNexusHangExitCode = 124;  // Same code coreutils `timeout` uses
+
+enum class ENexusWatchState : uint8
+{
+    Running,
+    Completed,
+    Expired,
+    Abandoned
+};
+
+struct FNexusWatchdog::FWatch
+{
+    FNexusTestId TestId = INDEX_NONE;
+    FString TestName;
+    uint32 ThreadId = 0;
+    double StartSeconds = 0.0;
+    double DeadlineSeconds = 0.0;
+    double GraceSeconds = 0.0;
+    TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Token;
+    TFunction<void()> AbandonHandler;
+    std::atomic<ENexusWatchState> State{ENexusWatchState::Running};
+    bool bHangReported = false;  // Watchdog thread only
+};
+
+typedef TSharedPtr<FNexusWatchdog::FWatch, ESPMode::ThreadSafe> FNexusWatchPtr;
+
+/** Per-thread abandon handler and sticky abandoned flag (function-local thread_locals, see FNexusCancellationToken) */
+static TFunction<void()>& GetThreadAbandonHandlerRef()
+{
+    thread_local TFunction<void()> Handler;
+    return Handler;
+}
+
+static bool& GetThreadAbandonedRef()
+{
+    thread_local bool bAbandoned = false;
+    return bAbandoned;
+}
+
+/** Background thread polling registered watches */
+class FNexusWatchdogRunnable : public FRunnable
+{
+public:
+    static FNexusWatchdogRunnable& Get()
+    {
+        static FNexusWatchdogRunnable Instance;
+        return Instance;
+    }
+
+    void Add(const FNexusWatchPtr& Watch)
+    {
+        FScopeLock Lock(&WatchesLock);
+        Watches.Add(Watch);
+        if (!Thread)
+        {
+            bStopping = false;
+            Thread = FRunnableThread::Create(this, TEXT("NexusWatchdog"), 0, TPri_AboveNormal);
+        }
+    }
+
+    void Remove(const FNexusWatchPtr& Watch)
+    {
+        FScopeLock Lock(&WatchesLock);
+        Watches.RemoveSingleSwap(Watch);
+    }
+
+    void Stop() override
+    {
+        bStopping = true;
+    }
+
+    void Shutdown()
+    {
+        FRunnableThread* ToJoin = nullptr;
+        {
+            FScopeLock Lock(&WatchesLock);
+            ToJoin = Thread;
+            Thread = nullptr;
+        }
+        if (ToJoin)
+        {
+            bStopping = true;
+            ToJoin->WaitForCompletion();
+            delete ToJoin;
+        }
+    }
+
+    uint32 Run() override
+    {
+        while (!bStopping)
+        {
+            FPlatformProcess::Sleep(GNexusWatchdogPollSeconds);
+
+            TArray<FNexusWatchPtr> Snapshot;
+            {
+                FScopeLock Lock(&WatchesLock);
+                Snapshot = Watches;
+            }
+
+            const double Now = FPlatformTime::Seconds();
+            for (const FNexusWatchPtr& Watch : Snapshot)
+            {
+                if (Now >= Watch->DeadlineSeconds)
+                {
+                    ENexusWatchState Expected = ENexusWatchState::Running;
+                    if (Watch->State.compare_exchange_strong(Expected, ENexusWatchState::Expired))
+                    {
+                        OnExpired(*Watch, Now);
+                    }
+                }
+                if (Watch->State.load() == ENexusWatchState::Expired && Now >= Watch->DeadlineSeconds + Watch->GraceSeconds)
+                {
+                    OnHung(*Watch, Now);
+                }
+            }
+        }
+        return 0;
+    }
+
+private:
+    static bool ShouldExitOnHang()
+    {
+        bool bExitOnHang = FParse::Param(FCommandLine::Get(), TEXT("NexusExitOnHang"));
+        if (!bExitOnHang && GConfig)
+        {
+            GConfig->GetBool(TEXT("/Script/Nexus.NexusSettings"), TEXT("ExitOnHang"), bExitOnHang, GGameIni);
+        }
+        return bExitOnHang;
+    }
+
+    static void OnExpired(FNexusWatchdog::FWatch& Watch, double Now)
+    {
+        const double Elapsed = Now - Watch.StartSeconds;
+
+        // Snapshot where the test is stuck before asking it to stop
+        uint64 BackTrace[GNexusWatchdogMaxStackDepth] = {};
+        const uint32 Depth = FPlatformStackWalk::CaptureThreadStackBackTrace(Watch.ThreadId, BackTrace, GNexusWatchdogMaxStackDepth);
+        const TArray<FString> StackLines = FNexusSymbolicator::Symbolicate(BackTrace, static_cast<int32>(Depth));
+
+        UE_LOG(LogNexus, Error, TEXT("NEXUS WATCHDOG: %s exceeded its %.1fs deadline (thread %u) - requesting cancellation"),
+            *Watch.TestName, Watch.DeadlineSeconds - Watch.StartSeconds, Watch.ThreadId);
+        for (const FString& StackLine : StackLines)
+        {
+            UE_LOG(LogNexus, Error, TEXT("    %s"), *StackLine);
+        }
+
+        FPalantirObserver::OnTestTimedOut(Watch.TestId, Elapsed, StackLines);
+        Watch.Token->Cancel(FString::Printf(TEXT("Timed out after %.1fs"), Elapsed));
+    }
+
+    static void OnHung(FNexusWatchdog::FWatch& Watch, double Now)
+    {
+        if (Watch.AbandonHandler)
+        {
+            ENexusWatchState Expected = ENexusWatchState::Expired;
+            if (Watch.State.compare_exchange_strong(Expected, ENexusWatchState::Abandoned))
+            {
+                UE_LOG(LogNexus, Error, TEXT("NEXUS WATCHDOG: %s ignored cancellation for %.1fs - abandoning thread %u"),
+                    *Watch.TestName, Now - Watch.DeadlineSeconds, Watch.ThreadId);
+                Watch.AbandonHandler();
+            }
+            return;
+        }
+
+        if (Watch.bHangReported)
+        {
+            return;
+        }
+        Watch.bHangReported = true;
+
+        // The game thread can't be replaced; in CI, failing fast beats hanging until the job is killed (opt-in)
+        UE_LOG(LogNexus, Error, TEXT("NEXUS WATCHDOG: %s is hung on a thread that cannot be abandoned"), *Watch.TestName);
+        if (ShouldExitOnHang())
+        {
+            UNexusCore::SignalAbort(FString::Printf(TEXT("Test hung past its deadline: %s"), *Watch.TestName));
+            UE_LOG(LogNexus, Error, TEXT("NEXUS WATCHDOG: ExitOnHang set - exiting with code %d"), GNexusHangExitCode);
+            FPlatformMisc::RequestExitWithStatus(true, GNexusHangExitCode);
+        }
+    }
+
+    FCriticalSection WatchesLock;
+    TArray<FNexusWatchPtr> Watches;
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopping{false};
+};
+
+FNexusWatchdog::FScope::FScope(FNexusTestId TestId, const FString& TestName, double TimeoutSeconds, const TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe>& Token)
+{
+    if (TimeoutSeconds <= 0.0)
+    {
+        return;
+    }
+
+    Watch = MakeShared<FWatch, ESPMode::ThreadSafe>();
+    Watch->TestId = TestId;
+    Watch->TestName = TestName;
+    Watch->ThreadId = FPlatformTLS::GetCurrentThreadId();
+    Watch->StartSeconds = FPlatformTime::Seconds();
+    Watch->DeadlineSeconds = Watch->StartSeconds + TimeoutSeconds;
+    Watch->GraceSeconds = GetGraceSeconds();
+    Watch->Token = Token;
+    Watch->AbandonHandler = GetThreadAbandonHandlerRef();
+    FNexusWatchdogRunnable::Get().Add(Watch);
+}
+
+FNexusWatchdog::FScope::~FScope()
+{
+    Finish();
+}
+
+bool FNexusWatchdog::FScope::Finish()
+{
+    if (!Watch.IsValid())
+    {
+        return !GetThreadAbandonedRef();
+    }
+
+    FNexusWatchdogRunnable::Get().Remove(Watch);
+
+    // Running/Expired -> Completed; losing to Abandoned means a replacement already reported this attempt
+    ENexusWatchState State = Watch->State.load();
+    while (State != ENexusWatchState::Abandoned && State != ENexusWatchState::Completed)
+    {
+        if (Watch->State.compare_exchange_weak(State, ENexusWatchState::Completed))
+        {
+            bExpired = State == ENexusWatchState::Expired;
+            break;
+        }
+    }
+    if (Watch->State.load() == ENexusWatchState::Abandoned)
+    {
+        GetThreadAbandonedRef() = true;
+    }
+    Watch.Reset();
+    return !GetThreadAbandonedRef();
+}
+
+bool FNexusWatchdog::FScope::HasExpired() const
+{
+    return bExpired || (Watch.IsValid() && Watch->State.load() != ENexusWatchState::Running);
+}
+
+void FNexusWatchdog::SetThreadAbandonHandler(TFunction<void()> Handler)
+{
+    GetThreadAbandonHandlerRef() = MoveTemp(Handler);
+    GetThreadAbandonedRef() = false;
+}
+
+bool FNexusWatchdog::IsCurrentThreadAbandoned()
+{
+    return GetThreadAbandonedRef();
+}
+
+double FNexusWatchdog::GetTimeoutSeconds(double MaxDurationSeconds)
+{
+    if (MaxDurationSeconds > 0.0)
+    {
+        return MaxDurationSeconds;
+    }
+
+    double TimeoutSeconds = GNexusWatchdogDefaultTimeoutSeconds;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusTestTimeout="), TimeoutSeconds) && GConfig)
+    {
+        GConfig->GetDouble(TEXT("/Script/Nexus.NexusSettings"), TEXT("DefaultTestTimeoutSeconds"), TimeoutSeconds, GGameIni);
+    }
+    return FMath::Max(TimeoutSeconds, 0.0);
+}
+
+double FNexusWatchdog::GetGraceSeconds()
+{
+    double GraceSeconds = GNexusWatchdogDefaultGraceSeconds;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusWatchdogGrace="), GraceSeconds) && GConfig)
+    {
+        GConfig->GetDouble(TEXT("/Script/Nexus.NexusSettings"), TEXT("WatchdogGraceSeconds"), GraceSeconds, GGameIni);
+    }
+    return FMath::Max(GraceSeconds, 0.0);
+}
+
+void FNexusWatchdog::Shutdown()
+{
+    FNexusWatchdogRunnable::Get().Shutdown();
+}
@@ -0,0 +1,987 @@
+#include "NexusWorkerFarm.h"
+#include "NexusTestGraph.h"
+#include "NexusCore.h"
+#include "NexusTest.h"
+#include "NexusModule.h"
+#include "NexusWatchdog.h"
+#include "NexusCancellation.h"
+#include "NexusWorldPool.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Containers/Ticker.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Json.h"
+
+// Per-slot restart budget before a crashing slot is retired
+static constexpr int32 GNexusFarmMaxRestarts = 3;
+
+// Editor boot plus map load; after this a silent worker is treated as dead
+static constexpr double GNexusFarmDefaultStartupTimeout = 300.0;
+
+// Coordinator poll interval while waiting on workers
+static constexpr float GNexusFarmPollSeconds = 0.01f;
+
+// Exit code of a worker whose watchdog gave up on a hung test (see FNexusWatchdog)
+static constexpr int32 GNexusFarmHangExitCode = 124;
+
+// ============================================================================
+// Wire format: one condensed JSON object per line, UTF-8
+// ============================================================================
+
+static bool SendFarmMessage(FSocket* Socket, const TSharedRef<FJsonObject>& Message)
+{
+    if (!Socket)
+    {
+        return false;
+    }
+
+    FString Line;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+    if (!FJsonSerializer::Serialize(Message, Writer))
+    {
+        return false;
+    }
+    Line += TEXT("\n");
+
+    FTCHARToUTF8 Utf8(*Line);
+    const uint8* Data = reinterpret_cast<const uint8*>(Utf8.Get());
+    int32 Remaining = Utf8.Length();
+    while (Remaining > 0)
+    {
+        int32 Sent = 0;
+        if (!Socket->Send(Data, Remaining, Sent))
+        {
+            return false;
+        }
+        Data += Sent;
+        Remaining -= Sent;
+        if (Sent == 0)
+        {
+            FPlatformProcess::Sleep(0.001f);
+        }
+    }
+    return true;
+}
+
+/**
+ * Drain pending bytes into Buffer and parse every complete line
+ * @return false once the connection is gone
+ */
+static bool ReceiveFarmMessages(FSocket* Socket, TArray<uint8>& Buffer, TArray<TSharedPtr<FJsonObject>>& OutMessages)
+{
+    if (!Socket)
+    {
+        return false;
+    }
+
+    uint32 PendingSize = 0;
+    while (Socket->HasPendingData(PendingSize) && PendingSize > 0)
+    {
+        const int32 Offset = Buffer.Num();
+        Buffer.AddUninitialized(PendingSize);
+        int32 BytesRead = 0;
+        if (!Socket->Recv(Buffer.GetData() + Offset, PendingSize, BytesRead))
+        {
+            Buffer.SetNum(Offset, EAllowShrinking::No);
+            return false;
+        }
+        Buffer.SetNum(Offset + BytesRead, EAllowShrinking::No);
+    }
+
+    int32 LineStart = 0;
+    for (int32 i = 0; i < Buffer.Num(); ++i)
+    {
+        if (Buffer[i] != '\n')
+        {
+            continue;
+        }
+
+        FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + LineStart), i - LineStart);
+        const FString Line(Converted.Length(), Converted.Get());
+        LineStart = i + 1;
+
+        TSharedPtr<FJsonObject> Message;
+        if (FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Message) && Message.IsValid())
+        {
+            OutMessages.Add(Message);
+        }
+        else
+        {
+            UE_LOG(LogNexus, Warning, TEXT("NEXUS FARM: Dropping malformed message: %s"), *Line);
+        }
+    }
+    Buffer.RemoveAt(0, LineStart, EAllowShrinking::No);
+
+    return Socket->GetConnectionState() != SCS_ConnectionError;
+}
+
+static TArray<TSharedPtr<FJsonValue>> ToJsonStrings(const TArray<FString>& Values)
+{
+    TArray<TSharedPtr<FJsonValue>> Out;
+    for (const FString& Value : Values)
+    {
+        Out.Add(MakeShareable(new FJsonValueString(Value)));
+    }
+    return Out;
+}
+
+static FNexusTest* FindTestByName(const FString& Name)
+{
+    FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
+    if (FNexusTest* Test = Registry.GetTest(Registry.FindId(Name)))
+    {
+        return Test;
+    }
+
+    // Worker processes never run discovery; build and register the suite on the first miss
+    FNexusTestDescriptor::MaterializeAll();
+    for (FNexusTest* Test : FNexusTest::AllTests)
+    {
+        Registry.Register(Test);
+    }
+    return Registry.GetTest(Registry.FindId(Name));
+}
+
+/**
+ * How long the coordinator lets a test run on a worker before killing it: every attempt's deadline,
+ * the worker watchdog's grace period twice over (its own abandon plus exit), and the retry backoff.
+ * @return 0 if the test has no deadline
+ */
+static double GetFarmDeadlineSeconds(const FNexusTest* Test)
+{
+    const double AttemptTimeout = FNexusWatchdog::GetTimeoutSeconds(Test->MaxDurationSeconds);
+    if (AttemptTimeout <= 0.0)
+    {
+        return 0.0;
+    }
+
+    double Deadline = 0.0;
+    for (uint32 Attempt = 1; Attempt <= 1 + Test->MaxRetries; ++Attempt)
+    {
+        Deadline += AttemptTimeout + 2.0 * FNexusWatchdog::GetGraceSeconds();
+        if (Attempt <= Test->MaxRetries)
+        {
+            Deadline += Test->GetRetryDelaySeconds(Attempt);
+        }
+    }
+    return Deadline;
+}
+
+static void DestroyFarmSocket(FSocket*& Socket)
+{
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
+
+// ============================================================================
+// Coordinator
+// ============================================================================
+
+FNexusWorkerFarm::FNexusWorkerFarm(int32 InNumProcesses)
+    : NumProcesses(FMath::Max(1, InNumProcesses))
+{
+}
+
+FNexusWorkerFarm::~FNexusWorkerFarm()
+{
+    Shutdown();
+}
+
+int32 FNexusWorkerFarm::GetConfiguredProcessCount()
+{
+    if (IsWorkerProcess())
+    {
+        return 0;  // Workers never start farms of their own
+    }
+
+    int32 Processes = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("NexusFarm="), Processes))
+    {
+        return FMath::Max(0, Processes);
+    }
+
+    if (GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("FarmWorkers"), Processes, GGameIni);
+    }
+    return FMath::Max(0, Processes);
+}
+
+bool FNexusWorkerFarm::IsWorkerProcess()
+{
+    FString Endpoint;
+    return FParse::Value(FCommandLine::Get(), TEXT("NexusWorker="), Endpoint) && !Endpoint.IsEmpty();
+}
+
+/**
+ * Worker binary: config override, else the console variant of the running executable
+ * (UnrealEditor -> UnrealEditor-Cmd) when it exists next to it
+ */
+static FString GetWorkerExecutable()
+{
+    FString Executable;
+    if (GConfig && GConfig->GetString(TEXT("/Script/Nexus.NexusSettings"), TEXT("FarmWorkerExecutable"), Executable, GGameIni) && !Executable.IsEmpty())
+    {
+        return Executable;
+    }
+
+    Executable = FPlatformProcess::ExecutablePath();
+    const FString BaseName = FPaths::GetBaseFilename(Executable);
+    if (!BaseName.EndsWith(TEXT("-Cmd")))
+    {
+        const FString CmdExecutable = FPaths::Combine(FPaths::GetPath(Executable), BaseName + TEXT("-Cmd") + FPaths::GetExtension(Executable, true));
+        if (FPaths::FileExists(CmdExecutable))
+        {
+            return CmdExecutable;
+        }
+    }
+    return Executable;
+}
+
+bool FNexusWorkerFarm::Start()
+{
+    ListenSocket = FTcpSocketBuilder(TEXT("NexusFarmListener"))
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToAddress(FIPv4Address(127, 0, 0, 1))
+        .BoundToPort(0)
+        .Listening(NumProcesses * 2)
+        .Build();
+
+    if (!ListenSocket)
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS FARM: Could not open loopback listener — running tests in-process"));
+        return false;
+    }
+    Port = ListenSocket->GetPortNo();
+
+    Slots.SetNum(NumProcesses);
+    int32 Launched = 0;
+    for (int32 i = 0; i < Slots.Num(); ++i)
+    {
+        Slots[i].Id = i;
+        if (LaunchWorker(Slots[i]))
+        {
+            ++Launched;
+        }
+        else
+        {
+            Slots[i].bRetired = true;
+        }
+    }
+
+    if (Launched == 0)
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS FARM: No worker process could be launched — running tests in-process"));
+        Shutdown();
+        return false;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS FARM: Launched %d worker process(es), listening on 127.0.0.1:%d"), Launched, Port);
+    return true;
+}
+
+bool FNexusWorkerFarm::LaunchWorker(FWorkerSlot& Slot)
+{
+    const FString Executable = GetWorkerExecutable();
+
+    FString Params = FString::Printf(TEXT("\"%s\""), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+    const FString TestMap = UNexusCore::GetConfiguredTestMap();
+    if (!TestMap.IsEmpty())
+    {
+        Params += TEXT(" ") + TestMap;
+    }
+    const FString LogPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectLogDir() / FString::Printf(TEXT("NexusWorker%d.log"), Slot.Id));
+    Params += FString::Printf(TEXT(" -game -nullrhi -unattended -nosplash -nosound -stdout -NexusExitOnHang -NexusWorker=127.0.0.1:%d -NexusWorkerId=%d -NexusCoordinatorPid=%u -abslog=\"%s\""),
+        Port, Slot.Id, FPlatformProcess::GetCurrentProcessId(), *LogPath);
+
+    Slot.Process = FPlatformProcess::CreateProc(*Executable, *Params, false, true, true, nullptr, 0, nullptr, nullptr);
+    Slot.LaunchTime = FPlatformTime::Seconds();
+    Slot.WarmFixtures.Reset();  // A fresh process has built nothing yet
+    Slot.bFixturesBegun = false;
+
+    if (!Slot.Process.IsValid())
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS FARM: Failed to launch worker %d (%s)"), Slot.Id, *Executable);
+        return false;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS FARM: Worker %d starting — log: %s"), Slot.Id, *LogPath);
+    return true;
+}
+
+void FNexusWorkerFarm::AcceptConnections(double Now)
+{
+    bool bHasPending = false;
+    while (ListenSocket && ListenSocket->HasPendingConnection(bHasPending) && bHasPending)
+    {
+        FSocket* Accepted = ListenSocket->Accept(TEXT("NexusFarmWorker"));
+        if (!Accepted)
+        {
+            break;
+        }
+        Accepted->SetNonBlocking(true);
+
+        FWorkerSlot Handshake;
+        Handshake.Socket = Accepted;
+        Handshake.LaunchTime = Now;
+        Handshakes.Add(MoveTemp(Handshake));
+    }
+
+    // Match each connection to its slot by the worker ID in its hello
+    for (int32 i = Handshakes.Num() - 1; i >= 0; --i)
+    {
+        FWorkerSlot& Handshake = Handshakes[i];
+        TArray<TSharedPtr<FJsonObject>> Messages;
+        const bool bConnected = ReceiveFarmMessages(Handshake.Socket, Handshake.RecvBuffer, Messages);
+
+        int32 WorkerId = INDEX_NONE;
+        for (const TSharedPtr<FJsonObject>& Message : Messages)
+        {
+            if (Message->GetStringField(TEXT("type")) == TEXT("hello"))
+            {
+                WorkerId = static_cast<int32>(Message->GetIntegerField(TEXT("worker")));
+            }
+        }
+
+        if (Slots.IsValidIndex(WorkerId) && !Slots[WorkerId].bRetired && !Slots[WorkerId].Socket)
+        {
+            FWorkerSlot& Slot = Slots[WorkerId];
+            Slot.Socket = Handshake.Socket;
+            Slot.RecvBuffer = MoveTemp(Handshake.RecvBuffer);
+            UE_LOG(LogNexus, Display, TEXT("NEXUS FARM: Worker %d connected after %.1fs"), WorkerId, Now - Slot.LaunchTime);
+            Handshakes.RemoveAt(i);
+        }
+        else if (!bConnected || WorkerId != INDEX_NONE || Now - Handshake.LaunchTime > 10.0)
+        {
+            // Dropped, stale (a restarted slot already reconnected) or never identified itself
+            DestroyFarmSocket(Handshake.Socket);
+            Handshakes.RemoveAt(i);
+        }
+    }
+}
+
+void FNexusWorkerFarm::PumpSlot(FWorkerSlot& Slot)
+{
+    if (Slot.Socket)
+    {
+        TArray<TSharedPtr<FJsonObject>> Messages;
+        const bool bConnected = ReceiveFarmMessages(Slot.Socket, Slot.RecvBuffer, Messages);
+
+        for (const TSharedPtr<FJsonObject>& Message : Messages)
+        {
+            if (Message->GetStringField(TEXT("type")) == TEXT("result") && Slot.InFlight &&
+                Message->GetStringField(TEXT("test")) == Slot.InFlight->TestName)
+            {
+                FNexusTest* Finished = Slot.InFlight;
+                Slot.InFlight = nullptr;
+                RecordResult(Finished, Message);
+            }
+        }
+
+        if (!bConnected)
+        {
+            HandleWorkerLost(Slot, TEXT("connection lost"), true);
+            return;
+        }
+    }
+
+    if (!FPlatformProcess::IsProcRunning(Slot.Process))
+    {
+        int32 ReturnCode = 0;
+        FPlatformProcess::GetProcReturnCode(Slot.Process, &ReturnCode);
+        HandleWorkerLost(Slot, FString::Printf(TEXT("process exited with code %d"), ReturnCode), true, ReturnCode == GNexusFarmHangExitCode);
+        return;
+    }
+
+    // Backstop for a worker whose own watchdog could not get it out (e.g. hung with the exit blocked)
+    if (Slot.InFlight)
+    {
+        const double Deadline = GetFarmDeadlineSeconds(Slot.InFlight);
+        const double Elapsed = FPlatformTime::Seconds() - Slot.InFlightStart;
+        if (Deadline > 0.0 && Elapsed > Deadline)
+        {
+            HandleWorkerLost(Slot, FString::Printf(TEXT("no result after %.0fs, deadline %.0fs"), Elapsed, Deadline), true, true);
+            return;
+        }
+    }
+
+    if (!Slot.Socket)
+    {
+        double StartupTimeout = GNexusFarmDefaultStartupTimeout;
+        if (GConfig)
+        {
+            GConfig->GetDouble(TEXT("/Script/Nexus.NexusSettings"), TEXT("FarmStartupTimeoutSeconds"), StartupTimeout, GGameIni);
+        }
+        if (FPlatformTime::Seconds() - Slot.LaunchTime > StartupTimeout)
+        {
+            HandleWorkerLost(Slot, FString::Printf(TEXT("did not connect within %.0fs"), StartupTimeout), true);
+        }
+    }
+}
+
+void FNexusWorkerFarm::CloseSlot(FWorkerSlot& Slot)
+{
+    DestroyFarmSocket(Slot.Socket);
+    Slot.RecvBuffer.Reset();
+
+    if (Slot.Process.IsValid())
+    {
+        if (FPlatformProcess::IsProcRunning(Slot.Process))
+        {
+            FPlatformProcess::TerminateProc(Slot.Process, true);
+        }
+        FPlatformProcess::CloseProc(Slot.Process);
+    }
+}
+
+void FNexusWorkerFarm::HandleWorkerLost(FWorkerSlot& Slot, const FString& Reason, bool bCanRestart, bool bTimedOut)
+{
+    UE_LOG(LogNexus, Error, TEXT("NEXUS FARM: Worker %d lost (%s)"), Slot.Id, *Reason);
+    CloseSlot(Slot);
+
+    if (Slot.InFlight)
+    {
+        FNexusTest* Crashed = Slot.InFlight;
+        Slot.InFlight = nullptr;
+        const FString Message = bTimedOut
+            ? FString::Printf(TEXT("Test hung worker process %d past its deadline (%s) — see NexusWorker%d.log for the stack"), Slot.Id, *Reason, Slot.Id)
+            : FString::Printf(TEXT("Worker process %d crashed while running this test (%s)"), Slot.Id, *Reason);
+        RecordCrash(Crashed, Message, bTimedOut);
+    }
+
+    if (bCanRestart && !bAborted && Pending.Num() > 0 && Slot.Restarts < GNexusFarmMaxRestarts)
+    {
+        ++Slot.Restarts;
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS FARM: Restarting worker %d (restart %d/%d)"), Slot.Id, Slot.Restarts, GNexusFarmMaxRestarts);
+        if (LaunchWorker(Slot))
+        {
+            return;
+        }
+    }
+    Slot.bRetired = true;
+}
+
+bool FNexusWorkerFarm::BeginFixtureUsers(FWorkerSlot& Slot)
+{
+    TSharedRef<FJsonObject> Message = MakeShareable(new FJsonObject());
+    Message->SetStringField(TEXT("type"), TEXT("begin"));
+    Message->SetArrayField(TEXT("fixture_users"), ToJsonStrings(FixtureUsers.Array()));
+    Slot.bFixturesBegun = SendFarmMessage(Slot.Socket, Message);
+    return Slot.bFixturesBegun;
+}
+
+void FNexusWorkerFarm::ReleaseFixtureUser(const FNexusTest* Test)
+{
+    if (FixtureUsers.Remove(Test->TestName) == 0) return;
+
+    // Every worker counted this user, so each one that built the fixture can tear it down after the last
+    TSharedRef<FJsonObject> Message = MakeShareable(new FJsonObject());
+    Message->SetStringField(TEXT("type"), TEXT("release"));
+    Message->SetStringField(TEXT("test"), Test->TestName);
+    for (FWorkerSlot& Slot : Slots)
+    {
+        if (Slot.Socket && Slot.bFixturesBegun)
+        {
+            SendFarmMessage(Slot.Socket, Message);
+        }
+    }
+}
+
+void FNexusWorkerFarm::RecordResult(FNexusTest* Test, const TSharedPtr<FJsonObject>& Message)
+{
+    ReleaseFixtureUser(Test);
+
+    FPalantirTestResult Result;
+    Result.bPassed = Message->GetBoolField(TEXT("passed"));
+    Result.bSkipped = Message->GetBoolField(TEXT("skipped"));
+    Message->TryGetBoolField(TEXT("timed_out"), Result.bTimedOut);
+    Result.Duration = Message->GetNumberField(TEXT("duration"));
+    Result.Priority = static_cast<uint8>(Test->Priority);
+    Result.ErrorMessage = Message->GetStringField(TEXT("error"));
+
+    TArray<FString> Tags;
+    Message->TryGetStringArrayField(TEXT("tags"), Tags);
+    TArray<FString> Artifacts;
+    Message->TryGetStringArrayField(TEXT("artifacts"), Artifacts);
+    FPalantirObserver::RecordExternalResult(Test->TestName, Result, Tags, Artifacts);
+
+    Test->LastResult = FNexusTestResult();
+    Test->LastResult.TestName = Test->TestName;
+    Test->LastResult.bPassed = Result.bPassed;
+    Test->LastResult.bSkipped = Result.bSkipped;
+    Test->LastResult.bTimedOut = Result.bTimedOut;
+    Test->LastResult.DurationSeconds = Result.Duration;
+    Test->LastResult.Attempts = static_cast<uint32>(FMath::Max(1, static_cast<int32>(Message->GetIntegerField(TEXT("attempts")))));
+    Test->LastResult.ErrorMessage = Result.ErrorMessage;
+    Test->LastResult.TraceID = Message->GetStringField(TEXT("trace_id"));
+
+    if (Result.bSkipped)
+    {
+        UNexusCore::NotifyTestSkipped(Test->TestName);
+        if (Graph)
+        {
+            Graph->SkipDependentsOf(Test);
+        }
+        return;
+    }
+
+    FNexusResultCollector::Record(Test->LastResult);
+    UNexusCore::NotifyTestFinished(Test->TestName, Result.bPassed);
+
+    if (Graph)
+    {
+        if (Result.bPassed)
+        {
+            Graph->MarkPassed(Test);
+        }
+        else
+        {
+            Graph->SkipDependentsOf(Test);
+        }
+    }
+
+    // A critical test that gates dependents only takes its subtree down
+    if (!Result.bPassed && FNexusTestGraph::ShouldAbortRun(Test, Graph))
+    {
+        bAborted = true;
+        UNexusCore::SignalAbort(FString::Printf(TEXT("Critical test failed on farm worker: %s"), *Test->TestName));
+    }
+}
+
+void FNexusWorkerFarm::RecordCrash(FNexusTest* Test, const FString& Reason, bool bTimedOut)
+{
+    ReleaseFixtureUser(Test);
+
+    FPalantirTestResult Result;
+    Result.bPassed = false;
+    Result.bTimedOut = bTimedOut;
+    Result.Priority = static_cast<uint8>(Test->Priority);
+    Result.ErrorMessage = Reason;
+    FPalantirObserver::RecordExternalResult(Test->TestName, Result, Test->GetCustomTags(), TArray<FString>());
+
+    Test->LastResult = FNexusTestResult();
+    Test->LastResult.TestName = Test->TestName;
+    Test->LastResult.ErrorMessage = Reason;
+    Test->LastResult.bTimedOut = bTimedOut;
+    FNexusResultCollector::Record(Test->LastResult);
+
+    UE_LOG(LogNexus, Error, TEXT("%s: %s — %s"), bTimedOut ? TEXT("TEST TIMED OUT") : TEXT("TEST CRASHED"), *Test->TestName, *Reason);
+    UNexusCore::NotifyTestFinished(Test->TestName, false);
+
+    if (Graph)
+    {
+        Graph->SkipDependentsOf(Test);
+    }
+
+    if (FNexusTestGraph::ShouldAbortRun(Test, Graph))
+    {
+        bAborted = true;
+        UNexusCore::SignalAbort(FString::Printf(TEXT("Critical test crashed its farm worker: %s"), *Test->TestName));
+    }
+}
+
+TArray<FNexusTest*> FNexusWorkerFarm::Run(const TArray<FNexusTest*>& Tests, FNexusTestGraph* InGraph)
+{
+    Graph = InGraph;
+    Pending.Reset();
+    for (FNexusTest* Test : Tests)
+    {
+        if (!Test || (Graph && Graph->IsSkipped(Test))) continue;
+
+        if (Test->bSkip)
+        {
+            UNexusCore::NotifyTestSkipped(Test->TestName);
+            FPalantirObserver::OnTestSkipped(Test->GetId());
+            if (Graph)
+            {
+                Graph->SkipDependentsOf(Test);
+            }
+            continue;
+        }
+        Pending.Add(Test);
+    }
+
+    // Workers count suite fixture users over this run's tests, sent with each worker's first test
+    FixtureUsers.Reset();
+    for (const FNexusTest* Test : Pending)
+    {
+        if (Test->Fixtures.Num() > 0)
+        {
+            FixtureUsers.Add(Test->TestName);
+        }
+    }
+    for (FWorkerSlot& Slot : Slots)
+    {
+        Slot.bFixturesBegun = false;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS FARM: Distributing %d test(s) across %d worker process(es)"), Pending.Num(), Slots.Num());
+
+    while (true)
+    {
+        const double Now = FPlatformTime::Seconds();
+        AcceptConnections(Now);
+        bAborted |= FNexusRunCancellation::IsCancelled();
+
+        bool bAnyInFlight = false;
+        bool bAnyAlive = false;
+        for (FWorkerSlot& Slot : Slots)
+        {
+            if (Slot.bRetired) continue;
+
+            PumpSlot(Slot);
+            if (Slot.bRetired) continue;
+            bAnyAlive = true;
+
+            // Tests whose prerequisite failed were already reported as skipped
+            if (Graph)
+            {
+                Pending.RemoveAll([this](const FNexusTest* Test)
+                {
+                    if (!Graph->IsSkipped(Test)) return false;
+                    ReleaseFixtureUser(Test);
+                    return true;
+                });
+            }
+
+            // Hand the next runnable test to an idle worker, preferring one whose suite fixture that worker already built
+            const auto IsRunnable = [this](const FNexusTest* Test) { return !Graph || Graph->IsReady(Test); };
+            int32 NextIndex = Pending.IndexOfByPredicate([&Slot, &IsRunnable](const FNexusTest* Test)
+            {
+                return IsRunnable(Test) && Slot.WarmFixtures.Contains(FNexusFixture::GetAffinityKey(*Test));
+            });
+            if (NextIndex == INDEX_NONE)
+            {
+                NextIndex = Pending.IndexOfByPredicate(IsRunnable);
+            }
+            if (Slot.Socket && !Slot.InFlight && !bAborted && NextIndex != INDEX_NONE && (Slot.bFixturesBegun || BeginFixtureUsers(Slot)))
+            {
+                FNexusTest* Test = Pending[NextIndex];
+                TSharedRef<FJsonObject> Message = MakeShareable(new FJsonObject());
+                Message->SetStringField(TEXT("type"), TEXT("run"));
+                Message->SetStringField(TEXT("test"), Test->TestName);
+                if (SendFarmMessage(Slot.Socket, Message))
+                {
+                    Pending.RemoveAt(NextIndex);
+                    Slot.WarmFixtures.Append(Test->Fixtures);
+                    Slot.InFlight = Test;
+                    Slot.InFlightStart = Now;
+                    FPalantirObserver::OnTestStarted(Test);
+                    UNexusCore::NotifyTestStarted(Test->TestName);
+                }
+            }
+            bAnyInFlight |= Slot.InFlight != nullptr;
+        }
+
+        if (bAborted && Pending.Num() > 0)
+        {
+            for (FNexusTest* Test : Pending)
+            {
+                UE_LOG(LogNexus, Warning, TEXT("Skipping test %s due to critical failure"), *Test->TestName);
+                UNexusCore::NotifyTestSkipped(Test->TestName);
+                FPalantirObserver::OnTestSkipped(Test->GetId());
+                ReleaseFixtureUser(Test);
+            }
+            Pending.Reset();
+        }
+
+        // Nothing running and nothing runnable: the remaining tests wait on prerequisites outside the farm
+        // that never passed (the in-process lane aborted), so they can't run either
+        if (!bAnyInFlight && bAnyAlive && Graph && Pending.Num() > 0 && !Pending.ContainsByPredicate([this](const FNexusTest* Test) { return Graph->IsReady(Test); }))
+        {
+            for (FNexusTest* Test : Pending)
+            {
+                if (Graph->IsSkipped(Test)) continue;
+                UE_LOG(LogNexus, Warning, TEXT("Skipping test %s — a prerequisite did not run"), *Test->TestName);
+                Test->LastResult = FNexusTestResult();
+                Test->LastResult.TestName = Test->TestName;
+                Test->LastResult.bSkipped = true;
+                Test->LastResult.ErrorMessage = TEXT("Prerequisite did not run");
+                UNexusCore::NotifyTestSkipped(Test->TestName);
+                FPalantirObserver::OnTestSkipped(Test->GetId());
+                ReleaseFixtureUser(Test);
+                Graph->SkipDependentsOf(Test);
+            }
+            Pending.Reset();
+        }
+
+        if (!bAnyInFlight && (Pending.Num() == 0 || !bAnyAlive))
+        {
+            break;
+        }
+        FPlatformProcess::Sleep(GNexusFarmPollSeconds);
+    }
+
+    if (Pending.Num() > 0)
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS FARM: All workers retired with %d test(s) left — handing them back"), Pending.Num());
+    }
+
+    TArray<FNexusTest*> Unrun = MoveTemp(Pending);
+    Pending.Reset();
+    Graph = nullptr;
+    return Unrun;
+}
+
+void FNexusWorkerFarm::Shutdown()
+{
+    TSharedRef<FJsonObject> Message = MakeShareable(new FJsonObject());
+    Message->SetStringField(TEXT("type"), TEXT("shutdown"));
+
+    for (FWorkerSlot& Slot : Slots)
+    {
+        if (Slot.Socket)
+        {
+            SendFarmMessage(Slot.Socket, Message);
+        }
+    }
+
+    // Give workers a moment to exit cleanly before terminating them
+    const double Deadline = FPlatformTime::Seconds() + 5.0;
+    for (FWorkerSlot& Slot : Slots)
+    {
+        while (Slot.Process.IsValid() && FPlatformProcess::IsProcRunning(Slot.Process) && FPlatformTime::Seconds() < Deadline)
+        {
+            FPlatformProcess::Sleep(0.05f);
+        }
+        CloseSlot(Slot);
+    }
+    Slots.Reset();
+
+    for (FWorkerSlot& Handshake : Handshakes)
+    {
+        DestroyFarmSocket(Handshake.Socket);
+    }
+    Handshakes.Reset();
+
+    DestroyFarmSocket(ListenSocket);
+}
+
+// ============================================================================
+// Worker
+// ============================================================================
+
+static FSocket* GNexusWorkerSocket = nullptr;
+static TArray<uint8> GNexusWorkerBuffer;
+static TArray<FString> GNexusWorkerQueue;
+static FProcHandle GNexusCoordinatorProcess;
+static FTSTicker::FDelegateHandle GNexusWorkerTicker;
+
+// Shared by every test the worker runs outside a pooled world, like the sequential lane's context; rebuilt
+// only when its world goes away
+static TOptional<FNexusTestContext> GNexusWorkerContext;
+
+static void RunWorkerTest(const FString& Name)
+{
+    TSharedRef<FJsonObject> Message = MakeShareable(new FJsonObject());
+    Message->SetStringField(TEXT("type"), TEXT("result"));
+    Message->SetStringField(TEXT("test"), Name);
+
+    bool bPassed = false;
+    bool bSkipped = false;
+    FString Error;
+    FNexusTest* Test = FindTestByName(Name);
+
+    if (!Test)
+    {
+        Error = TEXT("Test is not registered in the worker process");
+    }
+    else if (Test->bSkip)
+    {
+        bSkipped = true;
+    }
+    else
+    {
+        // Game-thread tests lease a pooled world when the pool is configured, as in the in-process lane
+        FNexusWorldPool& WorldPool = FNexusWorldPool::Get();
+        UWorld* PooledWorld = nullptr;
+        if (Test->bRequiresGameThread && !Test->HasCustomTag(FNexusWorldPool::NoPoolTag) && WorldPool.Prewarm() > 0)
+        {
+            PooledWorld = WorldPool.Acquire(Test->Fixtures);
+        }
+
+        FNexusTestContext PooledContext;
+        if (PooledWorld)
+        {
+            PooledContext.World = PooledWorld;
+            PooledContext.GameState = PooledWorld->GetGameState();
+        }
+        else if (!GNexusWorkerContext.IsSet() || !GNexusWorkerContext->IsValid())
+        {
+            GNexusWorkerContext.Emplace(UNexusCore::CreateTestContext());
+        }
+        FNexusTestContext& Context = PooledWorld ? PooledContext : GNexusWorkerContext.GetValue();
+
+        if (Test->bRequiresGameThread && !Context.World)
+        {
+            bSkipped = true;
+            Error = TEXT("No active game world in worker process");
+            UE_LOG(LogNexus, Warning, TEXT("⚠️  No active game world detected — Skipping %s"), *Name);
+        }
+        else
+        {
+            FPalantirObserver::OnTestStarted(Test);
+            bPassed = Test->Execute(Context);
+            FPalantirObserver::OnTestFinished(Test->GetId(), bPassed);
+            bSkipped = Test->LastResult.bSkipped;
+            Error = Test->LastResult.ErrorMessage;
+        }
+
+        // Roll the world back so the next test starts from the map's initial state
+        if (PooledWorld)
+        {
+            PooledContext.CleanupSpawnedActors();
+            WorldPool.Release(PooledWorld);
+        }
+    }
+
+    Message->SetBoolField(TEXT("passed"), bPassed && !bSkipped);
+    Message->SetBoolField(TEXT("skipped"), bSkipped);
+    Message->SetBoolField(TEXT("timed_out"), Test && !bPassed && Test->LastResult.bTimedOut);
+    Message->SetNumberField(TEXT("duration"), Test ? Test->LastResult.DurationSeconds : 0.0);
+    Message->SetNumberField(TEXT("attempts"), Test ? Test->LastResult.Attempts : 1);
+    Message->SetStringField(TEXT("error"), Error);
+    Message->SetStringField(TEXT("trace_id"), Test ? Test->LastResult.TraceID : FString());
+    Message->SetArrayField(TEXT("tags"), ToJsonStrings(FPalantirObserver::GetTestTags(Name)));
+    Message->SetArrayField(TEXT("artifacts"), ToJsonStrings(FPalantirObserver::GetArtifacts(Name)));
+
+    SendFarmMessage(GNexusWorkerSocket, Message);
+}
+
+static void StopWorker(const TCHAR* Reason)
+{
+    UE_LOG(LogNexus, Display, TEXT("NEXUS WORKER: Stopping (%s)"), Reason);
+    FNexusRunCancellation::EndRun();
+    FNexusFixture::EndRun();  // Fixtures still built when the run stops early or hands tests back
+    GNexusWorkerContext.Reset();  // Its actors belong to worlds that go away with the engine
+    DestroyFarmSocket(GNexusWorkerSocket);
+    if (GNexusCoordinatorProcess.IsValid())
+    {
+        FPlatformProcess::CloseProc(GNexusCoordinatorProcess);
+    }
+    RequestEngineExit(TEXT("Nexus worker finished"));
+}
+
+static bool TickNexusWorker(float DeltaTime)
+{
+    TArray<TSharedPtr<FJsonObject>> Messages;
+    if (!ReceiveFarmMessages(GNexusWorkerSocket, GNexusWorkerBuffer, Messages))
+    {
+        StopWorker(TEXT("coordinator connection lost"));
+        return false;
+    }
+
+    for (const TSharedPtr<FJsonObject>& Message : Messages)
+    {
+        const FString Type = Message->GetStringField(TEXT("type"));
+        if (Type == TEXT("run"))
+        {
+            GNexusWorkerQueue.Add(Message->GetStringField(TEXT("test")));
+        }
+        else if (Type == TEXT("begin"))
+        {
+            // The farm's fixture users with no result yet, wherever they run; this worker tears a fixture
+            // down once all of them are released
+            TArray<FString> Names;
+            Message->TryGetStringArrayField(TEXT("fixture_users"), Names);
+            TArray<FNexusTest*> Users;
+            for (const FString& UserName : Names)
+            {
+                if (FNexusTest* User = FindTestByName(UserName))
+                {
+                    Users.Add(User);
+                }
+            }
+            FNexusFixture::BeginRun(Users);
+        }
+        else if (Type == TEXT("release"))
+        {
+            if (FNexusTest* User = FindTestByName(Message->GetStringField(TEXT("test"))))
+            {
+                FNexusFixture::Release(User->GetId());
+            }
+        }
+        else if (Type == TEXT("shutdown"))
+        {
+            StopWorker(TEXT("coordinator requested shutdown"));
+            return false;
+        }
+    }
+
+    if (GNexusCoordinatorProcess.IsValid() && !FPlatformProcess::IsProcRunning(GNexusCoordinatorProcess))
+    {
+        StopWorker(TEXT("coordinator process exited"));
+        return false;
+    }
+
+    // One test per frame so the world ticks between tests
+    if (GNexusWorkerQueue.Num() > 0)
+    {
+        const FString Name = GNexusWorkerQueue[0];
+        GNexusWorkerQueue.RemoveAt(0);
+        RunWorkerTest(Name);
+    }
+    return true;
+}
+
+bool FNexusWorkerFarm::StartWorker()
+{
+    FString Endpoint;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusWorker="), Endpoint))
+    {
+        return false;
+    }
+
+    int32 WorkerId = 0;
+    FParse::Value(FCommandLine::Get(), TEXT("NexusWorkerId="), WorkerId);
+    uint32 CoordinatorPid = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("NexusCoordinatorPid="), CoordinatorPid) && CoordinatorPid != 0)
+    {
+        GNexusCoordinatorProcess = FPlatformProcess::OpenProcess(CoordinatorPid);
+    }
+
+    FString Host, PortString;
+    if (!Endpoint.Split(TEXT(":"), &Host, &PortString) || !PortString.IsNumeric())
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS WORKER: Invalid endpoint '%s' — expected host:port"), *Endpoint);
+        return false;
+    }
+
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+    bool bValidAddress = false;
+    Address->SetIp(*Host, bValidAddress);
+    Address->SetPort(FCString::Atoi(*PortString));
+
+    GNexusWorkerSocket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("NexusWorker"), false);
+    if (!bValidAddress || !GNexusWorkerSocket || !GNexusWorkerSocket->Connect(*Address))
+    {
+        UE_LOG(LogNexus, Error, TEXT("NEXUS WORKER: Could not connect to coordinator at %s"), *Endpoint);
+        DestroyFarmSocket(GNexusWorkerSocket);
+        return false;
+    }
+    GNexusWorkerSocket->SetNonBlocking(true);
+
+    TSharedRef<FJsonObject> Hello = MakeShareable(new FJsonObject());
+    Hello->SetStringField(TEXT("type"), TEXT("hello"));
+    Hello->SetNumberField(TEXT("worker"), WorkerId);
+    Hello->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+    SendFarmMessage(GNexusWorkerSocket, Hello);
+
+    // The worker's tests stop as soon as the coordinator (or any other process of the run) signals abort
+    FNexusRunCancellation::BeginRun();
+    GNexusWorkerTicker = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickNexusWorker), 0.0f);
+    UE_LOG(LogNexus, Display, TEXT("NEXUS WORKER %d: Connected to coordinator at %s"), WorkerId, *Endpoint);
+    return true;
+}
@@ -0,0 +1,423 @@
+#include "NexusWorldPool.h"
+#include "NexusCore.h"
+#include "NexusActorPool.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/LinkerInstancingContext.h"
+#include "Misc/PackageName.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Serialization/ObjectWriter.h"
+#include "Serialization/ObjectReader.h"
+
+static constexpr int32 GNexusWorldPoolDefaultSize = 1;
+static constexpr const TCHAR* GNexusWorldPoolPackageRoot = TEXT("/Temp/NexusWorldPool");
+
+const TCHAR* FNexusWorldPool::NoPoolTag = TEXT("NoWorldPool");
+
+/** Copies an object's UPROPERTY state (transient included) to memory; object references stay raw pointers */
+class FNexusPropertyWriter : public FObjectWriter
+{
+public:
+    FNexusPropertyWriter(UObject* Object, TArray<uint8>& Bytes)
+        : FObjectWriter(Bytes)
+    {
+        Object->SerializeScriptProperties(*this);
+    }
+};
+
+class FNexusPropertyReader : public FObjectReader
+{
+public:
+    FNexusPropertyReader(UObject* Object, TArray<uint8>& Bytes)
+        : FObjectReader(Bytes)
+    {
+        Object->SerializeScriptProperties(*this);
+    }
+};
+
+FNexusWorldPool& FNexusWorldPool::Get()
+{
+    static FNexusWorldPool Instance;
+    return Instance;
+}
+
+int32 FNexusWorldPool::GetConfiguredSize()
+{
+    int32 Size = GNexusWorldPoolDefaultSize;
+    if (!FParse::Value(FCommandLine::Get(), TEXT("NexusWorldPool="), Size) && GConfig)
+    {
+        GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("WorldPoolSize"), Size, GGameIni);
+    }
+    return FMath::Max(0, Size);
+}
+
+bool FNexusWorldPool::IsEnabled()
+{
+    return GetConfiguredSize() > 0 && !UNexusCore::GetConfiguredTestMap().IsEmpty();
+}
+
+bool FNexusWorldPool::IsPooledWorld(const UWorld* World)
+{
+    return World && World->GetPackage()->GetName().StartsWith(GNexusWorldPoolPackageRoot);
+}
+
+int32 FNexusWorldPool::Prewarm()
+{
+    check(IsInGameThread());
+
+    if (!IsEnabled() || !GEngine)
+    {
+        return 0;
+    }
+
+    // A changed TestMapPath invalidates every pooled world
+    const FString ConfiguredPackage = FPackageName::ObjectPathToPackageName(UNexusCore::GetConfiguredTestMap());
+    if (ConfiguredPackage != MapPackageName)
+    {
+        Shutdown();
+        MapPackageName = ConfiguredPackage;
+    }
+
+    const int32 TargetSize = GetConfiguredSize();
+    const double StartTime = FPlatformTime::Seconds();
+    int32 Created = 0;
+    while (Worlds.Num() < TargetSize)
+    {
+        UWorld* World = CreateWorld(CreatedCount++);
+        if (!World)
+        {
+            break;
+        }
+
+        FPooledWorld& Pooled = Worlds.AddDefaulted_GetRef();
+        Pooled.World = World;
+        TakeSnapshot(Pooled);
+        ++Created;
+    }
+
+    if (Created > 0)
+    {
+        UE_LOG(LogNexus, Display, TEXT("NEXUS: World pool warmed %d world(s) of %s in %.2fs"),
+            Created, *MapPackageName, FPlatformTime::Seconds() - StartTime);
+    }
+    return Worlds.Num();
+}
+
+UWorld* FNexusWorldPool::Acquire(const TArray<FString>& Fixtures)
+{
+    check(IsInGameThread());
+
+    // The users of a fixture go back to the world its actors live in; any other test takes an unpinned world
+    FPooledWorld* Free = nullptr;
+    for (FPooledWorld& Pooled : Worlds)
+    {
+        if (Pooled.bLeased || !Pooled.World || Pooled.World->bIsTearingDown)
+        {
+            continue;
+        }
+        if (Pooled.Fixtures.ContainsByPredicate([&Fixtures](const FString& Name) { return Fixtures.Contains(Name); }))
+        {
+            Free = &Pooled;
+            break;
+        }
+        if (!Free && Pooled.Fixtures.Num() == 0)
+        {
+            Free = &Pooled;
+        }
+    }
+
+    if (!Free)
+    {
+        return nullptr;
+    }
+    Free->bLeased = true;
+    return Free->World;
+}
+
+void FNexusWorldPool::Release(UWorld* World)
+{
+    check(IsInGameThread());
+
+    const int32 Index = IndexOf(World);
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    Worlds[Index].bLeased = false;
+    ResetWorld(Index);
+}
+
+void FNexusWorldPool::Pin(UWorld* World, const FString& FixtureName)
+{
+    check(IsInGameThread());
+
+    const int32 Index = IndexOf(World);
+    if (Index == INDEX_NONE)
+    {
+        return;
+    }
+
+    FPooledWorld& Pooled = Worlds[Index];
+    if (Pooled.Fixtures.Num() == 0)
+    {
+        Pooled.MapSnapshot = MoveTemp(Pooled.Snapshot);
+    }
+    Pooled.Fixtures.AddUnique(FixtureName);
+    TakeSnapshot(Pooled);
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Pooled world %s pinned by suite fixture '%s'"), *World->GetName(), *FixtureName);
+}
+
+void FNexusWorldPool::Unpin(UWorld* World, const FString& FixtureName)
+{
+    check(IsInGameThread());
+
+    const int32 Index = IndexOf(World);
+    if (Index == INDEX_NONE || Worlds[Index].Fixtures.Remove(FixtureName) == 0)
+    {
+        return;  // Reloaded since it was pinned; the fixture's actors went with the old world
+    }
+
+    FPooledWorld& Pooled = Worlds[Index];
+    if (Pooled.Fixtures.Num() > 0)
+    {
+        // Other fixtures still live here; forget the actors this one's teardown destroyed
+        Pooled.Snapshot.RemoveAll([](const FActorSnapshot& Snapshot)
+        {
+            const AActor* Actor = Snapshot.Actor.Get();
+            return !Actor || Actor->IsActorBeingDestroyed();
+        });
+        return;
+    }
+
+    Pooled.Snapshot = MoveTemp(Pooled.MapSnapshot);
+    Pooled.MapSnapshot.Reset();
+    if (!Pooled.bLeased)
+    {
+        ResetWorld(Index);
+    }
+}
+
+int32 FNexusWorldPool::IndexOf(const UWorld* World) const
+{
+    return World ? Worlds.IndexOfByPredicate([World](const FPooledWorld& Pooled) { return Pooled.World == World; }) : INDEX_NONE;
+}
+
+void FNexusWorldPool::ResetWorld(int32 Index)
+{
+    FPooledWorld& Pooled = Worlds[Index];
+    if (RestoreSnapshot(Pooled))
+    {
+        return;
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: Pooled world %s could not be rolled back — reloading it"), *Pooled.World->GetName());
+    if (Pooled.Fixtures.Num() > 0)
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: Reloading %s loses the actors of suite fixture(s) %s"),
+            *Pooled.World->GetName(), *FString::Join(Pooled.Fixtures, TEXT(", ")));
+        Pooled.Fixtures.Reset();
+        Pooled.MapSnapshot.Reset();
+    }
+    DestroyWorld(Pooled.World);
+    Pooled.World = CreateWorld(CreatedCount++);
+    if (Pooled.World)
+    {
+        TakeSnapshot(Pooled);
+    }
+    else
+    {
+        Worlds.RemoveAt(Index);
+    }
+}
+
+void FNexusWorldPool::Shutdown()
+{
+    for (FPooledWorld& Pooled : Worlds)
+    {
+        DestroyWorld(Pooled.World);
+    }
+    Worlds.Empty();
+}
+
+UWorld* FNexusWorldPool::CreateWorld(int32 Index) const
+{
+    if (!FPackageName::DoesPackageExist(MapPackageName))
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: World pool map %s does not exist"), *MapPackageName);
+        return nullptr;
+    }
+
+    // Load the map into a package of its own, so every pooled world has private actors
+    const FString InstancePackageName = FString::Printf(TEXT("%s/%s_%d"), GNexusWorldPoolPackageRoot, *FPackageName::GetShortName(MapPackageName), Index);
+    UPackage* InstancePackage = CreatePackage(*InstancePackageName);
+    InstancePackage->SetPackageFlags(PKG_NewlyCreated);
+
+    FLinkerInstancingContext InstancingContext;
+    InstancingContext.AddPackageMapping(FName(*MapPackageName), InstancePackage->GetFName());
+    UPackage* Loaded = LoadPackage(InstancePackage, *MapPackageName, LOAD_None, nullptr, &InstancingContext);
+    UWorld* World = Loaded ? UWorld::FindWorldInPackage(Loaded) : nullptr;
+    if (!World)
+    {
+        UE_LOG(LogNexus, Warning, TEXT("NEXUS: World pool failed to load %s"), *MapPackageName);
+        return nullptr;
+    }
+
+    World->WorldType = EWorldType::Game;
+    World->AddToRoot();
+
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    // Borrow the running game's instance so the map's game mode and game state are spawned
+    for (TObjectIterator<UWorld> It; It; ++It)
+    {
+        UWorld* Other = *It;
+        if (Other && !IsPooledWorld(Other) && Other->WorldType != EWorldType::Editor && Other->GetGameInstance())
+        {
+            World->SetGameInstance(Other->GetGameInstance());
+            break;
+        }
+    }
+
+    if (!World->bIsWorldInitialized)
+    {
+        World->InitWorld(UWorld::InitializationValues()
+            .AllowAudioPlayback(false)
+            .CreateFXSystem(false)
+            .ShouldSimulatePhysics(true)
+            .EnableTraceCollision(true));
+    }
+    World->UpdateWorldComponents(true, false);
+
+    const FURL URL;
+    if (World->GetGameInstance())
+    {
+        World->SetGameMode(URL);
+    }
+    World->InitializeActorsForPlay(URL);
+    World->BeginPlay();
+    return World;
+}
+
+void FNexusWorldPool::DestroyWorld(UWorld* World)
+{
+    if (!World)
+    {
+        return;
+    }
+
+    if (GEngine)
+    {
+        GEngine->DestroyWorldContext(World);
+    }
+    World->DestroyWorld(false);
+    World->RemoveFromRoot();
+}
+
+void FNexusWorldPool::TakeSnapshot(FPooledWorld& Pooled)
+{
+    UWorld* World = Pooled.World;
+    Pooled.Snapshot.Reset();
+    Pooled.TimeSeconds = World->TimeSeconds;
+    Pooled.RealTimeSeconds = World->RealTimeSeconds;
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AActor* Actor = *It;
+        if (!Actor || Actor->IsActorBeingDestroyed())
+        {
+            continue;
+        }
+
+        FActorSnapshot& Snapshot = Pooled.Snapshot.AddDefaulted_GetRef();
+        Snapshot.Actor = Actor;
+        Snapshot.bHasRoot = Actor->GetRootComponent() != nullptr;
+        Snapshot.Transform = Actor->GetActorTransform();
+        Snapshot.State.Object = Actor;
+        FNexusPropertyWriter ActorWriter(Actor, Snapshot.State.Properties);
+
+        for (UActorComponent* Component : Actor->GetComponents())
+        {
+            if (Component)
+            {
+                FObjectState& ComponentState = Snapshot.Components.AddDefaulted_GetRef();
+                ComponentState.Object = Component;
+                FNexusPropertyWriter ComponentWriter(Component, ComponentState.Properties);
+            }
+        }
+    }
+}
+
+bool FNexusWorldPool::RestoreSnapshot(FPooledWorld& Pooled)
+{
+    UWorld* World = Pooled.World;
+    if (!World || World->bIsTearingDown)
+    {
+        return false;
+    }
+
+    TSet<AActor*> SnapshotActors;
+    SnapshotActors.Reserve(Pooled.Snapshot.Num());
+    for (const FActorSnapshot& Snapshot : Pooled.Snapshot)
+    {
+        AActor* Actor = Snapshot.Actor.Get();
+        if (!Actor || Actor->IsActorBeingDestroyed())
+        {
+            return false;  // The map itself changed; only a reload brings the actor back
+        }
+        SnapshotActors.Add(Actor);
+    }
+
+    // Actors the test spawned (and missed cleaning up); idle FNexusActorPool actors stay for the next test
+    const FNexusActorPool& ActorPool = FNexusActorPool::Get();
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        AActor* Actor = *It;
+        if (Actor && !SnapshotActors.Contains(Actor) && !Actor->IsActorBeingDestroyed() && !ActorPool.IsPooledActor(Actor))
+        {
+            Actor->Destroy();
+        }
+    }
+
+    for (FActorSnapshot& Snapshot : Pooled.Snapshot)
+    {
+        AActor* Actor = Snapshot.Actor.Get();
+
+        TSet<UActorComponent*> SnapshotComponents;
+        for (FObjectState& ComponentState : Snapshot.Components)
+        {
+            if (UActorComponent* Component = Cast<UActorComponent>(ComponentState.Object.Get()))
+            {
+                SnapshotComponents.Add(Component);
+                FNexusPropertyReader ComponentReader(Component, ComponentState.Properties);
+            }
+        }
+
+        // Components the test added to a map actor
+        for (UActorComponent* Component : Actor->GetComponents().Array())
+        {
+            if (Component && !SnapshotComponents.Contains(Component))
+            {
+                Component->DestroyComponent();
+            }
+        }
+
+        FNexusPropertyReader ActorReader(Actor, Snapshot.State.Properties);
+        if (Snapshot.bHasRoot && Actor->GetRootComponent())
+        {
+            Actor->SetActorTransform(Snapshot.Transform, false, nullptr, ETeleportType::ResetPhysics);
+        }
+    }
+
+    World->TimeSeconds = Pooled.TimeSeconds;
+    World->RealTimeSeconds = Pooled.RealTimeSeconds;
+    return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UWorld;
+class UClass;
+class AActor;
+
+/**
+ * Actor pool counters for the current run (shown in the LCARS and JUnit reports)
+ */
+struct NEXUS_API FNexusActorPoolStats
+{
+    int32 Hits = 0;       // Acquires served by a pooled actor
+    int32 Misses = 0;     // Acquires that had to spawn (pool empty or reactivation failed)
+    int32 Prewarmed = 0;  // Actors spawned ahead of demand
+    int32 Released = 0;   // Actors returned to the pool instead of destroyed
+
+    double GetHitRate() const
+    {
+        const int32 Acquires = Hits + Misses;
+        return Acquires > 0 ? static_cast<double>(Hits) / Acquires : 0.0;
+    }
+};
+
+/**
+ * FNexusActorPool - Reuses test actors instead of spawning and destroying them (opt-in)
+ *
+ * FNexusTestContext::SpawnTestCharacter takes actors from here and CleanupSpawnedActors hands them back,
+ * so a gameplay suite spawning thousands of characters stops feeding the garbage collector and the
+ * hitches stop leaking into ArgusLens metrics. Pools are kept per world and per class. The first request
+ * for a class in a world pre-warms ActorPoolPrewarm actors of it. A released actor is reset: unpossessed,
+ * movement stopped, detached, hidden, collision and tick off, parked out of the way. Acquiring reactivates
+ * it at the requested transform; if it cannot be placed there, a fresh actor is spawned instead.
+ *
+ * Enable: -NexusActorPool or [/Script/Nexus.NexusSettings] bActorPoolEnabled=true.
+ * Pre-warm size: -NexusActorPoolPrewarm=N or ActorPoolPrewarm=N (default 8). Game thread only.
+ */
+class NEXUS_API FNexusActorPool
+{
+public:
+    static FNexusActorPool& Get();
+
+    static bool IsEnabled();
+    static int32 GetPrewarmCount();
+
+    /**
+     * A reactivated pooled actor of Class at Location, or a newly spawned one
+     * @return nullptr if no actor could be placed there without colliding
+     */
+    AActor* Acquire(UWorld* World, UClass* Class, const FVector& Location, const FRotator& Rotation);
+
+    template<typename ActorType>
+    ActorType* Acquire(UWorld* World, UClass* Class, const FVector& Location, const FRotator& Rotation)
+    {
+        return Cast<ActorType>(Acquire(World, Class, Location, Rotation));
+    }
+
+    /**
+     * Deactivate an actor and keep it for reuse
+     * @return false if the actor was not created by the pool (the caller destroys it as usual)
+     */
+    bool Release(AActor* Actor);
+
+    /** Spawn idle actors of Class in World until Count are available */
+    void Prewarm(UWorld* World, UClass* Class, int32 Count);
+
+    /** Actor was spawned by the pool (FNexusWorldPool keeps these across its rollbacks) */
+    bool IsPooledActor(const AActor* Actor) const;
+
+    const FNexusActorPoolStats& GetStats() const { return Stats; }
+    void ResetStats() { Stats = FNexusActorPoolStats(); }
+
+    /** Destroy every idle actor and forget all pools */
+    void Empty();
+
+private:
+    typedef TPair<TObjectKey<UWorld>, TObjectKey<UClass>> FPoolKey;
+
+    AActor* SpawnPooled(UWorld* World, UClass* Class, const FVector& Location, const FRotator& Rotation);
+    static void Deactivate(AActor* Actor);
+    static bool Activate(AActor* Actor, const FVector& Location, const FRotator& Rotation);
+
+    TMap<FPoolKey, TArray<TWeakObjectPtr<AActor>>> IdleActors;
+    TSet<TObjectKey<AActor>> PooledActors;  // Idle or in use
+    FNexusActorPoolStats Stats;
+};
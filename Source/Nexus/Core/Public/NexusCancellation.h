@@ -0,0 +1,98 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * FNexusCancellationToken - Cooperative stop request for one test attempt
+ *
+ * Every attempt gets a fresh token, made current on the thread running it (FNexusCancellationScope).
+ * The watchdog cancels it when the attempt overruns its deadline, and a run-wide abort cancels it through
+ * its parent (FNexusRunCancellation). Long-running test code should poll
+ * FNexusTestContext::IsCancellationRequested() and return early; PALANTIR_BREADCRUMB, blocking Palantir
+ * requests and latent waits check it for you.
+ */
+class NEXUS_API FNexusCancellationToken : public TSharedFromThis<FNexusCancellationToken, ESPMode::ThreadSafe>
+{
+public:
+    FNexusCancellationToken() = default;
+
+    /** A child token is also cancelled whenever its parent is */
+    explicit FNexusCancellationToken(const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& InParent)
+        : Parent(InParent)
+    {
+    }
+
+    /** Request cancellation; the first reason wins */
+    void Cancel(const FString& InReason);
+
+    bool IsCancellationRequested() const
+    {
+        return bCancelled.load(std::memory_order_acquire) || (Parent.IsValid() && Parent->IsCancellationRequested());
+    }
+
+    /** Reason this token (or, failing that, its parent) was cancelled */
+    FString GetReason() const;
+
+    /** True for the first caller after cancellation only (used to breadcrumb where it was noticed) */
+    bool MarkObserved() { return IsCancellationRequested() && !bObserved.exchange(true); }
+
+    /** Token of the test attempt running on the calling thread (null outside a test) */
+    static TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> GetCurrent();
+
+    /** True if the calling thread's current token has been cancelled */
+    static bool IsCurrentCancelled();
+
+private:
+    friend class FNexusCancellationScope;
+    static TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& GetCurrentRef();
+
+    TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Parent;
+    std::atomic<bool> bCancelled{false};
+    std::atomic<bool> bObserved{false};
+    mutable FCriticalSection ReasonLock;
+    FString Reason;
+};
+
+/**
+ * FNexusRunCancellation - Run-wide abort, the parent of every attempt token
+ *
+ * Cancelled by UNexusCore::SignalAbort (critical failure, hung game thread) and, through a background
+ * watcher polling the abort sentinel (UNexusCore::GetAbortFilePath), by any other process of the same run
+ * that signals abort - shards, farm workers, or a CI step touching NexusAbort.flag. In-flight tests then
+ * stop at their next check instead of running to completion. Sentinels older than the run are ignored.
+ */
+class NEXUS_API FNexusRunCancellation
+{
+public:
+    /** Fresh run token and start watching the sentinel (RunAllTests / farm worker startup) */
+    static void BeginRun();
+
+    /** Stop watching the sentinel; the token stays cancelled if the run was aborted */
+    static void EndRun();
+
+    /** Cancel every in-flight attempt of this run */
+    static void Cancel(const FString& Reason);
+
+    /** Lock-free; checkpoints poll this from every worker */
+    static bool IsCancelled();
+
+    /** Parent for new attempt tokens (valid even outside BeginRun/EndRun; lock-free once created) */
+    static TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe> GetToken();
+
+    /** New attempt token parented to the run token */
+    static TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe> MakeAttemptToken();
+};
+
+/**
+ * RAII: make a token current on the calling thread, restoring the previous one on exit
+ */
+class NEXUS_API FNexusCancellationScope
+{
+public:
+    explicit FNexusCancellationScope(const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe>& Token);
+    ~FNexusCancellationScope();
+
+private:
+    TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Previous;
+};
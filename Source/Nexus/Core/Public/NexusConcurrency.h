@@ -0,0 +1,115 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+
+/**
+ * What a test mostly spends its time on; declared with NEXUS_TEST_RESOURCE
+ */
+enum class ENexusResourceClass : uint8
+{
+    Default,      // Undeclared - treated like CPU work, but the governor learns from what the box actually does
+    CpuBound,     // Saturates a core for its whole run
+    IoBound,      // Mostly blocked (HTTP, sockets, disk); does not take a CPU slot
+    MemoryHeavy   // Large resident footprint; few at a time, none added under memory pressure
+};
+
+NEXUS_API const TCHAR* LexToString(ENexusResourceClass ResourceClass);
+
+/**
+ * One reading of the machine, taken by FNexusConcurrencyGovernor::Tick
+ */
+struct NEXUS_API FNexusConcurrencySample
+{
+    double CpuUtilization = 0.0;     // Process CPU time over wall time, 0-100 across all cores
+    int32 RunQueueLength = 0;        // Runnable jobs waiting in the scheduler's deques
+    double ResidentMemoryMb = 0.0;   // This process
+    double AvailableMemoryMb = 0.0;  // Whole machine
+};
+
+/**
+ * Counters for the end-of-run log line
+ */
+struct NEXUS_API FNexusConcurrencyStats
+{
+    int32 InitialTarget = 0;
+    int32 MinTarget = 0;
+    int32 MaxTarget = 0;
+    int32 Raises = 0;
+    int32 Lowers = 0;
+    int32 MemoryPressureSamples = 0;
+    int32 PeakActive = 0;
+    double PeakCpuUtilization = 0.0;
+};
+
+/**
+ * FNexusConcurrencyGovernor - Runtime concurrency limit for the Nexus scheduler
+ *
+ * The scheduler starts threads for the most work the box might take (MaxAdaptiveWorkers, twice the default
+ * worker count unless configured) and asks the governor before each job starts. CPU-bound and undeclared
+ * tests share a target number of slots (at most one CPU-bound test per core); IO-bound tests only need a
+ * thread, so blocking tests no longer keep cores idle; memory-heavy tests take a slot and are further
+ * limited to half the target, and to one at a time while memory is tight. Work always runs when nothing
+ * else is, so a refusal can delay a job but never stall the run.
+ *
+ * Every SampleInterval a worker samples process CPU utilization, the scheduler's run-queue length and
+ * resident/available memory, and the target moves:
+ *   - memory pressure (available < MinFreeMemoryMb, or resident > MaxResidentMemoryMb): drop by a quarter
+ *   - CPU above ConcurrencyCpuHigh (90%): one slot down
+ *   - CPU below ConcurrencyCpuLow (75%) with every slot busy and jobs queued: one slot up
+ *
+ * Disable: -NexusNoAdaptiveConcurrency or [/Script/Nexus.NexusSettings] bAdaptiveConcurrency=false.
+ * An explicit -NexusWorkers=N also pins the worker count.
+ */
+class NEXUS_API FNexusConcurrencyGovernor
+{
+public:
+    FNexusConcurrencyGovernor(int32 InInitialTarget, int32 InMaxTarget);
+
+    static bool IsEnabled();
+
+    /** Threads to start when the governor is on: MaxAdaptiveWorkers, or twice DefaultWorkers */
+    static int32 GetMaxWorkerCount(int32 DefaultWorkers);
+
+    /**
+     * Take a slot for a job of this class if the current limits allow it
+     * @param bForce Admit regardless (the run is cancelled and jobs are only being finalized)
+     */
+    bool TryAdmit(ENexusResourceClass ResourceClass, bool bForce = false);
+
+    /** Give back the slot TryAdmit took */
+    void Release(ENexusResourceClass ResourceClass);
+
+    /** Sample and adjust if SampleInterval has passed; cheap otherwise. Safe from any worker. */
+    void Tick(TFunctionRef<int32()> GetRunQueueLength);
+
+    /** Apply the control law to one sample (Tick calls this) */
+    void Update(const FNexusConcurrencySample& Sample);
+
+    int32 GetTarget() const;
+    FNexusConcurrencyStats GetStats() const;
+
+private:
+    bool CanAdmitLocked(ENexusResourceClass ResourceClass) const;
+    void SetTargetLocked(int32 NewTarget, const TCHAR* Reason, const FNexusConcurrencySample& Sample);
+
+    mutable FCriticalSection Lock;
+    int32 Target = 1;
+    int32 MaxTarget = 1;
+    int32 CpuCores = 1;
+    int32 ActiveSlots = 0;        // Default, CpuBound and MemoryHeavy jobs running
+    int32 ActiveCpuBound = 0;
+    int32 ActiveMemoryHeavy = 0;
+    int32 ActiveIoBound = 0;
+    bool bMemoryPressure = false;
+    FNexusConcurrencyStats Stats;
+
+    FCriticalSection SampleLock;  // Held by the one worker sampling; others skip
+    double NextSampleSeconds = 0.0;
+    double LastSampleSeconds = 0.0;
+    double SampleIntervalSeconds = 0.25;
+    double CpuHigh = 90.0;
+    double CpuLow = 75.0;
+    double MinFreeMemoryMb = 1024.0;
+    double MaxResidentMemoryMb = 0.0;  // 0 = no limit
+};
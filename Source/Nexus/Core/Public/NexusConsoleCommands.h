@@ -9,4 +9,5 @@ public:
 
 private:
 	static void OnRunTests(const TArray<FString>& Args);
+	static void OnMergeShards(const TArray<FString>& Args);
 };
@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "NexusTest.h"
 #include "NexusModule.h"
+#include <atomic>
 
 /**
  * NexusCore - Test framework coordinator
@@ -14,18 +15,23 @@ public:
     static void Execute(const TArray<FString>& Args);
     static void DiscoverAllTests();
     static void RunAllTests(bool bParallel = true);
+    static void RunTests(const TArray<class FNexusTest*>& Tests, bool bParallel = true);  // Run exactly these tests (DiscoveredTests is left untouched)
+    static int32 RunTestsMatching(const FString& FilterExpression, bool bParallel = true);  // Run tests selected by an FNexusTestFilter expression; INDEX_NONE if it doesn't parse
     static void RunTestsWithTags(ETestTag Tags, bool bParallel = true);  // Run only tests matching tags
     static void RegisterTest(class FNexusTest* Test);
     static bool EnsurePIEWorldActive();  // Auto-launch PIE if needed for game-thread tests
     static bool EnsurePIEWorldActive(const FString& MapPath);  // Auto-launch PIE if needed for game-thread tests
     static FString GetConfiguredTestMap();
     static void RunSequentialWithFailFast();
+    static void RunSequentialWithFailFast(const TArray<class FNexusTest*>& Tests);
+    static FNexusTestContext CreateTestContext();  // World/GameState/PlayerController of the first game world, if any
     static FString GetAbortFilePath();
     static void SignalAbort(const FString& Reason = TEXT(""));
 
     // Reporting is now delegated
     static void NotifyTestStarted(const FString& Name);
     static void NotifyTestFinished(const FString& Name, bool bPassed);
+    static void NotifyQuarantinedTestFinished(const FString& Name, bool bPassed);  // Counted apart from passes and failures
     static void NotifyTestSkipped(const FString& Name);
     
     // Test filtering
@@ -42,11 +48,13 @@ public:
     static void ExportTestTrends(const FString& OutputPath = TEXT(""));        // Export trend report to JSON/CSV
     static void ClearTestHistory();                                             // Clear all stored test results
 
-    // Stats
-    static int32 TotalTests;
-    static int32 PassedTests;
-    static int32 FailedTests;
-    static int32 SkippedTests;
-    static int32 CriticalTests;
+    // Stats (updated concurrently by scheduler workers)
+    static std::atomic<int32> TotalTests;
+    static std::atomic<int32> PassedTests;
+    static std::atomic<int32> FailedTests;
+    static std::atomic<int32> SkippedTests;
+    static std::atomic<int32> CriticalTests;
+    static std::atomic<int32> QuarantinedTests;     // Quarantined tests that ran (not in PassedTests/FailedTests)
+    static std::atomic<int32> QuarantinedFailures;  // Of those, how many failed
     static TArray<class FNexusTest*> DiscoveredTests;
 };
\ No newline at end of file
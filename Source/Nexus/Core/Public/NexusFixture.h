@@ -0,0 +1,107 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include "NexusTestRegistry.h"
+#include <atomic>
+
+class FNexusTest;
+class UWorld;
+struct FNexusTestContext;
+
+/**
+ * FNexusFixture - Suite-scoped setup shared by every test that uses it (NEXUS_FIXTURE)
+ *
+ * BeforeEach/AfterEach run per attempt; a fixture holds what is too expensive for that (a loaded map, a
+ * logged-in backend stub, a crowd of actors). It is built lazily by the first test that needs it, shared
+ * read-only by all its tests - parallel ones included - and torn down as soon as the last test using it in
+ * the run has its final result (or at the end of the run for tests that never started).
+ * Setup runs on the thread of the first user, Teardown on the thread of the last one, so fixtures that
+ * touch the world should only be used by game-thread tests. A fixture whose Setup fails fails its tests
+ * without running them, and is not retried until the next run.
+ *
+ * A fixture set up in a pooled world (FNexusWorldPool) pins that world: what Setup spawned there survives
+ * the rollback after each test, and the fixture's other users lease the same world. Spawn the fixture's
+ * actors with Context.World->SpawnActor, not Context.SpawnTestCharacter - actors tracked by the context are
+ * cleaned up when the first user's attempt ends.
+ *
+ * RunTests groups the users of a fixture (the scheduler deals them to the same worker, the farm to the
+ * same worker process) so each fixture is built as few times as possible and lives as briefly as possible.
+ *
+ *   class FArenaFixture : public FNexusFixture
+ *   {
+ *   public:
+ *       FArenaFixture() : FNexusFixture(TEXT("Arena")) {}
+ *       virtual bool Setup(const FNexusTestContext& Context) override;
+ *       virtual void Teardown() override;
+ *       TArray<AActor*> Crowd;
+ *   };
+ *   NEXUS_FIXTURE(FArenaFixture);
+ *   NEXUS_TEST_FIXTURE(FCrowdPathing, FArenaFixture);
+ *   // In the test body: const FArenaFixture* Arena = FNexusFixture::Get<FArenaFixture>(TEXT("Arena"));
+ */
+class NEXUS_API FNexusFixture
+{
+public:
+    explicit FNexusFixture(const FString& InName);
+    virtual ~FNexusFixture();
+
+    const FString& GetName() const { return Name; }
+    bool IsReady() const { return State.load() == EState::Ready; }
+
+    /** Fixture registered under Name, or nullptr */
+    static FNexusFixture* Find(const FString& Name);
+
+    /**
+     * Built fixture registered under Name, for use inside a test that declared it
+     * @return nullptr if no such fixture exists or it is not set up
+     */
+    template<typename FixtureType>
+    static const FixtureType* Get(const FString& Name)
+    {
+        const FNexusFixture* Fixture = Find(Name);
+        return Fixture && Fixture->IsReady() ? static_cast<const FixtureType*>(Fixture) : nullptr;
+    }
+
+    /** Fixture the test's users are grouped by (its first fixture), empty if it uses none */
+    static const FString& GetAffinityKey(const FNexusTest& Test);
+
+    /** Count the users of every fixture in Tests and forget failures of earlier runs */
+    static void BeginRun(const TArray<FNexusTest*>& Tests);
+
+    /**
+     * Build the test's fixtures that are not built yet (called before every attempt)
+     * @return false (with the fixture named in OutError) if one of them failed to set up
+     */
+    static bool Acquire(const FNexusTest& Test, const FNexusTestContext& Context, FString& OutError);
+
+    /** The test has its final result (or will never run); tears down fixtures it was the last user of */
+    static void Release(FNexusTestId TestId);
+
+    /** Tear down every fixture still built (end of run, module shutdown) */
+    static void EndRun();
+
+protected:
+    /** Build the shared state; runs once per run, on the thread of the first test that needs it */
+    virtual bool Setup(const FNexusTestContext& Context) = 0;
+
+    /** Release the shared state once no test of the run needs it */
+    virtual void Teardown() {}
+
+private:
+    enum class EState : uint8
+    {
+        Idle,
+        Ready,
+        Failed
+    };
+
+    bool EnsureBuilt(const FNexusTestContext& Context);
+    void TearDownIfBuilt();
+
+    FString Name;
+    FCriticalSection BuildLock;  // Serializes Setup/Teardown; users of a ready fixture never take it
+    std::atomic<EState> State{EState::Idle};
+    int32 RemainingUsers = 0;    // Tests of the current run that have not finished (guarded by the run lock)
+    TWeakObjectPtr<UWorld> PinnedWorld;  // Pooled world Setup ran in, unpinned on teardown
+};
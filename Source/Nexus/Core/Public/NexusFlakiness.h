@@ -0,0 +1,82 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class FNexusTest;
+
+/**
+ * Flip statistics of one test over its recorded outcome window
+ */
+struct NEXUS_API FNexusFlakinessStats
+{
+    int32 Observations = 0;  // Attempt outcomes in the window, oldest first across runs
+    int32 Flips = 0;         // Pass/fail changes between consecutive outcomes
+    double FlipRate = 0.0;   // Flips per transition (Observations - 1)
+    double LowerBound = 0.0; // 95% Wilson score interval of FlipRate
+    double UpperBound = 1.0;
+    bool bQuarantined = false;
+};
+
+/**
+ * FNexusFlakiness - Flaky-test detection from persisted pass/fail history, and automatic quarantine
+ *
+ * Outcomes come from FNexusRunHistory: each recorded run contributes its attempt outcomes (so a retry that
+ * passed counts a fail then a pass), and the last FlakyWindow of them are judged. A test that keeps failing is broken, not
+ * flaky; what marks a flaky test is how often consecutive outcomes disagree. The flip rate is judged by
+ * its 95% Wilson score interval, so a handful of runs never quarantines anything: a test is quarantined
+ * once the interval's lower bound reaches FlakyFlipThreshold (with at least FlakyMinObservations outcomes),
+ * and released once the upper bound drops below it.
+ *
+ * Quarantined tests run after everything else in a low-priority lane with a single attempt (MaxRetries is
+ * not spent on them), never trigger fail-fast, and are counted apart from passes and failures. Their
+ * outcomes keep feeding the history, so a fixed test earns its way back out.
+ *
+ * Nothing is stored here: whether a test is quarantined follows from the lane its last recorded run used
+ * and the outcome window it ended with.
+ * Disable: -NexusNoQuarantine or [/Script/Nexus.NexusSettings] bQuarantineEnabled=false (history is still kept).
+ * Tuning: FlakyFlipThreshold (default 0.2, -NexusFlakyThreshold=), FlakyMinObservations (10), FlakyWindow (30).
+ */
+class NEXUS_API FNexusFlakiness
+{
+public:
+    static FNexusFlakiness& Get();
+
+    static bool IsQuarantineEnabled();
+    static double GetThreshold();
+    static int32 GetMinObservations();
+    static int32 GetWindowSize();
+
+    /** 95% Wilson score interval of Successes out of Trials ([0, 1] when Trials is 0) */
+    static void ComputeWilsonInterval(int32 Successes, int32 Trials, double& OutLower, double& OutUpper);
+
+    /** Build every test's outcome window and quarantine state from the run history (all shards) */
+    void Load();
+
+    /**
+     * Set FNexusTest::bQuarantined on Tests from their history for the coming run
+     * @return number of tests quarantined
+     */
+    int32 ApplyQuarantine(const TArray<FNexusTest*>& Tests) const;
+
+    /**
+     * Fold in the outcomes of every test in Tests that finished after RunStart and re-evaluate quarantine
+     * In memory only; the run itself is persisted by FNexusRunHistory::RecordResults
+     */
+    void RecordResults(const TArray<FNexusTest*>& Tests, const FDateTime& RunStart);
+
+    FNexusFlakinessStats GetStats(const FString& TestName) const;
+
+    /** Outcome window of the test, oldest first ('P' pass, 'F' fail) */
+    FString GetHistory(const FString& TestName) const;
+
+private:
+    struct FEntry
+    {
+        FString Outcomes;
+        bool bQuarantined = false;
+        FDateTime UpdatedAt;
+    };
+
+    static FNexusFlakinessStats ComputeStats(const FEntry& Entry);
+
+    TMap<FString, FEntry> Entries;  // Test name -> outcome window
+};
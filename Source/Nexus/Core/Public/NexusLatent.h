@@ -0,0 +1,214 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NexusCancellation.h"
+#include "Nexus/Palantir/Public/PalantirTrace.h"
+#include <coroutine>
+
+class FNexusTest;
+class FNexusTestGraph;
+struct FNexusTestContext;
+
+/**
+ * FNexusLatentTask - Coroutine returned by NEXUS_TEST_LATENT bodies
+ *
+ * The body starts suspended and only ever runs on the game thread, resumed by FNexusLatentRunner.
+ * Each co_await hands the runner a wake condition that it polls once per frame, so many latent tests
+ * wait on the same world tick loop instead of blocking it one after another. co_return the result.
+ */
+class FNexusLatentTask
+{
+public:
+    struct promise_type
+    {
+        TFunction<bool()> WakeCondition;  // Set by the awaiter the body is suspended on
+        bool bResult = false;
+
+        FNexusLatentTask get_return_object() { return FNexusLatentTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_value(bool bInResult) { bResult = bInResult; }
+        void unhandled_exception() { bResult = false; }
+    };
+
+    FNexusLatentTask() = default;
+    FNexusLatentTask(FNexusLatentTask&& Other) : Handle(Other.Handle) { Other.Handle = nullptr; }
+    FNexusLatentTask& operator=(FNexusLatentTask&& Other)
+    {
+        if (this != &Other)
+        {
+            Reset();
+            Handle = Other.Handle;
+            Other.Handle = nullptr;
+        }
+        return *this;
+    }
+    FNexusLatentTask(const FNexusLatentTask&) = delete;
+    FNexusLatentTask& operator=(const FNexusLatentTask&) = delete;
+    ~FNexusLatentTask() { Reset(); }
+
+    bool IsValid() const { return static_cast<bool>(Handle); }
+    bool IsDone() const { return !Handle || Handle.done(); }
+    bool GetResult() const { return Handle && Handle.done() && Handle.promise().bResult; }
+
+    /** Not finished and whatever it is waiting on has happened */
+    bool IsReadyToResume() const
+    {
+        if (IsDone())
+        {
+            return false;
+        }
+        const TFunction<bool()>& Condition = Handle.promise().WakeCondition;
+        return !Condition || Condition();
+    }
+
+    /** Run the body until its next co_await or co_return */
+    void Resume()
+    {
+        Handle.promise().WakeCondition.Reset();
+        Handle.resume();
+    }
+
+    /** Destroy the coroutine frame; a suspended body is abandoned and its locals destructed */
+    void Reset()
+    {
+        if (Handle)
+        {
+            Handle.destroy();
+            Handle = nullptr;
+        }
+    }
+
+private:
+    explicit FNexusLatentTask(std::coroutine_handle<promise_type> InHandle) : Handle(InHandle) {}
+
+    std::coroutine_handle<promise_type> Handle;
+};
+
+/**
+ * Base for co_await-able waits: suspends the test until IsSatisfied() returns true.
+ * The awaiter lives in the coroutine frame for the whole suspension, so the wake condition can point at it.
+ */
+template <typename TDerived>
+struct TNexusLatentAwaiter
+{
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<FNexusLatentTask::promise_type> Awaiting)
+    {
+        TDerived* Self = static_cast<TDerived*>(this);
+        Self->OnSuspend();
+        Awaiting.promise().WakeCondition = [Self]() { return Self->IsSatisfied(); };
+    }
+    void await_resume() const noexcept {}
+    void OnSuspend() {}
+};
+
+/**
+ * FNexusLatentRunner - Interleaves latent tests on the game thread
+ *
+ * Starts up to GetConfiguredConcurrency() tests at once, then steps frames: resume every test whose wait
+ * is over, then tick the test world, HTTP and game-thread tasks once. Fifty tests that each wait three
+ * seconds of game time finish in about three seconds. Retries back off in frames instead of sleeping,
+ * MaxDurationSeconds is enforced while the test is suspended, and dependencies (FNexusTestGraph) are
+ * honoured: a test starts once its prerequisites passed.
+ *
+ * The game thread is blocked for the duration of Run, so the runner ticks the world itself.
+ * Concurrency: -NexusLatentConcurrency=N or [/Script/Nexus.NexusSettings] LatentConcurrency=N (default 64).
+ */
+class NEXUS_API FNexusLatentRunner
+{
+public:
+    /** Context must outlive the runner; latent bodies keep a reference to it across frames */
+    explicit FNexusLatentRunner(const FNexusTestContext& InContext);
+
+    /** Run Tests interleaved until each one has a result; reports through UNexusCore/FPalantirObserver */
+    void Run(const TArray<FNexusTest*>& Tests, FNexusTestGraph* Graph = nullptr);
+
+    /**
+     * Drive a single task to completion on the calling thread (FNexusTest::Execute path for latent tests)
+     * @param TimeoutSeconds Abandon the body and fail after this long (0 = no limit)
+     */
+    static bool RunToCompletion(FNexusLatentTask Task, const FNexusTestContext& Context, double TimeoutSeconds = 0.0);
+
+    /** Frames stepped by the runner so far (Nexus::NextFrame/Frames count these) */
+    static uint64 GetFrameNumber();
+
+    /** Game time advanced by the runner so far (Nexus::Seconds counts this) */
+    static double GetTimeSeconds();
+
+    static int32 GetConfiguredConcurrency();
+
+private:
+    struct FLatentSlot
+    {
+        FNexusTest* Test = nullptr;
+        FNexusLatentTask Task;
+        uint32 Attempt = 0;
+        double AttemptStartTime = 0.0;
+        double NotBeforeSeconds = 0.0;  // Retry backoff
+        FPalantirBreadcrumbSnapshot Breadcrumbs;  // Breadcrumbs of the current attempt, gathered across frames
+        TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Token;  // Current attempt's token, made current on every resume
+    };
+
+    /** Start, resume or time out the slot's current attempt; true once the test has its final result */
+    bool TickSlot(FLatentSlot& Slot, double Now);
+    bool FinishAttempt(FLatentSlot& Slot, bool bResult);
+    void ReportResult(FNexusTest* Test, bool bPassed);
+    void SkipUnrunnable(FNexusTest* Test, const FString& Reason);
+
+    /** Sleep out the rest of the frame, then advance the latent clock and tick the test world, HTTP and game-thread tasks */
+    static void StepFrame(UWorld* World, double& InOutLastFrameTime);
+
+    const FNexusTestContext& Context;
+    FNexusTestGraph* Graph = nullptr;
+    bool bAborted = false;
+};
+
+namespace Nexus
+{
+    /** co_await Nexus::NextFrame(); - resume after the next frame step */
+    struct FNextFrame : TNexusLatentAwaiter<FNextFrame>
+    {
+        explicit FNextFrame(uint64 InFrames = 1) : Frames(FMath::Max<uint64>(1, InFrames)) {}
+        void OnSuspend() { TargetFrame = FNexusLatentRunner::GetFrameNumber() + Frames; }
+        bool IsSatisfied() const { return FNexusLatentRunner::GetFrameNumber() >= TargetFrame; }
+
+        uint64 Frames = 1;
+        uint64 TargetFrame = 0;
+    };
+
+    /** co_await Nexus::Seconds(2.0); - resume once this much game time has been stepped */
+    struct FSeconds : TNexusLatentAwaiter<FSeconds>
+    {
+        explicit FSeconds(double InSeconds) : Seconds(InSeconds) {}
+        void OnSuspend() { Deadline = FNexusLatentRunner::GetTimeSeconds() + Seconds; }
+        bool IsSatisfied() const { return FNexusLatentRunner::GetTimeSeconds() >= Deadline; }
+
+        double Seconds = 0.0;
+        double Deadline = 0.0;
+    };
+
+    /** if (!co_await Nexus::Until([&]{ return Door->IsOpen(); }, 5.0)) co_return false; - false on timeout */
+    struct FUntil : TNexusLatentAwaiter<FUntil>
+    {
+        FUntil(TFunction<bool()> InPredicate, double InTimeoutSeconds)
+            : Predicate(MoveTemp(InPredicate)), TimeoutSeconds(InTimeoutSeconds) {}
+        bool await_ready() { bSatisfied = Predicate(); return bSatisfied; }
+        void OnSuspend() { Deadline = TimeoutSeconds > 0.0 ? FNexusLatentRunner::GetTimeSeconds() + TimeoutSeconds : 0.0; }
+        bool IsSatisfied()
+        {
+            bSatisfied = Predicate();
+            return bSatisfied || (Deadline > 0.0 && FNexusLatentRunner::GetTimeSeconds() >= Deadline);
+        }
+        bool await_resume() const noexcept { return bSatisfied; }
+
+        TFunction<bool()> Predicate;
+        double TimeoutSeconds = 0.0;
+        double Deadline = 0.0;
+        bool bSatisfied = false;
+    };
+
+    inline FNextFrame NextFrame() { return FNextFrame(1); }
+    inline FNextFrame Frames(uint64 Count) { return FNextFrame(Count); }
+    inline FSeconds Seconds(double InSeconds) { return FSeconds(InSeconds); }
+    inline FUntil Until(TFunction<bool()> Predicate, double TimeoutSeconds = 0.0) { return FUntil(MoveTemp(Predicate), TimeoutSeconds); }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NexusSharding.h"
+
+class FNexusTest;
+
+/**
+ * FNexusResultCache - Per-test results keyed on the inputs the test was built from
+ *
+ * A test's inputs are the binary of the module that defines it (NEXUS_TEST records the module name) and
+ * the data files declared with NEXUS_TEST_DATA. Every run records, for each test it executed, an MD5 over
+ * those inputs plus the outcome. With -Incremental, tests whose inputs hash the same as last time and whose
+ * last result was a pass are not run again; they are reported as cached (passed) in LCARS/JUnit.
+ *
+ * Files are only re-hashed when their size or timestamp changed, and each module binary is hashed at most
+ * once per run. Stored in Saved/NexusReports/result_cache.json (one file per shard when sharded, all read back).
+ */
+class NEXUS_API FNexusResultCache
+{
+public:
+    explicit FNexusResultCache(const FNexusShardSpec& InShard = FNexusShardSpec());
+
+    /** -Incremental in Args or -NexusIncremental on the process command line */
+    static bool IsIncremental(const TArray<FString>& Args);
+
+    /** Directory holding the cache files */
+    static FString GetCacheDir();
+
+    /** Read every cache file in GetCacheDir(); the most recent entry per test wins */
+    void Load();
+
+    /**
+     * Report tests that can be served from the cache as cached passes and return the ones that must run.
+     * A test also runs when any of its prerequisites in Tests runs, so dependency gates stay meaningful.
+     * @param OutCachedCount Number of tests served from the cache
+     */
+    TArray<FNexusTest*> FilterUnchanged(const TArray<FNexusTest*>& Tests, int32& OutCachedCount);
+
+    /** Store the outcome of every test in Tests that finished after RunStart (skipped tests keep their old entry) */
+    void RecordResults(const TArray<FNexusTest*>& Tests, const FDateTime& RunStart);
+
+    bool Save() const;
+
+    /** MD5 over the test's module binary and data dependencies; empty if the module can't be resolved */
+    FString ComputeInputsHash(const FNexusTest& Test);
+
+private:
+    struct FFileStamp
+    {
+        int64 Size = -1;
+        FDateTime Modified;
+        FString Hash;
+    };
+
+    struct FEntry
+    {
+        FString Inputs;
+        bool bPassed = false;
+        double DurationSeconds = 0.0;
+        FDateTime RecordedAt;
+    };
+
+    FString HashFile(const FString& Path);
+    FString HashModule(const FString& ModuleName);
+
+    FNexusShardSpec Shard;
+    TMap<FString, FFileStamp> Files;      // Absolute path -> last known stamp and hash
+    TMap<FString, FEntry> Entries;        // Test name -> last recorded result
+    TMap<FString, FString> ModuleHashes;  // Module name -> binary hash, this run only
+    TMap<FString, FString> InputsByTest;  // Test name -> inputs hash, this run only
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include "CoreMinimal.h"
+
+struct FNexusTestResult;
+
+/**
+ * FNexusResultCollector - Lock-free hand-off of finished test results
+ *
+ * Workers publish results to a multi-producer/single-consumer queue instead of appending to
+ * FNexusTest::AllResults directly. The queue is merged into AllResults by Flush, which RunAllTests
+ * calls once at the end of a run; readers of AllResults call it first to pick up anything still queued.
+ */
+class NEXUS_API FNexusResultCollector
+{
+public:
+    /** Publish a final result; safe from any thread and never blocks on other producers */
+    static void Record(const FNexusTestResult& Result);
+
+    /** Move every queued result into FNexusTest::AllResults, symbolicating failure stacks; returns how many were merged */
+    static int32 Flush();
+
+    /** Drop queued results without merging them (used when clearing history) */
+    static void Discard();
+
+    /** Results recorded but not yet flushed */
+    static int32 GetPendingCount();
+};
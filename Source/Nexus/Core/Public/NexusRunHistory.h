@@ -0,0 +1,162 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Templates/Function.h"
+#include "NexusSharding.h"
+
+class FNexusTest;
+
+/**
+ * Final status of one recorded execution
+ */
+enum class ENexusHistoryStatus : uint8
+{
+    Passed,
+    Failed,
+    TimedOut
+};
+
+NEXUS_API const TCHAR* LexToString(ENexusHistoryStatus Status);
+
+/**
+ * One execution of one test, as read back from the history store
+ */
+struct NEXUS_API FNexusHistoryRun
+{
+    FDateTime Timestamp;
+    double DurationSeconds = 0.0;
+    ENexusHistoryStatus Status = ENexusHistoryStatus::Passed;
+    bool bQuarantined = false;   // Ran in the quarantine lane
+    uint32 Attempts = 1;
+    FString TraceID;             // Only filled when asked for (GetRecentRuns bResolveTraceIds, ForEachRun)
+
+    bool Passed() const { return Status == ENexusHistoryStatus::Passed; }
+};
+
+/**
+ * Totals of one test over its whole recorded history
+ */
+struct NEXUS_API FNexusHistorySummary
+{
+    int64 Runs = 0;
+    int64 Passes = 0;
+    double AverageSeconds = 0.0;
+    double MedianSeconds = 0.0;  // Over the recent window
+
+    double GetPassRate() const { return Runs > 0 ? static_cast<double>(Passes) / Runs : 0.0; }
+};
+
+/**
+ * FNexusRunHistory - Persistent, append-only columnar store of every test execution
+ *
+ * Saved/NexusReports/history/ holds one file per column, each a flat array of fixed-width values
+ * appended once per run:
+ *   test_id.col (uint32, index into tests.txt)  timestamp.col (int64 ticks)  duration.col (float seconds)
+ *   status.col (uint8)  attempts.col (uint8)  trace_id.col (16 bytes)
+ * Test names are interned in tests.txt (one per line, the line number is the test ID). Row N is the N-th
+ * value of every column; a torn append is cut back to the shortest column before the next one.
+ * Sharded runs write their own store (history/shard-K-of-N/) so shard processes never share a file; every
+ * store is read back.
+ *
+ * Queries never load the columns into memory: the first one maps them and makes a single pass, keeping
+ * per-test totals, the last HistoryRecentRuns executions of each test (default 32, at least FlakyWindow)
+ * and a log-bucket histogram of all durations. Rows recorded later in the process are folded in directly.
+ * Average, median and regression queries (UNexusCore), flakiness windows (FNexusFlakiness) and the duration
+ * estimates behind LPT scheduling and sharding all read from here.
+ */
+class NEXUS_API FNexusRunHistory
+{
+public:
+    static FNexusRunHistory& Get();
+
+    static FString GetHistoryDir();
+
+    /** Executions kept per test for windowed queries */
+    static int32 GetRecentWindow();
+
+    /**
+     * Append one row per test in Tests that executed after RunStart (skipped and cached tests are not recorded)
+     * @return rows appended
+     */
+    int32 RecordResults(const TArray<FNexusTest*>& Tests, const FDateTime& RunStart, const FNexusShardSpec& Shard = FNexusShardSpec());
+
+    /** Mean duration over every recorded execution of TestName (all tests when empty); 0 without history */
+    double GetAverageDuration(const FString& TestName = TEXT(""));
+
+    /** Median duration of TestName's recent executions; over all history (histogram estimate, ~1%) when empty */
+    double GetMedianDuration(const FString& TestName = TEXT(""));
+
+    /** Expected duration for scheduling: median of TestName's recent passing executions */
+    bool GetExpectedDuration(const FString& TestName, double& OutSeconds);
+
+    FNexusHistorySummary GetSummary(const FString& TestName);
+
+    /** Recent executions of TestName, oldest first */
+    TArray<FNexusHistoryRun> GetRecentRuns(const FString& TestName, bool bResolveTraceIds = false);
+
+    TArray<FString> GetTestNames();
+
+    /** Every recorded execution, store by store in append order, streamed from the mapped columns */
+    void ForEachRun(TFunctionRef<void(const FString& TestName, const FNexusHistoryRun& Run)> Visitor);
+
+    int64 GetRowCount();
+
+    /** Forget the in-memory index; the next query re-reads the store (the files are never deleted) */
+    void Reset();
+
+    /**
+     * Read and append to the store in Dir instead of GetHistoryDir (empty switches back), then Reset.
+     * For tests that record executions without touching the project's history.
+     */
+    void SetDirectory(const FString& Dir);
+
+private:
+    struct FRecentEntry
+    {
+        int64 Ticks = 0;
+        float DurationSeconds = 0.0f;
+        uint8 Status = 0;
+        uint8 Attempts = 1;
+        int32 StoreIndex = 0;
+        int64 Row = 0;
+    };
+
+    struct FTestIndex
+    {
+        FString Name;
+        int64 Runs = 0;
+        int64 Passes = 0;
+        double TotalSeconds = 0.0;
+        TArray<FRecentEntry> Recent;  // Up to 2x the window between compactions; oldest first once compacted
+    };
+
+    struct FStore
+    {
+        FString Dir;
+        TArray<FString> TestNames;     // Local test ID -> name (tests.txt)
+        TMap<FString, uint32> TestIds;
+        TArray<int32> Slots;           // Local test ID -> Tests index
+        int64 Rows = 0;
+    };
+
+    FString GetDirectoryLocked() const { return Directory.IsEmpty() ? GetHistoryDir() : Directory; }
+    void EnsureIndexLocked();
+    int32 FindOrAddStoreLocked(const FString& Dir);
+    int32 FindOrAddSlotLocked(const FString& Name);
+    void AddRowLocked(FStore& Store, int32 StoreIndex, int64 Row, uint32 LocalTestId, int64 Ticks, float DurationSeconds, uint8 Status, uint8 Attempts);
+    void CompactLocked(FTestIndex& Test) const;
+    FTestIndex* FindTestLocked(const FString& TestName);
+    FNexusHistoryRun MakeRun(const FRecentEntry& Entry) const;
+    FString ReadTraceIdLocked(const FRecentEntry& Entry) const;
+
+    FCriticalSection Lock;
+    FString Directory;  // Overrides GetHistoryDir when set
+    bool bIndexed = false;
+    int32 Window = 32;
+    TArray<FStore> Stores;
+    TArray<FTestIndex> Tests;
+    TMap<FString, int32> TestSlots;
+    int64 TotalRuns = 0;
+    double TotalSeconds = 0.0;
+    TArray<int64> DurationHistogram;
+};
@@ -0,0 +1,166 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "NexusConcurrency.h"
+#include <atomic>
+
+class FNexusTest;
+class FEvent;
+
+/**
+ * A single unit of work owned by the scheduler
+ */
+struct NEXUS_API FNexusScheduledTest
+{
+    FNexusTest* Test = nullptr;
+    double PredictedSeconds = 0.0;  // LPT weight, taken from the persisted baseline
+    int32 PriorityRank = 0;         // Higher runs earlier (Critical > Smoke > Normal)
+    uint32 Attempt = 0;             // Attempts already run; > 0 means this is a pending retry
+    double NotBeforeSeconds = 0.0;  // FPlatformTime::Seconds() before which the job must not start
+    ENexusResourceClass ResourceClass = ENexusResourceClass::Default;  // Admission class for FNexusConcurrencyGovernor
+};
+
+/**
+ * What the scheduler should do with a job once the body returns
+ */
+enum class ENexusJobResult : uint8
+{
+    Completed,   // Job is finished
+    Reschedule   // Requeue the job; it becomes runnable again at NotBeforeSeconds
+};
+
+/**
+ * FNexusScheduler - Duration-aware work-stealing scheduler for parallel-safe tests
+ *
+ * Tests are ordered longest-processing-time-first (LPT) within their priority class, using the median
+ * of each test's recent passing runs in FNexusRunHistory (else the FPalantirObserver baseline), and dealt to per-worker deques so every
+ * worker starts with roughly the same predicted load. A worker pops the next longest test from its own
+ * deque; an idle worker steals the shortest test from the peer with the most predicted work left,
+ * which absorbs bad predictions without moving the long tests that dominate makespan. Tests sharing a
+ * suite fixture (FNexusFixture) are dealt to the same worker as long as that keeps the loads balanced.
+ *
+ * Jobs can be rescheduled with a not-before timestamp (retry backoff): the job goes back on the
+ * worker's deque and the worker picks up other tests until it becomes runnable again.
+ *
+ * A worker whose test ignores the watchdog's cancellation past the grace period is abandoned: a
+ * replacement worker takes over its deque, reports the hung job through the abandon handler and carries
+ * on. The hung thread is left running (and leaked) - it unwinds on its own if the test ever returns.
+ *
+ * Worker count defaults to the engine's worker thread count and can be overridden with
+ * -NexusWorkers=N or [/Script/Nexus.NexusSettings] MaxParallelWorkers. With a concurrency governor
+ * (EnableGovernor), extra threads are started and a job only starts once the governor admits its
+ * resource class; a worker skips jobs it can't start yet and takes the next admissible one.
+ */
+class NEXUS_API FNexusScheduler
+{
+public:
+    typedef TFunction<ENexusJobResult(FNexusScheduledTest& Job, int32 WorkerIndex)> FTestBody;
+    typedef TFunction<void(FNexusScheduledTest& Job, int32 WorkerIndex, double HungSeconds)> FAbandonHandler;
+    typedef TFunction<void(FNexusScheduledTest& Job, int32 WorkerIndex)> FSkipHandler;
+
+    explicit FNexusScheduler(int32 InNumWorkers = 0);
+    ~FNexusScheduler();
+
+    /** Order tests LPT-first within priority class and distribute them across worker deques */
+    void Enqueue(const TArray<FNexusTest*>& Tests);
+
+    /** Spawn workers and block until every enqueued test has run (or been dropped by Cancel) */
+    void Run(FTestBody InBody);
+
+    /**
+     * Limit how many of the workers run jobs at once, adjusted at runtime (see FNexusConcurrencyGovernor)
+     * @param InitialConcurrency Slots for CPU and undeclared tests at the start; grows up to the worker count
+     * Call before Run.
+     */
+    void EnableGovernor(int32 InitialConcurrency);
+
+    /**
+     * Called on the replacement worker for a job whose thread the watchdog abandoned; the job then counts
+     * as completed. The body must not touch its captures after ExecuteAttempt if the thread was abandoned.
+     * Call before Run.
+     */
+    void SetAbandonHandler(FAbandonHandler InHandler) { AbandonHandler = MoveTemp(InHandler); }
+
+    /**
+     * Called for every test Cancel kept from starting: on a worker for a first attempt still queued, and on
+     * the cancelling thread (WorkerIndex INDEX_NONE) for a test still waiting on prerequisites. The test then
+     * counts as completed. Call before Run.
+     */
+    void SetSkipHandler(FSkipHandler InHandler) { SkipHandler = MoveTemp(InHandler); }
+
+    /**
+     * Dependency support: Tests are waiting on prerequisites and will arrive later via ReleasePending
+     * (or never, via DropPending or Cancel). Workers stay alive until every pending test is accounted for.
+     * Call before Run.
+     */
+    void AddPending(const TArray<FNexusTest*>& Tests);
+
+    /**
+     * A pending test's prerequisites passed - queue it at the back of WorkerIndex's deque so it runs next
+     * there (idle peers can still steal it). Safe from inside the body.
+     * @return false if Cancel already dropped the pending test
+     */
+    bool ReleasePending(FNexusTest* Test, int32 WorkerIndex);
+
+    /** A pending test will never run (a prerequisite failed); no-op if it was already released or dropped */
+    void DropPending(FNexusTest* Test);
+
+    /**
+     * Stop handing out new tests; tests already running finish normally.
+     * Pending retries are handed to the body immediately (ignoring NotBeforeSeconds) so it can finalize them;
+     * queued first attempts and tests still waiting on prerequisites go to the skip handler.
+     */
+    void Cancel();
+    bool IsCancelled() const { return bCancelled.load(); }
+
+    int32 GetNumWorkers() const { return NumWorkers; }
+
+    /** Worker count from -NexusWorkers=N, config, or the engine's worker thread count */
+    static int32 GetDefaultWorkerCount();
+
+    /** Critical (2) > Smoke (1) > everything else (0) */
+    static int32 GetPriorityRank(const FNexusTest* Test);
+
+    /** Predicted duration from baseline, or DefaultSeconds if the test has no history */
+    static double PredictDuration(const FNexusTest* Test, double DefaultSeconds);
+
+private:
+    class FWorker;
+
+    struct FWorkerQueue
+    {
+        FCriticalSection Lock;
+        // Sorted ascending by (rank, predicted duration): owner pops from the back, thieves take from the front.
+        // Rescheduled jobs are pushed on the back so in-flight tests finish before new ones start.
+        TArray<FNexusScheduledTest> Jobs;
+        double RemainingSeconds = 0.0;
+    };
+
+    bool TryPopLocal(int32 WorkerIndex, FNexusScheduledTest& OutJob);
+    bool TrySteal(int32 ThiefIndex, FNexusScheduledTest& OutJob);
+    bool IsRunnable(const FNexusScheduledTest& Job, double Now) const;
+    bool TryAdmit(const FNexusScheduledTest& Job);
+    int32 CountRunnableJobs() const;
+    void Reschedule(int32 WorkerIndex, const FNexusScheduledTest& Job);
+    void WorkerLoop(FWorker& Worker);
+    void StartWorker(TUniquePtr<FWorker> Worker);
+    void AbandonWorker(FWorker& Worker);
+    bool ClaimPending(FNexusTest* Test);
+    void CompleteJobs(int32 Count);
+
+    int32 NumWorkers = 1;
+    TArray<TUniquePtr<FWorkerQueue>> Queues;
+    FTestBody Body;
+    FAbandonHandler AbandonHandler;
+    FSkipHandler SkipHandler;
+    TUniquePtr<FNexusConcurrencyGovernor> Governor;
+    FEvent* WorkEvent = nullptr;
+    FEvent* DoneEvent = nullptr;
+    FCriticalSection WorkersLock;
+    TArray<TUniquePtr<FWorker>> Workers;  // Includes replacements; abandoned ones are released (leaked) at the end of Run
+    std::atomic<int32> LiveWorkers{0};   // Workers still in their loop, not counting abandoned ones
+    std::atomic<int32> Outstanding{0};   // Queued, running and pending tests
+    FCriticalSection PendingLock;
+    TSet<FNexusTest*> PendingTests;      // Waiting on prerequisites (subset of Outstanding)
+    std::atomic<bool> bCancelled{false};
+};
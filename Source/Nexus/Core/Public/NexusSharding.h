@@ -0,0 +1,48 @@
+#pragma once
+#include "CoreMinimal.h"
+
+class FNexusTest;
+
+/**
+ * Shard selector parsed from -Shard=K/N (K is 1-based)
+ */
+struct NEXUS_API FNexusShardSpec
+{
+    int32 Index = 0;  // 0-based shard index
+    int32 Count = 1;  // Total number of shards
+
+    bool IsSharded() const { return Count > 1; }
+
+    /** Parse "K/N" with 1 <= K <= N */
+    static bool Parse(const FString& Spec, FNexusShardSpec& OutSpec);
+
+    /** "K/N" (1-based, as given on the command line) */
+    FString ToString() const;
+};
+
+/**
+ * FNexusSharding - Deterministic cross-process test partitioning
+ *
+ * Every shard process computes the same partition independently: tests are sorted by name, tests with
+ * recorded durations (FNexusRunHistory, then the baseline) are dealt longest-first to the shard with the least
+ * predicted runtime, and tests with no history are placed by a stable hash of their name. Tests connected
+ * by NEXUS_TEST_DEPENDS are placed together so prerequisites always run on the same shard.
+ * Each shard writes a result file that Nexus.MergeShards folds back into a single LCARS/JUnit report.
+ */
+class NEXUS_API FNexusSharding
+{
+public:
+    /** Find -Shard=K/N in Args, falling back to the process command line */
+    static bool ParseFromArgs(const TArray<FString>& Args, FNexusShardSpec& OutSpec);
+
+    /** Tests that belong to this shard; the union over all shards is exactly Tests */
+    static TArray<FNexusTest*> Partition(const TArray<FNexusTest*>& Tests, const FNexusShardSpec& Spec);
+
+    /** Write this shard's results to Saved/NexusReports/shards/ and return the file path */
+    static FString WriteShardResults(const FNexusShardSpec& Spec);
+
+    /** Merge every shard result file in Directory into FPalantirOracle; returns number of files merged */
+    static int32 MergeShardResults(const FString& Directory = TEXT(""));
+
+    static FString GetShardResultsDir();
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/**
+ * FNexusSymbolicator - Deferred, cached stack symbolication
+ *
+ * Resolving program counters to function/file/line is slow (debug info is loaded and searched on first
+ * use, and it is slowest on Linux with large DWARF sections), so a failing test only records raw program
+ * counters (CaptureBackTrace) and queues them (Enqueue). A background thread resolves the queued frames
+ * into a per-address cache while the run carries on; FNexusResultCollector::Flush waits for it and fills
+ * FNexusTestResult::StackTrace from the cache before any report is written. A failure-heavy run resolves
+ * each distinct address once instead of walking and symbolizing the whole stack on every failing worker.
+ *
+ * All symbol lookups (including the watchdog's) go through the cache lock, so the platform symbol engine
+ * is never entered from two threads at once.
+ */
+class NEXUS_API FNexusSymbolicator
+{
+public:
+    static constexpr int32 MaxFrames = 32;
+
+    /**
+     * Record the calling thread's program counters; no symbol lookup
+     * @param FramesToSkip Innermost frames to drop (this function by default)
+     */
+    static void CaptureBackTrace(TArray<uint64>& OutFrames, int32 FramesToSkip = 1);
+
+    /** Queue frames for background symbolication; safe from any thread and never blocks on a lookup */
+    static void Enqueue(const TArray<uint64>& Frames);
+
+    /** Resolve frames on the calling thread, using (and filling) the cache; one line per frame */
+    static TArray<FString> Symbolicate(const uint64* Frames, int32 NumFrames);
+    static TArray<FString> Symbolicate(const TArray<uint64>& Frames);
+
+    /** Block until every queued frame has been resolved */
+    static void WaitForPending();
+
+    /** Distinct addresses resolved so far */
+    static int32 GetCachedAddressCount();
+
+    /** Stop the background thread and drop the cache (module shutdown) */
+    static void Shutdown();
+};
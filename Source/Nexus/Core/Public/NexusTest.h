@@ -2,8 +2,20 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "Nexus/Palantir/Public/PalantirTrace.h"
+#include "Nexus/Palantir/Public/PalantirTimeline.h"
+#include "Nexus/Palantir/Public/PalantirExporter.h"
+#include "NexusResultCollector.h"
+#include "NexusLatent.h"
+#include "NexusCancellation.h"
+#include "NexusWatchdog.h"
+#include "NexusTestRegistry.h"
+#include "NexusFixture.h"
+#include "NexusTestDescriptor.h"
+#include "NexusActorPool.h"
+#include "NexusConcurrency.h"
+#include "NexusSymbolication.h"
+#include "Nexus/Palantir/Public/PalantirOracle.h"
 #include "NexusModule.h"
-#include "HAL/PlatformStackWalk.h"
 
 // Forward declarations
 class UNexusCore;
@@ -27,6 +39,19 @@ struct NEXUS_API FTestPerformanceMetrics
     }
 };
 
+/**
+ * Outcome of a single attempt of a test
+ * One record per try, so retried tests keep the history of every failed attempt
+ */
+struct NEXUS_API FNexusAttemptRecord
+{
+    uint32 Attempt = 1;
+    bool bPassed = false;
+    bool bTimedOut = false;       // Overran its deadline (watchdog or MaxDurationSeconds)
+    double DurationSeconds = 0.0;
+    FPalantirBreadcrumbSnapshot Breadcrumbs;  // Breadcrumbs recorded during this attempt (raw events, formatted on demand)
+};
+
 /**
  * Test execution result with diagnostic information
  * Captured for every test execution and used for reporting/analysis
@@ -36,11 +61,16 @@ struct NEXUS_API FNexusTestResult
     FString TestName;
     bool bPassed = false;
     bool bSkipped = false;       // true if test was skipped (not passed or failed)
+    bool bTimedOut = false;      // true if the final attempt failed by overrunning its deadline
+    bool bQuarantined = false;   // true if the test ran in the quarantine lane (reported apart from passes and failures)
     double DurationSeconds = 0.0;
     uint32 Attempts = 1;
     FString ErrorMessage;        // Error message if test failed or skipped
-    TArray<FString> StackTrace;  // Stack trace on failure (diagnostic info)
+    TArray<FString> StackTrace;  // Stack trace on failure, symbolicated from StackFrames by FNexusResultCollector::Flush
+    TArray<uint64> StackFrames;  // Raw program counters captured at failure time
     FDateTime Timestamp = FDateTime::Now();
+    FString TraceID;             // Trace ID shared by every attempt of this execution
+    TArray<FNexusAttemptRecord> AttemptHistory;  // Per-attempt results and breadcrumbs
     
     bool HasStackTrace() const
     {
@@ -63,6 +93,17 @@ struct NEXUS_API FNexusTestResult
     }
 };
 
+/**
+ * Result of FNexusTest::ExecuteAttempt
+ * Retry means the attempt failed but retries remain - the caller decides how to wait
+ */
+enum class ENexusAttemptOutcome : uint8
+{
+    Passed,
+    Failed,
+    Retry
+};
+
 #if !defined(NEXUS_API)
     #define NEXUS_API
 #endif
@@ -130,6 +171,24 @@ struct NEXUS_API FNexusTestContext
         return World != nullptr && !World->bIsTearingDown;
     }
     
+    /**
+     * Check if the running attempt has been asked to stop (deadline passed or run aborted)
+     * Long-running tests should poll this and return false promptly instead of running on.
+     */
+    bool IsCancellationRequested() const
+    {
+        return FNexusCancellationToken::IsCurrentCancelled();
+    }
+    
+    /**
+     * Token of the running attempt, for handing to work the test starts on other threads
+     * @return nullptr outside a test attempt
+     */
+    TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> GetCancellationToken() const
+    {
+        return FNexusCancellationToken::GetCurrent();
+    }
+    
     /**
      * Spawn a test character with automatic cleanup tracking
      * @param CharClass Character class to spawn
@@ -146,10 +205,19 @@ struct NEXUS_API FNexusTestContext
             return nullptr;
         }
         
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
-        
-        ACharacter* Character = World->SpawnActor<ACharacter>(CharClass, Location, Rotation, SpawnParams);
+        ACharacter* Character = nullptr;
+        if (FNexusActorPool::IsEnabled())
+        {
+            // Reactivate a pooled character instead of spawning (CleanupSpawnedActors returns it to the pool)
+            Character = FNexusActorPool::Get().Acquire<ACharacter>(World, CharClass.Get(), Location, Rotation);
+        }
+        else
+        {
+            FActorSpawnParameters SpawnParams;
+            SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+            
+            Character = World->SpawnActor<ACharacter>(CharClass, Location, Rotation, SpawnParams);
+        }
         if (Character)
         {
             // Explicitly cast ACharacter* to AActor* for storage in polymorphic array
@@ -159,13 +227,13 @@ struct NEXUS_API FNexusTestContext
     }
     
     /**
-     * Cleanup all spawned actors tracked by this context
+     * Cleanup all spawned actors tracked by this context (pooled actors go back to FNexusActorPool)
      */
     void CleanupSpawnedActors()
     {
         for (AActor* Actor : SpawnedActors)
         {
-            if (Actor && !Actor->IsActorBeingDestroyed())
+            if (Actor && !Actor->IsActorBeingDestroyed() && !FNexusActorPool::Get().Release(Actor))
             {
                 Actor->Destroy();
             }
@@ -255,22 +323,31 @@ class NEXUS_API FNexusTest
 {
 public:
     FString TestName;
+    FNexusTestId TestId = INDEX_NONE;  // Dense ID assigned by FNexusTestRegistry at discovery
     ETestPriority Priority = ETestPriority::Normal;
     ETestTag Tags = ETestTag::None;  // Tags for filtering tests (Networking, Performance, etc.)
     TArray<FString> CustomTags;  // Custom string-based tags for project-specific categorization
+    TArray<FString> Prerequisites;  // Names of tests that must pass before this one runs (see NEXUS_TEST_DEPENDS)
     bool bRequiresGameThread = false;  // Flag for game-thread-only tests
     bool bSkip = false;  // Flag to skip test execution
     uint32 MaxRetries = 0;  // Number of times to retry on failure (default: 0 = no retries)
+    ENexusResourceClass ResourceClass = ENexusResourceClass::Default;  // What the test loads; the concurrency governor admits by it (see NEXUS_TEST_RESOURCE)
+    bool bQuarantined = false;  // Flaky per FNexusFlakiness: runs last, once, outside fail-fast (set for each run by ApplyQuarantine)
     double MaxDurationSeconds = 0.0;  // Maximum test duration in seconds (0 = unlimited)
+    FString SourceFile;  // File the test is defined in (recorded by the NEXUS_TEST macros)
+    FString ModuleName;  // Module whose binary holds the test body; an input of incremental runs (see FNexusResultCache)
+    TArray<FString> DataDependencies;  // Project-relative data files the test reads (see NEXUS_TEST_DATA)
+    TArray<FString> Fixtures;  // Names of the suite fixtures the test uses (see NEXUS_TEST_FIXTURE)
     TFunction<bool(const FNexusTestContext&)> TestFunc;
+    TFunction<FNexusLatentTask(const FNexusTestContext&)> LatentFunc;  // Coroutine body of NEXUS_TEST_LATENT tests (TestFunc then runs it to completion)
     TFunction<bool(const FNexusTestContext&)> BeforeEach;  // Setup/fixture - called before each test attempt
     TFunction<void(const FNexusTestContext&)> AfterEach;   // Teardown/cleanup - called after each test attempt
     mutable FNexusTestResult LastResult;  // Result of last execution (mutable for const Execute())
 
-    // Static list of all test instances - populated automatically at load time
-    // when NEXUS_TEST() static objects are constructed
+    // Static list of all test instances - filled by the FNexusTest constructor, which runs when
+    // FNexusTestDescriptor::MaterializeAll creates the tests the NEXUS_TEST() macros registered
     static TArray<FNexusTest*> AllTests;
-    static TArray<FNexusTestResult> AllResults;  // History of all test results for trend analysis
+    static TArray<FNexusTestResult> AllResults;  // History of all test results for trend analysis (call FNexusResultCollector::Flush before reading)
 
     FNexusTest(const FString& InName, ETestPriority InPriority, TFunction<bool(const FNexusTestContext&)> InFunc, bool bInRequiresGameThread = false, std::initializer_list<FString> Tags = {})
         : TestName(InName), Priority(InPriority), bRequiresGameThread(bInRequiresGameThread), TestFunc(MoveTemp(InFunc))
@@ -302,6 +379,10 @@ public:
         if (!CustomTag.IsEmpty() && !CustomTags.Contains(CustomTag))
         {
             CustomTags.Add(CustomTag);
+            if (TestId != INDEX_NONE)
+            {
+                FNexusTestRegistry::Get().AddTag(TestId, CustomTag);
+            }
         }
     }
 
@@ -324,6 +405,71 @@ public:
         return CustomTags;
     }
 
+    /**
+     * Declare that this test only runs after PrerequisiteName has passed in the same run
+     * @param PrerequisiteName TestName of the prerequisite (e.g., "Backend.Health")
+     */
+    void AddPrerequisite(const FString& PrerequisiteName)
+    {
+        if (!PrerequisiteName.IsEmpty() && PrerequisiteName != TestName)
+        {
+            Prerequisites.AddUnique(PrerequisiteName);
+        }
+    }
+
+    /**
+     * Dense registry ID; tests that were never discovered are looked up (and interned) by name
+     */
+    FNexusTestId GetId() const
+    {
+        return TestId != INDEX_NONE ? TestId : FNexusTestRegistry::Get().FindOrAddId(TestName);
+    }
+
+    /**
+     * Record where the test is defined; the NEXUS_TEST macros call this with __FILE__ and the module being built
+     */
+    void SetSourceLocation(const FString& InSourceFile, const FString& InModuleName)
+    {
+        SourceFile = InSourceFile;
+        ModuleName = InModuleName;
+    }
+
+    /**
+     * Declare a data file the test reads, so incremental runs re-run it when the file changes
+     * @param ProjectRelativePath Path relative to the project directory (e.g., "Content/Maps/Arena.umap")
+     */
+    void AddDataDependency(const FString& ProjectRelativePath)
+    {
+        if (!ProjectRelativePath.IsEmpty())
+        {
+            DataDependencies.AddUnique(ProjectRelativePath);
+        }
+    }
+
+    /**
+     * Declare that the test uses a suite fixture; it is built before the test's first attempt and shared
+     * @param FixtureName Name the FNexusFixture was constructed with (e.g., "Arena")
+     */
+    void UseFixture(const FString& FixtureName)
+    {
+        if (!FixtureName.IsEmpty())
+        {
+            Fixtures.AddUnique(FixtureName);
+        }
+    }
+
+    /**
+     * Latent tests (NEXUS_TEST_LATENT) can be interleaved by FNexusLatentRunner
+     */
+    bool IsLatent() const
+    {
+        return static_cast<bool>(LatentFunc);
+    }
+
+    /**
+     * Run the test to completion on the calling thread, sleeping between retries
+     * The parallel scheduler drives BeginExecution/ExecuteAttempt itself so retry backoff never parks a worker
+     */
     bool Execute(const FNexusTestContext& Context = FNexusTestContext()) const
     {
         // Check if test should be skipped
@@ -335,117 +481,302 @@ public:
             return true;  // Return true to signal graceful skip (not a failure)
         }
         
-        // RAII guard automatically creates and cleans up trace context
-        FPalantirTraceGuard TraceGuard;
-        
-        const TCHAR* PriorityStr = NexusHasFlag(Priority, ETestPriority::Critical) ? TEXT("CRITICAL") : TEXT("NORMAL");
-        UE_LOG_TRACE(LogNexus, Display, TEXT("RUNNING: %s [%s]"), *TestName, PriorityStr);
-        PALANTIR_BREADCRUMB(TEXT("TestStart"), TestName);
+        BeginExecution();
         
-        // Execute test with retry logic and timeout handling
-        bool bResult = false;
         uint32 Attempt = 0;
-        uint32 MaxAttempts = 1 + MaxRetries;  // Total attempts = 1 initial + retries
-        
-        while (Attempt < MaxAttempts)
+        ENexusAttemptOutcome Outcome = ENexusAttemptOutcome::Retry;
+        while (Outcome == ENexusAttemptOutcome::Retry)
         {
             ++Attempt;
-            
-            // Call setup fixture (BeforeEach) if provided
-            bool bSetupSuccess = true;
-            if (BeforeEach)
+            Outcome = ExecuteAttempt(Context, Attempt);
+            if (Outcome == ENexusAttemptOutcome::Retry)
             {
-                bSetupSuccess = BeforeEach(Context);
-                if (!bSetupSuccess)
-                {
-                    UE_LOG(LogNexus, Error, TEXT("Setup fixture failed for %s"), *TestName);
-                    bResult = false;
-                }
+                FPalantirTimelineScope BackoffSpan(TestName, TEXT("retry"));
+                FPlatformProcess::Sleep(GetRetryDelaySeconds(Attempt));
             }
+        }
+        
+        return Outcome == ENexusAttemptOutcome::Passed;
+    }
+    
+    /**
+     * Reset the result and mint the trace ID shared by all attempts of this execution
+     */
+    void BeginExecution() const
+    {
+        LastResult = FNexusTestResult();
+        LastResult.TestName = TestName;
+        LastResult.TraceID = FPalantirTrace::GenerateTraceID();
+        FPalantirTimeline::BeginAsyncSpan(TestName, TEXT("execution"), GetTimelineId());
+    }
+    
+    /**
+     * Timeline ID of the current execution (pairs the async span from BeginExecution to CompleteExecution)
+     */
+    uint64 GetTimelineId() const
+    {
+        return (static_cast<uint64>(GetId()) << 32) | GetTypeHash(LastResult.TraceID);
+    }
+    
+    /**
+     * Attempts this execution may use: 1 + MaxRetries, or a single one while quarantined (retries are not spent on flaky tests)
+     */
+    uint32 GetMaxAttempts() const
+    {
+        return bQuarantined ? 1 : 1 + MaxRetries;
+    }
+    
+    /**
+     * Exponential backoff before the next attempt: 1s, 2s, 4s, 8s, etc.
+     * @param Attempt The attempt that just failed (1-based)
+     */
+    double GetRetryDelaySeconds(uint32 Attempt) const
+    {
+        return FMath::Pow(2.0, static_cast<double>(Attempt) - 1.0);
+    }
+    
+    /**
+     * Run one attempt (BeforeEach, TestFunc, AfterEach) under this execution's trace ID
+     * Completes the result when the attempt passes or was the last one allowed.
+     * Safe to call for successive attempts from different threads.
+     * The body runs under FNexusWatchdog with a fresh cancellation token. If the watchdog abandoned the
+     * calling thread meanwhile, the attempt was already reported for us and nothing here is touched again.
+     * @param Attempt 1-based attempt number
+     * @return Retry if the attempt failed and retries remain, otherwise the final outcome
+     */
+    ENexusAttemptOutcome ExecuteAttempt(const FNexusTestContext& Context, uint32 Attempt) const
+    {
+        // Re-enter this execution's trace so every attempt (and every thread) shares one trace ID
+        FPalantirTraceGuard TraceGuard(LastResult.TraceID);
+        FPalantirSpan AttemptSpan(TestName, TEXT("test"));
+        
+        FNexusAttemptRecord Record;
+        Record.Attempt = Attempt;
+        bool bResult = false;
+        
+        // Run test only if setup succeeded
+        if (BeginAttempt(Context, Attempt))
+        {
+            const TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe> Token = FNexusRunCancellation::MakeAttemptToken();
+            FNexusCancellationScope CancellationScope(Token);
+            FNexusWatchdog::FScope Watch(GetId(), TestName, FNexusWatchdog::GetTimeoutSeconds(MaxDurationSeconds), Token);
             
-            // Run test only if setup succeeded
-            if (bSetupSuccess)
+            double StartTime = FPlatformTime::Seconds();
             {
-                double StartTime = FPlatformTime::Seconds();
+                FPalantirSpan BodySpan(TEXT("TestFunc"), TEXT("phase"));
                 bResult = TestFunc(Context);
-                double Duration = FPlatformTime::Seconds() - StartTime;
-                
-                // Check if test exceeded timeout
-                if (MaxDurationSeconds > 0.0 && Duration > MaxDurationSeconds)
-                {
-                    UE_LOG(LogNexus, Error, TEXT("TIMEOUT: %s exceeded max duration: %.2fs > %.2fs"), 
-                        *TestName, Duration, MaxDurationSeconds);
-                    PALANTIR_BREADCRUMB(TEXT("Timeout"), 
-                        FString::Printf(TEXT("Duration: %.2fs, Limit: %.2fs"), Duration, MaxDurationSeconds));
-                    bResult = false;  // Timeout = test failure
-                }
             }
+            Record.DurationSeconds = FPlatformTime::Seconds() - StartTime;
             
-            // Call teardown fixture (AfterEach) if provided - always called regardless of test result
-            if (AfterEach)
+            if (!Watch.Finish())
             {
-                AfterEach(Context);
+                return ENexusAttemptOutcome::Failed;
             }
-            
-            if (bResult)
+            Record.bTimedOut = Watch.HasExpired();
+        }
+        
+        const ENexusAttemptOutcome Outcome = FinishAttempt(Context, MoveTemp(Record), bResult);
+        if (FPalantirSpan::IsObserved())
+        {
+            AttemptSpan.SetDetail(FString::Printf(TEXT("Attempt %d/%d: %s"), Attempt, GetMaxAttempts(),
+                Outcome == ENexusAttemptOutcome::Passed ? TEXT("PASS") : Outcome == ENexusAttemptOutcome::Retry ? TEXT("RETRY") : TEXT("FAIL")));
+        }
+        return Outcome;
+    }
+    
+    /**
+     * First half of an attempt: log/breadcrumb the start and run the setup fixture
+     * Must run inside this execution's trace. ExecuteAttempt runs TestFunc in between; FNexusLatentRunner
+     * resumes the latent body across frames and calls FinishAttempt when it completes.
+     * @return false if BeforeEach failed (the attempt then fails without running the body)
+     */
+    bool BeginAttempt(const FNexusTestContext& Context, uint32 Attempt) const
+    {
+        const uint32 MaxAttempts = GetMaxAttempts();
+        
+        if (Attempt == 1)
+        {
+            const TCHAR* PriorityStr = NexusHasFlag(Priority, ETestPriority::Critical) ? TEXT("CRITICAL") : TEXT("NORMAL");
+            UE_LOG_TRACE(LogNexus, Display, TEXT("RUNNING: %s [%s]"), *TestName, PriorityStr);
+            PALANTIR_BREADCRUMB(TEXT("TestStart"), TestName);
+        }
+        else
+        {
+            PALANTIR_BREADCRUMBF(TEXT("RetryStart"), TEXT("Attempt %d/%d"), Attempt, MaxAttempts);
+        }
+        
+        // Build the suite fixtures this test shares with others (no-op once they are ready)
+        if (Fixtures.Num() > 0)
+        {
+            FPalantirSpan FixtureSpan(TEXT("SuiteFixture"), TEXT("phase"));
+            FString FixtureError;
+            if (!FNexusFixture::Acquire(*this, Context, FixtureError))
             {
-                // Test passed
-                if (Attempt > 1)
-                {
-                    UE_LOG(LogNexus, Display, TEXT("PASSED after %d attempts: %s"), Attempt, *TestName);
-                }
-                break;
+                UE_LOG(LogNexus, Error, TEXT("Suite fixture failed for %s: %s"), *TestName, *FixtureError);
+                return false;
             }
-            else if (Attempt < MaxAttempts)
+        }
+        
+        // Call setup fixture (BeforeEach) if provided
+        bool bSetupSuccess = true;
+        if (BeforeEach)
+        {
+            FPalantirSpan SetupSpan(TEXT("BeforeEach"), TEXT("phase"));
+            bSetupSuccess = BeforeEach(Context);
+            if (!bSetupSuccess)
             {
-                // Test failed but we have retries remaining - use exponential backoff
-                double WaitTime = FMath::Pow(2.0, Attempt - 1);  // 1s, 2s, 4s, 8s, etc.
-                UE_LOG(LogNexus, Warning, TEXT("RETRY: %s failed attempt %d/%d, waiting %.1fs before retry"), 
-                    *TestName, Attempt, MaxAttempts, WaitTime);
-                FPlatformProcess::Sleep(WaitTime);
+                UE_LOG(LogNexus, Error, TEXT("Setup fixture failed for %s"), *TestName);
             }
         }
+        return bSetupSuccess;
+    }
+    
+    /**
+     * Second half of an attempt: timeout check, teardown fixture, retry decision and result bookkeeping
+     * Must run inside this execution's trace; breadcrumbs still on the trace are appended to Record.
+     * @param Record Attempt number and body duration (plus any breadcrumbs gathered earlier)
+     * @return Retry if the attempt failed and retries remain, otherwise the final outcome
+     */
+    ENexusAttemptOutcome FinishAttempt(const FNexusTestContext& Context, FNexusAttemptRecord Record, bool bResult) const
+    {
+        const uint32 Attempt = Record.Attempt;
+        const uint32 MaxAttempts = GetMaxAttempts();
         
-        PALANTIR_BREADCRUMB(TEXT("TestEnd"), 
-            FString::Printf(TEXT("Attempts: %d, Status: %s"), 
-                Attempt, bResult ? TEXT("PASS") : TEXT("FAIL")));
+        // Check if test exceeded timeout (the watchdog flags it while running; catch overruns that finished between its polls)
+        if (!Record.bTimedOut && MaxDurationSeconds > 0.0 && Record.DurationSeconds > MaxDurationSeconds)
+        {
+            Record.bTimedOut = true;
+            FPalantirObserver::OnTestTimedOut(GetId(), Record.DurationSeconds, TArray<FString>());
+        }
+        if (Record.bTimedOut)
+        {
+            UE_LOG(LogNexus, Error, TEXT("TIMEOUT: %s exceeded max duration: %.2fs > %.2fs"), 
+                *TestName, Record.DurationSeconds, FNexusWatchdog::GetTimeoutSeconds(MaxDurationSeconds));
+            PALANTIR_BREADCRUMBF(TEXT("Timeout"), TEXT("Duration: %.2fs, Limit: %.2fs"),
+                Record.DurationSeconds, FNexusWatchdog::GetTimeoutSeconds(MaxDurationSeconds));
+            bResult = false;  // Timeout = test failure
+        }
+        
+        // Call teardown fixture (AfterEach) if provided - always called regardless of test result
+        if (AfterEach)
+        {
+            FPalantirSpan TeardownSpan(TEXT("AfterEach"), TEXT("phase"));
+            AfterEach(Context);
+        }
+        
+        Record.bPassed = bResult;
+        LastResult.DurationSeconds += Record.DurationSeconds;
+        
+        ENexusAttemptOutcome Outcome = bResult ? ENexusAttemptOutcome::Passed : ENexusAttemptOutcome::Failed;
+        if (!bResult && FNexusRunCancellation::IsCancelled())
+        {
+            // The run was aborted while this attempt ran - no point retrying
+            UE_LOG(LogNexus, Warning, TEXT("CANCELLED: %s (%s)"), *TestName, *FNexusRunCancellation::GetToken()->GetReason());
+        }
+        else if (!bResult && Attempt < MaxAttempts)
+        {
+            UE_LOG(LogNexus, Warning, TEXT("RETRY: %s failed attempt %d/%d, retrying in %.1fs"), 
+                *TestName, Attempt, MaxAttempts, GetRetryDelaySeconds(Attempt));
+            Outcome = ENexusAttemptOutcome::Retry;
+        }
+        else if (bResult && Attempt > 1)
+        {
+            UE_LOG(LogNexus, Display, TEXT("PASSED after %d attempts: %s"), Attempt, *TestName);
+        }
+        
+        if (Outcome != ENexusAttemptOutcome::Retry)
+        {
+            LastResult.bTimedOut = Record.bTimedOut;
+            CompleteExecution(bResult, Attempt);
+        }
+        
+        // Keep this attempt's breadcrumbs before the guard clears the trace (copied raw, formatted only if reported)
+        Record.Breadcrumbs.Append(FPalantirTrace::SnapshotBreadcrumbs());
+        LastResult.AttemptHistory.Add(MoveTemp(Record));
+        
+        if (Outcome != ENexusAttemptOutcome::Retry)
+        {
+            // Store in global history for trend analysis (merged into AllResults by FNexusResultCollector::Flush)
+            FNexusResultCollector::Record(LastResult);
+            FNexusFixture::Release(GetId());
+        }
+        
+        return Outcome;
+    }
+    
+    /**
+     * Finalize the result after the last attempt (also used when an abort cancels a pending retry)
+     * Must run inside this execution's trace so the TestEnd breadcrumb lands in the right trace.
+     */
+    void CompleteExecution(bool bResult, uint32 Attempts) const
+    {
+        const uint32 MaxAttempts = GetMaxAttempts();
+        
+        PALANTIR_BREADCRUMBF(TEXT("TestEnd"), TEXT("Attempts: %d, Status: %s"),
+            Attempts, bResult ? TEXT("PASS") : TEXT("FAIL"));
         
         UE_LOG_TRACE(LogNexus, Display, TEXT("COMPLETED: %s [%s] (attempt %d/%d)"), 
-            *TestName, bResult ? TEXT("PASS") : TEXT("FAIL"), Attempt, MaxAttempts);
+            *TestName, bResult ? TEXT("PASS") : TEXT("FAIL"), Attempts, MaxAttempts);
+        FPalantirTimeline::EndAsyncSpan(TestName, TEXT("execution"), GetTimelineId(),
+            FPalantirTimeline::IsRecording() ? FString::Printf(TEXT("%s after %d attempt(s)"), bResult ? TEXT("PASS") : TEXT("FAIL"), Attempts) : FString());
         
         // Capture result for history tracking and failure diagnostics
         LastResult.TestName = TestName;
         LastResult.bPassed = bResult;
-        LastResult.Attempts = Attempt;
+        LastResult.bQuarantined = bQuarantined;
+        LastResult.Attempts = Attempts;
         LastResult.Timestamp = FDateTime::Now();
+        FPalantirOtlpExporter::RecordTestResult(GetId(), LastResult.TraceID, LastResult.DurationSeconds, bResult, Attempts);
         
-        // Capture stack trace on failure for diagnostics
+        // Capture the failure location for diagnostics
         if (!bResult)
         {
-            LastResult.ErrorMessage = FString::Printf(TEXT("Test failed after %d attempt(s)"), Attempt);
-            
-            // Capture stack trace (if available on this platform)
-            // UE 5.7 API: StackWalkAndDump expects ANSICHAR buffer
-            const int32 MaxFrames = 32;
-            const int32 BufferSize = MaxFrames * 256;  // Each frame ~256 chars
-            ANSICHAR* StackBuffer = static_cast<ANSICHAR*>(FMemory::Malloc(BufferSize));
-            
-            FPlatformStackWalk::StackWalkAndDump(StackBuffer, BufferSize, nullptr);
+            LastResult.ErrorMessage = LastResult.bTimedOut
+                ? FString::Printf(TEXT("Test timed out after %d attempt(s)"), Attempts)
+                : FString::Printf(TEXT("Test failed after %d attempt(s)"), Attempts);
             
-            // Convert ANSI buffer to FString and parse into lines
-            FString CallStack(StackBuffer);
-            FMemory::Free(StackBuffer);
-            
-            // Parse call stack into lines (UE 5.7 API: array passed by reference)
-            TArray<FString> Lines;
-            CallStack.ParseIntoArray(Lines, TEXT("\n"), true);
-            LastResult.StackTrace = Lines;
+            // Only the program counters are captured here - symbol lookup is slow and runs off the worker
+            // (FNexusSymbolicator), resolved into StackTrace when the result is flushed
+            FNexusSymbolicator::CaptureBackTrace(LastResult.StackFrames);
+            FNexusSymbolicator::Enqueue(LastResult.StackFrames);
+            LastResult.StackTrace.Reset();
         }
+    }
+    
+    /**
+     * Abandon a pending retry (e.g. after a critical abort) and keep the last failed attempt as the result
+     */
+    void AbandonRetry(uint32 AttemptsRun) const
+    {
+        FPalantirTraceGuard TraceGuard(LastResult.TraceID);
+        PALANTIR_BREADCRUMBF(TEXT("RetryAbandoned"), TEXT("After %d attempt(s)"), AttemptsRun);
+        CompleteExecution(false, AttemptsRun);
+        FNexusResultCollector::Record(LastResult);
+        FNexusFixture::Release(GetId());
+    }
+    
+    /**
+     * Report an attempt whose thread the watchdog abandoned (called on the replacement worker)
+     * The hung body may still be running, so there is no AfterEach and no retry - the attempt is final.
+     * @param Attempt 1-based attempt number that hung
+     * @param ElapsedSeconds Time the attempt had been running when it was abandoned
+     */
+    void AbandonHungAttempt(uint32 Attempt, double ElapsedSeconds) const
+    {
+        FPalantirTraceGuard TraceGuard(LastResult.TraceID);
+        PALANTIR_BREADCRUMBF(TEXT("Abandoned"), TEXT("Attempt %d hung for %.2fs"), Attempt, ElapsedSeconds);
         
-        // Store in global history for trend analysis
-        AllResults.Add(LastResult);
+        FNexusAttemptRecord Record;
+        Record.Attempt = Attempt;
+        Record.bTimedOut = true;
+        Record.DurationSeconds = ElapsedSeconds;
+        LastResult.DurationSeconds += ElapsedSeconds;
+        LastResult.bTimedOut = true;
+        CompleteExecution(false, Attempt);
         
-        return bResult;
+        Record.Breadcrumbs = FPalantirTrace::SnapshotBreadcrumbs();
+        LastResult.AttemptHistory.Add(MoveTemp(Record));
+        FNexusResultCollector::Record(LastResult);
     }
     
     /**
@@ -466,17 +797,27 @@ public:
 };
 
 // Use this instead of IMPLEMENT_SIMPLE_AUTOMATION_TEST
-// Tests self-register via FNexusTest constructor - no circular dependency!
+// Each test registers an FNexusTestDescriptor at load; the FNexusTest object is created at discovery
+
+// Module the test macros are expanded in (UBT defines UE_MODULE_NAME per module); keys incremental runs
+#ifdef UE_MODULE_NAME
+    #define NEXUS_MODULE_NAME ANSI_TO_TCHAR(UE_MODULE_NAME)
+#else
+    #define NEXUS_MODULE_NAME TEXT("")
+#endif
+
+#define NEXUS_TEST_SOURCE_LOCATION() SetSourceLocation(ANSI_TO_TCHAR(__FILE__), NEXUS_MODULE_NAME)
 
 // Internal macro implementation - handles both parallel-safe and game-thread-only tests
 #define NEXUS_TEST_INTERNAL(TestClassName, PrettyName, PriorityFlags, bGameThreadOnly, ...) \
 class TestClassName : public FNexusTest \
 { \
 public: \
-    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return RunTest(Context); }, bGameThreadOnly, __VA_ARGS__) {} \
+    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return RunTest(Context); }, bGameThreadOnly, __VA_ARGS__) { NEXUS_TEST_SOURCE_LOCATION(); } \
+    static FNexusTest* Create() { return new TestClassName(); } \
     bool RunTest(const FNexusTestContext& Context); \
 }; \
-static TestClassName Global_##TestClassName; \
+static FNexusTestDescriptor NexusDescriptor_##TestClassName(TEXT(PrettyName), &TestClassName::Create); \
 bool TestClassName::RunTest(const FNexusTestContext& Context)
 
 // ============================================================================
@@ -497,10 +838,11 @@ bool TestClassName::RunTest(const FNexusTestContext& Context)
 class TestClassName : public FNexusTest \
 { \
 public: \
-    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return RunPerformanceTest(Context); }, true, {}) {} \
+    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return RunPerformanceTest(Context); }, true, {}) { NEXUS_TEST_SOURCE_LOCATION(); } \
+    static FNexusTest* Create() { return new TestClassName(); } \
     bool RunPerformanceTest(const FNexusTestContext& Context); \
 }; \
-static TestClassName Global_##TestClassName; \
+static FNexusTestDescriptor NexusDescriptor_##TestClassName(TEXT(PrettyName), &TestClassName::Create); \
 bool TestClassName::RunPerformanceTest(const FNexusTestContext& Context)
 
 // ============================================================================
@@ -523,12 +865,101 @@ bool TestClassName::RunPerformanceTest(const FNexusTestContext& Context)
 class TestClassName : public FNexusTest \
 { \
 public: \
-    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return RunPerformanceTest(Context); }, true, __VA_ARGS__) {} \
+    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return RunPerformanceTest(Context); }, true, __VA_ARGS__) { NEXUS_TEST_SOURCE_LOCATION(); } \
+    static FNexusTest* Create() { return new TestClassName(); } \
     bool RunPerformanceTest(const FNexusTestContext& Context); \
 }; \
-static TestClassName Global_##TestClassName; \
+static FNexusTestDescriptor NexusDescriptor_##TestClassName(TEXT(PrettyName), &TestClassName::Create); \
 bool TestClassName::RunPerformanceTest(const FNexusTestContext& Context)
 
+// ============================================================================
+// Latent Test Macros (C++20 coroutines, game thread)
+// ============================================================================
+
+// Latent test - body is a coroutine that can co_await across frames and co_returns the result.
+// Latent tests are game-thread tests; RunAllTests interleaves them on one frame loop (FNexusLatentRunner).
+// Usage:
+//   NEXUS_TEST_LATENT(FDoorOpens, "Gameplay.Door.Opens", ETestPriority::Normal)
+//   {
+//       Door->Open();
+//       co_await Nexus::Seconds(2.0);
+//       co_return Door->IsOpen();
+//   }
+#define NEXUS_TEST_LATENT_INTERNAL(TestClassName, PrettyName, PriorityFlags, ...) \
+class TestClassName : public FNexusTest \
+{ \
+public: \
+    TestClassName() : FNexusTest(PrettyName, PriorityFlags, [this](const FNexusTestContext& Context) -> bool { return FNexusLatentRunner::RunToCompletion(RunTest(Context), Context, MaxDurationSeconds); }, true, __VA_ARGS__) \
+    { \
+        LatentFunc = [this](const FNexusTestContext& Context) { return RunTest(Context); }; \
+        NEXUS_TEST_SOURCE_LOCATION(); \
+    } \
+    static FNexusTest* Create() { return new TestClassName(); } \
+    FNexusLatentTask RunTest(const FNexusTestContext& Context); \
+}; \
+static FNexusTestDescriptor NexusDescriptor_##TestClassName(TEXT(PrettyName), &TestClassName::Create); \
+FNexusLatentTask TestClassName::RunTest(const FNexusTestContext& Context)
+
+#define NEXUS_TEST_LATENT(TestClassName, PrettyName, PriorityFlags) \
+    NEXUS_TEST_LATENT_INTERNAL(TestClassName, PrettyName, PriorityFlags, {})
+
+// Latent test with custom tags
+// Usage: NEXUS_TEST_LATENT_TAGGED(FMyTest, "Gameplay.Door.Opens", ETestPriority::Normal, {"Gameplay"})
+#define NEXUS_TEST_LATENT_TAGGED(TestClassName, PrettyName, PriorityFlags, ...) \
+    NEXUS_TEST_LATENT_INTERNAL(TestClassName, PrettyName, PriorityFlags, __VA_ARGS__)
+
+// ============================================================================
+// Test Dependencies
+// ============================================================================
+
+// Run TestClassName only after PrerequisiteClassName passed; if the prerequisite fails or is skipped,
+// TestClassName (and everything that depends on it) is skipped. Both tests must be defined above in this file.
+// Usage: NEXUS_TEST_DEPENDS(FLoginFlow, FBackendHealth);
+#define NEXUS_TEST_DEPENDS(TestClassName, PrerequisiteClassName) \
+static FNexusTestAttribute NexusDependency_##TestClassName##_##PrerequisiteClassName(NexusDescriptor_##TestClassName, \
+    [](FNexusTest& Test) { Test.AddPrerequisite(NexusDescriptor_##PrerequisiteClassName.Name); })
+
+// Same, naming a prerequisite defined in another file by its test name
+// Usage: NEXUS_TEST_DEPENDS_ON(FLoginFlow, "Backend.Health", Health);
+#define NEXUS_TEST_DEPENDS_ON(TestClassName, PrerequisiteName, UniqueSuffix) \
+static FNexusTestAttribute NexusDependency_##TestClassName##_##UniqueSuffix(NexusDescriptor_##TestClassName, \
+    [](FNexusTest& Test) { Test.AddPrerequisite(TEXT(PrerequisiteName)); })
+
+// Declare a data file (relative to the project directory) the test reads; -Incremental runs re-run the
+// test whenever the file changes, not only when its module is rebuilt
+// Usage: NEXUS_TEST_DATA(FArenaSpawns, "Content/Maps/Arena.umap", ArenaMap);
+#define NEXUS_TEST_DATA(TestClassName, ProjectRelativePath, UniqueSuffix) \
+static FNexusTestAttribute NexusData_##TestClassName##_##UniqueSuffix(NexusDescriptor_##TestClassName, \
+    [](FNexusTest& Test) { Test.AddDataDependency(TEXT(ProjectRelativePath)); })
+
+// Declare what the test mostly spends its time on, so the parallel scheduler's concurrency governor can
+// pack tests: CpuBound (one per core), IoBound (blocks on HTTP/sockets/disk, takes no CPU slot) or MemoryHeavy
+// Usage: NEXUS_TEST_RESOURCE(FLeaderboardFetch, IoBound);
+#define NEXUS_TEST_RESOURCE(TestClassName, ResourceClassName) \
+static FNexusTestAttribute NexusResource_##TestClassName(NexusDescriptor_##TestClassName, \
+    [](FNexusTest& Test) { Test.ResourceClass = ENexusResourceClass::ResourceClassName; })
+
+// ============================================================================
+// Suite Fixtures
+// ============================================================================
+
+// Instantiate a fixture class (an FNexusFixture subclass with a default constructor; see NexusFixture.h)
+// Usage: NEXUS_FIXTURE(FArenaFixture);
+#define NEXUS_FIXTURE(FixtureClassName) \
+static FixtureClassName Global_##FixtureClassName
+
+// Declare that TestClassName uses a fixture defined above in this file; it is built before the test's first attempt
+// Usage: NEXUS_TEST_FIXTURE(FCrowdPathing, FArenaFixture);
+#define NEXUS_TEST_FIXTURE(TestClassName, FixtureClassName) \
+static FNexusTestAttribute NexusFixture_##TestClassName##_##FixtureClassName(NexusDescriptor_##TestClassName, \
+    [](FNexusTest& Test) { Test.UseFixture(Global_##FixtureClassName.GetName()); })
+
+// Same, naming a fixture defined in another file
+// Usage: NEXUS_TEST_FIXTURE_NAMED(FCrowdPathing, "Arena", Arena);
+#define NEXUS_TEST_FIXTURE_NAMED(TestClassName, FixtureName, UniqueSuffix) \
+static FNexusTestAttribute NexusFixture_##TestClassName##_##UniqueSuffix(NexusDescriptor_##TestClassName, \
+    [](FNexusTest& Test) { Test.UseFixture(TEXT(FixtureName)); })
+
 // Performance assertion helpers - use in tests to validate metrics
 #define ASSERT_AVERAGE_FPS(Context, MinFPS) \
     if (!(Context).AssertAverageFPS(MinFPS)) { return false; }
@@ -555,4 +986,14 @@ bool TestClassName::RunPerformanceTest(const FNexusTestContext& Context)
         LastResult.ErrorMessage = FString(SkipReason); \
         UE_LOG(LogNexus, Display, TEXT("SKIPPED: %s [%s]"), *TestName, *FString(SkipReason)); \
         return true; \
-    } while(false)
\ No newline at end of file
+    } while(false)
+
+// NEXUS_SKIP_TEST for latent bodies (co_return instead of return)
+#define NEXUS_SKIP_LATENT_TEST(SkipReason) \
+    do { \
+        LastResult.bSkipped = true; \
+        LastResult.bPassed = false; \
+        LastResult.ErrorMessage = FString(SkipReason); \
+        UE_LOG(LogNexus, Display, TEXT("SKIPPED: %s [%s]"), *TestName, *FString(SkipReason)); \
+        co_return true; \
+    } while(false)
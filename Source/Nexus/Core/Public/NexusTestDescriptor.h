@@ -0,0 +1,79 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FNexusTest;
+struct FNexusTestAttribute;
+
+/**
+ * FNexusTestDescriptor - What a NEXUS_TEST macro leaves behind at module load
+ *
+ * Constructing a test object builds its name, tags and test function, and a module with thousands of
+ * tests paid for all of them while its DLL was loading, whether or not a run ever followed. The macros
+ * now define one descriptor per test instead: a name literal and a factory function, pushed onto a
+ * constant-initialized, process-wide list with one compare-and-swap - no lock and no allocation at load.
+ * The FNexusTest objects are created by MaterializeAll, which DiscoverAllTests (and everything else that
+ * reads FNexusTest::AllTests) calls first; descriptors registered by modules loaded later are picked up by
+ * the next call.
+ */
+struct NEXUS_API FNexusTestDescriptor
+{
+    typedef FNexusTest* (*FCreateFunc)();
+
+    FNexusTestDescriptor(const TCHAR* InName, FCreateFunc InCreate);
+    ~FNexusTestDescriptor();
+
+    FNexusTestDescriptor(const FNexusTestDescriptor&) = delete;
+    FNexusTestDescriptor& operator=(const FNexusTestDescriptor&) = delete;
+
+    const TCHAR* Name;
+    FCreateFunc Create;
+
+    /** Test object created from this descriptor, nullptr until materialized */
+    FNexusTest* GetInstance() const { return Instance; }
+
+    /** Number of registered descriptors (no test objects are created) */
+    static int32 Num();
+
+    /**
+     * Create the test object of every descriptor that has none yet and apply its pending attributes
+     * @return number of test objects created by this call
+     */
+    static int32 MaterializeAll();
+
+private:
+    friend struct FNexusTestAttribute;
+
+    template<typename NodeType>
+    static void PushFront(std::atomic<NodeType*>& Head, NodeType* Node);
+
+    template<typename NodeType>
+    static void Unlink(std::atomic<NodeType*>& Head, NodeType* Node);
+
+    FNexusTest* Instance = nullptr;
+    FNexusTestDescriptor* Next = nullptr;              // Registered before this one; the list is newest first
+    std::atomic<FNexusTestAttribute*> Attributes{nullptr};  // Newest first; applied in declaration order once Instance exists
+};
+
+/**
+ * FNexusTestAttribute - Deferred edit of a test declared by a macro after it (NEXUS_TEST_DEPENDS,
+ * NEXUS_TEST_DATA, NEXUS_TEST_FIXTURE); applied when the test is materialized
+ */
+struct NEXUS_API FNexusTestAttribute
+{
+    typedef void (*FApplyFunc)(FNexusTest&);
+
+    FNexusTestAttribute(FNexusTestDescriptor& InTest, FApplyFunc InApply);
+    ~FNexusTestAttribute();
+
+    FNexusTestAttribute(const FNexusTestAttribute&) = delete;
+    FNexusTestAttribute& operator=(const FNexusTestAttribute&) = delete;
+
+private:
+    friend struct FNexusTestDescriptor;
+
+    FNexusTestDescriptor& Test;
+    FApplyFunc Apply;
+    FNexusTestAttribute* Next = nullptr;
+    bool bApplied = false;
+};
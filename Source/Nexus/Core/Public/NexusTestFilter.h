@@ -0,0 +1,100 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+
+class FNexusTest;
+enum class ETestTag : uint8;
+
+/**
+ * FNexusTestFilter - Compiled test selection expression
+ *
+ *   -NexusFilter="tag:Networking && !tag:Stress && name:Palantir.*"
+ *
+ * Grammar (keywords case-insensitive):
+ *   expr  := and ( '||' and )*
+ *   and   := unary ( '&&' unary )*
+ *   unary := '!' unary | '(' expr ')' | atom
+ *   atom  := 'tag:' Tag | 'name:' Glob | 'name:/' Regex '/' | 'priority:' Critical|Smoke|OnlineOnly|Normal | Glob
+ *
+ * A tag matches a custom tag or the ETestTag flag of the same name. Globs (* and ?) match the whole
+ * test name, ignoring case; a bare word is a name glob. Values containing spaces or operators can be quoted.
+ *
+ * Compiled once into a postfix program. Select() evaluates it over the whole suite at once: tag atoms
+ * are the registry's per-tag bitsets, name and priority atoms are evaluated once per test into a bitset,
+ * and the operators are bitwise AND/OR/NOT over test IDs.
+ *
+ * Tests tagged OptInTag ("Benchmark") are left out of a run unless its filter names the tag
+ * (-NexusFilter=tag:Benchmark); see SelectForRun.
+ */
+class NEXUS_API FNexusTestFilter
+{
+public:
+    /** Tag of tests too slow for every run; they only run when a filter names it */
+    static const TCHAR* OptInTag;
+
+    /** @return false (with a message naming the position) if Expression does not parse */
+    static bool Compile(const FString& Expression, FNexusTestFilter& OutFilter, FString& OutError);
+
+    /** Filter matching any test carrying one of Tags (custom tag or ETestTag flag) - used by RunTestsWithTags */
+    static FNexusTestFilter FromTags(ETestTag Tags);
+
+    /** NexusFilter=... in Args (console; runs to the end or the next -Switch) or -NexusFilter=... on the process command line */
+    static bool ParseFromArgs(const TArray<FString>& Args, FString& OutExpression);
+
+    /** Matches every test */
+    bool IsEmpty() const { return Program.Num() == 0; }
+
+    bool Matches(const FNexusTest& Test) const;
+
+    /** Tests in Tests the expression selects, in their original order */
+    TArray<FNexusTest*> Select(const TArray<FNexusTest*>& Tests) const;
+
+    /** Tests a run picks: Select, minus opt-in tests unless the expression names tag:Benchmark (an empty filter never does) */
+    TArray<FNexusTest*> SelectForRun(const TArray<FNexusTest*>& Tests) const;
+
+    const FString& GetExpression() const { return Expression; }
+
+private:
+    friend class FNexusTestFilterParser;
+
+    enum class EOp : uint8
+    {
+        Tag,
+        NameGlob,
+        NameRegex,
+        Priority,
+        Not,
+        And,
+        Or
+    };
+
+    struct FInstruction
+    {
+        EOp Op = EOp::And;
+        int32 Operand = INDEX_NONE;  // Index into Tags / Globs / Regexes, or the priority flag bits
+    };
+
+    /** Glob split on '*': Segments[0] must prefix the name, the last segment suffix it, the rest appear in order */
+    struct FGlob
+    {
+        TArray<FString> Segments;
+        bool bHasStar = false;
+
+        static FGlob Compile(const FString& Pattern);
+        bool Matches(const FString& Name) const;
+    };
+
+    struct FTagOperand
+    {
+        FString Tag;
+        uint8 EnumFlag = 0;  // Matching ETestTag flag, 0 if none
+    };
+
+    bool EvaluateAtom(const FInstruction& Instruction, const FNexusTest& Test) const;
+
+    FString Expression;
+    TArray<FInstruction> Program;  // Postfix
+    TArray<FTagOperand> Tags;
+    TArray<FGlob> Globs;
+    TArray<FRegexPattern> Regexes;
+};
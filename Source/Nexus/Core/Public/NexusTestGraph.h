@@ -0,0 +1,88 @@
+#pragma once
+#include "CoreMinimal.h"
+#include <atomic>
+
+class FNexusTest;
+
+/**
+ * FNexusTestGraph - Dependency DAG over the tests of one run
+ *
+ * Built from FNexusTest::Prerequisites (NEXUS_TEST_DEPENDS). Prerequisites outside the run set are
+ * ignored, so filtered or sharded runs still execute. Tests on a cycle, and everything downstream of
+ * one, can never become runnable and are reported by GetUnreachableTests.
+ *
+ * MarkPassed/MarkFailed are lock-free and may be called from any scheduler worker: a dependent becomes
+ * runnable exactly once, when its last prerequisite passes, and a failure marks its whole downstream
+ * subtree as skipped exactly once.
+ */
+class NEXUS_API FNexusTestGraph
+{
+public:
+    void Build(const TArray<FNexusTest*>& Tests);
+
+    bool IsEmpty() const { return Nodes.Num() == 0; }
+    bool HasEdges() const { return bHasEdges; }
+
+    /** Tests in dependency order; ties keep the order they were passed to Build (priority order) */
+    const TArray<FNexusTest*>& GetTopologicalOrder() const { return TopologicalOrder; }
+
+    /** Tests on or downstream of a dependency cycle */
+    const TArray<FNexusTest*>& GetUnreachableTests() const { return Unreachable; }
+
+    /** Groups of tests connected by dependencies (in either direction); singletons for independent tests */
+    TArray<TArray<FNexusTest*>> GetConnectedGroups() const;
+
+    bool HasPrerequisites(const FNexusTest* Test) const;
+    bool HasDependents(const FNexusTest* Test) const;
+    TArray<FNexusTest*> GetPrerequisites(const FNexusTest* Test) const;
+
+    /** Every prerequisite has passed (always true for tests outside the graph) */
+    bool IsReady(const FNexusTest* Test) const;
+
+    /** Skipped because a prerequisite failed or was skipped */
+    bool IsSkipped(const FNexusTest* Test) const;
+
+    /** Record a pass; returns dependents that just became runnable */
+    TArray<FNexusTest*> MarkPassed(const FNexusTest* Test);
+
+    /** Record a failure or skip; returns the downstream tests newly marked as skipped */
+    TArray<FNexusTest*> MarkFailed(const FNexusTest* Test);
+
+    /** Claim a test that never ran as skipped; false if a failed prerequisite already skipped it */
+    bool TrySkip(const FNexusTest* Test);
+
+    /** MarkFailed, then report every newly skipped downstream test as skipped (result, counters, observer) */
+    TArray<FNexusTest*> SkipDependentsOf(const FNexusTest* Cause);
+
+    /**
+     * Fail-fast rule every lane applies to a failed test: a critical, non-quarantined test aborts the run
+     * unless it gates dependents in Graph (may be null), in which case only that subtree is skipped
+     */
+    static bool ShouldAbortRun(const FNexusTest* Failed, const FNexusTestGraph* Graph);
+
+private:
+    enum class ENodeState : uint8
+    {
+        Waiting,
+        Passed,
+        Failed,
+        Skipped
+    };
+
+    struct FNode
+    {
+        FNexusTest* Test = nullptr;
+        TArray<int32> Prerequisites;
+        TArray<int32> Dependents;
+        std::atomic<int32> RemainingPrerequisites{0};
+        std::atomic<uint8> State{static_cast<uint8>(ENodeState::Waiting)};
+    };
+
+    int32 FindNode(const FNexusTest* Test) const;
+
+    TArray<TUniquePtr<FNode>> Nodes;
+    TMap<const FNexusTest*, int32> NodeIndex;
+    TArray<FNexusTest*> TopologicalOrder;
+    TArray<FNexusTest*> Unreachable;
+    bool bHasEdges = false;
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+#include "HAL/CriticalSection.h"
+
+class FNexusTest;
+
+/** Dense index of a test name in FNexusTestRegistry (INDEX_NONE = unknown) */
+typedef int32 FNexusTestId;
+
+/**
+ * FNexusTestRegistry - Interned test names, dense test IDs and per-tag bitsets
+ *
+ * Every test name gets a stable integer ID the first time it is seen (DiscoverAllTests registers all
+ * NEXUS_TEST instances; names reported only by other processes, like shard files or farm workers, are
+ * interned on demand without a test object). Names and custom tags are FNames, and each tag keeps a
+ * bitset over test IDs, so name lookups, duplicate detection and tag queries never scan the suite.
+ * Observers keep per-test state in arrays indexed by ID.
+ *
+ * Thread-safe: lookups take a read lock, registration and interning a write lock.
+ */
+class NEXUS_API FNexusTestRegistry
+{
+public:
+    static FNexusTestRegistry& Get();
+
+    /**
+     * Register a test object under its name (idempotent) and tag its ID with its custom tags
+     * @return ID of the name; if another test already owns the name, that ID is returned and Test->TestId is left unset
+     */
+    FNexusTestId Register(FNexusTest* Test);
+
+    /** ID of Name, interning it if it has never been seen */
+    FNexusTestId FindOrAddId(const FString& Name);
+
+    /** ID of Name, or INDEX_NONE */
+    FNexusTestId FindId(const FString& Name) const;
+
+    /** Test object registered under Id (null for names interned without one) */
+    FNexusTest* GetTest(FNexusTestId Id) const;
+
+    FName GetName(FNexusTestId Id) const;
+
+    /** Number of IDs handed out; valid IDs are [0, Num()) */
+    int32 Num() const;
+
+    /** Set Tag on Id (FNexusTest::AddCustomTag forwards here once the test is registered) */
+    void AddTag(FNexusTestId Id, const FString& Tag);
+
+    bool HasTag(FNexusTestId Id, const FString& Tag) const;
+
+    /** Registered tests carrying Tag, in ID (registration) order */
+    TArray<FNexusTest*> GetTestsWithTag(const FString& Tag) const;
+
+    int32 CountTestsWithTag(const FString& Tag) const;
+
+    /** Copy of Tag's bitset over test IDs (may be shorter than Num(); missing bits are unset) */
+    TBitArray<> GetTagBits(const FString& Tag) const;
+
+    /** Every tag set on at least one test, sorted */
+    TArray<FString> GetAllTags() const;
+
+private:
+    FNexusTestId AddIdLocked(FName Name);
+    void SetTagLocked(FNexusTestId Id, FName Tag);
+
+    mutable FRWLock Lock;
+    TArray<FName> Names;                  // ID -> interned name
+    TArray<FNexusTest*> Tests;            // ID -> test object (null if interned by name only)
+    TMap<FName, FNexusTestId> IdsByName;
+    TMap<FName, TBitArray<>> TagBits;     // Tag -> bit per test ID
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "NexusCancellation.h"
+#include "NexusTestRegistry.h"
+
+/**
+ * FNexusWatchdog - Preemptive deadline enforcement for running tests
+ *
+ * A background thread tracks the deadline of every test attempt currently inside its body. When one
+ * expires it captures the stuck thread's stack, marks the test TimedOut in FPalantirOracle (stack saved
+ * as an artifact) and cancels the attempt's FNexusCancellationToken. If the body still has not returned
+ * after the grace period:
+ *  - on a scheduler worker, the thread is abandoned: the scheduler reports the test as timed out and
+ *    spins up a replacement worker, so the run carries on while the hung thread is left behind;
+ *  - on a thread that cannot be replaced (game thread), it is reported; with -NexusExitOnHang or ExitOnHang=true
+ *    the run signals abort and the process exits with code 124 instead of stalling the CI job until its own
+ *    timeout (farm workers are always launched with -NexusExitOnHang).
+ *
+ * Deadline per attempt: MaxDurationSeconds, else -NexusTestTimeout=S or [/Script/Nexus.NexusSettings]
+ * DefaultTestTimeoutSeconds (default 0: no deadline). Grace period: WatchdogGraceSeconds (default 5).
+ */
+class NEXUS_API FNexusWatchdog
+{
+public:
+    struct FWatch;
+
+    /**
+     * Watches the calling thread for the lifetime of the scope (one test attempt body)
+     */
+    class NEXUS_API FScope
+    {
+    public:
+        FScope(FNexusTestId TestId, const FString& TestName, double TimeoutSeconds, const TSharedRef<FNexusCancellationToken, ESPMode::ThreadSafe>& Token);
+        ~FScope();
+
+        /**
+         * Stop watching once the body returned
+         * @return false if the watchdog already abandoned this thread - the attempt's result is no longer ours to report
+         */
+        bool Finish();
+
+        /** The deadline passed while the body was running */
+        bool HasExpired() const;
+
+    private:
+        TSharedPtr<FWatch, ESPMode::ThreadSafe> Watch;
+        bool bExpired = false;
+    };
+
+    /**
+     * Install what the watchdog calls (on its own thread) to abandon the calling thread when a test on it
+     * ignores cancellation past the grace period. Threads without a handler are never abandoned.
+     */
+    static void SetThreadAbandonHandler(TFunction<void()> Handler);
+
+    /** The watchdog gave up on the calling thread; it must unwind without touching shared run state */
+    static bool IsCurrentThreadAbandoned();
+
+    /** Deadline for one attempt: MaxDurationSeconds if set, otherwise the configured default (0 = none) */
+    static double GetTimeoutSeconds(double MaxDurationSeconds);
+
+    static double GetGraceSeconds();
+
+    /** Stop the watchdog thread (module shutdown) */
+    static void Shutdown();
+};
@@ -0,0 +1,99 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+
+class FNexusTest;
+class FNexusTestGraph;
+class FSocket;
+
+/**
+ * FNexusWorkerFarm - Local multi-process test farm
+ *
+ * The coordinator (the process running UNexusCore) listens on a loopback socket and spawns N headless
+ * `UnrealEditor-Cmd -game -nullrhi` workers. Each worker connects back, and the coordinator hands out
+ * one test at a time as workers become idle, so game-thread tests that would otherwise be serialized
+ * run in parallel across isolated processes. Results, tags and artifacts stream back as they finish and
+ * are recorded in the coordinator's FPalantirOracle.
+ *
+ * Protocol: newline-delimited JSON over TCP (hello / begin / run / result / release / shutdown).
+ *
+ * Suite fixtures are counted across the farm: before its first test a worker gets the farm's fixture users
+ * that have no result yet (begin), and every worker hears of each final result of one (release). A fixture a
+ * worker built is torn down after the last farm test that uses it, wherever that test ran, and the rest
+ * when the worker stops.
+ *
+ * A worker that crashes is restarted (up to MaxRestarts per slot) and the test it was running is
+ * reported as failed with a crash message; the rest of the run continues. A worker that hangs is
+ * handled the same way: its own FNexusWatchdog exits it (code 124) once a test ignores cancellation,
+ * and the coordinator kills any worker still silent well past the test's deadline. Both are reported
+ * as timed out rather than crashed.
+ *
+ * Enable with -NexusFarm=N or [/Script/Nexus.NexusSettings] FarmWorkers=N.
+ */
+class NEXUS_API FNexusWorkerFarm
+{
+public:
+    explicit FNexusWorkerFarm(int32 InNumProcesses);
+    ~FNexusWorkerFarm();
+
+    /** Open the loopback listener and launch worker processes; they boot while the caller does other work */
+    bool Start();
+
+    /**
+     * Hand Tests out to workers and block until each one has a result
+     * @param Graph Optional dependency graph; a test is only dispatched once its prerequisites have passed
+     * @return Tests the farm could not run (every worker slot exhausted its restarts); run them in-process
+     */
+    TArray<FNexusTest*> Run(const TArray<FNexusTest*>& Tests, FNexusTestGraph* Graph = nullptr);
+
+    /** Ask workers to exit and close the listener (also done by the destructor) */
+    void Shutdown();
+
+    /** Worker process count from -NexusFarm=N or config; 0 means the farm is disabled */
+    static int32 GetConfiguredProcessCount();
+
+    /** True in a process launched by the farm (-NexusWorker=host:port) */
+    static bool IsWorkerProcess();
+
+    /**
+     * Worker side: connect to the coordinator and serve tests from the core ticker, one per frame,
+     * so the engine (and any loaded world) keeps ticking between tests. Requests engine exit on shutdown.
+     */
+    static bool StartWorker();
+
+private:
+    struct FWorkerSlot
+    {
+        int32 Id = 0;
+        FProcHandle Process;
+        FSocket* Socket = nullptr;
+        TArray<uint8> RecvBuffer;
+        FNexusTest* InFlight = nullptr;
+        TSet<FString> WarmFixtures;  // Suite fixtures the worker process has built; their other users are sent here first
+        bool bFixturesBegun = false; // Sent this run's fixture users (begin)
+        double InFlightStart = 0.0;
+        double LaunchTime = 0.0;
+        int32 Restarts = 0;
+        bool bRetired = false;
+    };
+
+    bool LaunchWorker(FWorkerSlot& Slot);
+    void AcceptConnections(double Now);
+    void PumpSlot(FWorkerSlot& Slot);
+    void HandleWorkerLost(FWorkerSlot& Slot, const FString& Reason, bool bCanRestart, bool bTimedOut = false);
+    void CloseSlot(FWorkerSlot& Slot);
+    void RecordResult(FNexusTest* Test, const TSharedPtr<class FJsonObject>& Message);
+    void RecordCrash(FNexusTest* Test, const FString& Reason, bool bTimedOut);
+    bool BeginFixtureUsers(FWorkerSlot& Slot);
+    void ReleaseFixtureUser(const FNexusTest* Test);
+
+    int32 NumProcesses = 0;
+    int32 Port = 0;
+    FSocket* ListenSocket = nullptr;
+    TArray<FWorkerSlot> Slots;
+    TArray<FWorkerSlot> Handshakes;  // Accepted connections that have not said hello yet
+    TArray<FNexusTest*> Pending;
+    TSet<FString> FixtureUsers;  // Farm tests with suite fixtures and no final result yet
+    FNexusTestGraph* Graph = nullptr;
+    bool bAborted = false;
+};
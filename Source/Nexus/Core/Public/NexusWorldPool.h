@@ -0,0 +1,114 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UWorld;
+class AActor;
+class UActorComponent;
+
+/**
+ * FNexusWorldPool - Pre-warmed, isolated game worlds for NEXUS_TEST_GAMETHREAD tests
+ *
+ * Without the pool every game-thread test shares whichever game world happens to exist, so one test's
+ * leftovers are the next test's starting state. The pool loads the configured TestMapPath into N private
+ * game worlds once (Prewarm), begins play in each and snapshots every actor. A sequential game-thread test
+ * leases a world for its attempts; releasing it rolls the world back to the snapshot: actors and components
+ * the test added are destroyed, and the properties and transforms of the map's own actors are restored.
+ * Per-test setup is a memory copy instead of a map load. A world whose snapshot can no longer be applied
+ * (the test destroyed one of the map's actors, or the world is tearing down) is reloaded.
+ *
+ * A suite fixture set up in a pooled world pins it (see FNexusFixture): the actors its Setup spawned become
+ * part of the snapshot, so they survive the rollback after each test, and the world is only leased to the
+ * fixture's users until its teardown unpins it and the world goes back to the map's own state.
+ *
+ * Pooled worlds get a game mode and game state when a game instance exists, but no local player, so
+ * Context.PlayerController is null. Tests that need the PIE player opt out with the "NoWorldPool" tag.
+ * Latent tests keep sharing one world, since they interleave on a single frame loop.
+ *
+ * Size: -NexusWorldPool=N or [/Script/Nexus.NexusSettings] WorldPoolSize=N (default 1, 0 disables).
+ * Requires TestMapPath. Game thread only.
+ */
+class NEXUS_API FNexusWorldPool
+{
+public:
+    /** Tag that makes a game-thread test run against the shared game world instead of a pooled one */
+    static const TCHAR* NoPoolTag;
+
+    static FNexusWorldPool& Get();
+
+    static int32 GetConfiguredSize();
+
+    /** A pool size is configured and TestMapPath is set */
+    static bool IsEnabled();
+
+    /** World was created by the pool (CreateTestContext never hands these out as the shared world) */
+    static bool IsPooledWorld(const UWorld* World);
+
+    /**
+     * Load worlds until the configured size is ready (no-op once warm)
+     * @return number of worlds ready to lease
+     */
+    int32 Prewarm();
+
+    /**
+     * A clean world not leased by anyone, or nullptr if all are leased or none could be created
+     * @param Fixtures Suite fixtures of the test; a world pinned by one of them is preferred, worlds pinned by others are never returned
+     */
+    UWorld* Acquire(const TArray<FString>& Fixtures = TArray<FString>());
+
+    /** Return a leased world; it is rolled back to its snapshot (or reloaded) before it is handed out again */
+    void Release(UWorld* World);
+
+    /** Keep the world's current state (the fixture's actors included) across rollbacks while FixtureName is set up */
+    void Pin(UWorld* World, const FString& FixtureName);
+
+    /** FixtureName was torn down; once no fixture pins the world it rolls back to the map's own state */
+    void Unpin(UWorld* World, const FString& FixtureName);
+
+    /** Destroy every pooled world (module shutdown) */
+    void Shutdown();
+
+    int32 Num() const { return Worlds.Num(); }
+
+private:
+    struct FObjectState
+    {
+        TWeakObjectPtr<UObject> Object;
+        TArray<uint8> Properties;
+    };
+
+    struct FActorSnapshot
+    {
+        TWeakObjectPtr<AActor> Actor;
+        FTransform Transform;
+        bool bHasRoot = false;
+        FObjectState State;
+        TArray<FObjectState> Components;
+    };
+
+    struct FPooledWorld
+    {
+        UWorld* World = nullptr;
+        bool bLeased = false;
+        double TimeSeconds = 0.0;
+        double RealTimeSeconds = 0.0;
+        TArray<FActorSnapshot> Snapshot;
+        TArray<FActorSnapshot> MapSnapshot;  // The map's own state while fixtures pin the world
+        TArray<FString> Fixtures;            // Suite fixtures pinning the world
+    };
+
+    UWorld* CreateWorld(int32 Index) const;
+    static void DestroyWorld(UWorld* World);
+    int32 IndexOf(const UWorld* World) const;
+
+    /** Roll the world at Index back to its snapshot, reloading it if that fails */
+    void ResetWorld(int32 Index);
+    static void TakeSnapshot(FPooledWorld& Pooled);
+
+    /** @return false if the world must be reloaded instead */
+    static bool RestoreSnapshot(FPooledWorld& Pooled);
+
+    TArray<FPooledWorld> Worlds;
+    FString MapPackageName;
+    int32 CreatedCount = 0;  // Keeps instance package names unique across reloads
+};
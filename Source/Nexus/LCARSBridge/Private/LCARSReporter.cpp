@@ -17,12 +17,14 @@ void LCARSReporter::ExportResultsToLCARS(const FAutomationTestFramework& Framewo
 	TSharedPtr<FJsonObject> Report = MakeShareable(new FJsonObject);
 
 	// Get test results from FPalantirOracle
-	const TMap<FString, FPalantirTestResult>& OracleResults = FPalantirOracle::Get().GetAllTestResults();
+	const TMap<FString, FPalantirTestResult> OracleResults = FPalantirOracle::Get().GetAllTestResults();
 
 	TArray<TSharedPtr<FJsonValue>> TestsArray;
     int32 PassedCount = 0;
     int32 FailedCount = 0;
     int32 SkippedCount = 0;
+    int32 CachedCount = 0;
+    int32 QuarantinedCount = 0;
 
     for (const auto& Pair : OracleResults)
     {
@@ -33,6 +35,9 @@ void LCARSReporter::ExportResultsToLCARS(const FAutomationTestFramework& Framewo
         TestObj->SetStringField(TEXT("name"), TestName);
         TestObj->SetBoolField(TEXT("passed"), TestResult.bPassed);
         TestObj->SetBoolField(TEXT("skipped"), TestResult.bSkipped);
+        TestObj->SetBoolField(TEXT("timed_out"), TestResult.bTimedOut);
+        TestObj->SetBoolField(TEXT("cached"), TestResult.bCached);
+        TestObj->SetBoolField(TEXT("quarantined"), TestResult.bQuarantined);
         TestObj->SetNumberField(TEXT("duration"), TestResult.Duration);
         TestObj->SetNumberField(TEXT("priority"), TestResult.Priority);
         if (!TestResult.ErrorMessage.IsEmpty())
@@ -66,9 +71,17 @@ void LCARSReporter::ExportResultsToLCARS(const FAutomationTestFramework& Framewo
         {
             SkippedCount++;
         }
+        else if (TestResult.bQuarantined)
+        {
+            QuarantinedCount++;  // Flaky (FNexusFlakiness): neither a pass nor a failure
+        }
         else if (TestResult.bPassed)
         {
             PassedCount++;
+            if (TestResult.bCached)
+            {
+                CachedCount++;
+            }
         }
         else
         {
@@ -80,6 +93,8 @@ void LCARSReporter::ExportResultsToLCARS(const FAutomationTestFramework& Framewo
     Report->SetNumberField(TEXT("passed"), PassedCount);
     Report->SetNumberField(TEXT("failed"), FailedCount);
     Report->SetNumberField(TEXT("skipped"), SkippedCount);
+    Report->SetNumberField(TEXT("cached"), CachedCount);  // Included in passed
+    Report->SetNumberField(TEXT("quarantined"), QuarantinedCount);  // Not included in passed or failed
     Report->SetNumberField(TEXT("total"), TestsArray.Num());
 
     FString OutputString;
@@ -489,6 +504,18 @@ FString LCARSReporter::GetEmbeddedHTMLTemplate()
                 <div class="card-secondary">Game-thread performance</div>
                 <div class="card-secondary">Requires PIE execution</div>
             </div>
+            <div class="card">
+                <div class="card-label">Actor Pool</div>
+                <div class="card-value">{ACTOR_POOL_HIT_RATE}</div>
+                <div class="card-secondary">Spawns served from the pool</div>
+                <div class="card-secondary">{ACTOR_POOL_STATS}</div>
+            </div>
+            <div class="card">
+                <div class="card-label">Quarantine</div>
+                <div class="card-value">{QUARANTINED_TESTS}</div>
+                <div class="card-secondary">Flaky tests run apart</div>
+                <div class="card-secondary">{QUARANTINE_STATS}</div>
+            </div>
         </div>
 
         <!-- TEST DISTRIBUTION BY TAG -->
@@ -307,6 +307,18 @@ const char* LCARS_REPORT_TEMPLATE = R"(<!DOCTYPE html>
                 <div class="card-secondary">Game-thread performance</div>
                 <div class="card-secondary">Requires PIE execution</div>
             </div>
+            <div class="card">
+                <div class="card-label">Actor Pool</div>
+                <div class="card-value">{ACTOR_POOL_HIT_RATE}</div>
+                <div class="card-secondary">Spawns served from the pool</div>
+                <div class="card-secondary">{ACTOR_POOL_STATS}</div>
+            </div>
+            <div class="card">
+                <div class="card-label">Quarantine</div>
+                <div class="card-value">{QUARANTINED_TESTS}</div>
+                <div class="card-secondary">Flaky tests run apart</div>
+                <div class="card-secondary">{QUARANTINE_STATS}</div>
+            </div>
         </div>
 
         <!-- TEST DISTRIBUTION BY TAG -->
@@ -18,7 +18,7 @@ FLCARSResults FPalantirLCARSProvider::GetResults()
 	}
 
 	// Get all test results from PalantirOracle
-	const TMap<FString, FPalantirTestResult>& TestResults = Oracle->GetAllTestResults();
+	const TMap<FString, FPalantirTestResult> TestResults = Oracle->GetAllTestResults();
 
 	for (const auto& Pair : TestResults)
 	{
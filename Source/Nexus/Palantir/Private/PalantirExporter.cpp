@@ -0,0 +1,938 @@
+#include "PalantirExporter.h"
+#include "PalantirTrace.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/FileManager.h"
+#include "Containers/Queue.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include <atomic>
+
+using FOtlpJsonWriter = TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+/** One metric sample waiting for export */
+struct FPalantirMetricPoint
+{
+	FString Name;
+	const TCHAR* Unit = TEXT("1");
+	double Value = 0.0;
+	uint64 TimeUnixNano = 0;
+	FNexusTestId TestId = INDEX_NONE;  // Attributes, omitted when unset
+	FString TraceID;
+	const TCHAR* Status = nullptr;
+};
+
+static int64 GetUnixNanosNow()
+{
+	return (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTicks() * 100;
+}
+
+// Maps FPlatformTime::Cycles64() (what spans are stamped with) to wall-clock time; anchored at BeginRun
+namespace FPalantirOtlpClock
+{
+	static uint64 AnchorCycles = 0;
+	static int64 AnchorUnixNanos = 0;
+
+	static void Anchor()
+	{
+		AnchorCycles = FPlatformTime::Cycles64();
+		AnchorUnixNanos = GetUnixNanosNow();
+	}
+
+	static uint64 ToUnixNanos(uint64 Cycles)
+	{
+		const double DeltaNanos = static_cast<double>(static_cast<int64>(Cycles - AnchorCycles)) * FPlatformTime::GetSecondsPerCycle64() * 1e9;
+		return static_cast<uint64>(AnchorUnixNanos + static_cast<int64>(DeltaNanos));
+	}
+}
+
+static void WriteStringAttribute(FOtlpJsonWriter& Json, const TCHAR* Key, const FString& Value)
+{
+	Json.WriteObjectStart();
+	Json.WriteValue(TEXT("key"), Key);
+	Json.WriteObjectStart(TEXT("value"));
+	Json.WriteValue(TEXT("stringValue"), Value);
+	Json.WriteObjectEnd();
+	Json.WriteObjectEnd();
+}
+
+static void WriteIntAttribute(FOtlpJsonWriter& Json, const TCHAR* Key, int64 Value)
+{
+	// OTLP/JSON carries 64-bit integers as strings
+	Json.WriteObjectStart();
+	Json.WriteValue(TEXT("key"), Key);
+	Json.WriteObjectStart(TEXT("value"));
+	Json.WriteValue(TEXT("intValue"), LexToString(Value));
+	Json.WriteObjectEnd();
+	Json.WriteObjectEnd();
+}
+
+static FString GetServiceName()
+{
+	FString ServiceName = TEXT("nexusqa");
+	if (GConfig)
+	{
+		GConfig->GetString(TEXT("/Script/Nexus.NexusSettings"), TEXT("OtlpServiceName"), ServiceName, GGameIni);
+	}
+	return ServiceName;
+}
+
+/** "resource": the process that produced the batch */
+static void WriteResource(FOtlpJsonWriter& Json)
+{
+	Json.WriteObjectStart(TEXT("resource"));
+	Json.WriteArrayStart(TEXT("attributes"));
+	WriteStringAttribute(Json, TEXT("service.name"), GetServiceName());
+	WriteStringAttribute(Json, TEXT("service.instance.id"), FApp::GetInstanceId().ToString(EGuidFormats::DigitsWithHyphensLower));
+	WriteStringAttribute(Json, TEXT("nexus.project"), FApp::GetProjectName());
+	WriteIntAttribute(Json, TEXT("process.pid"), FPlatformProcess::GetCurrentProcessId());
+	Json.WriteArrayEnd();
+	Json.WriteObjectEnd();
+}
+
+static void WriteScope(FOtlpJsonWriter& Json)
+{
+	Json.WriteObjectStart(TEXT("scope"));
+	Json.WriteValue(TEXT("name"), TEXT("nexus.palantir"));
+	Json.WriteObjectEnd();
+}
+
+/**
+ * Background thread that batches queued spans and metric points into OTLP requests
+ */
+class FPalantirOtlpRunnable : public FRunnable
+{
+public:
+	static FPalantirOtlpRunnable& Get()
+	{
+		static FPalantirOtlpRunnable Instance;
+		return Instance;
+	}
+
+	void Configure(const FString& InEndpoint, const FString& InFilePath, int32 InQueueSize, int32 InBatchSize, double InFlushInterval)
+	{
+		{
+			FScopeLock Lock(&SettingsLock);
+			Endpoint = InEndpoint;
+			FilePath = InFilePath;
+		}
+		QueueSize = InQueueSize;
+		BatchSize = InBatchSize;
+		FlushIntervalMs = static_cast<uint32>(InFlushInterval * 1000.0);
+
+		ExportedSpans = 0;
+		ExportedMetrics = 0;
+		DroppedSpans = 0;
+		DroppedMetrics = 0;
+		FailedBatches = 0;
+		PassedTests = 0;
+		FailedTests = 0;
+		RunStartUnixNanos = GetUnixNanosNow();
+		bActive = true;
+		EnsureThread();
+	}
+
+	bool IsActive() const { return bActive.load(std::memory_order_relaxed); }
+
+	FString GetFilePath()
+	{
+		FScopeLock Lock(&SettingsLock);
+		return FilePath;
+	}
+
+	/** Called on the thread that ended the span: never blocks, drops when the queue is full */
+	void EnqueueSpan(const FPalantirSpanRecord& Record)
+	{
+		if (!IsActive())
+		{
+			return;
+		}
+		if (QueuedSpans.fetch_add(1, std::memory_order_relaxed) >= QueueSize)
+		{
+			QueuedSpans.fetch_sub(1, std::memory_order_relaxed);
+			DroppedSpans.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		Spans.Enqueue(Record);
+		if (QueuedSpans.load(std::memory_order_relaxed) >= BatchSize)
+		{
+			WorkEvent->Trigger();
+		}
+	}
+
+	void EnqueueMetric(FPalantirMetricPoint&& Point)
+	{
+		if (!IsActive())
+		{
+			return;
+		}
+		if (QueuedMetrics.fetch_add(1, std::memory_order_relaxed) >= QueueSize)
+		{
+			QueuedMetrics.fetch_sub(1, std::memory_order_relaxed);
+			DroppedMetrics.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		Metrics.Enqueue(MoveTemp(Point));
+	}
+
+	void CountTest(bool bPassed)
+	{
+		(bPassed ? PassedTests : FailedTests).fetch_add(1, std::memory_order_relaxed);
+	}
+
+	bool Flush(double TimeoutSeconds)
+	{
+		if (!IsActive())
+		{
+			return true;
+		}
+
+		bFinalMetricsPending = true;
+		if (!HasThread())
+		{
+			Drain(true);
+		}
+
+		const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+		while (!IsIdle())
+		{
+			if (FPlatformTime::Seconds() > Deadline)
+			{
+				return false;
+			}
+			WorkEvent->Trigger();
+			IdleEvent->Wait(10);
+		}
+		return true;
+	}
+
+	FPalantirExporterStats GetStats() const
+	{
+		FPalantirExporterStats Stats;
+		Stats.ExportedSpans = ExportedSpans.load();
+		Stats.ExportedMetrics = ExportedMetrics.load();
+		Stats.DroppedSpans = DroppedSpans.load();
+		Stats.DroppedMetrics = DroppedMetrics.load();
+		Stats.FailedBatches = FailedBatches.load();
+		return Stats;
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopping.load())
+		{
+			WorkEvent->Wait(FlushIntervalMs);
+			Drain(false);
+		}
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+		WorkEvent->Trigger();
+	}
+
+	void Shutdown()
+	{
+		FRunnableThread* ToJoin = nullptr;
+		{
+			FScopeLock Lock(&ThreadLock);
+			ToJoin = Thread;
+			Thread = nullptr;
+		}
+		if (ToJoin)
+		{
+			ToJoin->Kill(true);
+			delete ToJoin;
+		}
+		bStopping = false;
+		bActive = false;
+	}
+
+private:
+	static constexpr int32 MaxInFlight = 4;
+
+	FPalantirOtlpRunnable()
+	{
+		WorkEvent = FPlatformProcess::GetSynchEventFromPool(false);
+		IdleEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	}
+
+	bool HasThread()
+	{
+		FScopeLock Lock(&ThreadLock);
+		return Thread != nullptr;
+	}
+
+	void EnsureThread()
+	{
+		FScopeLock Lock(&ThreadLock);
+		if (!Thread && FPlatformProcess::SupportsMultithreading())
+		{
+			Thread = FRunnableThread::Create(this, TEXT("PalantirOtlpExporter"), 0, TPri_BelowNormal);
+		}
+	}
+
+	bool IsIdle() const
+	{
+		return QueuedSpans.load() == 0 && QueuedMetrics.load() == 0 && InFlight.load() == 0 && !bFinalMetricsPending.load();
+	}
+
+	/**
+	 * Export full batches (or everything when bAll / a flush is pending); while MaxInFlight posts are
+	 * outstanding the rest stays queued, so a slow collector fills the queues and drops new items
+	 */
+	void Drain(bool bAll)
+	{
+		FScopeLock DrainScope(&DrainLock);  // The queues allow a single consumer
+		const bool bFlushing = bAll || bFinalMetricsPending.load();
+
+		TArray<FPalantirSpanRecord> SpanBatch;
+		while (InFlight.load() < MaxInFlight || bAll)
+		{
+			SpanBatch.Reset();
+			FPalantirSpanRecord Record;
+			while (SpanBatch.Num() < BatchSize && Spans.Dequeue(Record))
+			{
+				SpanBatch.Add(MoveTemp(Record));
+			}
+			if (SpanBatch.Num() == 0)
+			{
+				break;
+			}
+			QueuedSpans.fetch_sub(SpanBatch.Num());
+			Export(TEXT("/v1/traces"), FPalantirOtlpExporter::SerializeSpans(SpanBatch));
+			ExportedSpans.fetch_add(SpanBatch.Num());
+		}
+
+		// Metrics go out every interval (they are few) and once more at the flush with the final totals
+		TArray<FPalantirMetricPoint> MetricBatch;
+		FPalantirMetricPoint Point;
+		while (Metrics.Dequeue(Point))
+		{
+			MetricBatch.Add(MoveTemp(Point));
+		}
+		QueuedMetrics.fetch_sub(MetricBatch.Num());
+		if (MetricBatch.Num() > 0 || (bFlushing && bFinalMetricsPending.load()))
+		{
+			Export(TEXT("/v1/metrics"), SerializeMetrics(MetricBatch));
+			ExportedMetrics.fetch_add(MetricBatch.Num());
+		}
+		if (bFlushing && QueuedSpans.load() == 0)
+		{
+			bFinalMetricsPending = false;
+		}
+
+		IdleEvent->Trigger();
+	}
+
+	void Export(const TCHAR* Path, const FString& Body)
+	{
+		FString TargetEndpoint;
+		FString TargetFile;
+		{
+			FScopeLock Lock(&SettingsLock);
+			TargetEndpoint = Endpoint;
+			TargetFile = FilePath;
+		}
+
+		if (!TargetFile.IsEmpty())
+		{
+			if (!FFileHelper::SaveStringToFile(Body + TEXT("\n"), *TargetFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+			{
+				FailedBatches.fetch_add(1);
+			}
+		}
+
+		if (!TargetEndpoint.IsEmpty())
+		{
+			TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = FHttpModule::Get().CreateRequest();
+			Request->SetURL(TargetEndpoint + Path);
+			Request->SetVerb(TEXT("POST"));
+			Request->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+			Request->SetContentAsString(Body);
+			Request->SetTimeout(10.0f);
+			Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+			Request->OnProcessRequestComplete().BindLambda([this](FHttpRequestPtr, FHttpResponsePtr Response, bool bConnectedSuccessfully)
+			{
+				if (!bConnectedSuccessfully || !Response.IsValid() || Response->GetResponseCode() >= 300)
+				{
+					FailedBatches.fetch_add(1);
+				}
+				InFlight.fetch_sub(1);
+				IdleEvent->Trigger();
+			});
+
+			InFlight.fetch_add(1);
+			if (!Request->ProcessRequest())
+			{
+				InFlight.fetch_sub(1);
+				FailedBatches.fetch_add(1);
+			}
+		}
+	}
+
+	FString SerializeMetrics(TConstArrayView<FPalantirMetricPoint> Points) const
+	{
+		// Points grouped by metric name, in first-seen order
+		TArray<FString> Names;
+		TMultiMap<FString, int32> ByName;
+		for (int32 Index = 0; Index < Points.Num(); ++Index)
+		{
+			Names.AddUnique(Points[Index].Name);
+			ByName.Add(Points[Index].Name, Index);
+		}
+
+		FString Body;
+		const TSharedRef<FOtlpJsonWriter> Json = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+		Json->WriteObjectStart();
+		Json->WriteArrayStart(TEXT("resourceMetrics"));
+		Json->WriteObjectStart();
+		WriteResource(*Json);
+		Json->WriteArrayStart(TEXT("scopeMetrics"));
+		Json->WriteObjectStart();
+		WriteScope(*Json);
+		Json->WriteArrayStart(TEXT("metrics"));
+
+		for (const FString& Name : Names)
+		{
+			TArray<int32> Indices;
+			ByName.MultiFind(Name, Indices, true);
+
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("name"), Name);
+			Json->WriteValue(TEXT("unit"), Points[Indices[0]].Unit);
+			Json->WriteObjectStart(TEXT("gauge"));
+			Json->WriteArrayStart(TEXT("dataPoints"));
+			for (int32 Index : Indices)
+			{
+				const FPalantirMetricPoint& Point = Points[Index];
+				Json->WriteObjectStart();
+				Json->WriteValue(TEXT("timeUnixNano"), LexToString(Point.TimeUnixNano));
+				Json->WriteValue(TEXT("asDouble"), Point.Value);
+				Json->WriteArrayStart(TEXT("attributes"));
+				if (Point.TestId != INDEX_NONE)
+				{
+					WriteStringAttribute(*Json, TEXT("test.name"), FNexusTestRegistry::Get().GetName(Point.TestId).ToString());
+				}
+				if (!Point.TraceID.IsEmpty())
+				{
+					WriteStringAttribute(*Json, TEXT("nexus.trace_id"), Point.TraceID);
+				}
+				if (Point.Status)
+				{
+					WriteStringAttribute(*Json, TEXT("test.status"), Point.Status);
+				}
+				Json->WriteArrayEnd();
+				Json->WriteObjectEnd();
+			}
+			Json->WriteArrayEnd();
+			Json->WriteObjectEnd();
+			Json->WriteObjectEnd();
+		}
+
+		// Run totals: cumulative since BeginRun
+		const uint64 Now = GetUnixNanosNow();
+		auto WriteSum = [&Json, Now, this](const TCHAR* Name, const TCHAR* AttributeKey, const TCHAR* FirstKey, int64 FirstValue, const TCHAR* SecondKey, int64 SecondValue)
+		{
+			Json->WriteObjectStart();
+			Json->WriteValue(TEXT("name"), Name);
+			Json->WriteValue(TEXT("unit"), TEXT("1"));
+			Json->WriteObjectStart(TEXT("sum"));
+			Json->WriteValue(TEXT("aggregationTemporality"), 2);
+			Json->WriteValue(TEXT("isMonotonic"), true);
+			Json->WriteArrayStart(TEXT("dataPoints"));
+			for (int32 Index = 0; Index < 2; ++Index)
+			{
+				Json->WriteObjectStart();
+				Json->WriteValue(TEXT("startTimeUnixNano"), LexToString(RunStartUnixNanos));
+				Json->WriteValue(TEXT("timeUnixNano"), LexToString(Now));
+				Json->WriteValue(TEXT("asInt"), LexToString(Index == 0 ? FirstValue : SecondValue));
+				Json->WriteArrayStart(TEXT("attributes"));
+				WriteStringAttribute(*Json, AttributeKey, Index == 0 ? FirstKey : SecondKey);
+				Json->WriteArrayEnd();
+				Json->WriteObjectEnd();
+			}
+			Json->WriteArrayEnd();
+			Json->WriteObjectEnd();
+			Json->WriteObjectEnd();
+		};
+		WriteSum(TEXT("nexus.tests"), TEXT("test.status"), TEXT("PASS"), PassedTests.load(), TEXT("FAIL"), FailedTests.load());
+		WriteSum(TEXT("nexus.exporter.dropped"), TEXT("signal"), TEXT("spans"), DroppedSpans.load(), TEXT("metrics"), DroppedMetrics.load());
+
+		Json->WriteArrayEnd();
+		Json->WriteObjectEnd();
+		Json->WriteArrayEnd();
+		Json->WriteObjectEnd();
+		Json->WriteArrayEnd();
+		Json->WriteObjectEnd();
+		Json->Close();
+		return Body;
+	}
+
+	TQueue<FPalantirSpanRecord, EQueueMode::Mpsc> Spans;
+	TQueue<FPalantirMetricPoint, EQueueMode::Mpsc> Metrics;
+	std::atomic<int32> QueuedSpans{0};
+	std::atomic<int32> QueuedMetrics{0};
+	std::atomic<int32> InFlight{0};
+	std::atomic<bool> bActive{false};
+	std::atomic<bool> bStopping{false};
+	std::atomic<bool> bFinalMetricsPending{false};
+	FCriticalSection DrainLock;
+	FEvent* WorkEvent = nullptr;
+	FEvent* IdleEvent = nullptr;
+
+	std::atomic<int64> ExportedSpans{0};
+	std::atomic<int64> ExportedMetrics{0};
+	std::atomic<int64> DroppedSpans{0};
+	std::atomic<int64> DroppedMetrics{0};
+	std::atomic<int64> FailedBatches{0};
+	std::atomic<int64> PassedTests{0};
+	std::atomic<int64> FailedTests{0};
+	uint64 RunStartUnixNanos = 0;
+
+	FCriticalSection SettingsLock;
+	FString Endpoint;
+	FString FilePath;
+	int32 QueueSize = 8192;
+	int32 BatchSize = 512;
+	uint32 FlushIntervalMs = 2000;
+
+	FCriticalSection ThreadLock;
+	FRunnableThread* Thread = nullptr;
+};
+
+static FDelegateHandle GPalantirOtlpSpanHandle;
+
+static void OnPalantirSpanEnded(const FPalantirSpanRecord& Record)
+{
+	FPalantirOtlpRunnable::Get().EnqueueSpan(Record);
+}
+
+static FString GetOtlpSetting(const TCHAR* Param, const TCHAR* Key)
+{
+	FString Value;
+	if (!FParse::Value(FCommandLine::Get(), Param, Value) && GConfig)
+	{
+		GConfig->GetString(TEXT("/Script/Nexus.NexusSettings"), Key, Value, GGameIni);
+	}
+	return Value.TrimStartAndEnd();
+}
+
+bool FPalantirOtlpExporter::IsEnabled()
+{
+	return !GetOtlpSetting(TEXT("NexusOtlpEndpoint="), TEXT("OtlpEndpoint")).IsEmpty()
+		|| !GetOtlpSetting(TEXT("NexusOtlpFile="), TEXT("OtlpFile")).IsEmpty();
+}
+
+void FPalantirOtlpExporter::BeginRun()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("NexusReports");
+	FString Endpoint = GetOtlpSetting(TEXT("NexusOtlpEndpoint="), TEXT("OtlpEndpoint"));
+	FString FilePath = GetOtlpSetting(TEXT("NexusOtlpFile="), TEXT("OtlpFile"));
+
+	if (Endpoint.Equals(TEXT("local"), ESearchCase::IgnoreCase))
+	{
+		if (!FPalantirOtlpCollector::IsRunning() && !FPalantirOtlpCollector::Start(ReportDir / TEXT("otlp-collector.jsonl")))
+		{
+			UE_LOG(LogPalantirTrace, Error, TEXT("OTLP: could not start the local collector — exporting to the file sink only"));
+		}
+		Endpoint = FPalantirOtlpCollector::GetEndpoint();
+	}
+	Endpoint.RemoveFromEnd(TEXT("/"));
+
+	if (!FilePath.IsEmpty())
+	{
+		if (FPaths::IsRelative(FilePath))
+		{
+			FilePath = ReportDir / FilePath;
+		}
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(FilePath), true);
+		IFileManager::Get().Delete(*FilePath, false, true, true);  // One run per file
+	}
+
+	int32 QueueSize = 8192;
+	int32 BatchSize = 512;
+	float FlushInterval = 2.0f;
+	if (GConfig)
+	{
+		GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("OtlpQueueSize"), QueueSize, GGameIni);
+		GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("OtlpBatchSize"), BatchSize, GGameIni);
+		GConfig->GetFloat(TEXT("/Script/Nexus.NexusSettings"), TEXT("OtlpFlushIntervalSeconds"), FlushInterval, GGameIni);
+	}
+
+	FPalantirOtlpClock::Anchor();
+	FPalantirOtlpRunnable::Get().Configure(Endpoint, FilePath, FMath::Max(QueueSize, 64), FMath::Clamp(BatchSize, 1, QueueSize), FMath::Max(FlushInterval, 0.1f));
+
+	if (!GPalantirOtlpSpanHandle.IsValid())
+	{
+		GPalantirOtlpSpanHandle = FPalantirTrace::OnSpanEnded().AddStatic(&OnPalantirSpanEnded);
+	}
+
+	UE_LOG(LogPalantirTrace, Display, TEXT("OTLP export enabled%s%s%s%s"),
+		Endpoint.IsEmpty() ? TEXT("") : TEXT(" --> "), *Endpoint,
+		FilePath.IsEmpty() ? TEXT("") : TEXT(" --> "), *FilePath);
+}
+
+void FPalantirOtlpExporter::RecordTestResult(FNexusTestId TestId, const FString& TraceID, double DurationSeconds, bool bPassed, uint32 Attempts)
+{
+	FPalantirOtlpRunnable& Exporter = FPalantirOtlpRunnable::Get();
+	if (!Exporter.IsActive())
+	{
+		return;
+	}
+
+	Exporter.CountTest(bPassed);
+	const uint64 Now = GetUnixNanosNow();
+	const TCHAR* Status = bPassed ? TEXT("PASS") : TEXT("FAIL");
+
+	FPalantirMetricPoint Duration;
+	Duration.Name = TEXT("nexus.test.duration");
+	Duration.Unit = TEXT("s");
+	Duration.Value = DurationSeconds;
+	Duration.TimeUnixNano = Now;
+	Duration.TestId = TestId;
+	Duration.TraceID = TraceID;
+	Duration.Status = Status;
+
+	FPalantirMetricPoint AttemptCount = Duration;
+	AttemptCount.Name = TEXT("nexus.test.attempts");
+	AttemptCount.Unit = TEXT("1");
+	AttemptCount.Value = Attempts;
+
+	Exporter.EnqueueMetric(MoveTemp(Duration));
+	Exporter.EnqueueMetric(MoveTemp(AttemptCount));
+}
+
+void FPalantirOtlpExporter::RecordGauge(const FString& Name, double Value, const TCHAR* Unit)
+{
+	FPalantirMetricPoint Point;
+	Point.Name = Name;
+	Point.Unit = Unit;
+	Point.Value = Value;
+	Point.TimeUnixNano = GetUnixNanosNow();
+	FPalantirOtlpRunnable::Get().EnqueueMetric(MoveTemp(Point));
+}
+
+bool FPalantirOtlpExporter::Flush(double TimeoutSeconds)
+{
+	FPalantirOtlpRunnable& Exporter = FPalantirOtlpRunnable::Get();
+	if (!Exporter.IsActive())
+	{
+		return true;
+	}
+
+	const bool bDrained = Exporter.Flush(TimeoutSeconds);
+	const FPalantirExporterStats Stats = Exporter.GetStats();
+	UE_LOG(LogPalantirTrace, Display, TEXT("OTLP export: %lld spans, %lld metric points (%lld spans and %lld points dropped, %lld batches failed)%s"),
+		Stats.ExportedSpans, Stats.ExportedMetrics, Stats.DroppedSpans, Stats.DroppedMetrics, Stats.FailedBatches,
+		bDrained ? TEXT("") : TEXT(" — timed out waiting for the collector"));
+	if (Stats.DroppedSpans + Stats.DroppedMetrics > 0)
+	{
+		UE_LOG(LogPalantirTrace, Warning, TEXT("OTLP export queue overflowed; raise OtlpQueueSize or check the collector"));
+	}
+	return bDrained;
+}
+
+void FPalantirOtlpExporter::Shutdown()
+{
+	if (GPalantirOtlpSpanHandle.IsValid())
+	{
+		FPalantirTrace::OnSpanEnded().Remove(GPalantirOtlpSpanHandle);
+		GPalantirOtlpSpanHandle.Reset();
+	}
+	FPalantirOtlpRunnable::Get().Flush(2.0);
+	FPalantirOtlpRunnable::Get().Shutdown();
+	FPalantirOtlpCollector::Stop();
+}
+
+FPalantirExporterStats FPalantirOtlpExporter::GetStats()
+{
+	return FPalantirOtlpRunnable::Get().GetStats();
+}
+
+FString FPalantirOtlpExporter::GetFilePath()
+{
+	return FPalantirOtlpRunnable::Get().GetFilePath();
+}
+
+FString FPalantirOtlpExporter::ToOtlpTraceId(FStringView TraceID)
+{
+	return FPalantirTraceId::FromTraceID(TraceID).ToHex();
+}
+
+FString FPalantirOtlpExporter::ToOtlpSpanId(uint64 SpanId)
+{
+	return FString::Printf(TEXT("%016llx"), SpanId);
+}
+
+FString FPalantirOtlpExporter::SerializeSpans(TConstArrayView<FPalantirSpanRecord> Spans)
+{
+	FString Body;
+	const TSharedRef<FOtlpJsonWriter> Json = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Body);
+	Json->WriteObjectStart();
+	Json->WriteArrayStart(TEXT("resourceSpans"));
+	Json->WriteObjectStart();
+	WriteResource(*Json);
+	Json->WriteArrayStart(TEXT("scopeSpans"));
+	Json->WriteObjectStart();
+	WriteScope(*Json);
+	Json->WriteArrayStart(TEXT("spans"));
+
+	for (const FPalantirSpanRecord& Span : Spans)
+	{
+		Json->WriteObjectStart();
+		Json->WriteValue(TEXT("traceId"), Span.TraceId.IsValid() ? Span.TraceId.ToHex() : ToOtlpTraceId(Span.TraceID));
+		Json->WriteValue(TEXT("spanId"), ToOtlpSpanId(Span.SpanId));
+		if (Span.ParentSpanId != 0)
+		{
+			Json->WriteValue(TEXT("parentSpanId"), ToOtlpSpanId(Span.ParentSpanId));
+		}
+		Json->WriteValue(TEXT("name"), Span.Name);
+		// SPAN_KIND_CLIENT for outgoing requests, SPAN_KIND_INTERNAL otherwise
+		Json->WriteValue(TEXT("kind"), FCString::Strcmp(Span.Category, TEXT("http")) == 0 ? 3 : 1);
+		Json->WriteValue(TEXT("startTimeUnixNano"), LexToString(FPalantirOtlpClock::ToUnixNanos(Span.StartCycles)));
+		Json->WriteValue(TEXT("endTimeUnixNano"), LexToString(FPalantirOtlpClock::ToUnixNanos(Span.EndCycles)));
+		Json->WriteArrayStart(TEXT("attributes"));
+		WriteStringAttribute(*Json, TEXT("nexus.trace_id"), Span.TraceID);
+		WriteStringAttribute(*Json, TEXT("nexus.category"), Span.Category);
+		WriteIntAttribute(*Json, TEXT("thread.id"), Span.ThreadId);
+		if (!Span.Detail.IsEmpty())
+		{
+			WriteStringAttribute(*Json, TEXT("nexus.detail"), Span.Detail);
+		}
+		Json->WriteArrayEnd();
+		Json->WriteObjectEnd();
+	}
+
+	Json->WriteArrayEnd();
+	Json->WriteObjectEnd();
+	Json->WriteArrayEnd();
+	Json->WriteObjectEnd();
+	Json->WriteArrayEnd();
+	Json->WriteObjectEnd();
+	Json->Close();
+	return Body;
+}
+
+/**
+ * Loopback HTTP listener standing in for a collector: one request per connection, body appended to a file
+ */
+class FPalantirOtlpCollectorRunnable : public FRunnable
+{
+public:
+	static FPalantirOtlpCollectorRunnable& Get()
+	{
+		static FPalantirOtlpCollectorRunnable Instance;
+		return Instance;
+	}
+
+	bool Start(const FString& InOutputFile, int32 InPort)
+	{
+		FScopeLock Lock(&StateLock);
+		if (Thread)
+		{
+			return true;
+		}
+
+		ListenSocket = FTcpSocketBuilder(TEXT("PalantirOtlpCollector"))
+			.AsReusable()
+			.BoundToAddress(FIPv4Address(127, 0, 0, 1))
+			.BoundToPort(InPort)
+			.Listening(8)
+			.Build();
+		if (!ListenSocket)
+		{
+			return false;
+		}
+
+		OutputFile = InOutputFile;
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(OutputFile), true);
+		Port = ListenSocket->GetPortNo();
+		RequestCount = 0;
+		bStopping = false;
+		Thread = FRunnableThread::Create(this, TEXT("PalantirOtlpCollector"), 0, TPri_BelowNormal);
+		UE_LOG(LogPalantirTrace, Display, TEXT("OTLP: local collector listening on 127.0.0.1:%d --> %s"), Port, *OutputFile);
+		return Thread != nullptr;
+	}
+
+	void StopCollector()
+	{
+		FRunnableThread* ToJoin = nullptr;
+		{
+			FScopeLock Lock(&StateLock);
+			ToJoin = Thread;
+			Thread = nullptr;
+		}
+		if (ToJoin)
+		{
+			ToJoin->Kill(true);
+			delete ToJoin;
+		}
+
+		FScopeLock Lock(&StateLock);
+		if (ListenSocket)
+		{
+			ListenSocket->Close();
+			ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+			ListenSocket = nullptr;
+		}
+		Port = 0;
+	}
+
+	bool IsRunning()
+	{
+		FScopeLock Lock(&StateLock);
+		return Thread != nullptr;
+	}
+
+	int32 GetPort()
+	{
+		FScopeLock Lock(&StateLock);
+		return Port;
+	}
+
+	int32 GetRequestCount() const { return RequestCount.load(); }
+
+	virtual uint32 Run() override
+	{
+		while (!bStopping.load())
+		{
+			bool bPending = false;
+			if (!ListenSocket->WaitForPendingConnection(bPending, FTimespan::FromMilliseconds(100)) || !bPending)
+			{
+				continue;
+			}
+			if (FSocket* Connection = ListenSocket->Accept(TEXT("PalantirOtlpCollectorConnection")))
+			{
+				ServeRequest(Connection);
+				Connection->Close();
+				ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Connection);
+			}
+		}
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping = true;
+	}
+
+private:
+	void ServeRequest(FSocket* Connection)
+	{
+		// Read the headers, then Content-Length bytes of body
+		TArray<uint8> Data;
+		int32 HeaderEnd = INDEX_NONE;
+		int64 ContentLength = -1;
+		const double Deadline = FPlatformTime::Seconds() + 5.0;
+		while (FPlatformTime::Seconds() < Deadline && !bStopping.load())
+		{
+			if (HeaderEnd != INDEX_NONE && Data.Num() - HeaderEnd >= ContentLength)
+			{
+				break;
+			}
+			if (!Connection->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(100)))
+			{
+				continue;
+			}
+
+			uint8 Buffer[16 * 1024];
+			int32 BytesRead = 0;
+			if (!Connection->Recv(Buffer, sizeof(Buffer), BytesRead) || BytesRead <= 0)
+			{
+				break;
+			}
+			Data.Append(Buffer, BytesRead);
+
+			if (HeaderEnd == INDEX_NONE)
+			{
+				for (int32 Index = 3; Index < Data.Num(); ++Index)
+				{
+					if (Data[Index - 3] == '\r' && Data[Index - 2] == '\n' && Data[Index - 1] == '\r' && Data[Index] == '\n')
+					{
+						HeaderEnd = Index + 1;
+						break;
+					}
+				}
+				if (HeaderEnd != INDEX_NONE)
+				{
+					const FString Headers(HeaderEnd, reinterpret_cast<const ANSICHAR*>(Data.GetData()));
+					const int32 LengthAt = Headers.Find(TEXT("Content-Length:"), ESearchCase::IgnoreCase);
+					ContentLength = LengthAt != INDEX_NONE ? FCString::Atoi64(*Headers + LengthAt + 15) : 0;
+				}
+			}
+		}
+
+		const bool bComplete = HeaderEnd != INDEX_NONE && Data.Num() - HeaderEnd >= ContentLength;
+		if (bComplete && ContentLength > 0)
+		{
+			const FString Body = FString(FUTF8ToTCHAR(reinterpret_cast<const ANSICHAR*>(Data.GetData()) + HeaderEnd, static_cast<int32>(ContentLength)));
+			FFileHelper::SaveStringToFile(Body.Replace(TEXT("\n"), TEXT("")) + TEXT("\n"), *OutputFile, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append);
+			RequestCount.fetch_add(1);
+		}
+
+		const char* Reply = bComplete
+			? "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 2\r\nConnection: close\r\n\r\n{}"
+			: "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+		int32 Sent = 0;
+		Connection->Send(reinterpret_cast<const uint8*>(Reply), FCStringAnsi::Strlen(Reply), Sent);
+	}
+
+	FCriticalSection StateLock;
+	FSocket* ListenSocket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	FString OutputFile;
+	int32 Port = 0;
+	std::atomic<int32> RequestCount{0};
+	std::atomic<bool> bStopping{false};
+};
+
+bool FPalantirOtlpCollector::Start(const FString& OutputFile, int32 Port)
+{
+	return FPalantirOtlpCollectorRunnable::Get().Start(OutputFile, Port);
+}
+
+void FPalantirOtlpCollector::Stop()
+{
+	FPalantirOtlpCollectorRunnable::Get().StopCollector();
+}
+
+bool FPalantirOtlpCollector::IsRunning()
+{
+	return FPalantirOtlpCollectorRunnable::Get().IsRunning();
+}
+
+FString FPalantirOtlpCollector::GetEndpoint()
+{
+	const int32 Port = FPalantirOtlpCollectorRunnable::Get().GetPort();
+	return Port > 0 ? FString::Printf(TEXT("http://127.0.0.1:%d"), Port) : FString();
+}
+
+int32 FPalantirOtlpCollector::GetRequestCount()
+{
+	return FPalantirOtlpCollectorRunnable::Get().GetRequestCount();
+}
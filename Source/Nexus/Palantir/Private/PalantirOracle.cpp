@@ -1,5 +1,9 @@
 #include "PalantirOracle.h"
+#include "PalantirTimeline.h"
+#include "PalantirExporter.h"
 #include "NexusCore.h"
+#include "NexusActorPool.h"
+#include "NexusFlakiness.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
@@ -34,22 +38,54 @@ FPalantirOracle& FPalantirOracle::Get()
 	return Instance;
 }
 
+void FPalantirOracle::RecordTestResult(FNexusTestId TestId, const FPalantirTestResult& Result)
+{
+	if (TestId == INDEX_NONE)
+	{
+		return;
+	}
+	FScopeLock Lock(&ResultsLock);
+	TestResults.Add(TestId, Result);
+}
+
 void FPalantirOracle::RecordTestResult(const FString& TestName, const FPalantirTestResult& Result)
 {
+	RecordTestResult(FNexusTestRegistry::Get().FindOrAddId(TestName), Result);
+}
+
+TMap<FString, FPalantirTestResult> FPalantirOracle::GetAllTestResults() const
+{
+	const FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
+	TMap<FString, FPalantirTestResult> ByName;
 	FScopeLock Lock(&ResultsLock);
-	TestResults.Add(TestName, Result);
+	ByName.Reserve(TestResults.Num());
+	for (const auto& Pair : TestResults)
+	{
+		ByName.Add(Registry.GetName(Pair.Key).ToString(), Pair.Value);
+	}
+	return ByName;
 }
 
-const TMap<FString, FPalantirTestResult>& FPalantirOracle::GetAllTestResults() const
+TMap<FNexusTestId, FPalantirTestResult> FPalantirOracle::GetAllTestResultsById() const
 {
 	FScopeLock Lock(&ResultsLock);
 	return TestResults;
 }
 
-const FPalantirTestResult* FPalantirOracle::GetTestResult(const FString& TestName) const
+bool FPalantirOracle::GetTestResult(FNexusTestId TestId, FPalantirTestResult& OutResult) const
 {
 	FScopeLock Lock(&ResultsLock);
-	return TestResults.Find(TestName);
+	if (const FPalantirTestResult* Found = TestResults.Find(TestId))
+	{
+		OutResult = *Found;
+		return true;
+	}
+	return false;
+}
+
+bool FPalantirOracle::GetTestResult(const FString& TestName, FPalantirTestResult& OutResult) const
+{
+	return GetTestResult(FNexusTestRegistry::Get().FindId(TestName), OutResult);
 }
 
 void FPalantirOracle::ClearAllResults()
@@ -70,7 +106,7 @@ int32 FPalantirOracle::GetPassedTestCount() const
 	int32 Count = 0;
 	for (const auto& Pair : TestResults)
 	{
-		if (Pair.Value.bPassed)
+		if (Pair.Value.bPassed && !Pair.Value.bQuarantined)
 		{
 			Count++;
 		}
@@ -84,7 +120,7 @@ int32 FPalantirOracle::GetFailedTestCount() const
 	int32 Count = 0;
 	for (const auto& Pair : TestResults)
 	{
-		if (!Pair.Value.bPassed)
+		if (!Pair.Value.bPassed && !Pair.Value.bQuarantined)
 		{
 			Count++;
 		}
@@ -96,20 +132,68 @@ int32 FPalantirOracle::GetFailedTestCount() const
 // End FPalantirOracle Implementation
 // ============================================================================
 
-// In-memory maps populated by OnTestStarted/OnTestFinished.
-static TMap<FString, bool> GPalantirTestResults;
-static TMap<FString, FDateTime> GPalantirTestStartTimes;
-static TMap<FString, double> GPalantirTestDurations;
-// Support multiple artifacts per test (screenshots, logs, replays)
-static TMap<FString, TArray<FString>> GPalantirArtifactPaths;
-// Store test metadata for report generation (tags, priority, etc.)
-static TMap<FString, TArray<FString>> GPalantirTestTags;
+// Per-test state populated by OnTestStarted/OnTestFinished, indexed by FNexusTestId (see FNexusTestRegistry).
+// Names are only looked up when a report is written.
+struct FPalantirTestSlot
+{
+    FDateTime StartTime;
+    bool bStarted = false;
+    bool bTimedOut = false;     // Flagged by the watchdog while running; consumed by OnTestFinished
+    bool bHasPriority = false;  // Captured at test start or from an external result
+    uint8 Priority = 0;
+    bool bHasResult = false;    // Finished, skipped or reported by another process
+    bool bPassed = false;
+    bool bHasDuration = false;  // Skipped tests have none
+    double Duration = 0.0;
+    bool bHasTags = false;
+    TArray<FString> Tags;       // Custom tags for report grouping, captured at start
+    TArray<FString> Artifacts;  // Screenshots, logs, replays
+};
+static TArray<FPalantirTestSlot> GPalantirSlots;
 // Baseline duration tracking for regression detection
 static TMap<FString, double> GBaselineTestDurations;
+static bool GBaselineLoaded = false;
 static TMap<FString, double> GRegressionDeltas;  // Current - Baseline for each test
 static int32 GRegressionCount = 0;
 static FCriticalSection GPalantirMutex;
 
+/** Slot for Id, growing the table on first use. Caller holds GPalantirMutex. */
+static FPalantirTestSlot& GetSlotLocked(FNexusTestId Id)
+{
+    if (Id >= GPalantirSlots.Num())
+    {
+        GPalantirSlots.SetNum(FMath::Max(Id + 1, FNexusTestRegistry::Get().Num()));
+    }
+    return GPalantirSlots[Id];
+}
+
+/** Name-keyed copy of the recorded results, durations and artifacts (report time). Caller holds GPalantirMutex. */
+static void CollectResultsLocked(TMap<FString, bool>& OutResults, TMap<FString, double>& OutDurations, TMap<FString, TArray<FString>>& OutArtifacts)
+{
+    const FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
+    for (int32 Id = 0; Id < GPalantirSlots.Num(); ++Id)
+    {
+        const FPalantirTestSlot& Slot = GPalantirSlots[Id];
+        if (!Slot.bHasResult && !Slot.bHasDuration && Slot.Artifacts.Num() == 0)
+        {
+            continue;
+        }
+        const FString Name = Registry.GetName(Id).ToString();
+        if (Slot.bHasResult)
+        {
+            OutResults.Add(Name, Slot.bPassed);
+        }
+        if (Slot.bHasDuration)
+        {
+            OutDurations.Add(Name, Slot.Duration);
+        }
+        if (Slot.Artifacts.Num() > 0)
+        {
+            OutArtifacts.Add(Name, Slot.Artifacts);
+        }
+    }
+}
+
 // Pluggable provider (set during Initialize)
 static TUniquePtr<ILCARSResultsProvider> GLCARSProvider;
 
@@ -121,21 +205,7 @@ public:
     {
         FLCARSResults Out;
         FScopeLock _lock(&GPalantirMutex);
-        // Copy boolean results
-        for (const auto& P : GPalantirTestResults)
-        {
-            Out.Results.Add(P.Key, P.Value);
-        }
-        // Copy durations (convert stored double)
-        for (const auto& P : GPalantirTestDurations)
-        {
-            Out.Durations.Add(P.Key, P.Value);
-        }
-        // Copy artifacts
-        for (const auto& P : GPalantirArtifactPaths)
-        {
-            Out.Artifacts.Add(P.Key, P.Value);
-        }
+        CollectResultsLocked(Out.Results, Out.Durations, Out.Artifacts);
         return Out;
     }
 };
@@ -150,7 +220,7 @@ public:
         FLCARSResults Out;
         
         // Get results from FPalantirOracle singleton
-        const TMap<FString, FPalantirTestResult>& OracleResults = FPalantirOracle::Get().GetAllTestResults();
+        const TMap<FString, FPalantirTestResult> OracleResults = FPalantirOracle::Get().GetAllTestResults();
         
         for (const auto& Pair : OracleResults)
         {
@@ -219,12 +289,21 @@ void FPalantirObserver::Initialize()
 
 void FPalantirObserver::OnTestStarted(const FString& Name)
 {
-    UE_LOG(LogTemp, Display, TEXT("Palantir: Test started: %s"), *Name);
-    UNexusCore::NotifyTestStarted(Name);
+    OnTestStarted(FNexusTestRegistry::Get().FindOrAddId(Name));
+}
+
+void FPalantirObserver::OnTestStarted(FNexusTestId TestId)
+{
+    const FName Name = FNexusTestRegistry::Get().GetName(TestId);
+    UE_LOG(LogTemp, Display, TEXT("Palantir: Test started: %s"), *Name.ToString());
+    UNexusCore::NotifyTestStarted(Name.ToString());
     // Record start time for duration measurement
+    if (TestId != INDEX_NONE)
     {
         FScopeLock _lock(&GPalantirMutex);
-        GPalantirTestStartTimes.Add(Name, FDateTime::Now());
+        FPalantirTestSlot& Slot = GetSlotLocked(TestId);
+        Slot.StartTime = FDateTime::Now();
+        Slot.bStarted = true;
     }
 }
 
@@ -239,167 +318,243 @@ void FPalantirObserver::OnTestStarted(const FNexusTest* Test)
     UNexusCore::NotifyTestStarted(Test->TestName);
     
     // Record start time and metadata
+    const FNexusTestId TestId = Test->GetId();
     {
         FScopeLock _lock(&GPalantirMutex);
-        GPalantirTestStartTimes.Add(Test->TestName, FDateTime::Now());
+        FPalantirTestSlot& Slot = GetSlotLocked(TestId);
+        Slot.StartTime = FDateTime::Now();
+        Slot.bStarted = true;
+        Slot.Priority = static_cast<uint8>(Test->Priority);
+        Slot.bHasPriority = true;
         
         // Store test tags for report generation
         // Always store tags, even if empty (ensures all tests appear in categorization)
-        TArray<FString> Tags = Test->GetCustomTags();
-        if (Tags.Num() == 0)
+        Slot.Tags = Test->GetCustomTags();
+        if (Slot.Tags.Num() == 0)
         {
             // Tests without explicit tags should have been given "Untagged" in constructor
             // but ensure it exists for consistency
-            Tags.Add(TEXT("Untagged"));
+            Slot.Tags.Add(TEXT("Untagged"));
         }
-        GPalantirTestTags.Add(Test->TestName, Tags);
+        Slot.bHasTags = true;
     }
 }
 
+/** Priority recorded at start (or by an external result), else the registered test's. Caller holds GPalantirMutex. */
+static uint8 FindTestPriorityLocked(FNexusTestId TestId)
+{
+    if (GPalantirSlots.IsValidIndex(TestId) && GPalantirSlots[TestId].bHasPriority)
+    {
+        return GPalantirSlots[TestId].Priority;
+    }
+    const FNexusTest* Test = FNexusTestRegistry::Get().GetTest(TestId);
+    return Test ? static_cast<uint8>(Test->Priority) : 0;
+}
+
 void FPalantirObserver::RegisterArtifact(const FString& TestName, const FString& ArtifactPath)
 {
-    FScopeLock _lock(&GPalantirMutex);
-    if (!GPalantirArtifactPaths.Contains(TestName))
+    const FNexusTestId TestId = FNexusTestRegistry::Get().FindOrAddId(TestName);
     {
-        GPalantirArtifactPaths.Add(TestName, TArray<FString>());
+        FScopeLock _lock(&GPalantirMutex);
+        GetSlotLocked(TestId).Artifacts.Add(ArtifactPath);
     }
-    GPalantirArtifactPaths[TestName].Add(ArtifactPath);
     UE_LOG(LogTemp, Display, TEXT("Palantir: Registered artifact for %s -> %s"), *TestName, *ArtifactPath);
 }
 
+TArray<FString> FPalantirObserver::GetArtifacts(const FString& TestName)
+{
+    const FNexusTestId TestId = FNexusTestRegistry::Get().FindId(TestName);
+    FScopeLock _lock(&GPalantirMutex);
+    return GPalantirSlots.IsValidIndex(TestId) ? GPalantirSlots[TestId].Artifacts : TArray<FString>();
+}
+
+TArray<FString> FPalantirObserver::GetTestTags(const FString& TestName)
+{
+    const FNexusTestId TestId = FNexusTestRegistry::Get().FindId(TestName);
+    FScopeLock _lock(&GPalantirMutex);
+    return GPalantirSlots.IsValidIndex(TestId) ? GPalantirSlots[TestId].Tags : TArray<FString>();
+}
+
+void FPalantirObserver::RecordExternalResult(const FString& Name, const FPalantirTestResult& Result, const TArray<FString>& Tags, const TArray<FString>& Artifacts)
+{
+    const FNexusTestId TestId = FNexusTestRegistry::Get().FindOrAddId(Name);
+    {
+        FScopeLock _lock(&GPalantirMutex);
+        FPalantirTestSlot& Slot = GetSlotLocked(TestId);
+        Slot.bHasResult = true;
+        Slot.bPassed = Result.bPassed;
+        if (!Result.bSkipped)
+        {
+            Slot.bHasDuration = true;
+            Slot.Duration = Result.Duration;
+        }
+        Slot.Tags = Tags.Num() > 0 ? Tags : TArray<FString>({ TEXT("Untagged") });
+        Slot.bHasTags = true;
+        Slot.Priority = Result.Priority;
+        Slot.bHasPriority = true;
+        Slot.Artifacts.Append(Artifacts);
+    }
+    FPalantirOracle::Get().RecordTestResult(TestId, Result);
+}
+
 void FPalantirObserver::OnTestFinished(const FString& Name, bool bPassed)
 {
+    OnTestFinished(FNexusTestRegistry::Get().FindOrAddId(Name), bPassed);
+}
+
+void FPalantirObserver::OnTestFinished(FNexusTestId TestId, bool bPassed)
+{
+    if (TestId == INDEX_NONE)
+    {
+        return;
+    }
+
+    const FString Name = FNexusTestRegistry::Get().GetName(TestId).ToString();
     UE_LOG(LogTemp, Display, TEXT("Palantir: Test finished: %s -> %s"), *Name, bPassed ? TEXT("PASSED") : TEXT("FAILED"));
     // NOTE: NotifyTestFinished is called by the caller (NexusCore), not here to avoid double-counting
 
+    // Per-test log path is deterministic, so the artifact can be registered in the same critical section
+    const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("NexusReports");
+    FString SafeName = Name;
+    for (TCHAR& C : SafeName) if (!FChar::IsAlnum(C)) C = TEXT('_');
+    const FString TestLogPath = ReportDir / FString::Printf(TEXT("test_%s.log"), *SafeName);
+
     // Declare Result in outer scope to use it outside the lock
     FPalantirTestResult Result;
+    Result.bPassed = bPassed;
+    Result.bSkipped = false;
+    const FNexusTest* Test = FNexusTestRegistry::Get().GetTest(TestId);
+    Result.bQuarantined = Test && Test->bQuarantined;
     
-    // Record the result for final reporting (JUnit, HTML)
+    // Record the result for final reporting (JUnit, HTML) - one lock acquisition per finished test
+    bool bHasStartTime = false;
     {
         FScopeLock _lock(&GPalantirMutex);
-        GPalantirTestResults.Add(Name, bPassed);
-        // Record full result for LCARS/Palantir
-        Result.bPassed = bPassed;
-        Result.bSkipped = false;
-        Result.Duration = 0.0;
-        // Find priority if possible
-        Result.Priority = 0;
-        for (FNexusTest* Test : UNexusCore::DiscoveredTests)
-        {
-            if (Test && Test->TestName == Name)
-            {
-                Result.Priority = static_cast<uint8>(Test->Priority);
-                break;
-            }
-        }
-        if (GPalantirTestStartTimes.Contains(Name))
+        FPalantirTestSlot& Slot = GetSlotLocked(TestId);
+        Slot.bHasResult = true;
+        Slot.bPassed = bPassed;
+        Result.Priority = FindTestPriorityLocked(TestId);
+        Result.bTimedOut = Slot.bTimedOut && !bPassed;
+        Slot.bTimedOut = false;
+        if (Result.bTimedOut)
         {
-            FDateTime Start = GPalantirTestStartTimes[Name];
-            Result.Duration = (FDateTime::Now() - Start).GetTotalSeconds();
-            GPalantirTestStartTimes.Remove(Name);
-            // Log duration for debugging
-            if (Result.Duration < 0.001)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("⚠️  Test duration suspiciously low for %s: %.6f seconds"), *Name, Result.Duration);
-            }
+            Result.ErrorMessage = TEXT("Timed out");
         }
-        else
+        if (Slot.bStarted)
         {
-            UE_LOG(LogTemp, Warning, TEXT("⚠️  No start time recorded for test: %s — Duration will be 0"), *Name);
+            bHasStartTime = true;
+            Slot.bStarted = false;
+            Result.Duration = (FDateTime::Now() - Slot.StartTime).GetTotalSeconds();
         }
-        GPalantirTestDurations.Add(Name, Result.Duration);
-        FPalantirOracle::Get().RecordTestResult(Name, Result);
+        Slot.bHasDuration = true;
+        Slot.Duration = Result.Duration;
+        Slot.Artifacts.Add(TestLogPath);
+    }
+    FPalantirOracle::Get().RecordTestResult(TestId, Result);
+
+    if (!bHasStartTime)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("⚠️  No start time recorded for test: %s — Duration will be 0"), *Name);
+    }
+    else if (Result.Duration < 0.001)
+    {
+        // Log duration for debugging
+        UE_LOG(LogTemp, Warning, TEXT("⚠️  Test duration suspiciously low for %s: %.6f seconds"), *Name, Result.Duration);
     }
 
     // Ensure report directory exists and write a per-test log/artifact (simple summary).
-    const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("NexusReports");
     FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*ReportDir);
-    // Sanitize test name for filename
-    FString SafeName = Name;
-    for (TCHAR& C : SafeName) if (!FChar::IsAlnum(C)) C = TEXT('_');
-    const FString TestLogPath = ReportDir / FString::Printf(TEXT("test_%s.log"), *SafeName);
     FString LogContents = FString::Printf(TEXT("Test: %s\nResult: %s\nDuration: %.3f seconds\nTime: %s\n"),
         *Name,
-        bPassed ? TEXT("PASSED") : TEXT("FAILED"),
+        bPassed ? TEXT("PASSED") : (Result.bTimedOut ? TEXT("TIMED OUT") : TEXT("FAILED")),
         Result.Duration,
         *FDateTime::Now().ToString());
-    FFileHelper::SaveStringToFile(LogContents, *TestLogPath);
-    // Add the per-test log as an artifact; keep array for multiple artifacts.
+    if (Result.bQuarantined)
     {
-        FScopeLock _lock(&GPalantirMutex);
-        if (!GPalantirArtifactPaths.Contains(Name))
-        {
-            GPalantirArtifactPaths.Add(Name, TArray<FString>());
-        }
-        GPalantirArtifactPaths[Name].Add(TestLogPath);
+        LogContents += TEXT("Quarantined: flaky (see Saved/NexusReports/flakiness.json)\n");
     }
+    FFileHelper::SaveStringToFile(LogContents, *TestLogPath);
 
-    if (!bPassed)
-    {
-        // Find the test to determine its priority; if critical, signal abort
-        for (FNexusTest* Test : UNexusCore::DiscoveredTests)
-        {
-            if (Test && Test->TestName == Name)
-            {
-                if ((static_cast<uint8>(Test->Priority) & static_cast<uint8>(ETestPriority::Critical)) != 0)
-                {
-                    const FString Reason = FString::Printf(TEXT("Critical test failed: %s"), *Name);
-                    UNexusCore::SignalAbort(Reason);
-                }
-                break;
-            }
-        }
-    }
+    // Fail-fast is decided by the lane that ran the test: only it knows whether the failure gates dependents
 }
 
 void FPalantirObserver::OnTestSkipped(const FString& Name)
 {
+    OnTestSkipped(FNexusTestRegistry::Get().FindOrAddId(Name));
+}
+
+void FPalantirObserver::OnTestSkipped(FNexusTestId TestId)
+{
+    if (TestId == INDEX_NONE)
+    {
+        return;
+    }
+
+    const FString Name = FNexusTestRegistry::Get().GetName(TestId).ToString();
     UE_LOG(LogTemp, Warning, TEXT("Palantir: Test skipped: %s"), *Name);
     
-    // Record skipped test result
+    const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("NexusReports");
+    FString SafeName = Name;
+    for (TCHAR& C : SafeName) if (!FChar::IsAlnum(C)) C = TEXT('_');
+    const FString TestLogPath = ReportDir / FString::Printf(TEXT("test_%s.log"), *SafeName);
+    
+    // Record skipped test result and register the skip log as artifact in one critical section
+    FPalantirTestResult Result;
+    Result.bPassed = false;
+    Result.bSkipped = true;
     {
         FScopeLock _lock(&GPalantirMutex);
-        GPalantirTestResults.Add(Name, false);  // Skipped counts as not-failed but not-passed
-        // Record full result for LCARS/Palantir
-        FPalantirTestResult Result;
-        Result.bPassed = false;
-        Result.bSkipped = true;
-        Result.Duration = 0.0;
-        // Find priority if possible
-        Result.Priority = 0;
-        for (FNexusTest* Test : UNexusCore::DiscoveredTests)
-        {
-            if (Test && Test->TestName == Name)
-            {
-                Result.Priority = static_cast<uint8>(Test->Priority);
-                break;
-            }
-        }
-        FPalantirOracle::Get().RecordTestResult(Name, Result);
+        FPalantirTestSlot& Slot = GetSlotLocked(TestId);
+        Slot.bHasResult = true;
+        Slot.bPassed = false;  // Skipped counts as not-failed but not-passed
+        Result.Priority = FindTestPriorityLocked(TestId);
+        Slot.Artifacts.Add(TestLogPath);
     }
+    FPalantirOracle::Get().RecordTestResult(TestId, Result);
     
     // Write per-test skip log
-    const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("NexusReports");
     FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*ReportDir);
-    
-    FString SafeName = Name;
-    for (TCHAR& C : SafeName) if (!FChar::IsAlnum(C)) C = TEXT('_');
-    const FString TestLogPath = ReportDir / FString::Printf(TEXT("test_%s.log"), *SafeName);
     FString LogContents = FString::Printf(TEXT("Test: %s\nResult: SKIPPED\nTime: %s\n"),
         *Name,
         *FDateTime::Now().ToString());
     FFileHelper::SaveStringToFile(LogContents, *TestLogPath);
-    
-    // Register skip log as artifact
+}
+
+void FPalantirObserver::OnTestTimedOut(const FString& Name, double ElapsedSeconds, const TArray<FString>& StackLines)
+{
+    OnTestTimedOut(FNexusTestRegistry::Get().FindOrAddId(Name), ElapsedSeconds, StackLines);
+}
+
+void FPalantirObserver::OnTestTimedOut(FNexusTestId TestId, double ElapsedSeconds, const TArray<FString>& StackLines)
+{
+    if (TestId == INDEX_NONE)
+    {
+        return;
+    }
+
+    const FString Name = FNexusTestRegistry::Get().GetName(TestId).ToString();
+    UE_LOG(LogTemp, Error, TEXT("Palantir: Test timed out: %s (%.1fs)"), *Name, ElapsedSeconds);
+
+    const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("NexusReports");
+    FString SafeName = Name;
+    for (TCHAR& C : SafeName) if (!FChar::IsAlnum(C)) C = TEXT('_');
+    const FString StackPath = ReportDir / FString::Printf(TEXT("timeout_%s.txt"), *SafeName);
+
     {
         FScopeLock _lock(&GPalantirMutex);
-        if (!GPalantirArtifactPaths.Contains(Name))
-        {
-            GPalantirArtifactPaths.Add(Name, TArray<FString>());
-        }
-        GPalantirArtifactPaths[Name].Add(TestLogPath);
+        FPalantirTestSlot& Slot = GetSlotLocked(TestId);
+        Slot.bTimedOut = true;
+        Slot.Artifacts.Add(StackPath);
     }
+
+    // Where the test was stuck when its deadline passed
+    FPlatformFileManager::Get().GetPlatformFile().CreateDirectoryTree(*ReportDir);
+    FString Contents = FString::Printf(TEXT("Test: %s\nResult: TIMED OUT\nElapsed: %.3f seconds\nTime: %s\n\nStack at deadline:\n"),
+        *Name,
+        ElapsedSeconds,
+        *FDateTime::Now().ToString());
+    Contents += StackLines.Num() > 0 ? FString::Join(StackLines, TEXT("\n")) : FString(TEXT("(stack capture unavailable on this platform)"));
+    FFileHelper::SaveStringToFile(Contents, *StackPath);
 }
 
 void FPalantirObserver::UpdateLiveOverlay()
@@ -410,9 +565,9 @@ void FPalantirObserver::UpdateLiveOverlay()
     ImGui::Begin("PALANTIR LIVE", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
     ImGui::TextColored(ImVec4(1, 0.8f, 0, 1), "NEXUS STATUS");
     ImGui::Separator();
-    ImGui::Text("Tests Run: %d / %d", UNexusCore::PassedTests + UNexusCore::FailedTests, UNexusCore::TotalTests);
-    ImGui::Text("Passed: %d", UNexusCore::PassedTests);
-    ImGui::Text("Failed: %d", UNexusCore::FailedTests);
+    ImGui::Text("Tests Run: %d / %d", UNexusCore::PassedTests.load() + UNexusCore::FailedTests.load(), UNexusCore::TotalTests.load());
+    ImGui::Text("Passed: %d", UNexusCore::PassedTests.load());
+    ImGui::Text("Failed: %d", UNexusCore::FailedTests.load());
     ImGui::End();
 #else
     // ImGui not available - overlay disabled
@@ -425,6 +580,7 @@ void FPalantirObserver::LoadBaselineData()
     const FString BaselineFile = ReportDir / TEXT("test-baseline.json");
     
     GBaselineTestDurations.Empty();
+    GBaselineLoaded = true;
     
     if (!FPaths::FileExists(*BaselineFile))
     {
@@ -474,14 +630,28 @@ void FPalantirObserver::SaveBaselineData()
         }
     }
     
-    // Build JSON with current test durations
+    // Build JSON with current test durations merged over the existing baseline.
+    // Re-read the file first: sharded runs only time a subset of tests, and sibling
+    // shards may have saved since we started.
     TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
     
+    FString ExistingJson;
+    TSharedPtr<FJsonObject> ExistingObject;
+    if (FFileHelper::LoadFileToString(ExistingJson, *BaselineFile) &&
+        FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ExistingJson), ExistingObject) && ExistingObject.IsValid())
     {
+        JsonObject = ExistingObject;
+    }
+    
+    {
+        const FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
         FScopeLock _lock(&GPalantirMutex);
-        for (const auto& Pair : GPalantirTestDurations)
+        for (int32 Id = 0; Id < GPalantirSlots.Num(); ++Id)
         {
-            JsonObject->SetNumberField(Pair.Key, Pair.Value);
+            if (GPalantirSlots[Id].bHasDuration)
+            {
+                JsonObject->SetNumberField(Registry.GetName(Id).ToString(), GPalantirSlots[Id].Duration);
+            }
         }
     }
     
@@ -491,7 +661,7 @@ void FPalantirObserver::SaveBaselineData()
     
     if (FFileHelper::SaveStringToFile(JsonOutput, *BaselineFile))
     {
-        UE_LOG(LogTemp, Display, TEXT("✓ Saved baseline data for %d tests to: %s"), GPalantirTestDurations.Num(), *BaselineFile);
+        UE_LOG(LogTemp, Display, TEXT("✓ Saved baseline data for %d tests to: %s"), JsonObject->Values.Num(), *BaselineFile);
     }
     else
     {
@@ -499,6 +669,24 @@ void FPalantirObserver::SaveBaselineData()
     }
 }
 
+bool FPalantirObserver::GetBaselineDuration(const FString& Name, double& OutSeconds)
+{
+    FScopeLock _lock(&GPalantirMutex);
+
+    // Console-driven runs never call Initialize(), so load the baseline on demand
+    if (!GBaselineLoaded)
+    {
+        LoadBaselineData();
+    }
+
+    if (const double* Found = GBaselineTestDurations.Find(Name))
+    {
+        OutSeconds = *Found;
+        return true;
+    }
+    return false;
+}
+
 void FPalantirObserver::DetectRegressions()
 {
     GRegressionDeltas.Empty();
@@ -507,11 +695,16 @@ void FPalantirObserver::DetectRegressions()
     const double REGRESSION_THRESHOLD = 0.1;  // 10% slower is a regression
     
     {
+        const FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
         FScopeLock _lock(&GPalantirMutex);
-        for (const auto& Pair : GPalantirTestDurations)
+        for (int32 Id = 0; Id < GPalantirSlots.Num(); ++Id)
         {
-            const FString& TestName = Pair.Key;
-            double CurrentDuration = Pair.Value;
+            if (!GPalantirSlots[Id].bHasDuration)
+            {
+                continue;
+            }
+            const FString TestName = Registry.GetName(Id).ToString();
+            double CurrentDuration = GPalantirSlots[Id].Duration;
             
             if (GBaselineTestDurations.Contains(TestName))
             {
@@ -595,6 +788,28 @@ void FPalantirObserver::GenerateFinalReport()
     Html.ReplaceInline(TEXT("{REGRESSION_COUNT}"), *FString::FromInt(GRegressionCount));
     Html.ReplaceInline(TEXT("{REGRESSION_STATUS}"), *RegressionStatus);
     
+    // Actor pool (FNexusActorPool, opt-in): how many SpawnTestCharacter calls reused an actor
+    const FNexusActorPoolStats PoolStats = FNexusActorPool::Get().GetStats();
+    const bool bActorPoolUsed = PoolStats.Hits + PoolStats.Misses > 0;
+    FString PoolHitRate = TEXT("N/A");
+    FString PoolSummary = FNexusActorPool::IsEnabled() ? TEXT("No pooled spawns") : TEXT("Pool disabled");
+    if (bActorPoolUsed)
+    {
+        PoolHitRate = FString::Printf(TEXT("%.0f%%"), PoolStats.GetHitRate() * 100.0);
+        PoolSummary = FString::Printf(TEXT("%d hits / %d misses / %d pre-warmed"), PoolStats.Hits, PoolStats.Misses, PoolStats.Prewarmed);
+    }
+    Html.ReplaceInline(TEXT("{ACTOR_POOL_HIT_RATE}"), *PoolHitRate);
+    Html.ReplaceInline(TEXT("{ACTOR_POOL_STATS}"), *PoolSummary);
+    
+    // Quarantine (FNexusFlakiness): flaky tests that ran in the low-priority lane, outside the integrity figures
+    const int32 QuarantinedCount = UNexusCore::QuarantinedTests;
+    const int32 QuarantinedFailures = UNexusCore::QuarantinedFailures;
+    const FString QuarantineSummary = QuarantinedCount > 0
+        ? FString::Printf(TEXT("%d passed / %d failed"), QuarantinedCount - QuarantinedFailures, QuarantinedFailures)
+        : FString(FNexusFlakiness::IsQuarantineEnabled() ? TEXT("No flaky tests") : TEXT("Quarantine disabled"));
+    Html.ReplaceInline(TEXT("{QUARANTINED_TESTS}"), *FString::FromInt(QuarantinedCount));
+    Html.ReplaceInline(TEXT("{QUARANTINE_STATS}"), *QuarantineSummary);
+    
     // Generate tag distribution cards and grouped test sections
     // Collect unique tags dynamically from test results instead of hardcoding
     TArray<FString> UniqueTags;
@@ -603,34 +818,34 @@ void FPalantirObserver::GenerateFinalReport()
     TMap<FString, TArray<FString>> TagTestsMap;
     
     // Iterate through actual test results and categorize by stored custom tags
+    TMap<FString, bool> PassedByName;
     {
+        const FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
+        const TArray<FString> UntaggedTags = { TEXT("Untagged") };
         FScopeLock _lock(&GPalantirMutex);
-        for (const auto& ResultPair : GPalantirTestResults)
+        for (int32 Id = 0; Id < GPalantirSlots.Num(); ++Id)
         {
-            const FString& TestName = ResultPair.Key;
-            bool bPassed = ResultPair.Value;
-            
-            // Get the stored tags for this test (captured during OnTestStarted)
-            TArray<FString> Tags;
-            if (GPalantirTestTags.Contains(TestName))
+            const FPalantirTestSlot& Slot = GPalantirSlots[Id];
+            if (!Slot.bHasResult)
             {
-                Tags = GPalantirTestTags[TestName];
-            }
-            else
-            {
-                // Fallback: tests without tags still need to appear somewhere
-                Tags.Add(TEXT("Untagged"));
+                continue;
             }
+            const FString TestName = Registry.GetName(Id).ToString();
+            const bool bPassed = Slot.bPassed;
+            PassedByName.Add(TestName, bPassed);
+            
+            // Get the stored tags for this test (captured during OnTestStarted)
+            // Fallback: tests without tags still need to appear somewhere
+            const TArray<FString>& Tags = Slot.bHasTags ? Slot.Tags : UntaggedTags;
             
             // Categorize by all tags
             for (const FString& Tag : Tags)
             {
-                if (!UniqueTags.Contains(Tag))
+                int32& TagCount = TagCountMap.FindOrAdd(Tag, 0);
+                if (TagCount++ == 0)
                 {
                     UniqueTags.Add(Tag);
                 }
-                
-                TagCountMap.FindOrAdd(Tag, 0)++;
                 if (bPassed) TagPassCountMap.FindOrAdd(Tag, 0)++;
                 TagTestsMap.FindOrAdd(Tag).Add(TestName);
             }
@@ -683,10 +898,9 @@ void FPalantirObserver::GenerateFinalReport()
         
         // Add test rows for this tag
         {
-            FScopeLock _lock(&GPalantirMutex);
             for (const FString& TestName : TestsInTag)
             {
-                bool bPassed = GPalantirTestResults.Contains(TestName) && GPalantirTestResults[TestName];
+                bool bPassed = PassedByName.FindRef(TestName);
                 GroupedSections += FString::Printf(
                     TEXT("            <tr>\n")
                     TEXT("                <td class=\"%s\">%s</td>\n")
@@ -700,16 +914,22 @@ void FPalantirObserver::GenerateFinalReport()
     }
     Html.ReplaceInline(TEXT("{GROUPED_TEST_SECTIONS}"), *GroupedSections);
     
+    // Names are resolved once here for every table and report below
+    const TMap<FString, FPalantirTestResult> OracleResults = FPalantirOracle::Get().GetAllTestResults();
+
     // Generate flat test table rows with skipped status
     FString TableRows;
-    for (const auto& Pair : FPalantirOracle::Get().GetAllTestResults())
+    for (const auto& Pair : OracleResults)
     {
         const FString& TestName = Pair.Key;
         const FPalantirTestResult& Result = Pair.Value;
         FString Status;
         FString CssClass;
         if (Result.bSkipped) { Status = TEXT("SKIPPED"); CssClass = TEXT("test-skipped"); }
+        else if (Result.bQuarantined) { Status = Result.bPassed ? TEXT("QUARANTINED (PASSED)") : TEXT("QUARANTINED (FAILED)"); CssClass = TEXT("test-skipped"); }
+        else if (Result.bCached) { Status = TEXT("CACHED"); CssClass = TEXT("test-passed"); }
         else if (Result.bPassed) { Status = TEXT("PASSED"); CssClass = TEXT("test-passed"); }
+        else if (Result.bTimedOut) { Status = TEXT("TIMED OUT"); CssClass = TEXT("test-failed"); }
         else { Status = TEXT("FAILED"); CssClass = TEXT("test-failed"); }
         TableRows += FString::Printf(
             TEXT("<tr><td class='test-name'>%s</td><td class='%s'>%s</td></tr>\n"),
@@ -754,8 +974,7 @@ void FPalantirObserver::GenerateFinalReport()
     // Generate critical tests details table
     FString CriticalTestsRows;
     {
-        FScopeLock _lock(&GPalantirMutex);
-        for (const auto& Pair : FPalantirOracle::Get().GetAllTestResults())
+        for (const auto& Pair : OracleResults)
         {
             const FString& TestName = Pair.Key;
             const FPalantirTestResult& Result = Pair.Value;
@@ -795,27 +1014,66 @@ void FPalantirObserver::GenerateFinalReport()
         UE_LOG(LogTemp, Error, TEXT("Failed to write HTML report --> %s"), *HtmlPath);
     }
     
-    // Count failures and skipped
+    // Count failures and skipped (a failed quarantined test is reported as skipped, so it never breaks the build)
     int32 Total = 0, Failures = 0, Skipped = 0;
-    for (const auto& Pair : FPalantirOracle::Get().GetAllTestResults()) {
+    for (const auto& Pair : OracleResults) {
         ++Total;
-        if (Pair.Value.bSkipped) ++Skipped;
+        if (Pair.Value.bSkipped || (Pair.Value.bQuarantined && !Pair.Value.bPassed)) ++Skipped;
         else if (!Pair.Value.bPassed) ++Failures;
     }
 
     FString Xml = TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
     Xml += FString::Printf(TEXT("<testsuites>\n  <testsuite name=\"Nexus\" tests=\"%d\" failures=\"%d\" skipped=\"%d\">\n"), Total, Failures, Skipped);
+    if (bActorPoolUsed || QuarantinedCount > 0)
+    {
+        Xml += TEXT("    <properties>\n");
+        if (bActorPoolUsed)
+        {
+            Xml += FString::Printf(TEXT("      <property name=\"actorPoolHits\" value=\"%d\" />\n      <property name=\"actorPoolMisses\" value=\"%d\" />\n      <property name=\"actorPoolPrewarmed\" value=\"%d\" />\n"),
+                PoolStats.Hits, PoolStats.Misses, PoolStats.Prewarmed);
+        }
+        if (QuarantinedCount > 0)
+        {
+            Xml += FString::Printf(TEXT("      <property name=\"quarantined\" value=\"%d\" />\n      <property name=\"quarantinedFailures\" value=\"%d\" />\n"),
+                QuarantinedCount, QuarantinedFailures);
+        }
+        Xml += TEXT("    </properties>\n");
+    }
+
+    // Failure stacks and the failing attempt's breadcrumbs (only failures pay for formatting them);
+    // Flush waits for the background symbolicator, so every frame is resolved by now
+    FNexusResultCollector::Flush();
+    TMap<FString, FString> FailureStacks;
+    for (const FNexusTestResult& NexusResult : FNexusTest::AllResults)
+    {
+        if (NexusResult.bPassed || NexusResult.bSkipped)
+        {
+            continue;
+        }
+        FString Details = NexusResult.HasStackTrace() ? NexusResult.GetStackTraceString() : FString();
+        if (NexusResult.AttemptHistory.Num() > 0 && NexusResult.AttemptHistory.Last().Breadcrumbs.Num() > 0)
+        {
+            const FNexusAttemptRecord& LastAttempt = NexusResult.AttemptHistory.Last();
+            Details += FString::Printf(TEXT("%sBreadcrumbs (attempt %d):\n%s"), Details.IsEmpty() ? TEXT("") : TEXT("\n"),
+                LastAttempt.Attempt, *FString::Join(LastAttempt.Breadcrumbs.FormatLines(), TEXT("\n")));
+        }
+        if (!Details.IsEmpty())
+        {
+            FailureStacks.Add(NexusResult.TestName, MoveTemp(Details));
+        }
+    }
 
-    for (const auto& Pair : FPalantirOracle::Get().GetAllTestResults())
+    const FNexusTestRegistry& Registry = FNexusTestRegistry::Get();
+    for (const auto& Pair : OracleResults)
     {
         const FString& TestName = Pair.Key;
         const FPalantirTestResult& Result = Pair.Value;
         double DurationSeconds = Result.Duration;
         FString SystemOut;
-        if (GPalantirArtifactPaths.Contains(TestName))
+        const FNexusTestId TestId = Registry.FindId(TestName);
+        if (GPalantirSlots.IsValidIndex(TestId))
         {
-            const TArray<FString>& Arr = GPalantirArtifactPaths[TestName];
-            for (const FString& ArtifactPath : Arr)
+            for (const FString& ArtifactPath : GPalantirSlots[TestId].Artifacts)
             {
                 SystemOut += FString::Printf(TEXT("%s\n"), *ArtifactPath);
             }
@@ -825,9 +1083,25 @@ void FPalantirObserver::GenerateFinalReport()
         {
             Xml += TEXT("\n      <skipped />\n");
         }
-        else if (!Result.bPassed)
+        else if (Result.bQuarantined)
+        {
+            // Flaky per FNexusFlakiness: the outcome is kept for the record but never fails the suite
+            Xml += Result.bPassed
+                ? TEXT("\n      <properties><property name=\"quarantined\" value=\"true\" /></properties>\n")
+                : TEXT("\n      <skipped message=\"quarantined: failed\" />\n");
+        }
+        else if (Result.bTimedOut || !Result.bPassed)
         {
-            Xml += TEXT("\n      <failure message=\"failed\">Test failed</failure>\n");
+            const FString* Stack = FailureStacks.Find(TestName);
+            Xml += FString::Printf(TEXT("\n      <failure message=\"%s\"><![CDATA[%s%s%s]]></failure>\n"),
+                Result.bTimedOut ? TEXT("timed out") : TEXT("failed"),
+                Result.bTimedOut ? TEXT("Test exceeded its deadline") : TEXT("Test failed"),
+                Stack ? TEXT("\n") : TEXT(""), Stack ? **Stack : TEXT(""));
+        }
+        else if (Result.bCached)
+        {
+            // Passed in an earlier run with the same module binaries and data; not executed this time
+            Xml += TEXT("\n      <properties><property name=\"cached\" value=\"true\" /></properties>\n");
         }
         if (!SystemOut.IsEmpty())
         {
@@ -860,13 +1134,29 @@ void FPalantirObserver::GenerateFinalReport()
         {
             // Fallback: copy the in-memory Palantir maps
             FScopeLock _lock2(&GPalantirMutex);
-            for (const auto& P : GPalantirTestResults) Results.Results.Add(P.Key, P.Value);
-            for (const auto& P : GPalantirTestDurations) Results.Durations.Add(P.Key, P.Value);
-            for (const auto& P : GPalantirArtifactPaths) Results.Artifacts.Add(P.Key, P.Value);
+            CollectResultsLocked(Results.Results, Results.Durations, Results.Artifacts);
         }
 
         LCARSReporter::ExportResultsToLCARSFromPalantir(Results.Results, Results.Durations, Results.Artifacts, LcarsPath);
         // Register with Palantir so CI and artifact collectors pick it up
         FPalantirObserver::RegisterArtifact(TEXT("LCARS_Final"), LcarsPath);
     }
+
+    // Whole-run timeline (-NexusTimeline); written once per run
+    const FString TimelinePath = FPalantirTimeline::Write(ReportDir);
+    if (!TimelinePath.IsEmpty())
+    {
+        FPalantirObserver::RegisterArtifact(TEXT("Nexus_Timeline"), TimelinePath);
+    }
+
+    // OTLP export (OtlpEndpoint / OtlpFile): ship what is still queued before the process moves on
+    if (FPalantirOtlpExporter::IsEnabled())
+    {
+        FPalantirOtlpExporter::Flush();
+        const FString OtlpPath = FPalantirOtlpExporter::GetFilePath();
+        if (!OtlpPath.IsEmpty())
+        {
+            FPalantirObserver::RegisterArtifact(TEXT("Nexus_Otlp"), OtlpPath);
+        }
+    }
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "PalantirRequest.h"
 #include "PalantirTrace.h"
+#include "Nexus/Core/Public/NexusCancellation.h"
 #include "HttpModule.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Dom/JsonObject.h"
@@ -221,9 +222,29 @@ TSharedRef<IHttpRequest, ESPMode::ThreadSafe> FPalantirRequest::CreateHttpReques
 	{
 		Request->SetHeader(TEXT("X-Trace-ID"), TraceID);
 		Request->SetHeader(TEXT("User-Agent"), FString::Printf(TEXT("NexusTest/%s"), *TraceID));
+
+		// W3C Trace Context: same trace, parented to the span making the request (a fresh ID per request
+		// outside one). A traceparent set with WithHeader is kept if valid, to continue an upstream trace.
+		const FString* CallerTraceParent = Headers.Find(TEXT("traceparent"));
+		FPalantirTraceParent Parsed;
+		if (!CallerTraceParent || !FPalantirTraceParent::Parse(*CallerTraceParent, Parsed))
+		{
+			if (CallerTraceParent)
+			{
+				UE_LOG(LogPalantirTrace, Warning, TEXT("Ignoring malformed traceparent \"%s\" on %s %s"), **CallerTraceParent, *Verb, *URL);
+			}
+			FPalantirTraceParent TraceParent;
+			TraceParent.TraceId = FPalantirTrace::GetCurrentTraceId();
+			TraceParent.ParentId = FPalantirTrace::GetCurrentSpanId();
+			if (TraceParent.ParentId == 0)
+			{
+				TraceParent.ParentId = FPalantirTrace::NewSpanId();
+			}
+			Request->SetHeader(TEXT("traceparent"), TraceParent.ToString());
+		}
 		
 		// Log breadcrumb for network request
-		PALANTIR_BREADCRUMB(TEXT("HttpRequest"), FString::Printf(TEXT("%s %s"), *Verb, *URL));
+		PALANTIR_BREADCRUMBF(TEXT("HttpRequest"), TEXT("%s %s"), Verb, URL);
 	}
 
 	return Request;
@@ -295,15 +316,29 @@ FPalantirResponse FPalantirRequest::ExecuteBlocking()
 	FString ValidationError;
 
 	double StartTime = FPlatformTime::Seconds();
+	FPalantirSpan RequestSpan(Verb, TEXT("http"));
 
-	while (Attempt <= MaxRetries && !bSuccess)
+	// Waits below are sliced so a cancelled test attempt (deadline, run abort) stops waiting within milliseconds
+	const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> CancellationToken = FNexusCancellationToken::GetCurrent();
+	auto IsCancelled = [&CancellationToken]() { return CancellationToken.IsValid() && CancellationToken->IsCancellationRequested(); };
+	const uint32 WaitSliceMs = 10;
+
+	while (Attempt <= MaxRetries && !bSuccess && !IsCancelled())
 	{
 		if (Attempt > 0)
 		{
 			// Exponential backoff
 			float DelaySeconds = RetryDelaySeconds * FMath::Pow(2.0f, Attempt - 1);
 			UE_LOG(LogPalantirTrace, Warning, TEXT("Retrying %s %s (attempt %d/%d) after %.1fs"), *Verb, *URL, Attempt + 1, MaxRetries + 1, DelaySeconds);
-			FPlatformProcess::Sleep(DelaySeconds);
+			const double BackoffEnd = FPlatformTime::Seconds() + DelaySeconds;
+			while (FPlatformTime::Seconds() < BackoffEnd && !IsCancelled())
+			{
+				FPlatformProcess::Sleep(WaitSliceMs / 1000.0f);
+			}
+			if (IsCancelled())
+			{
+				break;
+			}
 		}
 
 		TSharedRef<IHttpRequest, ESPMode::ThreadSafe> Request = CreateHttpRequest();
@@ -373,7 +408,19 @@ FPalantirResponse FPalantirRequest::ExecuteBlocking()
 		// 5. Smart pointers keep data alive until lambda callback completes
 		if (CompletionEvent)
 		{
-			CompletionEvent->Wait(static_cast<uint32>(TimeoutSeconds * 1000.0f));
+			const double WaitEnd = FPlatformTime::Seconds() + TimeoutSeconds;
+			while (!CompletionEvent->Wait(WaitSliceMs))
+			{
+				if (IsCancelled())
+				{
+					Request->CancelRequest();
+					break;
+				}
+				if (FPlatformTime::Seconds() >= WaitEnd)
+				{
+					break;
+				}
+			}
 		}
 		
 		// Add a safety spin-wait to handle edge cases where callback might still be
@@ -409,7 +456,7 @@ FPalantirResponse FPalantirRequest::ExecuteBlocking()
 		// Log response breadcrumb
 		if (!Response.TraceID.IsEmpty())
 		{
-			PALANTIR_BREADCRUMB(TEXT("HttpResponse"), FString::Printf(TEXT("%d in %.1fms"), Response.StatusCode, Response.DurationMs));
+			PALANTIR_BREADCRUMBF(TEXT("HttpResponse"), TEXT("%d in %.1fms"), Response.StatusCode, Response.DurationMs);
 		}
 
 		// Validate response
@@ -425,11 +472,19 @@ FPalantirResponse FPalantirRequest::ExecuteBlocking()
 		++Attempt;
 	}
 
-	if (!bSuccess && !ValidationError.IsEmpty())
+	if (!bSuccess && IsCancelled())
+	{
+		UE_LOG(LogPalantirTrace, Warning, TEXT("%s %s cancelled: %s"), *Verb, *URL, *CancellationToken->GetReason());
+	}
+	else if (!bSuccess && !ValidationError.IsEmpty())
 	{
 		UE_LOG(LogPalantirTrace, Error, TEXT("Request failed after %d attempts: %s"), Attempt, *ValidationError);
 	}
 
+	if (FPalantirSpan::IsObserved())
+	{
+		RequestSpan.SetDetail(FString::Printf(TEXT("%s -> %d (%d attempt(s))"), *URL, Response.StatusCode, Attempt));
+	}
 	return Response;
 }
 
@@ -444,7 +499,8 @@ void FPalantirRequest::ExecuteAsync(TFunction<void(const FPalantirResponse&)> On
 	TSharedPtr<FString> VerbPtr = MakeShared<FString>(Verb);
 	TSharedPtr<FString> URLPtr = MakeShared<FString>(URL);
 
-	Request->OnProcessRequestComplete().BindLambda([OnComplete, TraceID, StartTime, VerbPtr, URLPtr](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bConnectedSuccessfully)
+	// The completion runs wherever the HTTP module ticks; Wrap brings it back into this trace (and under this span)
+	Request->OnProcessRequestComplete().BindLambda(FPalantirTrace::Wrap(TEXT("HttpResponse"), [OnComplete, TraceID, StartTime, VerbPtr, URLPtr](FHttpRequestPtr Req, FHttpResponsePtr Res, bool bConnectedSuccessfully)
 	{
 		FPalantirResponse Response;
 		Response.TraceID = TraceID;
@@ -474,12 +530,12 @@ void FPalantirRequest::ExecuteAsync(TFunction<void(const FPalantirResponse&)> On
 		// Log response breadcrumb
 		if (!TraceID.IsEmpty())
 		{
-			PALANTIR_BREADCRUMB(TEXT("HttpResponse"), FString::Printf(TEXT("%d in %.1fms"), Response.StatusCode, Response.DurationMs));
+			PALANTIR_BREADCRUMBF(TEXT("HttpResponse"), TEXT("%d in %.1fms"), Response.StatusCode, Response.DurationMs);
 		}
 
 		// Call user callback
 		OnComplete(Response);
-	});
+	}));
 
 	// Handle ProcessRequest failure
 	if (!Request->ProcessRequest())
@@ -494,3 +550,24 @@ void FPalantirRequest::ExecuteAsync(TFunction<void(const FPalantirResponse&)> On
 		OnComplete(ErrorResponse);
 	}
 }
+
+FPalantirResponseAwaiter FPalantirRequest::AsyncAwait()
+{
+	TSharedRef<FPalantirResponseAwaiter::FState, ESPMode::ThreadSafe> State = MakeShared<FPalantirResponseAwaiter::FState, ESPMode::ThreadSafe>();
+
+	// Copy of the expectations so validation does not depend on this builder outliving the request
+	const FPalantirRequest Expectations = *this;
+	ExecuteAsync([State, Expectations](const FPalantirResponse& Response)
+	{
+		FString ValidationError;
+		if (!Expectations.ValidateResponse(Response, ValidationError))
+		{
+			UE_LOG(LogPalantirTrace, Warning, TEXT("Validation failed: %s"), *ValidationError);
+		}
+
+		State->Response = Response;
+		State->bDone.store(true, std::memory_order_release);
+	});
+
+	return FPalantirResponseAwaiter(State);
+}
@@ -0,0 +1,450 @@
+#include "PalantirTimeline.h"
+#include "PalantirTrace.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/ThreadManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include <atomic>
+
+enum class EPalantirTimelinePhase : uint8
+{
+	Complete,
+	Instant,
+	GlobalInstant,
+	AsyncBegin,
+	AsyncEnd,
+	Counter,
+	FlowStart,
+	FlowEnd
+};
+
+struct FPalantirTimelineEvent
+{
+	EPalantirTimelinePhase Phase = EPalantirTimelinePhase::Instant;
+	const TCHAR* Category = TEXT("");
+	FString Name;
+	FString Detail;
+	uint64 StartCycles = 0;
+	uint64 EndCycles = 0;
+	uint64 Id = 0;
+	uint64 ParentId = 0;  // Complete spans opened as FPalantirSpan
+	double Value = 0.0;
+};
+
+/** One thread's events; only its own thread appends, Write reads it once the run is over */
+struct FPalantirTimelineLane
+{
+	uint32 ThreadId = 0;
+	FString ThreadName;
+	bool bGameThread = false;
+	FCriticalSection Lock;
+	TArray<FPalantirTimelineEvent> Events;
+	TArray<FPalantirBreadcrumbEvent> Breadcrumbs;
+};
+
+namespace FPalantirTimelineState
+{
+	static std::atomic<bool> bRecording{false};
+	static std::atomic<uint32> Generation{0};
+	static uint64 OriginCycles = 0;
+
+	// Lanes of the current run; threads register on their first event of a run
+	static FCriticalSection LanesLock;
+	static TArray<TSharedPtr<FPalantirTimelineLane, ESPMode::ThreadSafe>> Lanes;
+
+	thread_local TSharedPtr<FPalantirTimelineLane, ESPMode::ThreadSafe> CurrentLane;
+	thread_local uint32 CurrentLaneGeneration = 0;
+}
+
+static FPalantirTimelineLane& GetLane()
+{
+	using namespace FPalantirTimelineState;
+	const uint32 RunGeneration = Generation.load(std::memory_order_acquire);
+	if (!CurrentLane.IsValid() || CurrentLaneGeneration != RunGeneration)
+	{
+		CurrentLane = MakeShared<FPalantirTimelineLane, ESPMode::ThreadSafe>();
+		CurrentLane->ThreadId = FPlatformTLS::GetCurrentThreadId();
+		CurrentLane->bGameThread = IsInGameThread();
+		CurrentLane->ThreadName = CurrentLane->bGameThread ? FString(TEXT("GameThread")) : FThreadManager::GetThreadName(CurrentLane->ThreadId);
+		if (CurrentLane->ThreadName.IsEmpty())
+		{
+			CurrentLane->ThreadName = FString::Printf(TEXT("Thread %u"), CurrentLane->ThreadId);
+		}
+		CurrentLaneGeneration = RunGeneration;
+
+		FScopeLock Lock(&LanesLock);
+		Lanes.Add(CurrentLane);
+	}
+	return *CurrentLane;
+}
+
+static void AddEvent(FPalantirTimelineEvent&& Event)
+{
+	FPalantirTimelineLane& Lane = GetLane();
+	FScopeLock Lock(&Lane.Lock);  // Uncontended while recording; Write takes it once
+	Lane.Events.Add(MoveTemp(Event));
+}
+
+bool FPalantirTimeline::IsEnabled()
+{
+	if (FParse::Param(FCommandLine::Get(), TEXT("NexusTimeline")))
+	{
+		return true;
+	}
+
+	bool bEnabled = false;
+	if (GConfig)
+	{
+		GConfig->GetBool(TEXT("/Script/Nexus.NexusSettings"), TEXT("bWriteTimeline"), bEnabled, GGameIni);
+	}
+	return bEnabled;
+}
+
+bool FPalantirTimeline::IsRecording()
+{
+	return FPalantirTimelineState::bRecording.load(std::memory_order_relaxed);
+}
+
+void FPalantirTimeline::BeginRun()
+{
+	using namespace FPalantirTimelineState;
+	{
+		FScopeLock Lock(&LanesLock);
+		Lanes.Reset();
+		OriginCycles = FPlatformTime::Cycles64();
+	}
+	Generation.fetch_add(1, std::memory_order_release);
+	bRecording = IsEnabled();
+}
+
+void FPalantirTimeline::AddSpan(FStringView Name, const TCHAR* Category, uint64 StartCycles, uint64 EndCycles, FStringView Detail, uint64 SpanId, uint64 ParentSpanId)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FPalantirTimelineEvent Event;
+	Event.Phase = EPalantirTimelinePhase::Complete;
+	Event.Category = Category;
+	Event.Name = FString(Name);
+	Event.Detail = FString(Detail);
+	Event.StartCycles = StartCycles;
+	Event.EndCycles = EndCycles;
+	Event.Id = SpanId;
+	Event.ParentId = ParentSpanId;
+	AddEvent(MoveTemp(Event));
+}
+
+void FPalantirTimeline::AddInstant(FStringView Name, const TCHAR* Category, FStringView Detail, bool bGlobal)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FPalantirTimelineEvent Event;
+	Event.Phase = bGlobal ? EPalantirTimelinePhase::GlobalInstant : EPalantirTimelinePhase::Instant;
+	Event.Category = Category;
+	Event.Name = FString(Name);
+	Event.Detail = FString(Detail);
+	Event.StartCycles = FPlatformTime::Cycles64();
+	AddEvent(MoveTemp(Event));
+}
+
+void FPalantirTimeline::BeginAsyncSpan(FStringView Name, const TCHAR* Category, uint64 Id)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FPalantirTimelineEvent Event;
+	Event.Phase = EPalantirTimelinePhase::AsyncBegin;
+	Event.Category = Category;
+	Event.Name = FString(Name);
+	Event.StartCycles = FPlatformTime::Cycles64();
+	Event.Id = Id;
+	AddEvent(MoveTemp(Event));
+}
+
+void FPalantirTimeline::EndAsyncSpan(FStringView Name, const TCHAR* Category, uint64 Id, FStringView Detail)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FPalantirTimelineEvent Event;
+	Event.Phase = EPalantirTimelinePhase::AsyncEnd;
+	Event.Category = Category;
+	Event.Name = FString(Name);
+	Event.Detail = FString(Detail);
+	Event.StartCycles = FPlatformTime::Cycles64();
+	Event.Id = Id;
+	AddEvent(MoveTemp(Event));
+}
+
+void FPalantirTimeline::AddCounter(const TCHAR* Name, double Value)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FPalantirTimelineEvent Event;
+	Event.Phase = EPalantirTimelinePhase::Counter;
+	Event.Category = TEXT("counter");
+	Event.Name = Name;
+	Event.StartCycles = FPlatformTime::Cycles64();
+	Event.Value = Value;
+	AddEvent(MoveTemp(Event));
+}
+
+void FPalantirTimeline::AddFlow(uint64 FlowId, bool bStart)
+{
+	if (!IsRecording() || FlowId == 0)
+	{
+		return;
+	}
+
+	FPalantirTimelineEvent Event;
+	Event.Phase = bStart ? EPalantirTimelinePhase::FlowStart : EPalantirTimelinePhase::FlowEnd;
+	Event.Category = TEXT("flow");
+	Event.Name = TEXT("handoff");
+	Event.StartCycles = FPlatformTime::Cycles64();
+	Event.Id = FlowId;
+	AddEvent(MoveTemp(Event));
+}
+
+void FPalantirTimeline::AddBreadcrumb(const FPalantirBreadcrumbEvent& Event)
+{
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	FPalantirTimelineLane& Lane = GetLane();
+	FScopeLock Lock(&Lane.Lock);
+	Lane.Breadcrumbs.Add(Event);
+}
+
+FString FPalantirTimeline::Write(const FString& ReportDir)
+{
+	using namespace FPalantirTimelineState;
+	if (!bRecording.exchange(false))
+	{
+		return FString();
+	}
+
+	TArray<TSharedPtr<FPalantirTimelineLane, ESPMode::ThreadSafe>> RunLanes;
+	uint64 Origin = 0;
+	{
+		FScopeLock Lock(&LanesLock);
+		RunLanes = Lanes;
+		Origin = OriginCycles;
+	}
+	if (RunLanes.Num() == 0)
+	{
+		return FString();
+	}
+
+	// Game thread on top, then workers by name
+	RunLanes.Sort([](const TSharedPtr<FPalantirTimelineLane, ESPMode::ThreadSafe>& A, const TSharedPtr<FPalantirTimelineLane, ESPMode::ThreadSafe>& B)
+	{
+		if (A->bGameThread != B->bGameThread)
+		{
+			return A->bGameThread;
+		}
+		return A->ThreadName < B->ThreadName;
+	});
+
+	const FString Path = ReportDir / TEXT("nexus-timeline.json");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		UE_LOG(LogPalantirTrace, Error, TEXT("Failed to write timeline --> %s"), *Path);
+		return FString();
+	}
+
+	bool bFirst = true;
+	auto WriteEvent = [&Writer, &bFirst](TFunctionRef<void(TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>&)> Fill)
+	{
+		FString Line;
+		{
+			const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Json = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Line);
+			Json->WriteObjectStart();
+			Fill(*Json);
+			Json->WriteObjectEnd();
+			Json->Close();
+		}
+		Line.InsertAt(0, bFirst ? TEXT("\n") : TEXT(",\n"));
+		bFirst = false;
+
+		const FTCHARToUTF8 Utf8(*Line);
+		Writer->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+	};
+
+	const double MicrosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000000.0;
+	auto ToMicroseconds = [Origin, MicrosecondsPerCycle](uint64 Cycles)
+	{
+		return Cycles > Origin ? (Cycles - Origin) * MicrosecondsPerCycle : 0.0;
+	};
+
+	const FTCHARToUTF8 Header(TEXT("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+	Writer->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+
+	WriteEvent([](TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& Json)
+	{
+		Json.WriteValue(TEXT("ph"), TEXT("M"));
+		Json.WriteValue(TEXT("name"), TEXT("process_name"));
+		Json.WriteValue(TEXT("pid"), 1);
+		Json.WriteObjectStart(TEXT("args"));
+		Json.WriteValue(TEXT("name"), TEXT("Nexus"));
+		Json.WriteObjectEnd();
+	});
+
+	int64 EventCount = 0;
+	for (int32 LaneIndex = 0; LaneIndex < RunLanes.Num(); ++LaneIndex)
+	{
+		FPalantirTimelineLane& Lane = *RunLanes[LaneIndex];
+		FScopeLock Lock(&Lane.Lock);
+		const int64 Tid = Lane.ThreadId;
+
+		WriteEvent([&Lane, Tid](TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& Json)
+		{
+			Json.WriteValue(TEXT("ph"), TEXT("M"));
+			Json.WriteValue(TEXT("name"), TEXT("thread_name"));
+			Json.WriteValue(TEXT("pid"), 1);
+			Json.WriteValue(TEXT("tid"), Tid);
+			Json.WriteObjectStart(TEXT("args"));
+			Json.WriteValue(TEXT("name"), Lane.ThreadName);
+			Json.WriteObjectEnd();
+		});
+		WriteEvent([LaneIndex, Tid](TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& Json)
+		{
+			Json.WriteValue(TEXT("ph"), TEXT("M"));
+			Json.WriteValue(TEXT("name"), TEXT("thread_sort_index"));
+			Json.WriteValue(TEXT("pid"), 1);
+			Json.WriteValue(TEXT("tid"), Tid);
+			Json.WriteObjectStart(TEXT("args"));
+			Json.WriteValue(TEXT("sort_index"), LaneIndex);
+			Json.WriteObjectEnd();
+		});
+
+		for (const FPalantirTimelineEvent& Event : Lane.Events)
+		{
+			WriteEvent([&Event, Tid, &ToMicroseconds](TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& Json)
+			{
+				Json.WriteValue(TEXT("name"), Event.Name);
+				Json.WriteValue(TEXT("cat"), Event.Category);
+				Json.WriteValue(TEXT("pid"), 1);
+				Json.WriteValue(TEXT("tid"), Tid);
+				Json.WriteValue(TEXT("ts"), ToMicroseconds(Event.StartCycles));
+				switch (Event.Phase)
+				{
+				case EPalantirTimelinePhase::Complete:
+					Json.WriteValue(TEXT("ph"), TEXT("X"));
+					Json.WriteValue(TEXT("dur"), FMath::Max(0.0, ToMicroseconds(Event.EndCycles) - ToMicroseconds(Event.StartCycles)));
+					if (Event.Id != 0)
+					{
+						Json.WriteObjectStart(TEXT("args"));
+						Json.WriteValue(TEXT("span"), FString::Printf(TEXT("%llx"), Event.Id));
+						if (Event.ParentId != 0)
+						{
+							Json.WriteValue(TEXT("parent"), FString::Printf(TEXT("%llx"), Event.ParentId));
+						}
+						if (!Event.Detail.IsEmpty())
+						{
+							Json.WriteValue(TEXT("detail"), Event.Detail);
+						}
+						Json.WriteObjectEnd();
+						return;
+					}
+					break;
+				case EPalantirTimelinePhase::Instant:
+				case EPalantirTimelinePhase::GlobalInstant:
+					Json.WriteValue(TEXT("ph"), TEXT("i"));
+					Json.WriteValue(TEXT("s"), Event.Phase == EPalantirTimelinePhase::GlobalInstant ? TEXT("g") : TEXT("t"));
+					break;
+				case EPalantirTimelinePhase::AsyncBegin:
+				case EPalantirTimelinePhase::AsyncEnd:
+					Json.WriteValue(TEXT("ph"), Event.Phase == EPalantirTimelinePhase::AsyncBegin ? TEXT("b") : TEXT("e"));
+					Json.WriteValue(TEXT("id"), FString::Printf(TEXT("0x%llx"), Event.Id));
+					break;
+				case EPalantirTimelinePhase::FlowStart:
+				case EPalantirTimelinePhase::FlowEnd:
+					// Arrow from the span that handed work off to the span that continued it
+					Json.WriteValue(TEXT("ph"), Event.Phase == EPalantirTimelinePhase::FlowStart ? TEXT("s") : TEXT("f"));
+					Json.WriteValue(TEXT("id"), FString::Printf(TEXT("0x%llx"), Event.Id));
+					Json.WriteValue(TEXT("bp"), TEXT("e"));
+					return;
+				case EPalantirTimelinePhase::Counter:
+					Json.WriteValue(TEXT("ph"), TEXT("C"));
+					Json.WriteObjectStart(TEXT("args"));
+					Json.WriteValue(TEXT("value"), Event.Value);
+					Json.WriteObjectEnd();
+					return;
+				}
+				if (!Event.Detail.IsEmpty())
+				{
+					Json.WriteObjectStart(TEXT("args"));
+					Json.WriteValue(TEXT("detail"), Event.Detail);
+					Json.WriteObjectEnd();
+				}
+			});
+		}
+
+		// Breadcrumbs were copied raw while the run recorded; this is where they are formatted
+		for (const FPalantirBreadcrumbEvent& Breadcrumb : Lane.Breadcrumbs)
+		{
+			const FString Name = FPalantirTrace::GetEventName(Breadcrumb.EventId);
+			WriteEvent([&Breadcrumb, &Name, Tid, &ToMicroseconds](TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>& Json)
+			{
+				Json.WriteValue(TEXT("name"), Name);
+				Json.WriteValue(TEXT("cat"), Name.StartsWith(TEXT("Http"), ESearchCase::CaseSensitive) ? TEXT("http") : TEXT("breadcrumb"));
+				Json.WriteValue(TEXT("ph"), TEXT("i"));
+				Json.WriteValue(TEXT("s"), TEXT("t"));
+				Json.WriteValue(TEXT("pid"), 1);
+				Json.WriteValue(TEXT("tid"), Tid);
+				Json.WriteValue(TEXT("ts"), ToMicroseconds(Breadcrumb.Cycles));
+				Json.WriteObjectStart(TEXT("args"));
+				Json.WriteValue(TEXT("detail"), Breadcrumb.FormatDetails());
+				Json.WriteObjectEnd();
+			});
+		}
+
+		EventCount += Lane.Events.Num() + Lane.Breadcrumbs.Num();
+	}
+
+	const FTCHARToUTF8 Footer(TEXT("\n]}\n"));
+	Writer->Serialize(const_cast<ANSICHAR*>(Footer.Get()), Footer.Length());
+	Writer->Close();
+
+	UE_LOG(LogPalantirTrace, Display, TEXT("Timeline written (%lld events on %d lanes) --> %s"), EventCount, RunLanes.Num(), *Path);
+	return Path;
+}
+
+FPalantirTimelineScope::FPalantirTimelineScope(FStringView InName, const TCHAR* InCategory)
+	: Name(InName)
+	, Category(InCategory)
+{
+	if (FPalantirTimeline::IsRecording())
+	{
+		StartCycles = FPlatformTime::Cycles64();
+	}
+}
+
+FPalantirTimelineScope::~FPalantirTimelineScope()
+{
+	if (StartCycles != 0)
+	{
+		FPalantirTimeline::AddSpan(Name, Category, StartCycles, FPlatformTime::Cycles64(), Detail);
+	}
+}
@@ -1,16 +1,364 @@
 #include "PalantirTrace.h"
-#include "Misc/Guid.h"
+#include "PalantirTimeline.h"
+#include "Nexus/Core/Public/NexusCancellation.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/ScopeRWLock.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/DateTime.h"
+#include <atomic>
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
 
 DEFINE_LOG_CATEGORY(LogPalantirTrace);
 
+static constexpr int32 GPalantirDefaultRingSize = 512;
+static constexpr int32 GPalantirCachedNameChars = 31;
+
+/**
+ * Per-thread breadcrumb ring: allocated once (first trace on the thread), then only overwritten.
+ * Head counts every event ever written on the thread; the current trace owns [TraceStartHead, Head).
+ */
+struct FPalantirBreadcrumbRing
+{
+	TArray<FPalantirBreadcrumbEvent> Events;
+	uint64 Head = 0;
+	uint64 TraceStartHead = 0;
+	uint64 TraceStartCycles = 0;
+};
+
+/** Thread-local front of the event name table, so recording a known name takes no lock */
+struct FPalantirEventNameCacheEntry
+{
+	uint32 Hash = 0;
+	uint16 EventId = 0;
+	uint8 Len = 0;
+	TCHAR Name[GPalantirCachedNameChars] = {};
+};
+
+/**
+ * xoshiro256** (Blackman & Vigna): one generator per thread, so minting trace and span IDs takes no lock.
+ * Seeded through splitmix64 from the clock, the thread, the process and a global counter, so threads
+ * (and worker processes) started in the same tick still get distinct streams.
+ */
+struct FPalantirRandom
+{
+	uint64 State[4] = {};
+	bool bSeeded = false;
+
+	static uint64 SplitMix64(uint64& Seed)
+	{
+		uint64 Z = (Seed += 0x9e3779b97f4a7c15ull);
+		Z = (Z ^ (Z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		Z = (Z ^ (Z >> 27)) * 0x94d049bb133111ebull;
+		return Z ^ (Z >> 31);
+	}
+
+	static uint64 Rotl(uint64 X, int32 K)
+	{
+		return (X << K) | (X >> (64 - K));
+	}
+
+	void Seed()
+	{
+		static std::atomic<uint64> SeedCounter{0};
+		uint64 Seed = FPlatformTime::Cycles64()
+			^ (static_cast<uint64>(FPlatformTLS::GetCurrentThreadId()) << 32)
+			^ (static_cast<uint64>(FPlatformProcess::GetCurrentProcessId()) << 48)
+			^ static_cast<uint64>(FDateTime::UtcNow().GetTicks())
+			^ reinterpret_cast<UPTRINT>(this)
+			^ (SeedCounter.fetch_add(1, std::memory_order_relaxed) * 0xd1b54a32d192ed03ull);
+		for (uint64& Word : State)
+		{
+			Word = SplitMix64(Seed);
+		}
+		bSeeded = true;
+	}
+
+	uint64 Next()
+	{
+		if (!bSeeded)
+		{
+			Seed();
+		}
+		const uint64 Result = Rotl(State[1] * 5, 7) * 9;
+		const uint64 T = State[1] << 17;
+		State[2] ^= State[0];
+		State[3] ^= State[1];
+		State[1] ^= State[2];
+		State[0] ^= State[3];
+		State[2] ^= T;
+		State[3] = Rotl(State[3], 45);
+		return Result;
+	}
+};
+
+/**
+ * Breadcrumbs recorded for a trace on threads other than its owner's (FPalantirTraceContextScope).
+ * One per live trace ID, shared by every thread and captured context in that trace; the owner moves them
+ * into its own ring when it next reads its breadcrumbs.
+ */
+struct FPalantirTraceMailbox
+{
+	FCriticalSection Lock;
+	TArray<FPalantirBreadcrumbEvent> Events;
+	std::atomic<int32> NumEvents{0};
+};
+
 // Thread-local storage for trace context (avoid DLL export issues with static thread_local)
 namespace FPalantirTraceLocal
 {
 	thread_local FString CurrentTraceID;
-	thread_local TArray<TPair<double, FString>> CurrentBreadcrumbs;
+	thread_local FPalantirTraceId CurrentTraceId;
+	thread_local FString LogPrefix;
+	thread_local FPalantirRandom Random;
 	thread_local double TraceStartTime = 0.0;
+	thread_local uint64 CurrentSpanId = 0;
+	thread_local uint64 CurrentParentSpanId = 0;  // ParentSpanId of the innermost open FPalantirSpan
+	thread_local TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> CurrentMailbox;
+	thread_local FPalantirBreadcrumbRing Ring;
+	thread_local FPalantirEventNameCacheEntry NameCache[64];
+}
+
+// Live mailboxes by trace ID, so every re-entry of a trace (attempts, latent slices) finds the same one
+namespace FPalantirTraceMailboxes
+{
+	static FCriticalSection Lock;
+	static TMap<FString, TWeakPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe>> ByTraceID;
+	static int32 PruneAt = 64;
+}
+
+static TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> FindOrAddMailbox(const FString& TraceID)
+{
+	using namespace FPalantirTraceMailboxes;
+	FScopeLock ScopeLock(&Lock);
+	if (TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> Existing = ByTraceID.FindRef(TraceID).Pin())
+	{
+		return Existing;
+	}
+
+	if (ByTraceID.Num() >= PruneAt)
+	{
+		for (auto It = ByTraceID.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+		PruneAt = FMath::Max(64, ByTraceID.Num() * 2);
+	}
+
+	TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> Mailbox = MakeShared<FPalantirTraceMailbox, ESPMode::ThreadSafe>();
+	ByTraceID.Add(TraceID, Mailbox);
+	return Mailbox;
+}
+
+// Interned event names, shared by all threads (ID 0 is the fallback once the table is full)
+namespace FPalantirEventNames
+{
+	static FRWLock Lock;
+	static TArray<FString> Names = { TEXT("Event") };
+	static TMap<FString, uint16> Ids;
+}
+
+static const TCHAR GPalantirHexDigits[] = TEXT("0123456789abcdef");
+
+static void WriteHex(uint64 Value, int32 Digits, TCHAR* Out)
+{
+	for (int32 Index = Digits - 1; Index >= 0; --Index)
+	{
+		Out[Index] = GPalantirHexDigits[Value & 0xF];
+		Value >>= 4;
+	}
+}
+
+/** Lowercase hex only (what W3C Trace Context requires); -1 otherwise */
+static int32 HexValue(TCHAR Char)
+{
+	if (Char >= TEXT('0') && Char <= TEXT('9'))
+	{
+		return Char - TEXT('0');
+	}
+	if (Char >= TEXT('a') && Char <= TEXT('f'))
+	{
+		return Char - TEXT('a') + 10;
+	}
+	return -1;
+}
+
+static bool ParseHex64(FStringView Hex, uint64& OutValue)
+{
+	uint64 Value = 0;
+	for (TCHAR Char : Hex)
+	{
+		const int32 Digit = HexValue(Char);
+		if (Digit < 0)
+		{
+			return false;
+		}
+		Value = (Value << 4) | static_cast<uint64>(Digit);
+	}
+	OutValue = Value;
+	return true;
+}
+
+/** Switch the thread's current trace (string, binary and log prefix together) */
+static void SetTraceLocal(const FString& TraceID, const FPalantirTraceId& TraceId)
+{
+	using namespace FPalantirTraceLocal;
+	CurrentTraceID = TraceID;
+	CurrentTraceId = TraceId;
+	LogPrefix.Reset();
+	if (!TraceID.IsEmpty())
+	{
+		LogPrefix += TEXT('[');
+		LogPrefix += TraceID;
+		LogPrefix += TEXT("] ");
+	}
+}
+
+// FPalantirTraceId Implementation
+FPalantirTraceId FPalantirTraceId::New()
+{
+	FPalantirRandom& Random = FPalantirTraceLocal::Random;
+	FPalantirTraceId Id;
+	Id.High = (Random.Next() & ~0xF000ull) | 0x4000ull;                              // UUID version 4
+	Id.Low = (Random.Next() & 0x3FFFFFFFFFFFFFFFull) | 0x8000000000000000ull;       // RFC 4122 variant
+	return Id;
+}
+
+bool FPalantirTraceId::Parse(FStringView TraceID, FPalantirTraceId& OutId)
+{
+	if (TraceID.StartsWith(TEXT("nexus-test-")))
+	{
+		TraceID.RightChopInline(11);
+	}
+
+	FPalantirTraceId Id;
+	if (TraceID.Len() == 32)
+	{
+		if (!ParseHex64(TraceID.Left(16), Id.High) || !ParseHex64(TraceID.Mid(16), Id.Low))
+		{
+			return false;
+		}
+	}
+	else if (TraceID.Len() == 36 && TraceID[8] == TEXT('-') && TraceID[13] == TEXT('-') && TraceID[18] == TEXT('-') && TraceID[23] == TEXT('-'))
+	{
+		uint64 A, B, C, D, E;
+		if (!ParseHex64(TraceID.Mid(0, 8), A) || !ParseHex64(TraceID.Mid(9, 4), B) || !ParseHex64(TraceID.Mid(14, 4), C)
+			|| !ParseHex64(TraceID.Mid(19, 4), D) || !ParseHex64(TraceID.Mid(24, 12), E))
+		{
+			return false;
+		}
+		Id.High = (A << 32) | (B << 16) | C;
+		Id.Low = (D << 48) | E;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (!Id.IsValid())
+	{
+		return false;
+	}
+	OutId = Id;
+	return true;
+}
+
+FPalantirTraceId FPalantirTraceId::FromTraceID(FStringView TraceID)
+{
+	FPalantirTraceId Id;
+	if (TraceID.IsEmpty() || Parse(TraceID, Id))
+	{
+		return Id;
+	}
+
+	const char* Bytes = reinterpret_cast<const char*>(TraceID.GetData());
+	const uint32 Length = TraceID.Len() * sizeof(TCHAR);
+	Id.High = CityHash64(Bytes, Length);
+	Id.Low = CityHash64WithSeed(Bytes, Length, 0x9e3779b97f4a7c15ull) | 1;  // Never all zero
+	return Id;
+}
+
+FString FPalantirTraceId::ToHex() const
+{
+	TCHAR Buffer[32];
+	WriteHex(High, 16, Buffer);
+	WriteHex(Low, 16, Buffer + 16);
+	return FString(FStringView(Buffer, UE_ARRAY_COUNT(Buffer)));
+}
+
+FString FPalantirTraceId::ToTraceID() const
+{
+	// nexus-test-xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+	TCHAR Buffer[11 + 36] = { 'n', 'e', 'x', 'u', 's', '-', 't', 'e', 's', 't', '-' };
+	TCHAR* Uuid = Buffer + 11;
+	WriteHex(High >> 32, 8, Uuid);
+	Uuid[8] = TEXT('-');
+	WriteHex((High >> 16) & 0xFFFF, 4, Uuid + 9);
+	Uuid[13] = TEXT('-');
+	WriteHex(High & 0xFFFF, 4, Uuid + 14);
+	Uuid[18] = TEXT('-');
+	WriteHex(Low >> 48, 4, Uuid + 19);
+	Uuid[23] = TEXT('-');
+	WriteHex(Low & 0xFFFFFFFFFFFFull, 12, Uuid + 24);
+	return FString(FStringView(Buffer, UE_ARRAY_COUNT(Buffer)));
+}
+
+// FPalantirTraceParent Implementation
+FString FPalantirTraceParent::ToString() const
+{
+	// 00-<32 hex>-<16 hex>-<2 hex>
+	TCHAR Buffer[55];
+	Buffer[0] = TEXT('0');
+	Buffer[1] = TEXT('0');
+	Buffer[2] = TEXT('-');
+	WriteHex(TraceId.High, 16, Buffer + 3);
+	WriteHex(TraceId.Low, 16, Buffer + 19);
+	Buffer[35] = TEXT('-');
+	WriteHex(ParentId, 16, Buffer + 36);
+	Buffer[52] = TEXT('-');
+	WriteHex(Flags, 2, Buffer + 53);
+	return FString(FStringView(Buffer, UE_ARRAY_COUNT(Buffer)));
+}
+
+bool FPalantirTraceParent::Parse(FStringView Header, FPalantirTraceParent& Out)
+{
+	Header.TrimStartAndEndInline();
+	if (Header.Len() < 55 || Header[2] != TEXT('-') || Header[35] != TEXT('-') || Header[52] != TEXT('-'))
+	{
+		return false;
+	}
+
+	uint64 Version = 0;
+	if (!ParseHex64(Header.Left(2), Version) || Version == 0xFF)
+	{
+		return false;
+	}
+	// Version 00 is exactly 55 characters; later versions may append fields after another '-'
+	if (Version == 0 ? Header.Len() != 55 : (Header.Len() > 55 && Header[55] != TEXT('-')))
+	{
+		return false;
+	}
+
+	FPalantirTraceParent Parsed;
+	uint64 ParsedFlags = 0;
+	if (!ParseHex64(Header.Mid(3, 16), Parsed.TraceId.High) || !ParseHex64(Header.Mid(19, 16), Parsed.TraceId.Low)
+		|| !ParseHex64(Header.Mid(36, 16), Parsed.ParentId) || !ParseHex64(Header.Mid(53, 2), ParsedFlags))
+	{
+		return false;
+	}
+	Parsed.Flags = static_cast<uint8>(ParsedFlags);
+	if (!Parsed.IsValid())
+	{
+		return false;
+	}
+
+	Out = Parsed;
+	return true;
 }
 
 // Static accessor functions to avoid DLL export issues
@@ -19,29 +367,274 @@ FString& FPalantirTrace::GetCurrentTraceIDRef()
 	return FPalantirTraceLocal::CurrentTraceID;
 }
 
-TArray<TPair<double, FString>>& FPalantirTrace::GetBreadcrumbsRef()
+double& FPalantirTrace::GetTraceStartTimeRef()
 {
-	return FPalantirTraceLocal::CurrentBreadcrumbs;
+	return FPalantirTraceLocal::TraceStartTime;
 }
 
-double& FPalantirTrace::GetTraceStartTimeRef()
+int32 FPalantirTrace::GetRingCapacity()
 {
-	return FPalantirTraceLocal::TraceStartTime;
+	static const int32 Capacity = []()
+	{
+		int32 Size = GPalantirDefaultRingSize;
+		if (GConfig)
+		{
+			GConfig->GetInt(TEXT("/Script/Nexus.NexusSettings"), TEXT("BreadcrumbRingSize"), Size, GGameIni);
+		}
+		return FMath::Clamp(Size, 16, 65536);
+	}();
+	return Capacity;
+}
+
+uint16 FPalantirTrace::InternEvent(FStringView EventName)
+{
+	const int32 Len = EventName.Len();
+	const uint32 Hash = CityHash32(reinterpret_cast<const char*>(EventName.GetData()), Len * sizeof(TCHAR));
+
+	FPalantirEventNameCacheEntry& Cached = FPalantirTraceLocal::NameCache[Hash % UE_ARRAY_COUNT(FPalantirTraceLocal::NameCache)];
+	if (Cached.EventId != 0 && Cached.Hash == Hash && Cached.Len == Len &&
+		FMemory::Memcmp(Cached.Name, EventName.GetData(), Len * sizeof(TCHAR)) == 0)
+	{
+		return Cached.EventId;
+	}
+
+	const FString Name(EventName);
+	uint16 EventId = 0;
+	{
+		FReadScopeLock ReadLock(FPalantirEventNames::Lock);
+		if (const uint16* Found = FPalantirEventNames::Ids.Find(Name))
+		{
+			EventId = *Found;
+		}
+	}
+	if (EventId == 0)
+	{
+		FWriteScopeLock WriteLock(FPalantirEventNames::Lock);
+		if (const uint16* Found = FPalantirEventNames::Ids.Find(Name))
+		{
+			EventId = *Found;
+		}
+		else if (FPalantirEventNames::Names.Num() <= MAX_uint16)
+		{
+			EventId = static_cast<uint16>(FPalantirEventNames::Names.Add(Name));
+			FPalantirEventNames::Ids.Add(Name, EventId);
+		}
+		else
+		{
+			return 0;  // Table full - recorded under the fallback name, not cached so it is reported again
+		}
+	}
+
+	if (Len <= GPalantirCachedNameChars)
+	{
+		Cached.Hash = Hash;
+		Cached.EventId = EventId;
+		Cached.Len = static_cast<uint8>(Len);
+		FMemory::Memcpy(Cached.Name, EventName.GetData(), Len * sizeof(TCHAR));
+	}
+	return EventId;
+}
+
+FString FPalantirTrace::GetEventName(uint16 EventId)
+{
+	FReadScopeLock ReadLock(FPalantirEventNames::Lock);
+	return FPalantirEventNames::Names.IsValidIndex(EventId) ? FPalantirEventNames::Names[EventId] : FString();
+}
+
+void FPalantirBreadcrumbEvent::PushText(FStringView Value)
+{
+	const int32 Room = MaxTextChars - TextLen - 1;  // Keep one char for the terminator
+	++NumTextArgs;
+	if (Room < 0)
+	{
+		bTextTruncated = true;
+		return;
+	}
+
+	const int32 Copied = FMath::Min(Value.Len(), Room);
+	FMemory::Memcpy(Text + TextLen, Value.GetData(), Copied * sizeof(TCHAR));
+	bTextTruncated |= Copied < Value.Len();
+	TextLen += Copied;
+	Text[TextLen++] = TEXT('\0');
+}
+
+FString FPalantirBreadcrumbEvent::FormatDetails() const
+{
+	// Text segments in push order
+	const TCHAR* Segments[MaxTextChars / 2 + 1] = {};
+	int32 NumSegments = 0;
+	for (int32 Offset = 0; Offset < TextLen && NumSegments < static_cast<int32>(UE_ARRAY_COUNT(Segments)); Offset += FCString::Strlen(Text + Offset) + 1)
+	{
+		Segments[NumSegments++] = Text + Offset;
+	}
+
+	FString Details;
+	if (!Format)
+	{
+		Details = NumSegments > 0 ? Segments[0] : TEXT("");
+	}
+	else
+	{
+		// printf subset: flags, width and precision are kept, length modifiers are replaced by the stored type
+		int32 NextArg = 0;
+		int32 NextSegment = 0;
+		for (const TCHAR* Cursor = Format; *Cursor; ++Cursor)
+		{
+			if (*Cursor != TEXT('%'))
+			{
+				Details.AppendChar(*Cursor);
+				continue;
+			}
+			if (Cursor[1] == TEXT('%'))
+			{
+				Details.AppendChar(TEXT('%'));
+				++Cursor;
+				continue;
+			}
+
+			TCHAR Spec[32] = { TEXT('%') };
+			int32 SpecLen = 1;
+			++Cursor;
+			while (*Cursor && FCString::Strchr(TEXT("-+ #0123456789."), *Cursor) && SpecLen < static_cast<int32>(UE_ARRAY_COUNT(Spec)) - 4)
+			{
+				Spec[SpecLen++] = *Cursor++;
+			}
+			while (*Cursor && FCString::Strchr(TEXT("hlLjztIq"), *Cursor))
+			{
+				++Cursor;
+			}
+			if (!*Cursor)
+			{
+				break;
+			}
+
+			const TCHAR Conversion = *Cursor;
+			const bool bHasArg = NextArg < NumArgs;
+			const bool bFloatArg = bHasArg && (FloatArgMask & (1 << NextArg)) != 0;
+			switch (Conversion)
+			{
+			case TEXT('s'):
+			case TEXT('S'):
+				Spec[SpecLen++] = TEXT('s');
+				Spec[SpecLen] = TEXT('\0');
+				Details += FString::Printf(Spec, NextSegment < NumSegments ? Segments[NextSegment] : TEXT(""));
+				++NextSegment;
+				break;
+			case TEXT('f'):
+			case TEXT('F'):
+			case TEXT('e'):
+			case TEXT('E'):
+			case TEXT('g'):
+			case TEXT('G'):
+			{
+				const double Value = !bHasArg ? 0.0 : bFloatArg ? Args[NextArg].Float : static_cast<double>(Args[NextArg].Int);
+				Spec[SpecLen++] = Conversion;
+				Spec[SpecLen] = TEXT('\0');
+				Details += FString::Printf(Spec, Value);
+				++NextArg;
+				break;
+			}
+			case TEXT('c'):
+				if (bHasArg)
+				{
+					Details.AppendChar(static_cast<TCHAR>(bFloatArg ? static_cast<int64>(Args[NextArg].Float) : Args[NextArg].Int));
+				}
+				++NextArg;
+				break;
+			default:
+			{
+				// d i u x X o p - always printed from the stored 64-bit value
+				const int64 Value = !bHasArg ? 0 : bFloatArg ? static_cast<int64>(Args[NextArg].Float) : Args[NextArg].Int;
+				Spec[SpecLen++] = TEXT('l');
+				Spec[SpecLen++] = TEXT('l');
+				Spec[SpecLen++] = Conversion == TEXT('p') ? TEXT('x') : Conversion == TEXT('i') ? TEXT('d') : Conversion;
+				Spec[SpecLen] = TEXT('\0');
+				Details += FString::Printf(Spec, Value);
+				++NextArg;
+				break;
+			}
+			}
+		}
+	}
+
+	if (bTextTruncated)
+	{
+		Details += TEXT("...");
+	}
+	return Details;
+}
+
+void FPalantirBreadcrumbSnapshot::Reset()
+{
+	Events.Reset();
+	StartCycles = 0;
+	Overwritten = 0;
+}
+
+void FPalantirBreadcrumbSnapshot::Append(const FPalantirBreadcrumbSnapshot& Other)
+{
+	if (Events.Num() == 0 && Overwritten == 0)
+	{
+		StartCycles = Other.StartCycles;
+	}
+	Events.Append(Other.Events);
+	Overwritten += Other.Overwritten;
+}
+
+TArray<TPair<double, FString>> FPalantirBreadcrumbSnapshot::Format() const
+{
+	TArray<TPair<double, FString>> Breadcrumbs;
+	Breadcrumbs.Reserve(Events.Num() + 1);
+	if (Overwritten > 0)
+	{
+		Breadcrumbs.Add(TPair<double, FString>(0.0,
+			FString::Printf(TEXT("[0.000s] BreadcrumbsDropped: %d earlier breadcrumb(s) overwritten (BreadcrumbRingSize %d)"),
+				Overwritten, FPalantirTrace::GetRingCapacity())));
+	}
+
+	const double SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	for (const FPalantirBreadcrumbEvent& Event : Events)
+	{
+		const double Timestamp = Event.Cycles > StartCycles ? (Event.Cycles - StartCycles) * SecondsPerCycle : 0.0;
+		Breadcrumbs.Add(TPair<double, FString>(Timestamp,
+			FString::Printf(TEXT("[%.3fs] %s: %s"), Timestamp, *FPalantirTrace::GetEventName(Event.EventId), *Event.FormatDetails())));
+	}
+	return Breadcrumbs;
+}
+
+TArray<FString> FPalantirBreadcrumbSnapshot::FormatLines() const
+{
+	TArray<FString> Lines;
+	for (TPair<double, FString>& Breadcrumb : Format())
+	{
+		Lines.Add(MoveTemp(Breadcrumb.Value));
+	}
+	return Lines;
 }
 
 FString FPalantirTrace::GenerateTraceID()
 {
 	// Format: "nexus-test-<UUID>"
 	// Example: "nexus-test-a3f2e1d4-7c9b-4f2a-9e8d-3c5b1a2f0d7e"
-	FGuid UniqueID = FGuid::NewGuid();
-	return FString::Printf(TEXT("nexus-test-%s"), *UniqueID.ToString(EGuidFormats::DigitsWithHyphens).ToLower());
+	return FPalantirTraceId::New().ToTraceID();
 }
 
 void FPalantirTrace::SetCurrentTraceID(const FString& TraceID)
 {
-	GetCurrentTraceIDRef() = TraceID;
+	SetTraceLocal(TraceID, FPalantirTraceId::FromTraceID(TraceID));
 	GetTraceStartTimeRef() = FPlatformTime::Seconds();
-	GetBreadcrumbsRef().Empty();
+
+	// The only allocation breadcrumbs ever make on this thread
+	FPalantirBreadcrumbRing& Ring = FPalantirTraceLocal::Ring;
+	if (Ring.Events.Num() == 0)
+	{
+		Ring.Events.SetNum(GetRingCapacity());
+	}
+	Ring.TraceStartHead = Ring.Head;
+	Ring.TraceStartCycles = FPlatformTime::Cycles64();
+	FPalantirTraceLocal::CurrentSpanId = 0;
+	FPalantirTraceLocal::CurrentParentSpanId = 0;
+	FPalantirTraceLocal::CurrentMailbox = TraceID.IsEmpty() ? nullptr : FindOrAddMailbox(TraceID);
 	
 	UE_LOG(LogPalantirTrace, Log, TEXT("Trace started: %s"), *TraceID);
 }
@@ -51,6 +644,16 @@ FString FPalantirTrace::GetCurrentTraceID()
 	return GetCurrentTraceIDRef();
 }
 
+FPalantirTraceId FPalantirTrace::GetCurrentTraceId()
+{
+	return FPalantirTraceLocal::CurrentTraceId;
+}
+
+const TCHAR* FPalantirTrace::GetLogPrefix()
+{
+	return *FPalantirTraceLocal::LogPrefix;
+}
+
 void FPalantirTrace::Clear()
 {
 	FString& TraceID = GetCurrentTraceIDRef();
@@ -59,34 +662,313 @@ void FPalantirTrace::Clear()
 		UE_LOG(LogPalantirTrace, Log, TEXT("Trace ended: %s (duration: %.2fs)"), 
 			*TraceID, FPlatformTime::Seconds() - GetTraceStartTimeRef());
 	}
-	TraceID.Empty();
-	GetBreadcrumbsRef().Empty();
+	TraceID.Reset();  // Keeps the buffers for the next trace on this thread
+	FPalantirTraceLocal::CurrentTraceId = FPalantirTraceId();
+	FPalantirTraceLocal::LogPrefix.Reset();
+	FPalantirTraceLocal::Ring.TraceStartHead = FPalantirTraceLocal::Ring.Head;
+	FPalantirTraceLocal::CurrentSpanId = 0;
+	FPalantirTraceLocal::CurrentParentSpanId = 0;
+	FPalantirTraceLocal::CurrentMailbox.Reset();
 	GetTraceStartTimeRef() = 0.0;
 }
 
-void FPalantirTrace::AddBreadcrumb(const FString& EventName, const FString& Details)
+static FPalantirBreadcrumbEvent& ClaimBreadcrumb(FPalantirBreadcrumbRing& Ring, uint16 EventId, const TCHAR* Format)
 {
-	FString& TraceID = GetCurrentTraceIDRef();
-	if (TraceID.IsEmpty())
+	FPalantirBreadcrumbEvent& Event = Ring.Events[Ring.Head++ % Ring.Events.Num()];
+	Event.Cycles = FPlatformTime::Cycles64();
+	Event.EventId = EventId;
+	Event.NumArgs = 0;
+	Event.FloatArgMask = 0;
+	Event.TextLen = 0;
+	Event.NumTextArgs = 0;
+	Event.bTextTruncated = false;
+	Event.Format = Format;
+	return Event;
+}
+
+FPalantirBreadcrumbEvent* FPalantirTrace::BeginBreadcrumb(FStringView EventName, const TCHAR* Format, bool& bOutContinue)
+{
+	const TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Token = FNexusCancellationToken::GetCurrent();
+	const bool bCancelled = Token.IsValid() && Token->IsCancellationRequested();
+	bOutContinue = !bCancelled;
+
+	FPalantirBreadcrumbRing& Ring = FPalantirTraceLocal::Ring;
+	if (GetCurrentTraceIDRef().IsEmpty() || Ring.Events.Num() == 0)
+	{
+		return nullptr;  // No active trace
+	}
+
+	// Mark the first place a cancelled attempt noticed it, so the timeline shows how long it took to stop
+	if (bCancelled && Token->MarkObserved())
+	{
+		FPalantirBreadcrumbEvent& Cancelled = ClaimBreadcrumb(Ring, InternEvent(TEXT("Cancelled")), TEXT("%s (observed at %s)"));
+		Cancelled.PushText(Token->GetReason());
+		Cancelled.PushText(EventName);
+		EndBreadcrumb(Cancelled);
+	}
+
+	return &ClaimBreadcrumb(Ring, InternEvent(EventName), Format);
+}
+
+void FPalantirTrace::EndBreadcrumb(const FPalantirBreadcrumbEvent& Event)
+{
+	if (FPalantirTimeline::IsRecording())
+	{
+		FPalantirTimeline::AddBreadcrumb(Event);
+	}
+	if (UE_LOG_ACTIVE(LogPalantirTrace, Verbose))
+	{
+		const double Timestamp = (Event.Cycles - FPalantirTraceLocal::Ring.TraceStartCycles) * FPlatformTime::GetSecondsPerCycle64();
+		UE_LOG(LogPalantirTrace, Verbose, TEXT("[%s] [%.3fs] %s: %s"),
+			*GetCurrentTraceIDRef(), Timestamp, *GetEventName(Event.EventId), *Event.FormatDetails());
+	}
+}
+
+bool FPalantirTrace::AddBreadcrumb(FStringView EventName, FStringView Details)
+{
+	bool bContinue = true;
+	if (FPalantirBreadcrumbEvent* Event = BeginBreadcrumb(EventName, nullptr, bContinue))
+	{
+		Event->PushText(Details);
+		EndBreadcrumb(*Event);
+	}
+	return bContinue;
+}
+
+/** Move breadcrumbs other threads recorded for the current trace into this thread's ring */
+static void DrainMailbox(FPalantirBreadcrumbRing& Ring)
+{
+	FPalantirTraceMailbox* Mailbox = FPalantirTraceLocal::CurrentMailbox.Get();
+	if (!Mailbox || Mailbox->NumEvents.load(std::memory_order_acquire) == 0)
+	{
+		return;
+	}
+
+	TArray<FPalantirBreadcrumbEvent> Forwarded;
+	{
+		FScopeLock ScopeLock(&Mailbox->Lock);
+		Forwarded = MoveTemp(Mailbox->Events);
+		Mailbox->Events.Reset();
+		Mailbox->NumEvents = 0;
+	}
+	for (const FPalantirBreadcrumbEvent& Event : Forwarded)
 	{
-		return;  // No active trace
+		Ring.Events[Ring.Head++ % Ring.Events.Num()] = Event;
+	}
+}
+
+FPalantirBreadcrumbSnapshot FPalantirTrace::SnapshotBreadcrumbs()
+{
+	FPalantirBreadcrumbSnapshot Snapshot;
+	FPalantirBreadcrumbRing& Ring = FPalantirTraceLocal::Ring;
+	if (GetCurrentTraceIDRef().IsEmpty() || Ring.Events.Num() == 0)
+	{
+		return Snapshot;
+	}
+	DrainMailbox(Ring);
+
+	const uint64 Capacity = Ring.Events.Num();
+	const uint64 First = FMath::Max(Ring.TraceStartHead, Ring.Head > Capacity ? Ring.Head - Capacity : 0);
+	Snapshot.StartCycles = Ring.TraceStartCycles;
+	Snapshot.Overwritten = static_cast<int32>(First - Ring.TraceStartHead);
+	Snapshot.Events.Reserve(static_cast<int32>(Ring.Head - First));
+	bool bOrdered = true;
+	for (uint64 Index = First; Index < Ring.Head; ++Index)
+	{
+		const FPalantirBreadcrumbEvent& Event = Ring.Events[Index % Capacity];
+		bOrdered &= Snapshot.Events.Num() == 0 || Snapshot.Events.Last().Cycles <= Event.Cycles;
+		Snapshot.Events.Add(Event);
+	}
+	if (!bOrdered)
+	{
+		// Breadcrumbs forwarded from other threads land in the ring when they are collected, not when recorded
+		Snapshot.Events.StableSort([](const FPalantirBreadcrumbEvent& A, const FPalantirBreadcrumbEvent& B) { return A.Cycles < B.Cycles; });
+	}
+	return Snapshot;
+}
+
+uint64 FPalantirTrace::GetCurrentSpanId()
+{
+	return FPalantirTraceLocal::CurrentSpanId;
+}
+
+uint64 FPalantirTrace::GetCurrentParentSpanId()
+{
+	return FPalantirTraceLocal::CurrentParentSpanId;
+}
+
+uint64 FPalantirTrace::NewSpanId()
+{
+	uint64 SpanId = 0;
+	while (SpanId == 0)
+	{
+		SpanId = FPalantirTraceLocal::Random.Next();
+	}
+	return SpanId;
+}
+
+FOnPalantirSpanEnded& FPalantirTrace::OnSpanEnded()
+{
+	static FOnPalantirSpanEnded Delegate;
+	return Delegate;
+}
+
+FPalantirTraceContext FPalantirTraceContext::Capture()
+{
+	FPalantirTraceContext Context;
+	Context.TraceID = FPalantirTraceLocal::CurrentTraceID;
+	Context.TraceId = FPalantirTraceLocal::CurrentTraceId;
+	if (Context.TraceID.IsEmpty())
+	{
+		return Context;
 	}
 
-	double Timestamp = FPlatformTime::Seconds() - GetTraceStartTimeRef();
-	FString Breadcrumb = FString::Printf(
-		TEXT("[%.3fs] %s: %s"),
-		Timestamp,
-		*EventName,
-		Details.IsEmpty() ? TEXT("") : *Details
-	);
-	GetBreadcrumbsRef().Add(TPair<double, FString>(Timestamp, Breadcrumb));
+	Context.SpanId = FPalantirTraceLocal::CurrentSpanId;
+	Context.CancellationToken = FNexusCancellationToken::GetCurrent();
+	Context.Mailbox = FPalantirTraceLocal::CurrentMailbox;
+	if (FPalantirTimeline::IsRecording())
+	{
+		Context.FlowId = FPalantirTrace::NewSpanId();
+		FPalantirTimeline::AddFlow(Context.FlowId, true);
+	}
+	return Context;
+}
 
-	UE_LOG(LogPalantirTrace, Verbose, TEXT("[%s] %s"), *TraceID, *Breadcrumb);
+// FPalantirSpan Implementation
+FPalantirSpan::FPalantirSpan(FStringView InName, const TCHAR* InCategory)
+	: Name(InName)
+	, Category(InCategory)
+{
+	SpanId = FPalantirTrace::NewSpanId();
+	ParentSpanId = FPalantirTraceLocal::CurrentSpanId;
+	PreviousParentSpanId = FPalantirTraceLocal::CurrentParentSpanId;
+	FPalantirTraceLocal::CurrentSpanId = SpanId;
+	FPalantirTraceLocal::CurrentParentSpanId = ParentSpanId;
+	StartCycles = FPlatformTime::Cycles64();
+}
+
+FPalantirSpan::~FPalantirSpan()
+{
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	FPalantirTraceLocal::CurrentSpanId = ParentSpanId;
+	FPalantirTraceLocal::CurrentParentSpanId = PreviousParentSpanId;
+
+	if (FPalantirTimeline::IsRecording())
+	{
+		FPalantirTimeline::AddSpan(Name, Category, StartCycles, EndCycles, Detail, SpanId, ParentSpanId);
+	}
+
+	FOnPalantirSpanEnded& SpanEnded = FPalantirTrace::OnSpanEnded();
+	if (SpanEnded.IsBound())
+	{
+		FPalantirSpanRecord Record;
+		Record.TraceID = FPalantirTraceLocal::CurrentTraceID;
+		Record.TraceId = FPalantirTraceLocal::CurrentTraceId;
+		Record.Name = FString(Name);
+		Record.Category = Category;
+		Record.SpanId = SpanId;
+		Record.ParentSpanId = ParentSpanId;
+		Record.StartCycles = StartCycles;
+		Record.EndCycles = EndCycles;
+		Record.ThreadId = FPlatformTLS::GetCurrentThreadId();
+		Record.Detail = MoveTemp(Detail);
+		SpanEnded.Broadcast(Record);
+	}
+}
+
+bool FPalantirSpan::IsObserved()
+{
+	return FPalantirTimeline::IsRecording() || FPalantirTrace::OnSpanEnded().IsBound();
+}
+
+// FPalantirTraceContextScope Implementation
+FPalantirTraceContextScope::FPalantirTraceContextScope(const FPalantirTraceContext& Context, FStringView SpanName)
+{
+	using namespace FPalantirTraceLocal;
+	PreviousSpanId = CurrentSpanId;
+	if (!Context.IsValid())
+	{
+		return;
+	}
+
+	if (Context.TraceID != CurrentTraceID)
+	{
+		// Continue the trace as a fresh slice of this thread's ring; whatever the thread was doing resumes afterwards
+		bSwitchedTrace = true;
+		PreviousTraceID = CurrentTraceID;
+		PreviousTraceId = CurrentTraceId;
+		PreviousStartTime = TraceStartTime;
+		PreviousMailbox = MoveTemp(CurrentMailbox);
+		PreviousTraceStartHead = Ring.TraceStartHead;
+		PreviousTraceStartCycles = Ring.TraceStartCycles;
+
+		if (Ring.Events.Num() == 0)
+		{
+			Ring.Events.SetNum(FPalantirTrace::GetRingCapacity());
+		}
+		SetTraceLocal(Context.TraceID, Context.TraceId.IsValid() ? Context.TraceId : FPalantirTraceId::FromTraceID(Context.TraceID));
+		TraceStartTime = FPlatformTime::Seconds();
+		CurrentMailbox = Context.Mailbox;
+		Mailbox = Context.Mailbox;
+		ScopeStartHead = Ring.Head;
+		Ring.TraceStartHead = Ring.Head;
+		Ring.TraceStartCycles = FPlatformTime::Cycles64();
+	}
+
+	if (Context.CancellationToken.IsValid())
+	{
+		Cancellation.Emplace(Context.CancellationToken);
+	}
+
+	// Spans opened here are children of the point the work was handed off from
+	CurrentSpanId = Context.SpanId;
+	Span.Emplace(SpanName, TEXT("async"));
+	if (Context.FlowId != 0)
+	{
+		FPalantirTimeline::AddFlow(Context.FlowId, false);
+	}
+}
+
+FPalantirTraceContextScope::~FPalantirTraceContextScope()
+{
+	using namespace FPalantirTraceLocal;
+	Span.Reset();
+	Cancellation.Reset();
+
+	if (bSwitchedTrace)
+	{
+		// Hand this slice's breadcrumbs to the trace's owner and take them back off this thread's ring
+		const uint64 Capacity = Ring.Events.Num();
+		const uint64 HeadAtExit = Ring.Head;
+		if (Mailbox.IsValid() && HeadAtExit > ScopeStartHead)
+		{
+			const uint64 First = FMath::Max(ScopeStartHead, HeadAtExit > Capacity ? HeadAtExit - Capacity : 0);
+			FScopeLock ScopeLock(&Mailbox->Lock);
+			for (uint64 Index = First; Index < HeadAtExit && Mailbox->Events.Num() < static_cast<int32>(Capacity); ++Index)
+			{
+				Mailbox->Events.Add(Ring.Events[Index % Capacity]);
+			}
+			Mailbox->NumEvents = Mailbox->Events.Num();
+		}
+
+		// A slice that wrapped the ring overwrote the oldest events of the trace it interrupted
+		if (HeadAtExit > Capacity)
+		{
+			PreviousTraceStartHead = FMath::Min(ScopeStartHead, FMath::Max(PreviousTraceStartHead, HeadAtExit - Capacity));
+		}
+		Ring.Head = ScopeStartHead;
+		Ring.TraceStartHead = PreviousTraceStartHead;
+		Ring.TraceStartCycles = PreviousTraceStartCycles;
+		SetTraceLocal(PreviousTraceID, PreviousTraceId);
+		TraceStartTime = PreviousStartTime;
+		CurrentMailbox = MoveTemp(PreviousMailbox);
+	}
+	CurrentSpanId = PreviousSpanId;
 }
 
 TArray<TPair<double, FString>> FPalantirTrace::GetBreadcrumbs()
 {
-	return GetBreadcrumbsRef();
+	return SnapshotBreadcrumbs().Format();
 }
 
 FString FPalantirTrace::ExportToJSON()
@@ -97,7 +979,7 @@ FString FPalantirTrace::ExportToJSON()
 	JsonRoot->SetNumberField(TEXT("duration_seconds"), FPlatformTime::Seconds() - GetTraceStartTimeRef());
 
 	TArray<TSharedPtr<FJsonValue>> BreadcrumbArray;
-	for (const auto& Breadcrumb : GetBreadcrumbsRef())
+	for (const auto& Breadcrumb : GetBreadcrumbs())
 	{
 		TSharedPtr<FJsonObject> BreadcrumbObj = MakeShareable(new FJsonObject());
 		BreadcrumbObj->SetNumberField(TEXT("timestamp"), Breadcrumb.Key);
@@ -120,6 +1002,12 @@ FPalantirTraceGuard::FPalantirTraceGuard()
 	FPalantirTrace::SetCurrentTraceID(TraceID);
 }
 
+FPalantirTraceGuard::FPalantirTraceGuard(const FString& InTraceID)
+{
+	TraceID = InTraceID.IsEmpty() ? FPalantirTrace::GenerateTraceID() : InTraceID;
+	FPalantirTrace::SetCurrentTraceID(TraceID);
+}
+
 FPalantirTraceGuard::~FPalantirTraceGuard()
 {
 	FPalantirTrace::Clear();
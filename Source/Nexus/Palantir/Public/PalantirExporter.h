@@ -0,0 +1,100 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+#include "NexusTestRegistry.h"
+
+struct FPalantirSpanRecord;
+
+/**
+ * Counters of one exporter session (since the last BeginRun)
+ */
+struct NEXUS_API FPalantirExporterStats
+{
+	int64 ExportedSpans = 0;
+	int64 ExportedMetrics = 0;
+	int64 DroppedSpans = 0;      // Queue full when the span ended
+	int64 DroppedMetrics = 0;
+	int64 FailedBatches = 0;     // Collector unreachable or rejected the batch
+};
+
+/**
+ * FPalantirOtlpExporter - Ships spans and test metrics to an OpenTelemetry collector (OTLP/HTTP JSON)
+ *
+ * Every finished FPalantirSpan (OnSpanEnded) and every test result is put on a bounded queue and the test
+ * thread moves on; a background thread batches them and posts them to <endpoint>/v1/traces and
+ * <endpoint>/v1/metrics, and/or appends them to a file sink (one OTLP JSON request per line, the layout of
+ * the collector's file exporter). When a queue is full the item is dropped and counted, never waited for.
+ *
+ * Span trace IDs are derived from the Nexus trace ID, the X-Trace-ID header FPalantirRequest sends, which
+ * is also attached to every span as nexus.trace_id so backend traces can be joined to test runs.
+ *
+ * [/Script/Nexus.NexusSettings]
+ *   OtlpEndpoint=http://localhost:4318   ; -NexusOtlpEndpoint=  ("local" starts FPalantirOtlpCollector)
+ *   OtlpFile=                            ; -NexusOtlpFile=      (relative paths are under Saved/NexusReports)
+ *   OtlpQueueSize=8192  OtlpBatchSize=512  OtlpFlushIntervalSeconds=2.0
+ */
+class NEXUS_API FPalantirOtlpExporter
+{
+public:
+	/** An endpoint or a file sink is configured */
+	static bool IsEnabled();
+
+	/** Reset the counters and start exporting if enabled (subscribes to spans, starts the flush thread) */
+	static void BeginRun();
+
+	/**
+	 * Queue one finished test execution as metric points (nexus.test.duration, nexus.test.attempts, nexus.tests).
+	 * The test name is resolved from TestId on the export thread.
+	 */
+	static void RecordTestResult(FNexusTestId TestId, const FString& TraceID, double DurationSeconds, bool bPassed, uint32 Attempts);
+
+	/** Queue a gauge sample (e.g. a run-level measurement) */
+	static void RecordGauge(const FString& Name, double Value, const TCHAR* Unit = TEXT("1"));
+
+	/**
+	 * Export everything queued so far and wait (up to TimeoutSeconds) for in-flight posts; called at the end of a run
+	 * @return false if the queues did not drain in time
+	 */
+	static bool Flush(double TimeoutSeconds = 5.0);
+
+	/** Flush, stop the thread and the local collector */
+	static void Shutdown();
+
+	static FPalantirExporterStats GetStats();
+
+	/** Path of the file sink, empty when there is none */
+	static FString GetFilePath();
+
+	/** 32 hex digits for a Nexus trace ID (FPalantirTraceId::FromTraceID: the UUID it carries, otherwise a hash of it) */
+	static FString ToOtlpTraceId(FStringView TraceID);
+
+	/** 16 hex digits */
+	static FString ToOtlpSpanId(uint64 SpanId);
+
+	/** One OTLP/JSON ExportTraceServiceRequest for Spans (exposed for tests and custom sinks) */
+	static FString SerializeSpans(TConstArrayView<FPalantirSpanRecord> Spans);
+};
+
+/**
+ * Minimal stand-in for an OpenTelemetry collector, for local runs and verification without one installed.
+ * Listens on a loopback port, answers every POST with 200 and appends the request body (one OTLP JSON
+ * request) as a line to OutputFile. Started by OtlpEndpoint=local.
+ */
+class NEXUS_API FPalantirOtlpCollector
+{
+public:
+	/**
+	 * @param Port 0 picks a free port
+	 * @return false if the port could not be opened
+	 */
+	static bool Start(const FString& OutputFile, int32 Port = 0);
+	static void Stop();
+	static bool IsRunning();
+
+	/** http://127.0.0.1:<port> while running */
+	static FString GetEndpoint();
+
+	/** Requests received since Start */
+	static int32 GetRequestCount();
+};
@@ -1,12 +1,14 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "PalantirTypes.h"
+#include "NexusTestRegistry.h"
 
 /**
  * Test Result Oracle - Central repository for test execution results
  * 
  * Manages in-memory storage of test results, artifacts, and metadata.
  * Acts as the single source of truth for test execution data during and after test runs.
+ * Results are keyed by FNexusTestId; names are only resolved when a report asks for them.
  */
 class NEXUS_API FPalantirOracle
 {
@@ -15,13 +17,18 @@ public:
 	static FPalantirOracle& Get();
 
 	/** Register a new test result */
+	void RecordTestResult(FNexusTestId TestId, const FPalantirTestResult& Result);
 	void RecordTestResult(const FString& TestName, const FPalantirTestResult& Result);
 
-	/** Get all test results */
-	const TMap<FString, FPalantirTestResult>& GetAllTestResults() const;
+	/** Copy of all test results keyed by test name (resolves every name; meant for reports) */
+	TMap<FString, FPalantirTestResult> GetAllTestResults() const;
 
-	/** Get a specific test result by name */
-	const FPalantirTestResult* GetTestResult(const FString& TestName) const;
+	/** Copy of all test results keyed by ID */
+	TMap<FNexusTestId, FPalantirTestResult> GetAllTestResultsById() const;
+
+	/** Get a specific test result (copied out under the lock), false if none was recorded */
+	bool GetTestResult(FNexusTestId TestId, FPalantirTestResult& OutResult) const;
+	bool GetTestResult(const FString& TestName, FPalantirTestResult& OutResult) const;
 
 	/** Clear all recorded results */
 	void ClearAllResults();
@@ -29,17 +36,17 @@ public:
 	/** Get total test count */
 	int32 GetTotalTestCount() const;
 
-	/** Get passed test count */
+	/** Get passed test count (quarantined tests excluded) */
 	int32 GetPassedTestCount() const;
 
-	/** Get failed test count */
+	/** Get failed test count (quarantined tests excluded) */
 	int32 GetFailedTestCount() const;
 
 private:
 	FPalantirOracle() = default;
 
 	/** In-memory storage of test results */
-	TMap<FString, FPalantirTestResult> TestResults;
+	TMap<FNexusTestId, FPalantirTestResult> TestResults;
 
 	/** Synchronization for thread-safe access */
 	mutable FCriticalSection ResultsLock;
@@ -51,15 +58,27 @@ public:
     static void Initialize();                    // Called at startup
     static void UpdateLiveOverlay();             // Called every frame when active
     static void GenerateFinalReport();           // Called at test end
+    // Per-test calls take the test's FNexusTestId; the name overloads intern the name first (other modules, external results)
     static void OnTestStarted(const FString& Name);
+    static void OnTestStarted(FNexusTestId TestId);
     static void OnTestStarted(const class FNexusTest* Test);  // Overload to capture test metadata
     static void OnTestFinished(const FString& Name, bool bPassed);
+    static void OnTestFinished(FNexusTestId TestId, bool bPassed);
     static void OnTestSkipped(const FString& Name);  // Called when a test is skipped
+    static void OnTestSkipped(FNexusTestId TestId);
+    // Called by the watchdog when a test overruns its deadline; the stuck thread's stack is saved as an artifact
+    static void OnTestTimedOut(const FString& Name, double ElapsedSeconds, const TArray<FString>& StackLines);
+    static void OnTestTimedOut(FNexusTestId TestId, double ElapsedSeconds, const TArray<FString>& StackLines);
     // Register an artifact (screenshot, log, replay) for a given test name.
     static void RegisterArtifact(const FString& TestName, const FString& ArtifactPath);
+    static TArray<FString> GetArtifacts(const FString& TestName);
+    static TArray<FString> GetTestTags(const FString& TestName);
+    // Record a result produced by another process (shard files, remote workers)
+    static void RecordExternalResult(const FString& Name, const FPalantirTestResult& Result, const TArray<FString>& Tags, const TArray<FString>& Artifacts);
     
     // Baseline and regression detection
     static void LoadBaselineData();              // Load baseline durations from file
     static void SaveBaselineData();              // Save current durations as new baseline
     static void DetectRegressions();             // Compare current vs baseline and flag regressions
+    static bool GetBaselineDuration(const FString& Name, double& OutSeconds);  // Baseline duration for scheduling (loads on first use)
 };
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include "CoreMinimal.h"
 #include "Http.h"
 #include "PalantirTrace.h"
+#include "Nexus/Core/Public/NexusLatent.h"
+#include <atomic>
 
 /**
  * Network request wrapper with automatic trace ID injection and response validation.
@@ -51,6 +53,28 @@ struct NEXUS_API FPalantirResponse
 	bool Validate(FString& OutError) const;
 };
 
+/**
+ * co_await-able in-flight request returned by FPalantirRequest::AsyncAwait (latent tests only).
+ * Resumes the test on the frame after the response arrives; the co_await yields the response.
+ */
+struct FPalantirResponseAwaiter : TNexusLatentAwaiter<FPalantirResponseAwaiter>
+{
+	struct FState
+	{
+		FPalantirResponse Response;
+		std::atomic<bool> bDone{false};
+	};
+
+	explicit FPalantirResponseAwaiter(const TSharedRef<FState, ESPMode::ThreadSafe>& InState) : State(InState) {}
+
+	bool await_ready() const { return State->bDone.load(std::memory_order_acquire); }
+	bool IsSatisfied() const { return State->bDone.load(std::memory_order_acquire); }
+	FPalantirResponse await_resume() const { return State->Response; }
+
+	// Shared with the HTTP callback, which may outlive a test abandoned on timeout
+	TSharedRef<FState, ESPMode::ThreadSafe> State;
+};
+
 /**
  * HTTP request builder with fluent API and automatic tracing.
  */
@@ -88,6 +112,13 @@ public:
 	/** Execute request asynchronously with callback */
 	void ExecuteAsync(TFunction<void(const FPalantirResponse&)> OnComplete);
 
+	/**
+	 * Start the request and co_await the response from a NEXUS_TEST_LATENT body; expectations are
+	 * validated (and logged) like ExecuteBlocking, retries are not applied.
+	 * Usage: FPalantirResponse Res = co_await FPalantirRequest::Get(URL).ExpectStatus(200).AsyncAwait();
+	 */
+	FPalantirResponseAwaiter AsyncAwait();
+
 private:
 	FPalantirRequest(const FString& InURL, const FString& InVerb, const FString& InBody = TEXT(""));
 
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+
+struct FPalantirBreadcrumbEvent;
+
+/**
+ * FPalantirTimeline - Whole-run timeline in Chrome Trace Event format (chrome://tracing, ui.perfetto.dev)
+ *
+ * While a run records (-NexusTimeline, or bWriteTimeline=True in [/Script/Nexus.NexusSettings]) every thread
+ * that runs tests gets its own lane: the game thread and each scheduler worker. On a lane:
+ *   - one span per test attempt, with its BeforeEach / TestFunc / AfterEach phases (and latent slices) nested in it
+ *   - every FPalantirSpan, with flow arrows from where work was handed off to where it continued on another thread
+ *   - instant events for breadcrumbs, FPalantirRequest HTTP calls (category "http") and ArgusLens hitches
+ * Each test execution is also an async span from its first attempt to its result, so retry backoff shows
+ * up, and the concurrency governor's target is a counter track. Gaps on the worker lanes are idle workers.
+ *
+ * Events go into a per-thread buffer (no shared lock while recording) and are written once the run ends
+ * to Saved/NexusReports/nexus-timeline.json, registered as the "Nexus_Timeline" artifact.
+ */
+class NEXUS_API FPalantirTimeline
+{
+public:
+	/** -NexusTimeline or bWriteTimeline */
+	static bool IsEnabled();
+
+	/** True between BeginRun and Write of a run that records */
+	static bool IsRecording();
+
+	/** Drop the previous run's events and start recording if enabled; timestamps are relative to this call */
+	static void BeginRun();
+
+	/** Complete span on the calling thread's lane; FPalantirSpan passes its IDs so the trace tree shows in the args */
+	static void AddSpan(FStringView Name, const TCHAR* Category, uint64 StartCycles, uint64 EndCycles, FStringView Detail = FStringView(), uint64 SpanId = 0, uint64 ParentSpanId = 0);
+
+	/** Instant event on the calling thread's lane, or across all lanes (bGlobal, e.g. a hitch) */
+	static void AddInstant(FStringView Name, const TCHAR* Category, FStringView Detail = FStringView(), bool bGlobal = false);
+
+	/** Span that may overlap others on the same thread or move between threads, matched by Id */
+	static void BeginAsyncSpan(FStringView Name, const TCHAR* Category, uint64 Id);
+	static void EndAsyncSpan(FStringView Name, const TCHAR* Category, uint64 Id, FStringView Detail = FStringView());
+
+	/** Arrow between the point work was handed to another thread (bStart) and where it continued, matched by FlowId */
+	static void AddFlow(uint64 FlowId, bool bStart);
+
+	/** Sample of a counter track */
+	static void AddCounter(const TCHAR* Name, double Value);
+
+	/** Copy of a breadcrumb as recorded (formatted when written); called by FPalantirTrace */
+	static void AddBreadcrumb(const FPalantirBreadcrumbEvent& Event);
+
+	/**
+	 * Write the recorded run to ReportDir/nexus-timeline.json and stop recording
+	 * @return the written path, or empty if nothing was recorded
+	 */
+	static FString Write(const FString& ReportDir);
+};
+
+/**
+ * Records a complete span on the current lane when it goes out of scope (nothing when not recording).
+ * Usage: FPalantirTimelineScope Span(TEXT("BeforeEach"), TEXT("phase"));
+ */
+class NEXUS_API FPalantirTimelineScope
+{
+public:
+	FPalantirTimelineScope(FStringView InName, const TCHAR* InCategory);
+	~FPalantirTimelineScope();
+
+	/** False when the run is not recording; check before building a detail string */
+	bool IsActive() const { return StartCycles != 0; }
+
+	/** Shown in the span's args (e.g. the attempt's outcome) */
+	void SetDetail(const FString& InDetail) { Detail = InDetail; }
+
+private:
+	FStringView Name;
+	const TCHAR* Category;
+	uint64 StartCycles = 0;
+	FString Detail;
+};
@@ -3,10 +3,184 @@
 #include "CoreMinimal.h"
 #include "Containers/Map.h"
 #include "Containers/List.h"
+#include "Containers/StringView.h"
+#include "Delegates/Delegate.h"
+#include "Misc/Optional.h"
+#include "Async/Async.h"
+#include "Nexus/Core/Public/NexusCancellation.h"
+#include <type_traits>
 
 // Forward declare log categories
 DECLARE_LOG_CATEGORY_EXTERN(LogPalantirTrace, Log, All);
 
+/**
+ * One breadcrumb as recorded: fixed size, written in place into the thread's ring, never touches the heap.
+ * The event name is interned to an ID and the details are kept as a static format string plus the raw
+ * arguments (numbers by value, strings copied into the inline buffer), so nothing is formatted until the
+ * breadcrumbs are read (FPalantirBreadcrumbSnapshot::Format, ExportToJSON, a failed test's report).
+ */
+struct NEXUS_API FPalantirBreadcrumbEvent
+{
+	static constexpr int32 MaxArgs = 4;
+	static constexpr int32 MaxTextChars = 100;  // Shared by every string argument; longer text is cut
+
+	uint64 Cycles = 0;            // FPlatformTime::Cycles64() when recorded
+	uint16 EventId = 0;           // FPalantirTrace::InternEvent
+	uint8 NumArgs = 0;
+	uint8 FloatArgMask = 0;       // Bit N set: Args[N] is a double
+	uint8 TextLen = 0;            // Used chars of Text (string arguments, NUL separated)
+	uint8 NumTextArgs = 0;
+	bool bTextTruncated = false;
+	const TCHAR* Format = nullptr; // Static printf-style format (%d %u %f %s ...), or null for plain text
+	union
+	{
+		int64 Int;
+		double Float;
+	} Args[MaxArgs] = {};
+	TCHAR Text[MaxTextChars] = {};
+
+	template <typename T>
+	void PushArg(const T& Value)
+	{
+		if constexpr (std::is_floating_point_v<T>)
+		{
+			if (NumArgs < MaxArgs)
+			{
+				FloatArgMask |= 1 << NumArgs;
+				Args[NumArgs++].Float = static_cast<double>(Value);
+			}
+		}
+		else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>)
+		{
+			if (NumArgs < MaxArgs)
+			{
+				Args[NumArgs++].Int = static_cast<int64>(Value);
+			}
+		}
+		else
+		{
+			PushText(FStringView(Value));
+		}
+	}
+
+	void PushText(FStringView Value);
+
+	/** "Details" part of the breadcrumb */
+	FString FormatDetails() const;
+};
+
+/**
+ * Breadcrumbs copied out of a thread's ring (one test attempt); formatted only when asked
+ */
+struct NEXUS_API FPalantirBreadcrumbSnapshot
+{
+	TArray<FPalantirBreadcrumbEvent> Events;
+	uint64 StartCycles = 0;  // Timestamps are relative to this (the first trace start captured)
+	int32 Overwritten = 0;   // Older events the ring wrapped over before the snapshot was taken
+
+	int32 Num() const { return Events.Num(); }
+	void Reset();
+
+	/** Add a later slice of the same attempt (latent tests resume in several traces) */
+	void Append(const FPalantirBreadcrumbSnapshot& Other);
+
+	/** "[1.234s] EventName: Details" per event, oldest first */
+	TArray<TPair<double, FString>> Format() const;
+	TArray<FString> FormatLines() const;
+};
+
+struct FPalantirTraceMailbox;
+
+/**
+ * 128-bit trace ID, kept in binary and rendered as hex only where it leaves the process (log prefix,
+ * HTTP headers, reports). Its string form, the Nexus trace ID, is "nexus-test-" followed by the ID as a
+ * lowercase UUID; the same 32 hex digits are the W3C / OTLP trace-id.
+ */
+struct NEXUS_API FPalantirTraceId
+{
+	uint64 High = 0;
+	uint64 Low = 0;
+
+	bool IsValid() const { return (High | Low) != 0; }
+	bool operator==(const FPalantirTraceId& Other) const { return High == Other.High && Low == Other.Low; }
+	bool operator!=(const FPalantirTraceId& Other) const { return !(*this == Other); }
+
+	/** Random ID from the calling thread's generator: no lock, no allocation (laid out as a version-4 UUID) */
+	static FPalantirTraceId New();
+
+	/** The ID in "nexus-test-<uuid>", a bare UUID or 32 hex digits */
+	static bool Parse(FStringView TraceID, FPalantirTraceId& OutId);
+
+	/** Parse, or a stable hash of any other correlation ID (the same string always gives the same ID) */
+	static FPalantirTraceId FromTraceID(FStringView TraceID);
+
+	/** 32 lowercase hex digits */
+	FString ToHex() const;
+
+	/** "nexus-test-xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx" */
+	FString ToTraceID() const;
+};
+
+/**
+ * W3C Trace Context "traceparent" header: "00-<trace-id>-<parent-id>-<flags>"
+ * FPalantirRequest sends one with every request made inside a trace, so backends that speak W3C Trace
+ * Context (OpenTelemetry, most APMs) join the test's trace without reading X-Trace-ID.
+ */
+struct NEXUS_API FPalantirTraceParent
+{
+	FPalantirTraceId TraceId;
+	uint64 ParentId = 0;     // Span the request was made from
+	uint8 Flags = 0x01;      // sampled
+
+	bool IsValid() const { return TraceId.IsValid() && ParentId != 0; }
+
+	FString ToString() const;
+
+	/** Strict parse per the spec (lowercase hex, no all-zero IDs, version ff rejected); false leaves Out untouched */
+	static bool Parse(FStringView Header, FPalantirTraceParent& Out);
+};
+
+/**
+ * A finished span, as handed to FPalantirTrace::OnSpanEnded listeners (exporters)
+ */
+struct NEXUS_API FPalantirSpanRecord
+{
+	FString TraceID;
+	FPalantirTraceId TraceId;     // Binary form of TraceID
+	FString Name;
+	const TCHAR* Category = TEXT("span");
+	uint64 SpanId = 0;
+	uint64 ParentSpanId = 0;      // 0 for a root span
+	uint64 StartCycles = 0;       // FPlatformTime::Cycles64()
+	uint64 EndCycles = 0;
+	uint32 ThreadId = 0;
+	FString Detail;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnPalantirSpanEnded, const FPalantirSpanRecord&);
+
+/**
+ * Everything a piece of work needs to continue a trace on another thread: the trace ID, the span it was
+ * handed off from (parent of whatever it opens), the attempt's cancellation token, and the trace's mailbox,
+ * through which breadcrumbs recorded elsewhere reach the test's own timeline.
+ * Capture when the work is created, restore with FPalantirTraceContextScope where it runs (or use
+ * FPalantirTrace::Wrap / PalantirAsync, which do both).
+ */
+struct NEXUS_API FPalantirTraceContext
+{
+	FString TraceID;
+	FPalantirTraceId TraceId;
+	uint64 SpanId = 0;
+	uint64 FlowId = 0;  // Links the hand-off to the continuation on the timeline (0 when not recording)
+	TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> CancellationToken;
+	TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> Mailbox;
+
+	bool IsValid() const { return !TraceID.IsEmpty(); }
+
+	/** The calling thread's context (invalid outside a trace) */
+	static FPalantirTraceContext Capture();
+};
+
 /**
  * FPalantirTrace maintains a unique trace ID (correlation ID) for each test execution.
  * This ID is injected into logs, HTTP headers, and metrics to enable cross-system tracing
@@ -23,7 +197,7 @@ class NEXUS_API FPalantirTrace
 {
 public:
 	/**
-	 * Generate a new unique trace ID for a test execution.
+	 * Generate a new unique trace ID for a test execution (FPalantirTraceId::New, rendered once).
 	 * Format: "nexus-test-<UUID>"
 	 * Example: "nexus-test-a3f2e1d4-7c9b-4f2a-9e8d-3c5b1a2f0d7e"
 	 */
@@ -45,6 +219,12 @@ public:
 	 */
 	static FString GetCurrentTraceID();
 
+	/** Binary form of the current trace ID (invalid if no test is active) */
+	static FPalantirTraceId GetCurrentTraceId();
+
+	/** "[<trace ID>] " for log lines, or empty; built once per trace, valid until the trace changes */
+	static const TCHAR* GetLogPrefix();
+
 	/**
 	 * Clear the trace context (typically called after test completion).
 	 */
@@ -53,14 +233,71 @@ public:
 	/**
 	 * Add a breadcrumb event to the trace (e.g., "started asset loading", "network error at 5.2s").
 	 * Useful for timeline reconstruction during debugging.
+	 * Doubles as a cancellation check: the first breadcrumb after the running attempt was cancelled
+	 * (deadline, run abort) also records where the cancellation was observed.
+	 * @return false if the running test attempt has been cancelled and should stop
+	 */
+	static bool AddBreadcrumb(FStringView EventName, FStringView Details = FStringView());
+
+	/**
+	 * Add a breadcrumb whose details are formatted only when read (see PALANTIR_BREADCRUMBF).
+	 * The ring keeps the Format pointer, so it must be a string literal: other strings, including
+	 * TCHAR buffers and FString data, do not compile. Args are numbers or strings, at most
+	 * FPalantirBreadcrumbEvent::MaxArgs numbers plus MaxTextChars of string data.
+	 * @return false if the running test attempt has been cancelled and should stop
 	 */
-	static void AddBreadcrumb(const FString& EventName, const FString& Details = TEXT(""));
+	template <int32 N, typename... ArgTypes>
+	static bool AddBreadcrumbf(FStringView EventName, const TCHAR (&Format)[N], const ArgTypes&... Args)
+	{
+		bool bContinue = true;
+		if (FPalantirBreadcrumbEvent* Event = BeginBreadcrumb(EventName, Format, bContinue))
+		{
+			(Event->PushArg(Args), ...);
+			EndBreadcrumb(*Event);
+		}
+		return bContinue;
+	}
+
+	/** A writable buffer changes (or dies) before the breadcrumb is read - format it with AddBreadcrumb instead */
+	template <int32 N, typename... ArgTypes>
+	static bool AddBreadcrumbf(FStringView EventName, TCHAR (&Format)[N], const ArgTypes&... Args) = delete;
+
+	/** Stable ID for an event name; lock-free after a thread's first use of a (short) name */
+	static uint16 InternEvent(FStringView EventName);
+	static FString GetEventName(uint16 EventId);
 
 	/**
-	 * Get all breadcrumbs for the current trace.
+	 * Get all breadcrumbs for the current trace (formats them).
 	 */
 	static TArray<TPair<double, FString>> GetBreadcrumbs();
 
+	/**
+	 * Copy the current trace's breadcrumbs out of the ring without formatting them.
+	 */
+	static FPalantirBreadcrumbSnapshot SnapshotBreadcrumbs();
+
+	/** Events each thread's ring holds before overwriting the oldest ([/Script/Nexus.NexusSettings] BreadcrumbRingSize) */
+	static int32 GetRingCapacity();
+
+	/** Innermost open span on this thread (0 if none) */
+	static uint64 GetCurrentSpanId();
+
+	/** Parent of the innermost open span on this thread (0 if none, or it is a root span) */
+	static uint64 GetCurrentParentSpanId();
+
+	/** Fresh random span ID from the calling thread's generator (never 0; also a W3C parent-id) */
+	static uint64 NewSpanId();
+
+	/** Fired on the ending thread for every finished span; bind at startup, not while tests run */
+	static FOnPalantirSpanEnded& OnSpanEnded();
+
+	/**
+	 * Wrap a callable so it runs in the calling thread's trace context, inside a child span named SpanName.
+	 * Usage: World->GetTimerManager().SetTimer(Handle, FTimerDelegate::CreateLambda(FPalantirTrace::Wrap(TEXT("ChaosTick"), [](){ ... })), 1.0f, true);
+	 */
+	template <typename FuncType>
+	static auto Wrap(const TCHAR* SpanName, FuncType&& Func);
+
 	/**
 	 * Export trace metadata to JSON (for DataDog, ELK, or other APM systems).
 	 */
@@ -69,11 +306,97 @@ public:
 private:
 	// Thread-local trace context stored via static accessor functions
 	// (Avoids C2492 DLL export issues with thread_local static members in class interface)
+	friend class FPalantirTraceContextScope;
+	friend class FPalantirSpan;
 	static FString& GetCurrentTraceIDRef();
-	static TArray<TPair<double, FString>>& GetBreadcrumbsRef();
 	static double& GetTraceStartTimeRef();
+
+	/** Claim the next ring slot and fill its header; null when no trace is active */
+	static FPalantirBreadcrumbEvent* BeginBreadcrumb(FStringView EventName, const TCHAR* Format, bool& bOutContinue);
+	static void EndBreadcrumb(const FPalantirBreadcrumbEvent& Event);
 };
 
+/**
+ * RAII span: a timed, named node of the trace tree, child of the span open when it starts.
+ * Finished spans go to the run timeline (when recording) and to FPalantirTrace::OnSpanEnded listeners.
+ * Usage: FPalantirSpan Span(TEXT("LoadLevel"));
+ */
+class NEXUS_API FPalantirSpan
+{
+public:
+	explicit FPalantirSpan(FStringView InName, const TCHAR* InCategory = TEXT("span"));
+	~FPalantirSpan();
+
+	FPalantirSpan(const FPalantirSpan&) = delete;
+	FPalantirSpan& operator=(const FPalantirSpan&) = delete;
+
+	uint64 GetSpanId() const { return SpanId; }
+	uint64 GetParentSpanId() const { return ParentSpanId; }
+
+	/** Attached to the finished span (e.g. an attempt's outcome); only worth building while someone listens */
+	void SetDetail(const FString& InDetail) { Detail = InDetail; }
+	static bool IsObserved();
+
+private:
+	FStringView Name;
+	const TCHAR* Category;
+	uint64 SpanId = 0;
+	uint64 ParentSpanId = 0;
+	uint64 PreviousParentSpanId = 0;
+	uint64 StartCycles = 0;
+	FString Detail;
+};
+
+/**
+ * Continue a captured trace context on this thread for the scope's lifetime, inside a child span.
+ * Breadcrumbs recorded meanwhile are handed to the trace's owner (they show up in the test's breadcrumbs)
+ * and the thread's previous context is put back afterwards. Re-entering the trace already active on this
+ * thread only opens the span.
+ */
+class NEXUS_API FPalantirTraceContextScope
+{
+public:
+	explicit FPalantirTraceContextScope(const FPalantirTraceContext& Context, FStringView SpanName = TEXTVIEW("Continuation"));
+	~FPalantirTraceContextScope();
+
+	FPalantirTraceContextScope(const FPalantirTraceContextScope&) = delete;
+	FPalantirTraceContextScope& operator=(const FPalantirTraceContextScope&) = delete;
+
+private:
+	bool bSwitchedTrace = false;
+	FString PreviousTraceID;
+	FPalantirTraceId PreviousTraceId;
+	double PreviousStartTime = 0.0;
+	uint64 PreviousSpanId = 0;
+	uint64 PreviousTraceStartHead = 0;
+	uint64 PreviousTraceStartCycles = 0;
+	uint64 ScopeStartHead = 0;
+	TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> PreviousMailbox;
+	TSharedPtr<FPalantirTraceMailbox, ESPMode::ThreadSafe> Mailbox;
+	TOptional<FNexusCancellationScope> Cancellation;
+	TOptional<FPalantirSpan> Span;
+};
+
+template <typename FuncType>
+auto FPalantirTrace::Wrap(const TCHAR* SpanName, FuncType&& Func)
+{
+	return [Context = FPalantirTraceContext::Capture(), SpanName, Func = Forward<FuncType>(Func)](auto&&... Args) mutable -> decltype(auto)
+	{
+		FPalantirTraceContextScope Scope(Context, SpanName);
+		return Func(Forward<decltype(Args)>(Args)...);
+	};
+}
+
+/**
+ * Async() that carries the caller's trace context (trace ID, parent span, cancellation) to the task.
+ * Usage: PalantirAsync(EAsyncExecution::ThreadPool, TEXT("PollScreenshot"), [](){ ... });
+ */
+template <typename FuncType>
+auto PalantirAsync(EAsyncExecution Execution, const TCHAR* SpanName, FuncType&& Func)
+{
+	return Async(Execution, FPalantirTrace::Wrap(SpanName, Forward<FuncType>(Func)));
+}
+
 /**
  * RAII guard for trace context. Automatically generates a trace ID on construction
  * and clears it on destruction.
@@ -83,11 +406,14 @@ private:
  *       FPalantirTraceGuard Guard;  // Generates trace ID
  *       // ... test code ...
  *   }  // Trace context cleaned up automatically
+ *
+ * Pass an existing ID to re-enter a trace on another thread (e.g. a retried test attempt).
  */
 class NEXUS_API FPalantirTraceGuard
 {
 public:
 	FPalantirTraceGuard();
+	explicit FPalantirTraceGuard(const FString& InTraceID);
 	~FPalantirTraceGuard();
 
 	const FString& GetTraceID() const { return TraceID; }
@@ -102,10 +428,7 @@ private:
  */
 #define UE_LOG_TRACE(Category, Verbosity, Format, ...) \
 	{ \
-		FString TracePrefix = FPalantirTrace::GetCurrentTraceID().IsEmpty() \
-			? FString(TEXT("")) \
-			: FString::Printf(TEXT("[%s] "), *FPalantirTrace::GetCurrentTraceID()); \
-		UE_LOG(Category, Verbosity, TEXT("%s") Format, *TracePrefix, ##__VA_ARGS__); \
+		UE_LOG(Category, Verbosity, TEXT("%s") Format, FPalantirTrace::GetLogPrefix(), ##__VA_ARGS__); \
 	}
 
 /**
@@ -114,3 +437,24 @@ private:
  */
 #define PALANTIR_BREADCRUMB(EventName, Details) \
 	FPalantirTrace::AddBreadcrumb(EventName, Details)
+
+/**
+ * Breadcrumb with deferred formatting - use on hot paths instead of PALANTIR_BREADCRUMB + FString::Printf.
+ * Format must be a TEXT() literal.
+ * Usage: PALANTIR_BREADCRUMBF(TEXT("HttpResponse"), TEXT("%d in %.1fms"), StatusCode, DurationMs);
+ */
+#define PALANTIR_BREADCRUMBF(EventName, Format, ...) \
+	FPalantirTrace::AddBreadcrumbf(EventName, Format, ##__VA_ARGS__)
+
+/**
+ * Breadcrumb that also bails out of a (non-latent) test body once the attempt is cancelled.
+ * Usage: PALANTIR_CHECKPOINT(TEXT("Phase"), TEXT("Spawned wave 3"));  // returns false from the test if cancelled
+ */
+#define PALANTIR_CHECKPOINT(EventName, Details) \
+	do \
+	{ \
+		if (!FPalantirTrace::AddBreadcrumb(EventName, Details)) \
+		{ \
+			return false; \
+		} \
+	} while (0)
@@ -13,6 +13,15 @@ struct FPalantirTestResult
 	/** Whether the test was skipped */
 	bool bSkipped = false;
 
+	/** Whether the test failed by overrunning its deadline (see FNexusWatchdog) */
+	bool bTimedOut = false;
+
+	/** Whether the result was reused from an earlier run with identical inputs (see FNexusResultCache) */
+	bool bCached = false;
+
+	/** Whether the test ran quarantined as flaky (see FNexusFlakiness); reported apart from passes and failures */
+	bool bQuarantined = false;
+
 	/** Execution duration in seconds */
 	double Duration = 0.0;
 
@@ -73,7 +73,10 @@ public:
     }
 };
 
-static FNexusRetryExampleTest Global_FNexusRetryExampleTest;
+// Hand-written test classes register a descriptor too, so the object is only built at discovery
+static FNexusTestDescriptor NexusDescriptor_FNexusRetryExampleTest(
+    TEXT("Nexus.Retry.ExampleFlakeyTest"),
+    []() -> FNexusTest* { return new FNexusRetryExampleTest(); });
 
 // Example: Performance monitoring with assertions
 // This demonstrates the performance test macro with ArgusLens integration
@@ -99,3 +102,20 @@ NEXUS_PERF_TEST(FNexusPerformanceExampleTest, "Nexus.Performance.ContextExample"
     
     return true;
 }
+
+// Example: Latent test that waits across frames without blocking the game thread
+// Latent tests are interleaved, so many of these waiting at once take about as long as one
+NEXUS_TEST_LATENT_TAGGED(FNexusLatentExampleTest, "Nexus.Latent.FrameAndTimeWaits", ETestPriority::Normal, {"Example", "GameThread"})
+{
+    const uint64 StartFrame = FNexusLatentRunner::GetFrameNumber();
+    co_await Nexus::NextFrame();
+    if (FNexusLatentRunner::GetFrameNumber() <= StartFrame)
+    {
+        UE_LOG(LogTemp, Error, TEXT("NextFrame resumed without a frame being stepped"));
+        co_return false;
+    }
+
+    const double StartTime = FNexusLatentRunner::GetTimeSeconds();
+    co_await Nexus::Seconds(0.25);
+    co_return FNexusLatentRunner::GetTimeSeconds() - StartTime >= 0.25;
+}
@@ -1,5 +1,18 @@
 #include "Nexus/Core/Public/NexusTest.h"
 #include "NexusCore.h"
+#include "Nexus/Core/Public/NexusSharding.h"
+#include "Nexus/Core/Public/NexusFlakiness.h"
+#include "Nexus/Core/Public/NexusTestFilter.h"
+#include "Nexus/Core/Public/NexusTestGraph.h"
+#include "Nexus/Core/Public/NexusScheduler.h"
+#include "Nexus/Core/Public/NexusFixture.h"
+#include "Nexus/Core/Public/NexusRunHistory.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include <atomic>
 
 /**
  * Smoke test for Nexus core orchestration.
@@ -10,3 +23,982 @@ NEXUS_TEST_TAGGED(FNexusCoreSmoke, "Nexus.Core.Smoke", ETestPriority::Normal, {"
     // Core framework bootstrapped successfully if this runs
     return true;
 }
+
+/**
+ * Shards must partition the suite: every test runs on exactly one shard.
+ */
+NEXUS_TEST_TAGGED(FNexusShardPartition, "Nexus.Core.ShardPartition", ETestPriority::Normal, {"Framework"})
+{
+    FNexusShardSpec Spec;
+    if (!FNexusShardSpec::Parse(TEXT("2/3"), Spec) || Spec.Index != 1 || Spec.Count != 3)
+    {
+        return false;
+    }
+    if (FNexusShardSpec::Parse(TEXT("0/3"), Spec) || FNexusShardSpec::Parse(TEXT("4/3"), Spec) || FNexusShardSpec::Parse(TEXT("x"), Spec))
+    {
+        return false;
+    }
+
+    // Discovery materialized the suite before any test ran; this lane only reads AllTests
+    TArray<FNexusTest*> Suite;
+    for (FNexusTest* Test : FNexusTest::AllTests)
+    {
+        if (Test) Suite.AddUnique(Test);
+    }
+
+    TMap<FNexusTest*, int32> Owners;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        FNexusShardSpec Shard;
+        Shard.Index = Index;
+        Shard.Count = 3;
+        for (FNexusTest* Test : FNexusSharding::Partition(Suite, Shard))
+        {
+            Owners.FindOrAdd(Test)++;
+        }
+    }
+
+    for (FNexusTest* Test : Suite)
+    {
+        if (Owners.FindRef(Test) != 1)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Quarantine needs evidence: the same flip rate is only significant once enough outcomes back it.
+ */
+NEXUS_TEST_TAGGED(FNexusFlakinessInterval, "Nexus.Core.FlakinessInterval", ETestPriority::Normal, {"Framework"})
+{
+    double Lower = 0.0;
+    double Upper = 0.0;
+    FNexusFlakiness::ComputeWilsonInterval(0, 0, Lower, Upper);
+    if (Lower != 0.0 || Upper != 1.0)
+    {
+        return false;
+    }
+
+    // 2 flips in 4 transitions is no evidence; 15 in 30 clears a 0.2 threshold
+    FNexusFlakiness::ComputeWilsonInterval(2, 4, Lower, Upper);
+    if (Lower >= 0.2 || Upper <= 0.5)
+    {
+        return false;
+    }
+    FNexusFlakiness::ComputeWilsonInterval(15, 30, Lower, Upper);
+    if (Lower < 0.3 || Upper > 0.7)
+    {
+        return false;
+    }
+
+    // Never flipping keeps the upper bound above zero, but it shrinks with more outcomes
+    double SmallUpper = 0.0;
+    FNexusFlakiness::ComputeWilsonInterval(0, 9, Lower, SmallUpper);
+    FNexusFlakiness::ComputeWilsonInterval(0, 29, Lower, Upper);
+    return Lower < KINDA_SMALL_NUMBER && Upper > 0.0 && Upper < SmallUpper && Upper < 0.2;
+}
+
+/**
+ * Deferred breadcrumb formatting must read the same as the FString::Printf it replaces.
+ */
+NEXUS_TEST_TAGGED(FNexusBreadcrumbFormat, "Nexus.Core.BreadcrumbFormat", ETestPriority::Normal, {"Framework"})
+{
+    FPalantirBreadcrumbEvent Event;
+    Event.Format = TEXT("%s %d in %.1fms (%u%%)");
+    Event.PushArg(TEXT("GET"));
+    Event.PushArg(404);
+    Event.PushArg(12.34);
+    Event.PushArg(7u);
+    if (Event.FormatDetails() != FString::Printf(TEXT("%s %d in %.1fms (%u%%)"), TEXT("GET"), 404, 12.34, 7u))
+    {
+        return false;
+    }
+
+    // Plain details are kept as-is up to the inline buffer, then cut
+    FPalantirBreadcrumbEvent Plain;
+    Plain.PushText(FString::ChrN(FPalantirBreadcrumbEvent::MaxTextChars * 2, TEXT('x')));
+    const FString Details = Plain.FormatDetails();
+    return Details.EndsWith(TEXT("x...")) && Details.Len() == FPalantirBreadcrumbEvent::MaxTextChars - 1 + 3;
+}
+
+/**
+ * Work handed to another thread through PalantirAsync continues the test's trace: same trace ID, its span is a
+ * child of the one open at the hand-off, and its breadcrumbs come back to the test.
+ */
+NEXUS_TEST_TAGGED(FNexusTraceContextPropagation, "Nexus.Core.TraceContextPropagation", ETestPriority::Normal, {"Framework"})
+{
+    const FString TraceID = FPalantirTrace::GetCurrentTraceID();
+    const FPalantirTraceId TraceId = FPalantirTrace::GetCurrentTraceId();
+    FPalantirSpan Outer(TEXT("HandOff"));
+
+    struct FWorkerView
+    {
+        FString TraceID;
+        FPalantirTraceId TraceId;
+        uint64 SpanId = 0;
+        uint64 ParentSpanId = 0;
+    };
+    const FWorkerView Worker = PalantirAsync(EAsyncExecution::ThreadPool, TEXT("Worker"), []()
+    {
+        PALANTIR_BREADCRUMB(TEXT("WorkerStep"), TEXT("on pool thread"));
+        return FWorkerView{ FPalantirTrace::GetCurrentTraceID(), FPalantirTrace::GetCurrentTraceId(), FPalantirTrace::GetCurrentSpanId(), FPalantirTrace::GetCurrentParentSpanId() };
+    }).Get();
+
+    // The worker's span is a fresh child of the span open at the hand-off, in the same trace
+    if (Worker.TraceID != TraceID || Worker.TraceId != TraceId || !Worker.TraceId.IsValid()
+        || Worker.SpanId == 0 || Worker.SpanId == Outer.GetSpanId() || Worker.ParentSpanId != Outer.GetSpanId())
+    {
+        return false;
+    }
+    if (FPalantirTrace::GetCurrentSpanId() != Outer.GetSpanId() || FPalantirTrace::GetCurrentParentSpanId() != Outer.GetParentSpanId())
+    {
+        return false;
+    }
+
+    const uint16 WorkerStep = FPalantirTrace::InternEvent(TEXT("WorkerStep"));
+    return FPalantirTrace::SnapshotBreadcrumbs().Events.ContainsByPredicate([WorkerStep](const FPalantirBreadcrumbEvent& Event)
+    {
+        return Event.EventId == WorkerStep;
+    });
+}
+
+/**
+ * Trace IDs round-trip between binary and their string forms, and traceparent follows the W3C rules.
+ */
+NEXUS_TEST_TAGGED(FNexusTraceIdFormat, "Nexus.Core.TraceIdFormat", ETestPriority::Normal, {"Framework"})
+{
+    const FPalantirTraceId Minted = FPalantirTraceId::New();
+    FPalantirTraceId Parsed;
+    if (!Minted.IsValid() || Minted == FPalantirTraceId::New()
+        || !FPalantirTraceId::Parse(Minted.ToTraceID(), Parsed) || Parsed != Minted
+        || !FPalantirTraceId::Parse(Minted.ToHex(), Parsed) || Parsed != Minted)
+    {
+        return false;
+    }
+
+    // Existing IDs keep their UUID bytes
+    const FString TraceID = TEXT("nexus-test-a3f2e1d4-7c9b-4f2a-9e8d-3c5b1a2f0d7e");
+    if (FPalantirTraceId::FromTraceID(TraceID).ToTraceID() != TraceID)
+    {
+        return false;
+    }
+
+    FPalantirTraceParent TraceParent;
+    if (!FPalantirTraceParent::Parse(TEXT("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"), TraceParent)
+        || TraceParent.TraceId.ToHex() != TEXT("4bf92f3577b34da6a3ce929d0e0e4736")
+        || TraceParent.ParentId != 0x00f067aa0ba902b7ull
+        || TraceParent.ToString() != TEXT("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"))
+    {
+        return false;
+    }
+
+    // Rejected: all-zero trace-id, uppercase hex, version ff, trailing data on version 00
+    return !FPalantirTraceParent::Parse(TEXT("00-00000000000000000000000000000000-00f067aa0ba902b7-01"), TraceParent)
+        && !FPalantirTraceParent::Parse(TEXT("00-4BF92F3577B34DA6A3CE929D0E0E4736-00f067aa0ba902b7-01"), TraceParent)
+        && !FPalantirTraceParent::Parse(TEXT("ff-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"), TraceParent)
+        && !FPalantirTraceParent::Parse(TEXT("00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01-x"), TraceParent);
+}
+
+/**
+ * OTLP spans keep the X-Trace-ID correlation: the UUID of a Nexus trace ID is the OTLP trace ID, and the
+ * original ID rides along as nexus.trace_id.
+ */
+NEXUS_TEST_TAGGED(FNexusOtlpSpanFormat, "Nexus.Core.OtlpSpanFormat", ETestPriority::Normal, {"Framework"})
+{
+    FPalantirSpanRecord Span;
+    Span.TraceID = TEXT("nexus-test-a3f2e1d4-7c9b-4f2a-9e8d-3c5b1a2f0d7e");
+    Span.Name = TEXT("BeforeEach");
+    Span.Category = TEXT("phase");
+    Span.SpanId = 0x2a;
+    Span.ParentSpanId = 0x29;
+    Span.StartCycles = FPlatformTime::Cycles64();
+    Span.EndCycles = Span.StartCycles + 1000;
+
+    const FString Body = FPalantirOtlpExporter::SerializeSpans(MakeArrayView(&Span, 1));
+    return FPalantirOtlpExporter::ToOtlpTraceId(Span.TraceID) == TEXT("a3f2e1d47c9b4f2a9e8d3c5b1a2f0d7e")
+        && FPalantirOtlpExporter::ToOtlpTraceId(TEXT("custom-id")).Len() == 32
+        && Body.Contains(TEXT("\"traceId\":\"a3f2e1d47c9b4f2a9e8d3c5b1a2f0d7e\""))
+        && Body.Contains(TEXT("\"spanId\":\"000000000000002a\""))
+        && Body.Contains(TEXT("\"parentSpanId\":\"0000000000000029\""))
+        && Body.Contains(TEXT("\"stringValue\":\"nexus-test-a3f2e1d4-7c9b-4f2a-9e8d-3c5b1a2f0d7e\""));
+}
+
+/**
+ * Tests that are inspected or driven by hand, never run by the lanes. FNexusTest adds itself to AllTests, so they
+ * are taken out again when the suite goes out of scope, along with any results they recorded - use from
+ * game-thread tests, which never overlap other lanes.
+ */
+class FNexusSyntheticSuite
+{
+public:
+    ~FNexusSyntheticSuite()
+    {
+        FNexusTest::AllTests.RemoveAll([this](FNexusTest* Test)
+        {
+            return Tests.ContainsByPredicate([Test](const TUniquePtr<FNexusTest>& Owned) { return Owned.Get() == Test; });
+        });
+
+        FNexusResultCollector::Flush();
+        FNexusTest::AllResults.RemoveAll([this](const FNexusTestResult& Result)
+        {
+            return Tests.ContainsByPredicate([&Result](const TUniquePtr<FNexusTest>& Owned) { return Owned->TestName == Result.TestName; });
+        });
+    }
+
+    FNexusTest* Add(const FString& Name, ETestPriority Priority = ETestPriority::Normal, std::initializer_list<FString> Tags = {})
+    {
+        return Tests.Add_GetRef(MakeUnique<FNexusTest>(Name, Priority, [](const FNexusTestContext&) { return true; }, false, Tags)).Get();
+    }
+
+private:
+    TArray<TUniquePtr<FNexusTest>> Tests;
+};
+
+/** Names of the tests in Tests that Expression selects, or "<error>" if it does not compile */
+static FString NexusFilterSelect(const FString& Expression, const TArray<FNexusTest*>& Tests)
+{
+    FNexusTestFilter Filter;
+    FString Error;
+    if (!FNexusTestFilter::Compile(Expression, Filter, Error))
+    {
+        return TEXT("<error>");
+    }
+    TArray<FString> Names;
+    for (const FNexusTest* Test : Tests)
+    {
+        if (Filter.Matches(*Test))
+        {
+            Names.Add(Test->TestName);
+        }
+    }
+    return FString::Join(Names, TEXT(","));
+}
+
+/**
+ * -NexusFilter grammar: && binds tighter than ||, ! applies to the next term, globs and regexes match the whole
+ * name ignoring case, and malformed expressions are rejected with a position instead of selecting everything.
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusTestFilterGrammar, "Nexus.Core.TestFilterGrammar", ETestPriority::Normal, {"Framework"})
+{
+    // Synthetic tests are unregistered, so they are checked one at a time and gone before Select runs below
+    {
+        FNexusSyntheticSuite Suite;
+        const TArray<FNexusTest*> Tests = {
+            Suite.Add(TEXT("Net.Login"), ETestPriority::Critical, {TEXT("Networking")}),
+            Suite.Add(TEXT("Net.Stress"), ETestPriority::Normal, {TEXT("Networking"), TEXT("Stress")}),
+            Suite.Add(TEXT("UI.Menu"), ETestPriority::Smoke, {TEXT("UI")})
+        };
+
+        struct FCase
+        {
+            const TCHAR* Expression;
+            const TCHAR* Expected;
+        };
+        const FCase Cases[] = {
+            // Precedence: a || (b && c), not (a || b) && c
+            { TEXT("name:UI.* || tag:Stress && name:Net.Login"), TEXT("UI.Menu") },
+            { TEXT("(name:UI.* || tag:Stress) && name:Net.*"), TEXT("Net.Stress") },
+            { TEXT("tag:Networking && !tag:Stress"), TEXT("Net.Login") },
+            { TEXT("!(tag:Networking || tag:UI)"), TEXT("") },
+            { TEXT("!!TAG:ui"), TEXT("UI.Menu") },
+            // Globs, bare words, quoting and regexes
+            { TEXT("net.*"), TEXT("Net.Login,Net.Stress") },
+            { TEXT("Net.?ogin"), TEXT("Net.Login") },
+            { TEXT("*Stress || Net"), TEXT("Net.Stress") },
+            { TEXT("name:\"ui.menu\""), TEXT("UI.Menu") },
+            { TEXT("name:/^net\\.(login|menu)$/"), TEXT("Net.Login") },
+            // Priorities
+            { TEXT("priority:Critical || priority:smoke"), TEXT("Net.Login,UI.Menu") },
+            { TEXT("priority:Normal"), TEXT("Net.Stress") },
+            { TEXT(""), TEXT("Net.Login,Net.Stress,UI.Menu") },
+            // Malformed
+            { TEXT("tag:"), TEXT("<error>") },
+            { TEXT("&& tag:UI"), TEXT("<error>") },
+            { TEXT("(tag:UI"), TEXT("<error>") },
+            { TEXT("tag:UI)"), TEXT("<error>") },
+            { TEXT("tag:UI ||"), TEXT("<error>") },
+            { TEXT("priority:Bogus"), TEXT("<error>") },
+            { TEXT("name:/unterminated"), TEXT("<error>") },
+            { TEXT("name:\"unterminated"), TEXT("<error>") }
+        };
+        for (const FCase& Case : Cases)
+        {
+            const FString Selected = NexusFilterSelect(Case.Expression, Tests);
+            if (Selected != Case.Expected)
+            {
+                UE_LOG(LogNexus, Error, TEXT("Filter '%s' selected '%s', expected '%s'"), Case.Expression, *Selected, Case.Expected);
+                return false;
+            }
+        }
+    }
+
+    // The error names where parsing stopped
+    FNexusTestFilter Filter;
+    FString Error;
+    if (FNexusTestFilter::Compile(TEXT("tag:UI && (name:A"), Filter, Error) || !Error.Contains(TEXT("position")) || !Filter.IsEmpty())
+    {
+        return false;
+    }
+
+    // Select (bitsets over the whole suite) agrees with Matches (one test at a time) on the real suite
+    const TCHAR* const SuiteExpressions[] = { TEXT("tag:Framework && !name:*Grammar"), TEXT("priority:Critical || tag:Networking"), TEXT("!name:/^Nexus\\./") };
+    for (const TCHAR* Expression : SuiteExpressions)
+    {
+        if (!FNexusTestFilter::Compile(Expression, Filter, Error))
+        {
+            return false;
+        }
+        TArray<FNexusTest*> Expected;
+        for (FNexusTest* Test : FNexusTest::AllTests)
+        {
+            if (Test && Filter.Matches(*Test))
+            {
+                Expected.Add(Test);
+            }
+        }
+        if (Filter.Select(FNexusTest::AllTests) != Expected)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * A failed test takes down only what depends on it: its subtree is skipped once, unrelated tests stay runnable
+ * and their dependents are still released, and a critical failure that gates dependents does not abort the run.
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusTestGraphFailureIsolation, "Nexus.Core.TestGraphFailureIsolation", ETestPriority::Normal, {"Framework"})
+{
+    FNexusSyntheticSuite Suite;
+    FNexusTest* Login = Suite.Add(TEXT("Graph.Login"), ETestPriority::Critical);
+    FNexusTest* Inventory = Suite.Add(TEXT("Graph.Inventory"));
+    FNexusTest* Health = Suite.Add(TEXT("Graph.Health"));
+    FNexusTest* Checkout = Suite.Add(TEXT("Graph.Checkout"));
+    FNexusTest* Profile = Suite.Add(TEXT("Graph.Profile"));
+    FNexusTest* Leaderboard = Suite.Add(TEXT("Graph.Leaderboard"), ETestPriority::Critical);
+    Inventory->AddPrerequisite(Login->TestName);
+    Checkout->AddPrerequisite(Inventory->TestName);
+    Checkout->AddPrerequisite(Health->TestName);
+    Profile->AddPrerequisite(Health->TestName);
+    Profile->AddPrerequisite(TEXT("Graph.NotInThisRun"));  // Filtered out: ignored, not waited for
+
+    FNexusTestGraph Graph;
+    Graph.Build({ Checkout, Profile, Inventory, Login, Health, Leaderboard });
+    const TArray<FNexusTest*>& Order = Graph.GetTopologicalOrder();
+    if (Order.Num() != 6 || Order.Find(Login) > Order.Find(Inventory) || Order.Find(Inventory) > Order.Find(Checkout)
+        || Order.Find(Health) > Order.Find(Profile) || Graph.GetUnreachableTests().Num() != 0)
+    {
+        return false;
+    }
+    if (!Graph.IsReady(Login) || !Graph.IsReady(Health) || !Graph.IsReady(Leaderboard) || Graph.IsReady(Inventory) || Graph.IsReady(Profile))
+    {
+        return false;
+    }
+
+    // Login fails: its subtree is skipped, and only once
+    const TSet<FNexusTest*> Skipped(Graph.MarkFailed(Login));
+    if (Skipped.Num() != 2 || !Skipped.Contains(Inventory) || !Skipped.Contains(Checkout) || Graph.MarkFailed(Inventory).Num() != 0)
+    {
+        return false;
+    }
+    if (Graph.IsSkipped(Health) || Graph.IsSkipped(Profile) || Graph.IsSkipped(Leaderboard) || !Graph.IsReady(Health) || !Graph.IsReady(Leaderboard))
+    {
+        return false;
+    }
+
+    // Health still runs and releases Profile, but not the already skipped Checkout
+    if (Graph.MarkPassed(Health) != TArray<FNexusTest*>({ Profile }) || !Graph.IsReady(Profile) || Graph.IsReady(Checkout))
+    {
+        return false;
+    }
+
+    // Fail-fast: a critical failure gating dependents skips its subtree; without dependents it aborts the run
+    Leaderboard->bQuarantined = true;
+    const bool bQuarantinedAborts = FNexusTestGraph::ShouldAbortRun(Leaderboard, &Graph);
+    Leaderboard->bQuarantined = false;
+    if (FNexusTestGraph::ShouldAbortRun(Login, &Graph)
+        || !FNexusTestGraph::ShouldAbortRun(Leaderboard, &Graph)
+        || !FNexusTestGraph::ShouldAbortRun(Login, nullptr)
+        || FNexusTestGraph::ShouldAbortRun(Inventory, &Graph)
+        || bQuarantinedAborts)
+    {
+        return false;
+    }
+
+    // An abort hands every test the scheduler will not start to the skip handler exactly once: tests still
+    // waiting on prerequisites from Cancel itself, released ones from the worker that dequeues them
+    TMap<FNexusTest*, int32> AbortSkipped;
+    bool bBodyRan = false;
+    {
+        FNexusScheduler Scheduler(1);
+        Scheduler.SetSkipHandler([&AbortSkipped](FNexusScheduledTest& Job, int32 WorkerIndex)
+        {
+            AbortSkipped.Add(Job.Test, WorkerIndex);
+        });
+        Scheduler.AddPending({ Inventory, Checkout, Profile });
+        Scheduler.DropPending(Inventory);
+        if (!Scheduler.ReleasePending(Profile, 0))
+        {
+            return false;
+        }
+        Scheduler.Cancel();
+        Scheduler.Cancel();
+        if (Scheduler.ReleasePending(Checkout, 0))
+        {
+            return false;
+        }
+        Scheduler.Run([&bBodyRan](FNexusScheduledTest& Job, int32 WorkerIndex)
+        {
+            bBodyRan = true;
+            return ENexusJobResult::Completed;
+        });
+    }
+    const int32* CheckoutWorker = AbortSkipped.Find(Checkout);
+    const int32* ProfileWorker = AbortSkipped.Find(Profile);
+    return !bBodyRan && AbortSkipped.Num() == 2
+        && CheckoutWorker && *CheckoutWorker == INDEX_NONE
+        && ProfileWorker && *ProfileWorker == 0;
+}
+
+/**
+ * Points FNexusRunHistory at an empty store for the scope, so a test can record executions (and the scheduler
+ * weights jobs by them) without touching the project's history. Game-thread tests only, like FNexusSyntheticSuite.
+ */
+class FNexusScopedRunHistory
+{
+public:
+    FNexusScopedRunHistory()
+        : Dir(FPaths::ProjectIntermediateDir() / TEXT("NexusTests") / FGuid::NewGuid().ToString())
+    {
+        FNexusRunHistory::Get().SetDirectory(Dir);
+    }
+
+    ~FNexusScopedRunHistory()
+    {
+        FNexusRunHistory::Get().SetDirectory(FString());
+        IFileManager::Get().DeleteDirectory(*Dir, false, true);
+    }
+
+    const FString& GetDir() const { return Dir; }
+
+    /** Record one passing execution of Test that took Seconds */
+    void RecordPass(FNexusTest* Test, double Seconds) const
+    {
+        Test->LastResult = FNexusTestResult();
+        Test->LastResult.TestName = Test->TestName;
+        Test->LastResult.bPassed = true;
+        Test->LastResult.DurationSeconds = Seconds;
+        Test->LastResult.AttemptHistory.AddDefaulted();
+        FNexusRunHistory::Get().RecordResults({ Test }, Test->LastResult.Timestamp);
+    }
+
+private:
+    FString Dir;
+};
+
+/** Which worker ran which job, in start order; scheduler bodies add to it from every worker */
+struct FNexusJobLog
+{
+    FCriticalSection Lock;
+    TArray<TPair<FNexusTest*, int32>> Runs;
+
+    void Add(FNexusTest* Test, int32 WorkerIndex)
+    {
+        FScopeLock ScopeLock(&Lock);
+        Runs.Emplace(Test, WorkerIndex);
+    }
+
+    TArray<FNexusTest*> GetTests(int32 WorkerIndex = INDEX_NONE)
+    {
+        FScopeLock ScopeLock(&Lock);
+        TArray<FNexusTest*> Tests;
+        for (const TPair<FNexusTest*, int32>& Run : Runs)
+        {
+            if (WorkerIndex == INDEX_NONE || Run.Value == WorkerIndex)
+            {
+                Tests.Add(Run.Key);
+            }
+        }
+        return Tests;
+    }
+};
+
+/** Sleep-poll Condition from a scheduler body; false if it does not hold within TimeoutSeconds */
+static bool NexusWaitUntil(TFunctionRef<bool()> Condition, double TimeoutSeconds = 10.0)
+{
+    const double Deadline = FPlatformTime::Seconds() + TimeoutSeconds;
+    while (!Condition())
+    {
+        if (FPlatformTime::Seconds() > Deadline)
+        {
+            return false;
+        }
+        FPlatformProcess::Sleep(0.001f);
+    }
+    return true;
+}
+
+/**
+ * LPT dealing: priority class first, then longest predicted duration first, and a test without history is
+ * weighted with the mean of the known ones. One worker, so the run order is the dealing order.
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusSchedulerLptOrder, "Nexus.Core.SchedulerLptOrder", ETestPriority::Normal, {"Framework"})
+{
+    FNexusScopedRunHistory History;
+    FNexusSyntheticSuite Suite;
+    FNexusTest* Short = Suite.Add(TEXT("Sched.Lpt.Short"));
+    FNexusTest* Long = Suite.Add(TEXT("Sched.Lpt.Long"));
+    FNexusTest* Medium = Suite.Add(TEXT("Sched.Lpt.Medium"));
+    FNexusTest* Unknown = Suite.Add(TEXT("Sched.Lpt.Unknown"));
+    FNexusTest* Smoke = Suite.Add(TEXT("Sched.Lpt.Smoke"), ETestPriority::Smoke);
+    FNexusTest* Critical = Suite.Add(TEXT("Sched.Lpt.Critical"), ETestPriority::Critical);
+    History.RecordPass(Short, 1.0);
+    History.RecordPass(Long, 6.0);
+    History.RecordPass(Medium, 3.0);
+    History.RecordPass(Smoke, 0.5);
+    History.RecordPass(Critical, 0.5);
+    if (FNexusScheduler::PredictDuration(Long, 0.0) != 6.0 || FNexusScheduler::PredictDuration(Unknown, 0.0) != 0.0)
+    {
+        return false;
+    }
+
+    // Unknown is weighted 2.2s, between Medium and Short; the short Critical and Smoke tests still go first
+    FNexusJobLog Log;
+    FNexusScheduler Scheduler(1);
+    Scheduler.Enqueue({ Short, Unknown, Critical, Medium, Smoke, Long });
+    Scheduler.Run([&Log](FNexusScheduledTest& Job, int32 WorkerIndex)
+    {
+        Log.Add(Job.Test, WorkerIndex);
+        return ENexusJobResult::Completed;
+    });
+    return Log.GetTests() == TArray<FNexusTest*>({ Critical, Smoke, Long, Medium, Unknown, Short });
+}
+
+/**
+ * An idle worker steals from the peer with the most predicted work left, and takes that peer's shortest job -
+ * not the shortest job anywhere
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusSchedulerStealShortestFromMostLoaded, "Nexus.Core.SchedulerStealShortestFromMostLoaded", ETestPriority::Normal, {"Framework"})
+{
+    FNexusScopedRunHistory History;
+    FNexusSyntheticSuite Suite;
+    FNexusTest* Gate = Suite.Add(TEXT("Sched.Steal.Gate"));
+    FNexusTest* HoldA = Suite.Add(TEXT("Sched.Steal.HoldA"));
+    FNexusTest* HoldB = Suite.Add(TEXT("Sched.Steal.HoldB"));
+    FNexusTest* Mid = Suite.Add(TEXT("Sched.Steal.Mid"));
+    FNexusTest* Small = Suite.Add(TEXT("Sched.Steal.Small"));
+    FNexusTest* Tiny = Suite.Add(TEXT("Sched.Steal.Tiny"));
+    History.RecordPass(Gate, 10.0);
+    History.RecordPass(HoldA, 4.0);
+    History.RecordPass(HoldB, 3.0);
+    History.RecordPass(Mid, 2.0);
+    History.RecordPass(Small, 1.0);
+    History.RecordPass(Tiny, 0.5);
+
+    // Dealt as worker 0 = [Gate], 1 = [Tiny, Small, HoldA], 2 = [Mid, HoldB] (owners run from the back).
+    // Once both holds run, worker 1 has 1.5s left and worker 2 has 2s: Gate's worker must take Mid first.
+    FNexusJobLog Log;
+    std::atomic<int32> HoldsStarted{0};
+    std::atomic<int32> StolenFinished{0};
+    std::atomic<bool> bWaitTimedOut{false};
+    FNexusScheduler Scheduler(3);
+    Scheduler.Enqueue({ Tiny, HoldB, Gate, Small, HoldA, Mid });
+    Scheduler.Run([&](FNexusScheduledTest& Job, int32 WorkerIndex)
+    {
+        Log.Add(Job.Test, WorkerIndex);
+        if (Job.Test == Gate)
+        {
+            if (!NexusWaitUntil([&HoldsStarted]() { return HoldsStarted.load() == 2; }))
+            {
+                bWaitTimedOut = true;
+            }
+        }
+        else if (Job.Test == HoldA || Job.Test == HoldB)
+        {
+            HoldsStarted.fetch_add(1);
+            if (!NexusWaitUntil([&StolenFinished]() { return StolenFinished.load() == 3; }))
+            {
+                bWaitTimedOut = true;
+            }
+        }
+        else
+        {
+            StolenFinished.fetch_add(1);
+        }
+        return ENexusJobResult::Completed;
+    });
+    return !bWaitTimedOut
+        && Log.GetTests(0) == TArray<FNexusTest*>({ Gate, Mid, Tiny, Small })
+        && Log.GetTests(1) == TArray<FNexusTest*>({ HoldA })
+        && Log.GetTests(2) == TArray<FNexusTest*>({ HoldB });
+}
+
+/**
+ * A failed attempt with retries left goes back to the scheduler until NotBeforeSeconds: its worker runs other
+ * jobs meanwhile, then the retry continues the same execution and every attempt keeps its own AttemptHistory record
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusSchedulerRetryBackoff, "Nexus.Core.SchedulerRetryBackoff", ETestPriority::Normal, {"Framework"})
+{
+    FNexusSyntheticSuite Suite;
+    FNexusTest* Flaky = Suite.Add(TEXT("Sched.Retry.A.Flaky"));
+    FNexusTest* Other = Suite.Add(TEXT("Sched.Retry.B.Other"));
+    FNexusTest* Another = Suite.Add(TEXT("Sched.Retry.C.Another"));
+    std::atomic<int32> FlakyCalls{0};
+    Flaky->MaxRetries = 1;
+    Flaky->TestFunc = [&FlakyCalls](const FNexusTestContext&) { return FlakyCalls.fetch_add(1) > 0; };
+
+    // Same body as the parallel lane, with a shorter backoff than GetRetryDelaySeconds
+    constexpr double BackoffSeconds = 0.25;
+    FNexusJobLog Log;
+    double RetryNotBefore = 0.0;
+    double RetryStarted = 0.0;
+    FNexusScheduler Scheduler(1);
+    Scheduler.Enqueue({ Another, Flaky, Other });
+    Scheduler.Run([&](FNexusScheduledTest& Job, int32 WorkerIndex)
+    {
+        Log.Add(Job.Test, WorkerIndex);
+        if (Job.Attempt == 0)
+        {
+            Job.Test->BeginExecution();
+        }
+        else
+        {
+            RetryStarted = FPlatformTime::Seconds();
+        }
+
+        FNexusTestContext EmptyContext;
+        ++Job.Attempt;
+        if (Job.Test->ExecuteAttempt(EmptyContext, Job.Attempt) == ENexusAttemptOutcome::Retry)
+        {
+            Job.NotBeforeSeconds = RetryNotBefore = FPlatformTime::Seconds() + BackoffSeconds;
+            return ENexusJobResult::Reschedule;
+        }
+        return ENexusJobResult::Completed;
+    });
+
+    // Names break the tie between unweighted tests, so Flaky runs first and Other takes its worker while it backs off
+    const TArray<FNexusTest*> Order = Log.GetTests();
+    if (Order.Num() != 4 || Order[0] != Flaky || Order[1] != Other || Order.FilterByPredicate([Flaky](FNexusTest* Test) { return Test == Flaky; }).Num() != 2)
+    {
+        return false;
+    }
+
+    const FNexusTestResult& Result = Flaky->LastResult;
+    return RetryStarted >= RetryNotBefore
+        && Result.bPassed && Result.Attempts == 2 && Result.AttemptHistory.Num() == 2
+        && Result.AttemptHistory[0].Attempt == 1 && !Result.AttemptHistory[0].bPassed
+        && Result.AttemptHistory[1].Attempt == 2 && Result.AttemptHistory[1].bPassed
+        && Other->LastResult.bPassed && Other->LastResult.AttemptHistory.Num() == 1;
+}
+
+/**
+ * A scheduler-lane attempt that overruns a tiny MaxDurationSeconds: the watchdog cancels its token, the body's
+ * PALANTIR_CHECKPOINT returns within a poll, and the attempt is reported as timed out - neither abandoned nor hung
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusWatchdogCancelsOverrun, "Nexus.Core.WatchdogCancelsOverrun", ETestPriority::Normal, {"Framework"})
+{
+    FNexusSyntheticSuite Suite;
+    FNexusTest* Stuck = Suite.Add(TEXT("Watchdog.Stuck"));
+    Stuck->MaxDurationSeconds = 0.1;
+    TSharedPtr<FNexusCancellationToken, ESPMode::ThreadSafe> Token;
+    Stuck->TestFunc = [&Token](const FNexusTestContext&)
+    {
+        Token = FNexusCancellationToken::GetCurrent();
+        // Bounded, so a broken watchdog fails this test instead of stalling the run
+        const double GiveUpSeconds = FPlatformTime::Seconds() + 30.0;
+        while (FPlatformTime::Seconds() < GiveUpSeconds)
+        {
+            PALANTIR_CHECKPOINT(TEXT("Spin"), TEXT("Waiting for the deadline"));
+            FPlatformProcess::Sleep(0.005f);
+        }
+        return true;
+    };
+
+    bool bAbandoned = false;
+    const double StartSeconds = FPlatformTime::Seconds();
+    FNexusScheduler Scheduler(1);
+    Scheduler.SetAbandonHandler([&bAbandoned](FNexusScheduledTest& Job, int32 WorkerIndex, double HungSeconds)
+    {
+        bAbandoned = true;
+    });
+    Scheduler.Enqueue({ Stuck });
+    Scheduler.Run([](FNexusScheduledTest& Job, int32 WorkerIndex)
+    {
+        FNexusTestContext EmptyContext;
+        Job.Test->BeginExecution();
+        Job.Test->ExecuteAttempt(EmptyContext, ++Job.Attempt);
+        return ENexusJobResult::Completed;
+    });
+    const double ElapsedSeconds = FPlatformTime::Seconds() - StartSeconds;
+
+    // FPalantirObserver::OnTestTimedOut saves the stack at the deadline as an artifact of the test
+    const TArray<FString> Artifacts = FPalantirObserver::GetArtifacts(Stuck->TestName);
+    const FString* StackFile = Artifacts.FindByPredicate([](const FString& Path)
+    {
+        return FPaths::GetCleanFilename(Path).StartsWith(TEXT("timeout_"));
+    });
+    const bool bObserverNotified = StackFile != nullptr;
+    if (StackFile)
+    {
+        IFileManager::Get().Delete(**StackFile);
+    }
+
+    const FNexusTestResult& Result = Stuck->LastResult;
+    return bObserverNotified && !bAbandoned && ElapsedSeconds < FNexusWatchdog::GetGraceSeconds()
+        && Token.IsValid() && Token->IsCancellationRequested()
+        && Result.bTimedOut && !Result.bPassed
+        && Result.AttemptHistory.Num() == 1 && Result.AttemptHistory[0].bTimedOut;
+}
+
+/**
+ * The history store reads back what it appended once its index is dropped: durations, statuses, attempts and
+ * trace IDs. A torn append (one column a row short) is cut back to the shortest column on load and on the next
+ * append, so the columns line up again.
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusRunHistoryRoundTrip, "Nexus.Core.RunHistoryRoundTrip", ETestPriority::Normal, {"Framework"})
+{
+    FNexusScopedRunHistory History;
+    FNexusSyntheticSuite Suite;
+    FNexusTest* Steady = Suite.Add(TEXT("History.RoundTrip.Steady"));
+    FNexusTest* Slow = Suite.Add(TEXT("History.RoundTrip.Slow"));
+    FNexusRunHistory& Store = FNexusRunHistory::Get();
+
+    const auto SetResult = [](FNexusTest* Test, double Seconds, bool bPassed, uint32 Attempts)
+    {
+        Test->LastResult = FNexusTestResult();
+        Test->LastResult.TestName = Test->TestName;
+        Test->LastResult.bPassed = bPassed;
+        Test->LastResult.bTimedOut = !bPassed;
+        Test->LastResult.DurationSeconds = Seconds;
+        Test->LastResult.Attempts = Attempts;
+        Test->LastResult.AttemptHistory.SetNum(Attempts);
+        Test->LastResult.TraceID = FPalantirTrace::GenerateTraceID();
+        return Test->LastResult.TraceID;
+    };
+
+    const FDateTime RunStart = FDateTime::Now();
+    const FString SteadyTrace = SetResult(Steady, 1.5, true, 2);
+    const FString SlowTrace = SetResult(Slow, 3.0, false, 1);
+    if (Store.RecordResults({ Steady, Slow }, RunStart) != 2)
+    {
+        return false;
+    }
+
+    Store.Reset();
+    TArray<FNexusHistoryRun> SteadyRuns = Store.GetRecentRuns(Steady->TestName, true);
+    TArray<FNexusHistoryRun> SlowRuns = Store.GetRecentRuns(Slow->TestName, true);
+    if (Store.GetRowCount() != 2 || SteadyRuns.Num() != 1 || SlowRuns.Num() != 1
+        || SteadyRuns[0].DurationSeconds != 1.5 || !SteadyRuns[0].Passed() || SteadyRuns[0].Attempts != 2 || SteadyRuns[0].TraceID != SteadyTrace
+        || SlowRuns[0].DurationSeconds != 3.0 || SlowRuns[0].Status != ENexusHistoryStatus::TimedOut || SlowRuns[0].TraceID != SlowTrace)
+    {
+        return false;
+    }
+
+    // Tear the second row off one column, as a crash between column writes would
+    const FString DurationPath = History.GetDir() / TEXT("duration.col");
+    TArray<uint8> Durations;
+    if (!FFileHelper::LoadFileToArray(Durations, *DurationPath) || Durations.Num() != 2 * sizeof(float))
+    {
+        return false;
+    }
+    Durations.SetNum(sizeof(float));
+    FFileHelper::SaveArrayToFile(Durations, *DurationPath);
+
+    Store.Reset();
+    if (Store.GetRowCount() != 1 || Store.GetRecentRuns(Slow->TestName).Num() != 0 || Store.GetRecentRuns(Steady->TestName, true)[0].TraceID != SteadyTrace)
+    {
+        return false;
+    }
+
+    // The next append overwrites the torn row in every column
+    const FString RetryTrace = SetResult(Slow, 2.0, true, 1);
+    if (Store.RecordResults({ Slow }, RunStart) != 1)
+    {
+        return false;
+    }
+    Store.Reset();
+    SlowRuns = Store.GetRecentRuns(Slow->TestName, true);
+    return Store.GetRowCount() == 2 && SlowRuns.Num() == 1
+        && SlowRuns[0].DurationSeconds == 2.0 && SlowRuns[0].Passed() && SlowRuns[0].TraceID == RetryTrace
+        && IFileManager::Get().FileSize(*(History.GetDir() / TEXT("trace_id.col"))) == 2 * 16
+        && IFileManager::Get().FileSize(*(History.GetDir() / TEXT("test_id.col"))) == 2 * sizeof(uint32);
+}
+
+/**
+ * Suite fixture that spawns a crowd of actors in the world of its first user
+ */
+class FNexusCrowdFixture : public FNexusFixture
+{
+public:
+    FNexusCrowdFixture() : FNexusFixture(TEXT("Nexus.Core.Crowd")) {}
+
+    virtual bool Setup(const FNexusTestContext& Context) override
+    {
+        if (!Context.IsValid())
+        {
+            return true;  // No world running - the users have nothing to check
+        }
+        World = Context.World;
+        for (int32 Index = 0; Index < CrowdSize; ++Index)
+        {
+            Crowd.Add(Context.World->SpawnActor<AActor>(AActor::StaticClass(), FVector(Index * 100.0, 0.0, 0.0), FRotator::ZeroRotator));
+        }
+        return !Crowd.ContainsByPredicate([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid(); });
+    }
+
+    virtual void Teardown() override
+    {
+        for (const TWeakObjectPtr<AActor>& Actor : Crowd)
+        {
+            if (Actor.IsValid())
+            {
+                Actor->Destroy();
+            }
+        }
+        Crowd.Reset();
+        World.Reset();
+    }
+
+    /** Every actor Setup spawned is still alive, in the world this test runs in */
+    bool IsCrowdAlive(const FNexusTestContext& Context) const
+    {
+        return World.Get() == Context.World && Crowd.Num() == CrowdSize
+            && !Crowd.ContainsByPredicate([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid() || Actor->IsActorBeingDestroyed(); });
+    }
+
+private:
+    static constexpr int32 CrowdSize = 3;
+    TWeakObjectPtr<UWorld> World;
+    TArray<TWeakObjectPtr<AActor>> Crowd;
+};
+NEXUS_FIXTURE(FNexusCrowdFixture);
+
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusFixtureCrowdFirstUser, "Nexus.Core.FixtureCrowdFirstUser", ETestPriority::Normal, {"Framework"})
+{
+    const FNexusCrowdFixture* Fixture = FNexusFixture::Get<FNexusCrowdFixture>(TEXT("Nexus.Core.Crowd"));
+    return Fixture && (!Context.IsValid() || Fixture->IsCrowdAlive(Context));
+}
+NEXUS_TEST_FIXTURE(FNexusFixtureCrowdFirstUser, FNexusCrowdFixture);
+
+/**
+ * The crowd survives the world rollback after the first user (pooled worlds are pinned by the fixture)
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusFixtureCrowdSecondUser, "Nexus.Core.FixtureCrowdSecondUser", ETestPriority::Normal, {"Framework"})
+{
+    const FNexusCrowdFixture* Fixture = FNexusFixture::Get<FNexusCrowdFixture>(TEXT("Nexus.Core.Crowd"));
+    return Fixture && (!Context.IsValid() || Fixture->IsCrowdAlive(Context));
+}
+NEXUS_TEST_FIXTURE(FNexusFixtureCrowdSecondUser, FNexusCrowdFixture);
+NEXUS_TEST_DEPENDS(FNexusFixtureCrowdSecondUser, FNexusFixtureCrowdFirstUser);
+
+static FNexusTest* CreateSyntheticBenchmarkTest()
+{
+    return new FNexusTest(TEXT("Nexus.Synthetic.Deferred"), ETestPriority::Normal, [](const FNexusTestContext&) { return true; }, false, {TEXT("Synthetic")});
+}
+
+/**
+ * Module startup cost of 10k tests: what NEXUS_TEST does at load now (register a descriptor) against what
+ * it used to do (construct the test object), and what discovery pays later to materialize them.
+ * Timings are only logged; the test checks that registration builds nothing and materialization builds
+ * each test once, in registration order, with its attributes applied in declaration order.
+ * Opt-in (tag:Benchmark), and game thread, since it adds to and removes from FNexusTest::AllTests.
+ */
+NEXUS_TEST_GAMETHREAD_TAGGED(FNexusDeferredRegistrationBenchmark, "Nexus.Core.DeferredRegistrationBenchmark", ETestPriority::Normal, {"Framework", "Benchmark"})
+{
+    static constexpr int32 SyntheticCount = 10000;
+
+    // Built up front: real names are string literals that cost nothing at load
+    TArray<FString> Names;
+    Names.Reserve(SyntheticCount);
+    for (int32 Index = 0; Index < SyntheticCount; ++Index)
+    {
+        Names.Add(FString::Printf(TEXT("Nexus.Synthetic.Test%05d"), Index));
+    }
+
+    const int32 AllTestsBefore = FNexusTest::AllTests.Num();
+    const int32 RegisteredBefore = FNexusTestDescriptor::Num();
+
+    // Before: one test object per test while the module loads
+    TArray<TUniquePtr<FNexusTest>> Eager;
+    Eager.Reserve(SyntheticCount);
+    double StartTime = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < SyntheticCount; ++Index)
+    {
+        Eager.Add(MakeUnique<FNexusTest>(Names[Index], ETestPriority::Normal, [](const FNexusTestContext&) { return true; }, false, std::initializer_list<FString>{TEXT("Synthetic")}));
+    }
+    const double EagerSeconds = FPlatformTime::Seconds() - StartTime;
+    FNexusTest::AllTests.RemoveAt(AllTestsBefore, SyntheticCount);
+    Eager.Empty();
+
+    // After: one descriptor per test while the module loads
+    TArray<TUniquePtr<FNexusTestDescriptor>> Deferred;
+    Deferred.Reserve(SyntheticCount);
+    StartTime = FPlatformTime::Seconds();
+    for (int32 Index = 0; Index < SyntheticCount; ++Index)
+    {
+        Deferred.Add(MakeUnique<FNexusTestDescriptor>(*Names[Index], &CreateSyntheticBenchmarkTest));
+    }
+    const double RegisterSeconds = FPlatformTime::Seconds() - StartTime;
+    const bool bRegisteredLazily = FNexusTestDescriptor::Num() == RegisteredBefore + SyntheticCount
+        && FNexusTest::AllTests.Num() == AllTestsBefore;
+
+    // Deferred edits of the first test, declared after it like NEXUS_TEST_DEPENDS
+    TUniquePtr<FNexusTestAttribute> FirstEdit = MakeUnique<FNexusTestAttribute>(*Deferred[0], [](FNexusTest& Test) { Test.AddPrerequisite(TEXT("Nexus.Synthetic.A")); });
+    TUniquePtr<FNexusTestAttribute> SecondEdit = MakeUnique<FNexusTestAttribute>(*Deferred[0], [](FNexusTest& Test) { Test.AddPrerequisite(TEXT("Nexus.Synthetic.B")); });
+
+    // ...and what the first discovery pays for them
+    StartTime = FPlatformTime::Seconds();
+    const int32 Materialized = FNexusTestDescriptor::MaterializeAll();
+    const double MaterializeSeconds = FPlatformTime::Seconds() - StartTime;
+    const int32 MaterializedAgain = FNexusTestDescriptor::MaterializeAll();
+
+    // Every descriptor got its own test object, created in registration order
+    TMap<FNexusTest*, int32> Positions;
+    Positions.Reserve(Materialized);
+    for (int32 Index = AllTestsBefore; Index < FNexusTest::AllTests.Num(); ++Index)
+    {
+        Positions.Add(FNexusTest::AllTests[Index], Index);
+    }
+    bool bInOrder = true;
+    int32 LastPosition = INDEX_NONE;
+    TSet<FNexusTest*> Synthetic;
+    for (const TUniquePtr<FNexusTestDescriptor>& Descriptor : Deferred)
+    {
+        FNexusTest* Test = Descriptor->GetInstance();
+        const int32* Position = Test ? Positions.Find(Test) : nullptr;
+        bInOrder &= Position && *Position > LastPosition;
+        LastPosition = Position ? *Position : LastPosition;
+        Synthetic.Add(Test);
+    }
+    const bool bAttributesInOrder = Deferred[0]->GetInstance()
+        && Deferred[0]->GetInstance()->Prerequisites == TArray<FString>({ TEXT("Nexus.Synthetic.A"), TEXT("Nexus.Synthetic.B") });
+
+    FNexusTest::AllTests.RemoveAll([&Synthetic](FNexusTest* Test) { return Synthetic.Contains(Test); });
+    for (FNexusTest* Test : Synthetic)
+    {
+        delete Test;
+    }
+
+    // Newest first, like statics at module unload
+    SecondEdit.Reset();
+    FirstEdit.Reset();
+    while (Deferred.Num() > 0)
+    {
+        Deferred.Pop();
+    }
+
+    UE_LOG(LogNexus, Display, TEXT("NEXUS: %d tests at module load — construct %.2f ms, register %.3f ms (%.0fx); discovery materializes them in %.2f ms"),
+        SyntheticCount, EagerSeconds * 1000.0, RegisterSeconds * 1000.0, RegisterSeconds > 0.0 ? EagerSeconds / RegisterSeconds : 0.0, MaterializeSeconds * 1000.0);
+
+    return bRegisteredLazily
+        && Materialized >= SyntheticCount
+        && MaterializedAgain == 0
+        && Synthetic.Num() == SyntheticCount
+        && bInOrder
+        && bAttributesInOrder
+        && FNexusTestDescriptor::Num() == RegisteredBefore
+        && FNexusTest::AllTests.Num() == AllTestsBefore + Materialized - SyntheticCount;
+}